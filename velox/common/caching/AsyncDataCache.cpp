@@ -56,7 +56,8 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
     hook(*this);
   }
 
-  if ((ssdFile_ == nullptr) && (shard_->cache()->ssdCache() != nullptr)) {
+  if ((ssdFile_ == nullptr) && (shard_->cache()->ssdCache() != nullptr) &&
+      !isDecompressedPage(key_.offset)) {
     auto* ssdCache = shard_->cache()->ssdCache();
     assert(ssdCache); // for lint only.
     if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_)) {
@@ -137,6 +138,99 @@ std::string AsyncDataCacheEntry::toString() const {
       numPins_);
 }
 
+std::string cachePolicyKindString(CachePolicyKind kind) {
+  switch (kind) {
+    case CachePolicyKind::kDefault:
+      return "DEFAULT";
+    case CachePolicyKind::kTinyLfu:
+      return "TINY_LFU";
+    default:
+      return fmt::format("UNKNOWN: {}", static_cast<int>(kind));
+  }
+}
+
+namespace {
+class DefaultCachePolicy : public CachePolicy {
+ public:
+  CachePolicyKind kind() const override {
+    return CachePolicyKind::kDefault;
+  }
+
+  void recordAccess(RawFileCacheKey /*key*/, int32_t /*numEntries*/) override {
+  }
+
+  int32_t score(const AsyncDataCacheEntry& entry, AccessTime now)
+      const override {
+    return entry.score(now);
+  }
+
+  bool isProtected(const AsyncDataCacheEntry& /*entry*/) const override {
+    return false;
+  }
+};
+
+// Splits the entries into a protected segment of entries that the frequency
+// sketch has seen used at least twice recently and a probation segment of the
+// rest. Any probation entry scores above any protected one. Within a segment,
+// entries are ranked as with the default policy. An entry that is read once
+// by a scan stays in probation, whereas an entry of the working set enters
+// the protected segment on its first hit. Protected entries fall back to
+// probation as the sketch ages the counts of entries that are no longer used.
+class TinyLfuCachePolicy : public CachePolicy {
+ public:
+  CachePolicyKind kind() const override {
+    return CachePolicyKind::kTinyLfu;
+  }
+
+  void recordAccess(RawFileCacheKey key, int32_t numEntries) override {
+    if (numEntries > sketch_.capacity()) {
+      // Keeps the counts, so that the protected segment survives the growth
+      // of the cache during warm-up.
+      sketch_.grow(numEntries);
+    }
+    sketch_.recordAccess(std::hash<RawFileCacheKey>()(key));
+  }
+
+  int32_t score(const AsyncDataCacheEntry& entry, AccessTime now)
+      const override {
+    const auto score = entry.score(now);
+    if (score == std::numeric_limits<int32_t>::max()) {
+      // Explicitly evictable.
+      return score;
+    }
+    if (isProtected(entry)) {
+      return std::min(score, kProbationScore - 1);
+    }
+    return kProbationScore + std::clamp(score, 0, kProbationScore - 1);
+  }
+
+  bool isProtected(const AsyncDataCacheEntry& entry) const override {
+    return sketch_.estimate(std::hash<FileCacheKey>()(entry.key())) >=
+        kMinProtectedFrequency;
+  }
+
+ private:
+  static constexpr int32_t kInitialCapacity = 1024;
+  static constexpr int32_t kMinProtectedFrequency = 2;
+  // Lowest score of an entry in probation.
+  static constexpr int32_t kProbationScore = 1 << 30;
+
+  FrequencySketch sketch_{kInitialCapacity};
+};
+} // namespace
+
+// static
+std::unique_ptr<CachePolicy> CachePolicy::create(CachePolicyKind kind) {
+  switch (kind) {
+    case CachePolicyKind::kDefault:
+      return std::make_unique<DefaultCachePolicy>();
+    case CachePolicyKind::kTinyLfu:
+      return std::make_unique<TinyLfuCachePolicy>();
+    default:
+      VELOX_UNREACHABLE("Unknown cache policy {}", static_cast<int>(kind));
+  }
+}
+
 std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
   std::unique_ptr<AsyncDataCacheEntry> newEntry;
   if (freeEntries_.empty()) {
@@ -176,6 +270,7 @@ CachePin CacheShard::findOrCreate(
         } else {
           ++numHit_;
           hitBytes_ += found->size();
+          policy_->recordAccess(key, entries_.size());
         }
         ++found->numPins_;
         CachePin pin;
@@ -209,6 +304,7 @@ CachePin CacheShard::findOrCreate(
       entries_[index] = std::move(newEntry);
     }
     ++numNew_;
+    policy_->recordAccess(key, entries_.size());
     // Inside the shard mutex.
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
@@ -227,6 +323,29 @@ bool CacheShard::exists(RawFileCacheKey key) const {
   return false;
 }
 
+CachePin CacheShard::find(RawFileCacheKey key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++eventCounter_;
+  auto it = entryMap_.find(key);
+  if (it == entryMap_.end() || it->second->isExclusive()) {
+    return CachePin();
+  }
+  auto* found = it->second;
+  found->touch();
+  if (found->isPrefetch()) {
+    found->isFirstUse_ = true;
+    found->setPrefetch(false);
+  } else {
+    ++numHit_;
+    hitBytes_ += found->size();
+    policy_->recordAccess(key, entries_.size());
+  }
+  ++found->numPins_;
+  CachePin pin;
+  pin.setEntry(found);
+  return pin;
+}
+
 CachePin CacheShard::initEntry(
     RawFileCacheKey key,
     AsyncDataCacheEntry* entry) {
@@ -269,15 +388,15 @@ bool CoalescedLoad::loadOrFuture(folly::SemiFuture<bool>* wait) {
     state_ = State::kLoading;
   }
   // Outside of 'mutex_'.
+  auto pinsFuture = folly::Future<std::vector<CachePin>>::makeEmpty();
   try {
-    const auto pins = loadData(!wait);
-    for (const auto& pin : pins) {
-      auto* entry = pin.checkedEntry();
-      VELOX_CHECK(entry->key().fileNum.hasValue());
-      VELOX_CHECK(entry->isExclusive());
-      entry->setExclusiveToShared();
+    // Runs the continuations of IO that is already complete on this thread.
+    pinsFuture = loadDataAsync(!wait).via(
+        &folly::QueuedImmediateExecutor::instance());
+    if (pinsFuture.isReady()) {
+      finishLoad(std::move(pinsFuture).value());
+      return true;
     }
-    setEndState(State::kLoaded);
   } catch (std::exception& e) {
     try {
       setEndState(State::kCancelled);
@@ -286,7 +405,39 @@ bool CoalescedLoad::loadOrFuture(folly::SemiFuture<bool>* wait) {
     }
     throw;
   }
-  return true;
+
+  // The IO is in flight. The promise is made before the load can finish.
+  if (wait != nullptr) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (promise_ == nullptr) {
+      promise_ = std::make_unique<folly::SharedPromise<bool>>();
+    }
+    *wait = promise_->getSemiFuture();
+  }
+  std::move(pinsFuture)
+      .thenTry([self = shared_from_this()](
+                   folly::Try<std::vector<CachePin>>&& pins) {
+        try {
+          self->finishLoad(pins.value());
+        } catch (const std::exception& e) {
+          // The error, if it persists, is hit again by the reader that loads
+          // the entry on its own.
+          LOG(ERROR) << "IOERR: error in asynchronous coalesced load "
+                     << e.what();
+          self->setEndState(State::kCancelled);
+        }
+      });
+  return false;
+}
+
+void CoalescedLoad::finishLoad(const std::vector<CachePin>& pins) {
+  for (const auto& pin : pins) {
+    auto* entry = pin.checkedEntry();
+    VELOX_CHECK(entry->key().fileNum.hasValue());
+    VELOX_CHECK(entry->isExclusive());
+    entry->setExclusiveToShared();
+  }
+  setEndState(State::kLoaded);
 }
 
 void CoalescedLoad::setEndState(State endState) {
@@ -378,11 +529,14 @@ void CacheShard::evict(
       int32_t score = 0;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+           (score = policy_->score(*candidate, now)) >= evictionThreshold_)) {
         if (skipSsdSaveable && candidate->ssdSaveable_ && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
         }
+        if (score && policy_->isProtected(*candidate)) {
+          ++numProtectedEvict_;
+        }
         largeFreed += candidate->data_.byteSize();
         if (pagesToAcquire > 0) {
           auto candidatePages = candidate->data().numPages();
@@ -450,7 +604,7 @@ void CacheShard::calibrateThreshold() {
   evictionThreshold_ = percentile<int32_t>(
       [&]() -> int32_t {
         AsyncDataCacheEntry* element = iter->get();
-        int32_t score = element ? element->score(now) : 0;
+        int32_t score = element ? policy_->score(*element, now) : 0;
         if (entryIndex + step >= entries_.size()) {
           entryIndex = (entryIndex + step) % entries_.size();
           iter = entries_.begin() + entryIndex;
@@ -470,7 +624,11 @@ void CacheShard::updateStats(CacheStats& stats) {
     if (!entry || !entry->key_.fileNum.hasValue()) {
       ++stats.numEmptyEntries;
       continue;
-    } else if (entry->isExclusive()) {
+    }
+    if (policy_->isProtected(*entry)) {
+      ++stats.numProtected;
+    }
+    if (entry->isExclusive()) {
       ++stats.numExclusive;
     } else if (entry->isShared()) {
       ++stats.numShared;
@@ -492,6 +650,8 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numEvictChecks += numEvictChecks_;
   stats.numWaitExclusive += numWaitExclusive_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.policy = policy_->kind();
+  stats.numProtectedEvict += numProtectedEvict_;
   stats.allocClocks += allocClocks_;
 }
 
@@ -520,10 +680,11 @@ void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
 
 AsyncDataCache::AsyncDataCache(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache)
+    std::unique_ptr<SsdCache> ssdCache,
+    CachePolicyKind policyKind)
     : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this));
+    shards_.push_back(std::make_unique<CacheShard>(this, policyKind));
   }
 }
 
@@ -532,8 +693,10 @@ AsyncDataCache::~AsyncDataCache() {}
 // static
 std::shared_ptr<AsyncDataCache> AsyncDataCache::create(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache) {
-  auto cache = std::make_shared<AsyncDataCache>(allocator, std::move(ssdCache));
+    std::unique_ptr<SsdCache> ssdCache,
+    CachePolicyKind policyKind) {
+  auto cache = std::make_shared<AsyncDataCache>(
+      allocator, std::move(ssdCache), policyKind);
   allocator->registerCache(cache);
   return cache;
 }
@@ -578,6 +741,11 @@ bool AsyncDataCache::exists(RawFileCacheKey key) const {
   return shards_[shard]->exists(key);
 }
 
+CachePin AsyncDataCache::find(RawFileCacheKey key) {
+  const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
+  return shards_[shard]->find(key);
+}
+
 bool AsyncDataCache::makeSpace(
     MachinePageCount numPages,
     std::function<bool(memory::Allocation& allocation)> allocate) {
@@ -783,6 +951,12 @@ std::string CacheStats::toString() const {
       << " hit bytes: " << succinctBytes(hitBytes) << " eviction: " << numEvict
       << " eviction checks: " << numEvictChecks
       << "\n"
+      // Cache policy stats.
+      << "Cache policy: " << cachePolicyKindString(policy)
+      << " hit rate: " << fmt::format("{:.1f}%", hitRate() * 100)
+      << " protected entries: " << numProtected
+      << " protected evictions: " << numProtectedEvict
+      << "\n"
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
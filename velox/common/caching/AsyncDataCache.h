@@ -20,6 +20,7 @@
 
 #include <fmt/format.h>
 #include <folly/chrono/Hardware.h>
+#include <folly/futures/Future.h>
 #include <folly/futures/SharedPromise.h>
 #include "folly/GLog.h"
 #include "velox/common/base/BitUtil.h"
@@ -27,6 +28,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
@@ -110,6 +112,22 @@ struct RawFileCacheKey {
     return offset == other.offset && fileNum == other.fileNum;
   }
 };
+
+/// Set in the offset of the key of an entry that holds a decompressed page
+/// instead of bytes of the file. The rest of the offset is the offset of the
+/// compressed page in the file. Such entries use the same memory and eviction
+/// as the file bytes but are not saved to SSD.
+constexpr uint64_t kDecompressedPageBit = 1ULL << 63;
+
+/// Returns the key of the decompressed page for the compressed page at
+/// 'offset' in 'fileNum'.
+inline RawFileCacheKey decompressedPageKey(uint64_t fileNum, uint64_t offset) {
+  return RawFileCacheKey{fileNum, offset | kDecompressedPageBit};
+}
+
+inline bool isDecompressedPage(uint64_t offset) {
+  return (offset & kDecompressedPageBit) != 0;
+}
 } // namespace facebook::velox::cache
 
 namespace std {
@@ -404,8 +422,10 @@ class CachePin {
 /// Represents a possibly multi-entry load from a file system. The cache expects
 /// to load multiple entries in most IOs. The IO is either done by a background
 /// prefetch thread or if the query thread gets there first, then the query
-/// thread will do the IO. The IO is also cancelled as a unit.
-class CoalescedLoad {
+/// thread will do the IO. The IO is also cancelled as a unit. A load whose IO
+/// completes asynchronously is finished on the thread that completes the IO.
+/// Loads are owned by shared_ptr so that they stay live until then.
+class CoalescedLoad : public std::enable_shared_from_this<CoalescedLoad> {
  public:
   /// State of a CoalescedLoad
   enum class State { kPlanned, kLoading, kCancelled, kLoaded };
@@ -421,7 +441,9 @@ class CoalescedLoad {
   /// load of the entries that are not yet present. If another thread is in the
   /// process of doing this and 'wait' is null, returns immediately. If another
   /// thread is in the process of doing this and 'wait' is not null, waits for
-  /// the other thread to be done.
+  /// the other thread to be done. If the load started here completes
+  /// asynchronously, returns false and sets 'wait', if not null, to a future
+  /// that is realized when the load is done.
   bool loadOrFuture(folly::SemiFuture<bool>* wait);
 
   State state() const {
@@ -450,6 +472,18 @@ class CoalescedLoad {
   // users of the cache.
   virtual std::vector<CachePin> loadData(bool isPrefetch) = 0;
 
+  // Asynchronous version of loadData(). The returned pins are expected to be
+  // in the same state as the ones returned by loadData(). The default calls
+  // loadData() and returns a ready future.
+  virtual folly::SemiFuture<std::vector<CachePin>> loadDataAsync(
+      bool isPrefetch) {
+    return folly::makeSemiFuture(loadData(isPrefetch));
+  }
+
+  // Sets the pins of a completed load to shared state and sets the state to
+  // kLoaded.
+  void finishLoad(const std::vector<CachePin>& pins);
+
   // Sets a final state and resumes waiting threads.
   void setEndState(State endState);
 
@@ -465,6 +499,44 @@ class CoalescedLoad {
   std::vector<int32_t> sizes_;
 };
 
+/// Policy for ranking the entries of a CacheShard for eviction.
+enum class CachePolicyKind {
+  /// Ranks entries by time since last use divided by the number of uses.
+  kDefault,
+  /// Admits entries to a protected segment only after they have been used
+  /// repeatedly, as counted by a FrequencySketch. Entries outside the
+  /// protected segment are evicted first, so that a scan that reads a large
+  /// amount of data once does not evict the working set.
+  kTinyLfu,
+};
+
+std::string cachePolicyKindString(CachePolicyKind kind);
+
+/// Decides the retention of the entries of a CacheShard. Called under the
+/// shard mutex.
+class CachePolicy {
+ public:
+  static std::unique_ptr<CachePolicy> create(CachePolicyKind kind);
+
+  virtual ~CachePolicy() = default;
+
+  virtual CachePolicyKind kind() const = 0;
+
+  /// Records a use of the entry for 'key'. This is called when the entry is
+  /// created and when it is hit, except for the first use of a prefetched
+  /// entry. 'numEntries' is the number of entries in the shard.
+  virtual void recordAccess(RawFileCacheKey key, int32_t numEntries) = 0;
+
+  /// Returns the retention score of 'entry'. Entries with a higher score are
+  /// evicted first. 'now' is the current accessTime().
+  virtual int32_t score(const AsyncDataCacheEntry& entry, AccessTime now)
+      const = 0;
+
+  /// Returns true if 'entry' is retained in preference to entries that have
+  /// not been used repeatedly.
+  virtual bool isProtected(const AsyncDataCacheEntry& entry) const = 0;
+};
+
 // Struct for CacheShard stats. Stats from all shards are added into
 // this struct to provide a snapshot of state.
 struct CacheStats {
@@ -509,9 +581,22 @@ struct CacheStats {
   // Sum of scores of evicted entries. This serves to infer an average
   // lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  // Eviction policy of the cache.
+  CachePolicyKind policy{CachePolicyKind::kDefault};
+  // Number of entries in the protected segment of 'policy'.
+  int32_t numProtected{0};
+  // Number of times an entry in the protected segment of 'policy' was
+  // evicted.
+  int64_t numProtectedEvict{0};
 
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
 
+  // Fraction of lookups that found their entry in memory.
+  double hitRate() const {
+    const auto numLookups = numHit + numNew;
+    return numLookups == 0 ? 0 : static_cast<double>(numHit) / numLookups;
+  }
+
   std::string toString() const;
 };
 
@@ -521,7 +606,8 @@ struct CacheStats {
 /// and other housekeeping.
 class CacheShard {
  public:
-  explicit CacheShard(AsyncDataCache* cache) : cache_(cache) {}
+  CacheShard(AsyncDataCache* cache, CachePolicyKind policyKind)
+      : cache_(cache), policy_(CachePolicy::create(policyKind)) {}
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -532,6 +618,9 @@ class CacheShard {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  /// See AsyncDataCache::find.
+  CachePin find(RawFileCacheKey key);
+
   AsyncDataCache* cache() const {
     return cache_;
   }
@@ -599,6 +688,8 @@ class CacheShard {
 
   AsyncDataCache* const cache_;
 
+  const std::unique_ptr<CachePolicy> policy_;
+
   mutable std::mutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
   // Entries associated to a key.
@@ -631,6 +722,8 @@ class CacheShard {
   // Sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
+  // Count of evicted entries that 'policy_' considered protected.
+  uint64_t numProtectedEvict_{0};
   // Tracker of time spent in allocating/freeing MemoryAllocator space
   // for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
@@ -640,13 +733,15 @@ class AsyncDataCache : public memory::Cache {
  public:
   AsyncDataCache(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CachePolicyKind policyKind = CachePolicyKind::kDefault);
 
   ~AsyncDataCache() override;
 
   static std::shared_ptr<AsyncDataCache> create(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CachePolicyKind policyKind = CachePolicyKind::kDefault);
 
   static AsyncDataCache* getInstance();
 
@@ -690,6 +785,11 @@ class AsyncDataCache : public memory::Cache {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  /// Returns a shared pin on the entry for 'key' or an empty pin if there is
+  /// no entry or the entry is being loaded. Does not create an entry. Counts
+  /// as a hit and updates access time if found.
+  CachePin find(RawFileCacheKey key);
+
   CacheStats refreshStats() const;
 
   std::string toString() const;
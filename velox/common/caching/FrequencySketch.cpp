@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <folly/hash/Hash.h>
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+
+namespace {
+// Counts are halved after this many accesses per counter in a row.
+constexpr int32_t kSampleSizeFactor = 10;
+// Smallest number of counters in a row.
+constexpr int32_t kMinWidth = 64;
+// Largest number of counters in a row.
+constexpr int32_t kMaxWidth = 1 << 24;
+} // namespace
+
+void FrequencySketch::resize(int32_t capacity) {
+  width_ = bits::nextPowerOfTwo(std::clamp(capacity, kMinWidth, kMaxWidth));
+  table_.assign(kNumRows * width_ / kCountersPerWord, 0);
+  doorkeeper_.assign(width_ * 8 / 64, 0);
+  sampleSize_ = kSampleSizeFactor * width_;
+  numAccesses_ = 0;
+}
+
+void FrequencySketch::grow(int32_t capacity) {
+  const int32_t width =
+      bits::nextPowerOfTwo(std::clamp(capacity, kMinWidth, kMaxWidth));
+  while (width_ < width) {
+    doubleWidth();
+  }
+}
+
+void FrequencySketch::doubleWidth() {
+  // The counter of a key at index i of a row of 'width_' counters is at i or
+  // at i + width_ of a row of twice the width, depending on the next bit of
+  // its hash. Copying each row into both halves of the wider row keeps every
+  // estimate. The same holds for the bits of the doorkeeper.
+  const int32_t wordsPerRow = width_ / kCountersPerWord;
+  std::vector<uint64_t> table(2 * table_.size());
+  for (auto row = 0; row < kNumRows; ++row) {
+    const auto source = table_.begin() + row * wordsPerRow;
+    const auto target = table.begin() + 2 * row * wordsPerRow;
+    std::copy(source, source + wordsPerRow, target);
+    std::copy(source, source + wordsPerRow, target + wordsPerRow);
+  }
+  table_ = std::move(table);
+  const auto doorkeeperWords = doorkeeper_.size();
+  doorkeeper_.resize(2 * doorkeeperWords);
+  std::copy(
+      doorkeeper_.begin(),
+      doorkeeper_.begin() + doorkeeperWords,
+      doorkeeper_.begin() + doorkeeperWords);
+  width_ *= 2;
+  sampleSize_ = kSampleSizeFactor * width_;
+}
+
+uint32_t
+FrequencySketch::counterIndex(int32_t row, uint64_t h1, uint64_t h2) const {
+  const uint64_t hash = row < 2 ? h1 : h2;
+  const uint32_t index = (row & 1) ? hash >> 32 : hash;
+  return row * width_ + (index & (width_ - 1));
+}
+
+uint64_t FrequencySketch::counter(uint32_t index) const {
+  return (table_[index / kCountersPerWord] >>
+          (4 * (index % kCountersPerWord))) &
+      kMaxCount;
+}
+
+bool FrequencySketch::inDoorkeeper(uint64_t h1, uint64_t h2) const {
+  const uint64_t mask = width_ * 8 - 1;
+  return bits::isBitSet(doorkeeper_.data(), (h1 >> 16) & mask) &&
+      bits::isBitSet(doorkeeper_.data(), (h2 >> 8) & mask);
+}
+
+void FrequencySketch::recordAccess(uint64_t hash) {
+  const uint64_t h1 = folly::hash::twang_mix64(hash);
+  const uint64_t h2 = folly::hash::twang_mix64(h1);
+  if (!inDoorkeeper(h1, h2)) {
+    const uint64_t mask = width_ * 8 - 1;
+    bits::setBit(doorkeeper_.data(), (h1 >> 16) & mask);
+    bits::setBit(doorkeeper_.data(), (h2 >> 8) & mask);
+  } else {
+    // Conservative update: Only the counters that are at the minimum are
+    // incremented. This reduces the overestimate from collisions.
+    uint32_t indices[kNumRows];
+    uint64_t minCount = kMaxCount;
+    for (auto row = 0; row < kNumRows; ++row) {
+      indices[row] = counterIndex(row, h1, h2);
+      minCount = std::min(minCount, counter(indices[row]));
+    }
+    if (minCount < kMaxCount) {
+      for (auto row = 0; row < kNumRows; ++row) {
+        if (counter(indices[row]) == minCount) {
+          table_[indices[row] / kCountersPerWord] += 1ULL
+              << (4 * (indices[row] % kCountersPerWord));
+        }
+      }
+    }
+  }
+  if (++numAccesses_ >= sampleSize_) {
+    age();
+  }
+}
+
+int32_t FrequencySketch::estimate(uint64_t hash) const {
+  const uint64_t h1 = folly::hash::twang_mix64(hash);
+  const uint64_t h2 = folly::hash::twang_mix64(h1);
+  uint64_t minCount = kMaxCount;
+  for (auto row = 0; row < kNumRows; ++row) {
+    minCount = std::min(minCount, counter(counterIndex(row, h1, h2)));
+  }
+  return minCount + (inDoorkeeper(h1, h2) ? 1 : 0);
+}
+
+void FrequencySketch::age() {
+  for (auto& word : table_) {
+    word = (word >> 1) & 0x7777777777777777ULL;
+  }
+  std::fill(doorkeeper_.begin(), doorkeeper_.end(), 0);
+  numAccesses_ /= 2;
+  ++numAgings_;
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+// Approximate count of recent accesses per key hash. This is a count-min
+// sketch of 4 bit counters with a doorkeeper bit set in front. The first
+// access to a key only sets its doorkeeper bits, so that keys that are seen
+// once do not inflate the counters of other keys. After a number of accesses
+// proportional to the capacity, all counters are halved and the doorkeeper is
+// cleared so that old accesses age out. Not thread safe, synchronization is
+// the caller's responsibility.
+class FrequencySketch {
+ public:
+  // Largest value returned by estimate().
+  static constexpr int32_t kMaxFrequency = 16;
+
+  // 'capacity' is the expected number of distinct keys of interest.
+  explicit FrequencySketch(int32_t capacity) {
+    resize(capacity);
+  }
+
+  // Sizes 'this' for 'capacity' distinct keys. Forgets all accesses.
+  void resize(int32_t capacity);
+
+  // Sizes 'this' for at least 'capacity' distinct keys, keeping the
+  // estimates of the keys accessed so far. Does nothing if 'this' is already
+  // large enough.
+  void grow(int32_t capacity);
+
+  // Returns the number of distinct keys 'this' is sized for.
+  int32_t capacity() const {
+    return width_;
+  }
+
+  // Counts an access to the key with 'hash'.
+  void recordAccess(uint64_t hash);
+
+  // Returns the estimated number of recent accesses to the key with
+  // 'hash'. The estimate may be high due to collisions but is never low,
+  // except for the effect of aging.
+  int32_t estimate(uint64_t hash) const;
+
+  // Number of times the counts have been halved.
+  int64_t numAgings() const {
+    return numAgings_;
+  }
+
+ private:
+  static constexpr int32_t kNumRows = 4;
+  static constexpr int32_t kCountersPerWord = 16;
+  static constexpr uint64_t kMaxCount = 15;
+
+  // Returns the index of the counter for the key with hashes 'h1' and 'h2'
+  // in 'row'.
+  uint32_t counterIndex(int32_t row, uint64_t h1, uint64_t h2) const;
+
+  uint64_t counter(uint32_t index) const;
+
+  bool inDoorkeeper(uint64_t h1, uint64_t h2) const;
+
+  // Halves all counts and clears the doorkeeper.
+  void age();
+
+  // Doubles the number of counters in a row, keeping all counts.
+  void doubleWidth();
+
+  // Number of counters in a row. A power of 2.
+  int32_t width_{0};
+
+  // kNumRows rows of 'width_' 4 bit counters.
+  std::vector<uint64_t> table_;
+
+  // Bloom filter of keys accessed since the last aging. Has 8 bits per
+  // counter in a row.
+  std::vector<uint64_t> doorkeeper_;
+
+  // Number of accesses since the last aging.
+  int32_t numAccesses_{0};
+
+  // Number of accesses after which counts are halved.
+  int32_t sampleSize_{0};
+
+  int64_t numAgings_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -152,6 +152,20 @@ class ScanTracker {
     return readPct(id) >= minReadPct;
   }
 
+  // True if 'id' has been referenced more than once and is read at least
+  // 'minReadPct' % of the time. Unlike shouldPrefetch(), this is false if
+  // there is no data.
+  bool isFrequentlyRead(TrackingId id, int32_t minReadPct) {
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto it = data_.find(id);
+    if (it == data_.end()) {
+      return false;
+    }
+    const auto& data = it->second;
+    return data.numReferences > 1 &&
+        100L * data.numReads >= 1L * minReadPct * data.numReferences;
+  }
+
   // Returns the percentage of referenced columns that are actually read. 100%
   // if no data.
   int32_t readPct(TrackingId id) {
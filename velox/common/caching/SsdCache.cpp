@@ -31,7 +31,8 @@ SsdCache::SsdCache(
     int32_t numShards,
     folly::Executor* executor,
     int64_t checkpointIntervalBytes,
-    bool disableFileCow)
+    bool disableFileCow,
+    common::CompressionKind compressionKind)
     : filePrefix_(filePrefix),
       numShards_(numShards),
       groupStats_(std::make_unique<FileGroupStats>()),
@@ -56,7 +57,9 @@ SsdCache::SsdCache(
         i,
         fileMaxRegions,
         checkpointIntervalBytes / numShards,
-        disableFileCow));
+        disableFileCow,
+        /*executor=*/nullptr,
+        compressionKind));
   }
 }
 
@@ -151,6 +154,10 @@ std::string SsdCache::toString() const {
       << (data.bytesRead >> 20) << "MB Size " << (capacity >> 30)
       << "GB Occupied " << (data.bytesCached >> 30) << "GB";
   out << (data.entriesCached >> 10) << "K entries.";
+  if (data.entriesCompressed > 0) {
+    out << "\nCompression ratio " << data.compressionRatio() << " with "
+        << data.entriesIncompressible << " incompressible entries";
+  }
   out << "\nGroupStats: " << groupStats_->toString(capacity);
   return out.str();
 }
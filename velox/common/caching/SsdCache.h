@@ -43,13 +43,16 @@ class SsdCache {
   /// write) feature if the underlying filesystem (such as brtfs) supports it.
   /// This prevents the actual cache space usage on disk from exceeding the
   /// 'maxBytes' limit and stop working.
+  /// If 'compressionKind' is not NONE, entries are compressed with it when
+  /// written to SSD. Entries that do not compress well are stored as is.
   SsdCache(
       std::string_view filePrefix,
       uint64_t maxBytes,
       int32_t numShards,
       folly::Executor* executor,
       int64_t checkpointIntervalBytes = 0,
-      bool disableFileCow = false);
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE);
 
   /// Returns the shard corresponding to 'fileId'. 'fileId' is a file id from
   /// e.g. FileCacheKey.
@@ -16,11 +16,15 @@
 
 #include "velox/common/caching/SsdFile.h"
 #include <folly/Executor.h>
+#include <folly/futures/Future.h>
+#include <folly/io/Cursor.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
+#include "velox/common/time/Timer.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -34,6 +38,10 @@
 
 DEFINE_bool(ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 DEFINE_bool(ssd_verify_write, false, "Read back data after writing to SSD");
+DEFINE_bool(
+    ssd_io_uring,
+    true,
+    "Read SSD cache entries asynchronously through io_uring if available");
 
 namespace facebook::velox::cache {
 
@@ -79,6 +87,21 @@ void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
     };
   }
 }
+
+// Decompresses 'compressed', the stored data of 'run', into 'entry'.
+void decompressEntry(
+    folly::io::Codec& codec,
+    const folly::IOBuf& compressed,
+    SsdRun run,
+    AsyncDataCacheEntry& entry) {
+  auto uncompressed = codec.uncompress(&compressed, run.size());
+  folly::io::Cursor cursor(uncompressed.get());
+  std::vector<iovec> iovecs;
+  addEntryToIovecs(entry, iovecs);
+  for (const auto& iov : iovecs) {
+    cursor.pull(iov.iov_base, iov.iov_len);
+  }
+}
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -122,9 +145,11 @@ SsdFile::SsdFile(
     int32_t maxRegions,
     int64_t checkpointIntervalBytes,
     bool disableFileCow,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    common::CompressionKind compressionKind)
     : fileName_(filename),
       maxRegions_(maxRegions),
+      compressionKind_(compressionKind),
       shardId_(shardId),
       checkpointIntervalBytes_(checkpointIntervalBytes),
       executor_(executor) {
@@ -149,6 +174,9 @@ SsdFile::SsdFile(
   }
 
   readFile_ = std::make_unique<LocalReadFile>(fd_);
+  if (FLAGS_ssd_io_uring) {
+    ioUring_ = IoUring::getInstance();
+  }
   uint64_t size = lseek(fd_, 0, SEEK_END);
   numRegions_ = size / kRegionSize;
   if (numRegions_ > maxRegions_) {
@@ -216,13 +244,21 @@ bool SsdFile::erase(RawFileCacheKey key) {
 CoalesceIoStats SsdFile::load(
     const std::vector<SsdPin>& ssdPins,
     const std::vector<CachePin>& pins) {
+  return loadAsync(ssdPins, pins).get();
+}
+
+folly::SemiFuture<CoalesceIoStats> SsdFile::loadAsync(
+    const std::vector<SsdPin>& ssdPins,
+    const std::vector<CachePin>& pins) {
   VELOX_CHECK_EQ(ssdPins.size(), pins.size());
   if (pins.empty()) {
-    return CoalesceIoStats();
+    return folly::makeSemiFuture(CoalesceIoStats());
   }
   int payloadTotal = 0;
+  bool anyCompressed = false;
   for (auto i = 0; i < pins.size(); ++i) {
     const auto runSize = ssdPins[i].run().size();
+    anyCompressed |= ssdPins[i].run().isCompressed();
     auto* entry = pins[i].checkedEntry();
     if (FOLLY_UNLIKELY(runSize < entry->size())) {
       ++stats_.readSsdErrors;
@@ -240,36 +276,148 @@ CoalesceIoStats SsdFile::load(
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
-  auto stats = readPins(
-      pins,
-      payloadTotal / pins.size() < 10000 ? 25000 : 50000,
-      // Max ranges in one preadv call. Longest gap + longest cache entry are
-      // under 12 ranges. If a system has a limit of 1K ranges, coalesce limit
-      // of 1000 is safe.
-      900,
+  const int32_t maxGap = payloadTotal / pins.size() < 10000 ? 25000 : 50000;
+  // Max ranges in one preadv call. Longest gap + longest cache entry are
+  // under 12 ranges. If a system has a limit of 1K ranges, coalesce limit
+  // of 1000 is safe.
+  constexpr int32_t kMaxRangesPerIo = 900;
+  auto setSsdFile = [this, &ssdPins, &pins](CoalesceIoStats stats) {
+    for (auto i = 0; i < ssdPins.size(); ++i) {
+      pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
+    }
+    return stats;
+  };
+  if (!anyCompressed) {
+    std::vector<IoUring::Request> requests;
+    auto stats = readPins(
+        pins,
+        maxGap,
+        kMaxRangesPerIo,
+        [&](int32_t index) { return ssdPins[index].run().offset(); },
+        [&](const std::vector<CachePin>& /*pins*/,
+            int32_t /*begin*/,
+            int32_t /*end*/,
+            uint64_t offset,
+            const std::vector<folly::Range<char*>>& buffers) {
+          requests.push_back({fd_, offset, false, buffers});
+        });
+    return read(std::move(requests))
+        .deferValue([stats, setSsdFile](folly::Unit) {
+          return setSsdFile(stats);
+        });
+  }
+  return loadCompressed(ssdPins, pins, maxGap, kMaxRangesPerIo)
+      .deferValue(setSsdFile);
+}
+
+folly::SemiFuture<CoalesceIoStats> SsdFile::loadCompressed(
+    const std::vector<SsdPin>& ssdPins,
+    const std::vector<CachePin>& pins,
+    int32_t maxGap,
+    int32_t rangesPerIo) {
+  // Compressed entries are read into 'compressed' and decompressed into their
+  // entries after the IO. Entries stored as is are read directly into the
+  // entry. The items to coalesce are indices into 'pins' since pins of
+  // exclusive entries cannot be copied. 'compressed' is shared with the
+  // continuation that decompresses after the reads.
+  auto compressedHolder =
+      std::make_shared<std::vector<std::unique_ptr<folly::IOBuf>>>(
+          pins.size());
+  auto& compressed = *compressedHolder;
+  std::vector<int32_t> indices(pins.size());
+  std::iota(indices.begin(), indices.end(), 0);
+  std::vector<IoUring::Request> requests;
+  auto stats = coalesceIo<int32_t, folly::Range<char*>>(
+      indices,
+      maxGap,
+      rangesPerIo,
       [&](int32_t index) { return ssdPins[index].run().offset(); },
-      [&](const std::vector<CachePin>& /*pins*/,
+      [&](int32_t index) {
+        const auto run = ssdPins[index].run();
+        return run.isCompressed() ? run.compressedSize()
+                                  : pins[index].checkedEntry()->size();
+      },
+      [&](int32_t index) {
+        if (ssdPins[index].run().isCompressed()) {
+          return 1;
+        }
+        return std::max<int32_t>(
+            1, pins[index].checkedEntry()->data().numRuns());
+      },
+      [&](int32_t index, std::vector<folly::Range<char*>>& ranges) {
+        const auto run = ssdPins[index].run();
+        if (run.isCompressed()) {
+          compressed[index] = folly::IOBuf::create(run.compressedSize());
+          compressed[index]->append(run.compressedSize());
+          ranges.push_back(folly::Range<char*>(
+              reinterpret_cast<char*>(compressed[index]->writableData()),
+              run.compressedSize()));
+          return;
+        }
+        std::vector<iovec> iovecs;
+        addEntryToIovecs(*pins[index].checkedEntry(), iovecs);
+        for (const auto& iov : iovecs) {
+          ranges.push_back(folly::Range<char*>(
+              reinterpret_cast<char*>(iov.iov_base), iov.iov_len));
+        }
+      },
+      [&](int32_t size, std::vector<folly::Range<char*>>& ranges) {
+        // Same encoding of a gap as in readPins().
+        ranges.push_back(folly::Range<char*>(nullptr, (char*)(uint64_t)size));
+      },
+      [&](const std::vector<int32_t>& /*indices*/,
           int32_t /*begin*/,
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        requests.push_back({fd_, offset, false, buffers});
       });
-
-  for (auto i = 0; i < ssdPins.size(); ++i) {
-    pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
-  }
-  return stats;
+  return read(std::move(requests))
+      .deferValue(
+          [this, compressedHolder, &ssdPins, &pins, stats](folly::Unit) {
+            const auto& compressed = *compressedHolder;
+            uint64_t decompressionMicros{0};
+            {
+              MicrosecondTimer timer(&decompressionMicros);
+              auto codec = common::compressionKindToCodec(compressionKind_);
+              for (auto i = 0; i < pins.size(); ++i) {
+                if (compressed[i] != nullptr) {
+                  decompressEntry(
+                      *codec,
+                      *compressed[i],
+                      ssdPins[i].run(),
+                      *pins[i].checkedEntry());
+                }
+              }
+            }
+            stats_.decompressionMicros += decompressionMicros;
+            return stats;
+          });
 }
 
-void SsdFile::read(
-    uint64_t offset,
-    const std::vector<folly::Range<char*>>& buffers) {
-  readFile_->preadv(offset, buffers);
+folly::SemiFuture<folly::Unit> SsdFile::read(
+    std::vector<IoUring::Request> requests) {
+  if (ioUring_ == nullptr) {
+    for (const auto& request : requests) {
+      readFile_->preadv(request.offset, request.buffers);
+    }
+    return folly::makeSemiFuture();
+  }
+  // Waits for all reads before reporting an error, so that the buffers of the
+  // reads still in flight stay live until these complete.
+  return folly::collectAll(ioUring_->submit(std::move(requests)))
+      .deferValue([this](std::vector<folly::Try<uint64_t>> results) {
+        for (auto& result : results) {
+          if (result.hasException()) {
+            ++stats_.readSsdErrors;
+            result.throwUnlessValue();
+          }
+        }
+      });
 }
 
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
-    const std::vector<CachePin>& pins,
+    const std::vector<int32_t>& sizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -284,13 +432,12 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const auto offset = regionSizes_[region];
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
-    for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+    for (; next < sizes.size(); ++next) {
+      if (sizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= sizes[next];
+      toWrite += sizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -367,9 +514,18 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     total += entry->size();
   }
 
+  const auto compressed = compressEntries(pins);
+  // The number of bytes each entry takes on SSD.
+  std::vector<int32_t> storedSizes(pins.size());
+  for (auto i = 0; i < pins.size(); ++i) {
+    storedSizes[i] = compressed[i] != nullptr
+        ? compressed[i]->length()
+        : pins[i].checkedEntry()->size();
+  }
+
   int32_t storeIndex = 0;
   while (storeIndex < pins.size()) {
-    auto space = getSpace(pins, storeIndex);
+    auto space = getSpace(storedSizes, storeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
       return;
@@ -380,13 +536,17 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     int32_t bytes = 0;
     std::vector<iovec> iovecs;
     for (auto i = storeIndex; i < pins.size(); ++i) {
-      auto* entry = pins[i].checkedEntry();
-      const auto entrySize = entry->size();
-      if (bytes + entrySize > available) {
+      const auto storedSize = storedSizes[i];
+      if (bytes + storedSize > available) {
         break;
       }
-      addEntryToIovecs(*entry, iovecs);
-      bytes += entrySize;
+      if (compressed[i] != nullptr) {
+        iovecs.push_back(
+            {compressed[i]->writableData(), compressed[i]->length()});
+      } else {
+        addEntryToIovecs(*pins[i].checkedEntry(), iovecs);
+      }
+      bytes += storedSize;
       ++numWritten;
     }
     VELOX_CHECK_GE(fileSize_, offset + bytes);
@@ -410,16 +570,19 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         auto* entry = pins[i].checkedEntry();
         entry->setSsdFile(this, offset);
         const auto size = entry->size();
+        const auto storedSize = storedSizes[i];
+        const SsdRun run(
+            offset, size, compressed[i] != nullptr ? storedSize : 0);
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
-        entries_[std::move(key)] = SsdRun(offset, size);
+        entries_[std::move(key)] = run;
         if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size));
+          verifyWrite(*entry, run);
         }
-        offset += size;
+        offset += storedSize;
         ++stats_.entriesWritten;
-        stats_.bytesWritten += size;
-        bytesAfterCheckpoint_ += size;
+        stats_.bytesWritten += storedSize;
+        bytesAfterCheckpoint_ += storedSize;
       }
     }
     storeIndex += numWritten;
@@ -431,6 +594,40 @@ void SsdFile::write(std::vector<CachePin>& pins) {
   }
 }
 
+std::vector<std::unique_ptr<folly::IOBuf>> SsdFile::compressEntries(
+    const std::vector<CachePin>& pins) {
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed(pins.size());
+  if (compressionKind_ == common::CompressionKind_NONE) {
+    return compressed;
+  }
+  uint64_t compressionMicros{0};
+  {
+    MicrosecondTimer timer(&compressionMicros);
+    auto codec = common::compressionKindToCodec(compressionKind_);
+    for (auto i = 0; i < pins.size(); ++i) {
+      auto* entry = pins[i].checkedEntry();
+      std::vector<iovec> iovecs;
+      addEntryToIovecs(*entry, iovecs);
+      const auto input = folly::IOBuf::wrapIov(iovecs.data(), iovecs.size());
+      auto output = codec->compress(input.get());
+      stats_.compressionInputBytes += entry->size();
+      if (output->computeChainDataLength() >
+          entry->size() * kMaxCompressedFraction) {
+        // Not worth the decompression on read.
+        ++stats_.entriesIncompressible;
+        stats_.compressionOutputBytes += entry->size();
+        continue;
+      }
+      output->coalesce();
+      ++stats_.entriesCompressed;
+      stats_.compressionOutputBytes += output->length();
+      compressed[i] = std::move(output);
+    }
+  }
+  stats_.compressionMicros += compressionMicros;
+  return compressed;
+}
+
 namespace {
 int32_t indexOfFirstMismatch(char* x, char* y, int n) {
   for (auto i = 0; i < n; ++i) {
@@ -444,8 +641,23 @@ int32_t indexOfFirstMismatch(char* x, char* y, int n) {
 
 void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   auto testData = std::make_unique<char[]>(entry.size());
-  const auto rc = ::pread(fd_, testData.get(), entry.size(), ssdRun.offset());
-  VELOX_CHECK_EQ(rc, entry.size());
+  if (ssdRun.isCompressed()) {
+    auto compressed = folly::IOBuf::create(ssdRun.compressedSize());
+    const auto rc = ::pread(
+        fd_,
+        compressed->writableData(),
+        ssdRun.compressedSize(),
+        ssdRun.offset());
+    VELOX_CHECK_EQ(rc, ssdRun.compressedSize());
+    compressed->append(rc);
+    auto uncompressed = common::compressionKindToCodec(compressionKind_)
+                            ->uncompress(compressed.get(), ssdRun.size());
+    folly::io::Cursor(uncompressed.get()).pull(testData.get(), entry.size());
+  } else {
+    const auto rc =
+        ::pread(fd_, testData.get(), entry.size(), ssdRun.offset());
+    VELOX_CHECK_EQ(rc, entry.size());
+  }
   if (entry.tinyData() != 0) {
     if (::memcmp(testData.get(), entry.tinyData(), entry.size()) != 0) {
       VELOX_FAIL("bad read back");
@@ -496,6 +708,13 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.writeCheckpointErrors += stats_.writeCheckpointErrors;
   stats.readSsdErrors += stats_.readSsdErrors;
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
+
+  stats.entriesCompressed += stats_.entriesCompressed;
+  stats.entriesIncompressible += stats_.entriesIncompressible;
+  stats.compressionInputBytes += stats_.compressionInputBytes;
+  stats.compressionOutputBytes += stats_.compressionOutputBytes;
+  stats.compressionMicros += stats_.compressionMicros;
+  stats.decompressionMicros += stats_.decompressionMicros;
 }
 
 void SsdFile::clear() {
@@ -610,14 +829,17 @@ void SsdFile::checkpoint(bool force) {
     state.open(checkpointPath, std::ios_base::out | std::ios_base::trunc);
     // The checkpoint state file contains:
     // int32_t The 4 bytes of kCheckpointMagic,
+    // int32_t compressionKind,
     // int32_t maxRegions,
     // int32_t numRegions,
     // regionScores from the 'tracker_',
     // {fileId, fileName} pairs,
     // kMapMarker,
-    // {fileId, offset, SSdRun} triples,
+    // {fileId, offset, SSdRun bits, SsdRun compressed size} quadruples,
     // kEndMarker.
     state.write(kCheckpointMagic, sizeof(int32_t));
+    const int32_t compressionKind = compressionKind_;
+    state.write(asChar(&compressionKind), sizeof(compressionKind));
     state.write(asChar(&maxRegions_), sizeof(maxRegions_));
     state.write(asChar(&numRegions_), sizeof(numRegions_));
 
@@ -644,6 +866,8 @@ void SsdFile::checkpoint(bool force) {
       state.write(asChar(&pair.first.offset), sizeof(pair.first.offset));
       auto offsetAndSize = pair.second.bits();
       state.write(asChar(&offsetAndSize), sizeof(offsetAndSize));
+      auto compressedSize = pair.second.compressedSize();
+      state.write(asChar(&compressedSize), sizeof(compressedSize));
     }
 
     // NOTE: we need to ensure cache file data sync update completes before
@@ -753,7 +977,16 @@ T readNumber(std::ifstream& stream) {
 void SsdFile::readCheckpoint(std::ifstream& state) {
   char magic[4];
   state.read(magic, sizeof(magic));
-  VELOX_CHECK_EQ(strncmp(magic, kCheckpointMagic, 4), 0);
+  // A checkpoint from before compression has only uncompressed entries.
+  const bool hasCompression = strncmp(magic, kCheckpointMagic, 4) == 0;
+  VELOX_CHECK(hasCompression || strncmp(magic, kCheckpointMagicV1, 4) == 0);
+  if (hasCompression) {
+    const auto compressionKind = readNumber<int32_t>(state);
+    VELOX_CHECK_EQ(
+        compressionKind,
+        static_cast<int32_t>(compressionKind_),
+        "Trying to start from checkpoint with a different compression");
+  }
   const auto maxRegions = readNumber<int32_t>(state);
   VELOX_CHECK_EQ(
       maxRegions,
@@ -789,7 +1022,11 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       break;
     }
     const uint64_t offset = readNumber<uint64_t>(state);
-    const auto run = SsdRun(readNumber<uint64_t>(state));
+    auto run = SsdRun(readNumber<uint64_t>(state));
+    if (hasCompression) {
+      const auto compressedSize = readNumber<uint32_t>(state);
+      run = SsdRun(run.offset(), run.size(), compressedSize);
+    }
     // Check that the recovered entry does not fall in an evicted region.
     if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
       // The file may have a different id on restore.
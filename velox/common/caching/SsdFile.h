@@ -18,28 +18,35 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/IoUring.h"
 
 #include <gflags/gflags.h>
 
 DECLARE_bool(ssd_odirect);
 DECLARE_bool(ssd_verify_write);
+DECLARE_bool(ssd_io_uring);
 
 namespace facebook::velox::cache {
 
 // A 64 bit word describing a SSD cache entry in an SsdFile. The low
 // 23 bits are the size, for a maximum entry size of 8MB. The high
-// bits are the offset.
+// bits are the offset. If the entry is stored compressed,
+// 'compressedSize_' is the number of bytes it takes in the file and
+// size() is the size after decompression.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
 
   SsdRun() : bits_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size)
-      : bits_((offset << kSizeBits) | ((size - 1))) {
+  SsdRun(uint64_t offset, uint32_t size, uint32_t compressedSize = 0)
+      : bits_((offset << kSizeBits) | ((size - 1))),
+        compressedSize_(compressedSize) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_LT(size - 1, 1 << kSizeBits);
+    VELOX_CHECK_LT(compressedSize, size);
   }
 
   SsdRun(uint64_t bits) : bits_(bits) {}
@@ -49,9 +56,11 @@ class SsdRun {
 
   void operator=(const SsdRun& other) {
     bits_ = other.bits_;
+    compressedSize_ = other.compressedSize_;
   }
   void operator=(SsdRun&& other) {
     bits_ = other.bits_;
+    compressedSize_ = other.compressedSize_;
   }
 
   uint64_t offset() const {
@@ -62,6 +71,20 @@ class SsdRun {
     return (bits_ & ((1 << kSizeBits) - 1)) + 1;
   }
 
+  bool isCompressed() const {
+    return compressedSize_ != 0;
+  }
+
+  // Returns the compressed size or 0 if the entry is stored as is.
+  uint32_t compressedSize() const {
+    return compressedSize_;
+  }
+
+  // Returns the number of bytes the entry takes in the file.
+  uint32_t storedSize() const {
+    return isCompressed() ? compressedSize_ : size();
+  }
+
   // Returns raw bits for serialization.
   uint64_t bits() const {
     return bits_;
@@ -69,6 +92,7 @@ class SsdRun {
 
  private:
   uint64_t bits_;
+  uint32_t compressedSize_{0};
 };
 
 // Represents an SsdFile entry that is planned for load or being
@@ -144,6 +168,20 @@ struct SsdCacheStats {
     writeCheckpointErrors = tsanAtomicValue(other.writeCheckpointErrors);
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
+    entriesCompressed = tsanAtomicValue(other.entriesCompressed);
+    entriesIncompressible = tsanAtomicValue(other.entriesIncompressible);
+    compressionInputBytes = tsanAtomicValue(other.compressionInputBytes);
+    compressionOutputBytes = tsanAtomicValue(other.compressionOutputBytes);
+    compressionMicros = tsanAtomicValue(other.compressionMicros);
+    decompressionMicros = tsanAtomicValue(other.decompressionMicros);
+  }
+
+  // Returns the size of the entries offered for compression divided by the
+  // size they take on SSD. 1 if there was no compression.
+  double compressionRatio() const {
+    return compressionOutputBytes == 0
+        ? 1
+        : static_cast<double>(compressionInputBytes) / compressionOutputBytes;
   }
 
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -163,6 +201,18 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> writeCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
+
+  // Number of entries written compressed.
+  tsan_atomic<uint64_t> entriesCompressed{0};
+  // Number of entries that did not compress well enough and were written as
+  // is.
+  tsan_atomic<uint64_t> entriesIncompressible{0};
+  // Size of the entries offered for compression.
+  tsan_atomic<uint64_t> compressionInputBytes{0};
+  // Bytes written to SSD for the entries in 'compressionInputBytes'.
+  tsan_atomic<uint64_t> compressionOutputBytes{0};
+  tsan_atomic<uint64_t> compressionMicros{0};
+  tsan_atomic<uint64_t> decompressionMicros{0};
 };
 
 // A shard of SsdCache. Corresponds to one file on SSD.  The data
@@ -178,14 +228,16 @@ class SsdFile {
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
 
   // Constructs a cache backed by filename. Discards any previous
-  // contents of filename.
+  // contents of filename. If 'compressionKind' is not NONE, entries are
+  // compressed with it when written unless they do not compress well.
   SsdFile(
       const std::string& filename,
       int32_t shardId,
       int32_t maxRegions,
       int64_t checkpointInternalBytes = 0,
       bool disableFileCow = false,
-      folly::Executor* executor = nullptr);
+      folly::Executor* executor = nullptr,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE);
 
   // Adds entries of  'pins'  to this file. 'pins' must be in read mode and
   // those pins that are successfully added to SSD are marked as being on SSD.
@@ -204,6 +256,14 @@ class SsdFile {
       const std::vector<SsdPin>& ssdPins,
       const std::vector<CachePin>& pins);
 
+  // Asynchronous version of load(). The returned future is realized when the
+  // data is in 'pins'. 'ssdPins' and 'pins' must stay live until then. If
+  // io_uring is not used, the reads are made on the calling thread before
+  // returning. Decompression runs where the future is consumed.
+  folly::SemiFuture<CoalesceIoStats> loadAsync(
+      const std::vector<SsdPin>& ssdPins,
+      const std::vector<CachePin>& pins);
+
   // Increments the pin count of the region of 'offset'.
   void pinRegion(uint64_t offset);
 
@@ -257,7 +317,12 @@ class SsdFile {
  private:
   // 4 first bytes of a checkpoint file. Allows distinguishing between format
   // versions.
-  static constexpr const char* kCheckpointMagic = "CPT1";
+  static constexpr const char* kCheckpointMagic = "CPT2";
+  // Magic of the checkpoint format before entries could be compressed.
+  static constexpr const char* kCheckpointMagicV1 = "CPT1";
+  // A compressed entry is stored as is unless the compressed size is at most
+  // this fraction of the size.
+  static constexpr double kMaxCompressedFraction = 0.9;
   // Magic number separating file names from cache entry data in checkpoint
   // file.
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
@@ -271,13 +336,20 @@ class SsdFile {
   }
 
   // Returns [offset, size] of contiguous space for storing data of a number of
-  // contiguous 'pins' starting with the pin at index 'begin'.  Returns nullopt
-  // if there is no space. The space does not necessarily cover all the pins, so
-  // multiple calls starting at the first unwritten pin may be needed.
+  // contiguous entries of 'sizes' starting with the entry at index 'begin'.
+  // Returns nullopt if there is no space. The space does not necessarily cover
+  // all the entries, so multiple calls starting at the first unwritten entry
+  // may be needed.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
-      const std::vector<CachePin>& pins,
+      const std::vector<int32_t>& sizes,
       int32_t begin);
 
+  // Returns the compressed data for each of 'pins' or nullptr for entries that
+  // are to be stored as is. All entries are stored as is if
+  // 'compressionKind_' is NONE.
+  std::vector<std::unique_ptr<folly::IOBuf>> compressEntries(
+      const std::vector<CachePin>& pins);
+
   // Removes all 'entries_' that reference data in regions described by
   // 'regionIndices'.
   void clearRegionEntriesLocked(const std::vector<int32_t>& regions);
@@ -286,8 +358,19 @@ class SsdFile {
   // added to 'writableRegions_'. Returns true if regions could be cleared.
   bool growOrEvictLocked();
 
-  // Reads the backing file with ReadFile::preadv().
-  void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
+  // Loads 'pins' from 'ssdPins' when some of these are compressed. Coalesces
+  // IO like readPins(). The entries are decompressed when the reads complete.
+  folly::SemiFuture<CoalesceIoStats> loadCompressed(
+      const std::vector<SsdPin>& ssdPins,
+      const std::vector<CachePin>& pins,
+      int32_t maxGap,
+      int32_t rangesPerIo);
+
+  // Reads the coalesced IOs of a load from the backing file. If 'ioUring_' is
+  // set, submits all of 'requests' in one batch and returns a future that is
+  // realized when all of them are complete. Otherwise reads these one after
+  // the other with ReadFile::preadv() and returns a ready future.
+  folly::SemiFuture<folly::Unit> read(std::vector<IoUring::Request> requests);
 
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
@@ -325,6 +408,9 @@ class SsdFile {
   // Maximum size of the backing file in kRegionSize units.
   const int32_t maxRegions_;
 
+  // Codec for compressing written entries.
+  const common::CompressionKind compressionKind_;
+
   // Serializes access to all private data members.
   mutable std::shared_mutex mutex_;
 
@@ -365,6 +451,11 @@ class SsdFile {
   // ReadFile made from 'fd_'.
   std::unique_ptr<ReadFile> readFile_;
 
+  // Process wide ring for submitting the reads of a load from 'fd_' in one
+  // batch. Writes are single pwritev() calls, for which the ring would only
+  // add a thread hop. nullptr if io_uring is not available or disabled.
+  IoUring* ioUring_{nullptr};
+
   // Counters.
   SsdCacheStats stats_;
 
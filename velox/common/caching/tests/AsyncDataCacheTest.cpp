@@ -80,7 +80,10 @@ class AsyncDataCacheTest : public testing::Test {
     }
   }
 
-  void initializeCache(uint64_t maxBytes, int64_t ssdBytes = 0) {
+  void initializeCache(
+      uint64_t maxBytes,
+      int64_t ssdBytes = 0,
+      CachePolicyKind policyKind = CachePolicyKind::kDefault) {
     std::unique_ptr<SsdCache> ssdCache;
     if (ssdBytes > 0) {
       // tmpfs does not support O_DIRECT, so turn this off for testing.
@@ -108,7 +111,8 @@ class AsyncDataCacheTest : public testing::Test {
     memory::MmapAllocator::Options options;
     options.capacity = maxBytes;
     allocator_ = std::make_shared<memory::MmapAllocator>(options);
-    cache_ = AsyncDataCache::create(allocator_.get(), std::move(ssdCache));
+    cache_ = AsyncDataCache::create(
+        allocator_.get(), std::move(ssdCache), policyKind);
     if (filenames_.empty()) {
       for (auto i = 0; i < kNumFiles; ++i) {
         auto name = fmt::format("testing_file_{}", i);
@@ -325,6 +329,28 @@ class TestingCoalescedSsdLoad : public TestingCoalescedLoad {
   std::vector<SsdPin> ssdPins_;
 };
 
+// A load whose IO completes when complete() is called.
+class TestingAsyncCoalescedLoad : public TestingCoalescedLoad {
+ public:
+  using TestingCoalescedLoad::TestingCoalescedLoad;
+
+  void complete() {
+    ioPromise_.setValue();
+  }
+
+ protected:
+  folly::SemiFuture<std::vector<CachePin>> loadDataAsync(
+      bool isPrefetch) override {
+    pins_ = loadData(isPrefetch);
+    return ioPromise_.getSemiFuture().deferValue(
+        [this](folly::Unit) { return std::move(pins_); });
+  }
+
+ private:
+  folly::Promise<folly::Unit> ioPromise_;
+  std::vector<CachePin> pins_;
+};
+
 namespace {
 int64_t sizeAtOffset(int64_t offset) {
   return offset % 100'000;
@@ -578,6 +604,114 @@ TEST_F(AsyncDataCacheTest, pin) {
   EXPECT_EQ(0, cache_->incrementPrefetchPages(0));
 }
 
+TEST_F(AsyncDataCacheTest, asyncCoalescedLoad) {
+  constexpr int32_t kSize = 25000;
+  initializeCache(1 << 20);
+  StringIdLease file(fileIds(), std::string_view("testingfile"));
+  std::vector<RawFileCacheKey> keys{{file.id(), 0}, {file.id(), kSize}};
+  auto load = std::make_shared<TestingAsyncCoalescedLoad>(
+      keys, std::vector<int32_t>{kSize, kSize}, cache_, false);
+
+  // The load returns while its IO is in flight.
+  folly::SemiFuture<bool> wait(false);
+  EXPECT_FALSE(load->loadOrFuture(&wait));
+  EXPECT_EQ(CoalescedLoad::State::kLoading, load->state());
+  EXPECT_FALSE(wait.isReady());
+  folly::SemiFuture<bool> otherWait(false);
+  EXPECT_FALSE(load->loadOrFuture(&otherWait));
+  EXPECT_FALSE(otherWait.isReady());
+
+  // The load is finished on the thread that completes the IO.
+  load->complete();
+  EXPECT_TRUE(wait.isReady());
+  EXPECT_TRUE(otherWait.isReady());
+  EXPECT_EQ(CoalescedLoad::State::kLoaded, load->state());
+  EXPECT_TRUE(load->loadOrFuture(nullptr));
+  for (const auto& key : keys) {
+    auto pin = cache_->findOrCreate(key, kSize, nullptr);
+    ASSERT_FALSE(pin.empty());
+    EXPECT_TRUE(pin.checkedEntry()->isShared());
+    checkContents(*pin.checkedEntry());
+  }
+}
+
+TEST_F(AsyncDataCacheTest, decompressedPage) {
+  constexpr int64_t kSize = 10000;
+  initializeCache(1 << 20);
+  StringIdLease file(fileIds(), std::string_view("testingfile"));
+  constexpr uint64_t kOffset = 1000;
+  auto pageKey = decompressedPageKey(file.id(), kOffset);
+  EXPECT_TRUE(isDecompressedPage(pageKey.offset));
+  EXPECT_FALSE(isDecompressedPage(kOffset));
+  EXPECT_TRUE(cache_->find(pageKey).empty());
+
+  auto pin = cache_->findOrCreate(pageKey, kSize, nullptr);
+  ASSERT_FALSE(pin.empty());
+  EXPECT_TRUE(pin.checkedEntry()->isExclusive());
+  // An entry being filled is not returned by find().
+  EXPECT_TRUE(cache_->find(pageKey).empty());
+  initializeContents(
+      pageKey.fileNum + pageKey.offset, pin.checkedEntry()->data());
+  pin.checkedEntry()->setExclusiveToShared();
+  pin.clear();
+
+  // The decompressed page does not alias the raw data at the same offset.
+  RawFileCacheKey rawKey{file.id(), kOffset};
+  EXPECT_TRUE(cache_->find(rawKey).empty());
+
+  pin = cache_->find(pageKey);
+  ASSERT_FALSE(pin.empty());
+  EXPECT_TRUE(pin.checkedEntry()->isShared());
+  EXPECT_EQ(kSize, pin.checkedEntry()->size());
+  checkContents(*pin.checkedEntry());
+  pin.clear();
+  EXPECT_EQ(1, cache_->refreshStats().numHit);
+}
+
+TEST_F(AsyncDataCacheTest, tinyLfuPolicy) {
+  constexpr int64_t kMaxBytes = 16 << 20;
+  constexpr int64_t kSize = 128 << 10;
+  constexpr int32_t kNumHot = 8;
+  initializeCache(kMaxBytes, 0, CachePolicyKind::kTinyLfu);
+  StringIdLease hotFile(fileIds(), std::string_view("hotfile"));
+  StringIdLease scanFile(fileIds(), std::string_view("scanfile"));
+  auto load = [&](uint64_t fileNum, uint64_t offset) {
+    RawFileCacheKey key{fileNum, offset};
+    auto pin = cache_->findOrCreate(key, kSize, nullptr);
+    ASSERT_FALSE(pin.empty());
+    if (pin.checkedEntry()->isExclusive()) {
+      initializeContents(fileNum + offset, pin.checkedEntry()->data());
+      pin.checkedEntry()->setExclusiveToShared();
+    }
+  };
+
+  // The working set is read twice, which moves it to the protected segment.
+  for (auto round = 0; round < 2; ++round) {
+    for (auto i = 0; i < kNumHot; ++i) {
+      load(hotFile.id(), i * kSize);
+    }
+  }
+  auto stats = cache_->refreshStats();
+  EXPECT_EQ(CachePolicyKind::kTinyLfu, stats.policy);
+  EXPECT_EQ(kNumHot, stats.numProtected);
+  EXPECT_EQ(kNumHot, stats.numHit);
+  EXPECT_DOUBLE_EQ(0.5, stats.hitRate());
+
+  // A scan reads 4x the cache capacity once. The working set stays.
+  for (auto i = 0; i < 4 * kMaxBytes / kSize; ++i) {
+    load(scanFile.id(), i * kSize);
+  }
+  for (auto i = 0; i < kNumHot; ++i) {
+    EXPECT_TRUE(cache_->exists(RawFileCacheKey{hotFile.id(), i * kSize}));
+  }
+  stats = cache_->refreshStats();
+  EXPECT_LT(0, stats.numEvict);
+  // The sketch may count a few scanned entries as protected due to
+  // collisions.
+  EXPECT_LE(kNumHot, stats.numProtected);
+  EXPECT_NE(std::string::npos, stats.toString().find("TINY_LFU"));
+}
+
 TEST_F(AsyncDataCacheTest, replace) {
   constexpr int64_t kMaxBytes = 64 << 20;
   FLAGS_velox_exception_user_stacktrace_enabled = false;
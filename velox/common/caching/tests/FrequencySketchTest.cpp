@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+TEST(FrequencySketchTest, estimate) {
+  FrequencySketch sketch(1000);
+  EXPECT_EQ(1024, sketch.capacity());
+  EXPECT_EQ(0, sketch.estimate(1));
+
+  // The first access goes to the doorkeeper, further ones to the counters.
+  sketch.recordAccess(1);
+  EXPECT_EQ(1, sketch.estimate(1));
+  sketch.recordAccess(1);
+  EXPECT_EQ(2, sketch.estimate(1));
+  for (auto i = 0; i < 100; ++i) {
+    sketch.recordAccess(1);
+  }
+  EXPECT_EQ(FrequencySketch::kMaxFrequency, sketch.estimate(1));
+
+  // Keys seen once do not inflate the count of others.
+  for (uint64_t key = 100; key < 200; ++key) {
+    sketch.recordAccess(key);
+  }
+  for (uint64_t key = 100; key < 200; ++key) {
+    EXPECT_EQ(1, sketch.estimate(key));
+  }
+
+  sketch.resize(5000);
+  EXPECT_EQ(8192, sketch.capacity());
+  EXPECT_EQ(0, sketch.estimate(1));
+}
+
+TEST(FrequencySketchTest, grow) {
+  FrequencySketch sketch(64);
+  for (uint64_t key = 0; key < 32; ++key) {
+    for (auto i = 0; i <= key % 5; ++i) {
+      sketch.recordAccess(key);
+    }
+  }
+  std::vector<int32_t> estimates;
+  for (uint64_t key = 0; key < 32; ++key) {
+    estimates.push_back(sketch.estimate(key));
+  }
+
+  // Growing keeps the estimates of the keys seen so far.
+  sketch.grow(1000);
+  EXPECT_EQ(1024, sketch.capacity());
+  for (uint64_t key = 0; key < 32; ++key) {
+    EXPECT_EQ(estimates[key], sketch.estimate(key)) << key;
+  }
+  sketch.recordAccess(0);
+  EXPECT_EQ(estimates[0] + 1, sketch.estimate(0));
+
+  // Growing to a smaller capacity does nothing.
+  sketch.grow(100);
+  EXPECT_EQ(1024, sketch.capacity());
+}
+
+TEST(FrequencySketchTest, aging) {
+  FrequencySketch sketch(64);
+  for (auto i = 0; i < 9; ++i) {
+    sketch.recordAccess(1);
+  }
+  EXPECT_EQ(9, sketch.estimate(1));
+  // Access distinct keys until the counts are halved.
+  uint64_t key = 1000;
+  while (sketch.numAgings() == 0) {
+    sketch.recordAccess(key++);
+  }
+  // 8 counted accesses are halved and the doorkeeper is cleared.
+  EXPECT_EQ(4, sketch.estimate(1));
+}
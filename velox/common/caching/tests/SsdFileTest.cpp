@@ -22,6 +22,10 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <iterator>
+#include <random>
+
 using namespace facebook::velox;
 using namespace facebook::velox::cache;
 
@@ -53,7 +57,9 @@ class SsdFileTest : public testing::Test {
   void initializeCache(
       int64_t maxBytes,
       int64_t ssdBytes = 0,
-      bool setNoCowFlag = false) {
+      bool setNoCowFlag = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE,
+      int64_t checkpointIntervalBytes = 0) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = AsyncDataCache::create(MemoryAllocator::getInstance());
@@ -61,12 +67,84 @@ class SsdFileTest : public testing::Test {
     fileName_ = StringIdLease(fileIds(), "fileInStorage");
 
     tempDirectory_ = exec::test::TempDirectoryPath::create();
+    openSsdFile(
+        ssdBytes, setNoCowFlag, compressionKind, checkpointIntervalBytes);
+  }
+
+  std::string ssdFilePath() const {
+    return fmt::format("{}/ssdtest", tempDirectory_->path);
+  }
+
+  void openSsdFile(
+      int64_t ssdBytes,
+      bool setNoCowFlag,
+      common::CompressionKind compressionKind,
+      int64_t checkpointIntervalBytes) {
     ssdFile_ = std::make_unique<SsdFile>(
-        fmt::format("{}/ssdtest", tempDirectory_->path),
+        ssdFilePath(),
         0, // shardId
         bits::roundUp(ssdBytes, SsdFile::kRegionSize) / SsdFile::kRegionSize,
-        0, // checkpointInternalBytes
-        setNoCowFlag);
+        checkpointIntervalBytes,
+        setNoCowFlag,
+        nullptr, // executor
+        compressionKind);
+  }
+
+  // Replaces 'ssdFile_' with a new SsdFile on the same file, as after a
+  // restart. The memory cache is emptied so that entries come from the new
+  // file. All pins of the test must be released.
+  void reopenSsdFile(
+      int64_t ssdBytes,
+      common::CompressionKind compressionKind,
+      int64_t checkpointIntervalBytes) {
+    cache_->clear();
+    ssdFile_.reset();
+    openSsdFile(ssdBytes, false, compressionKind, checkpointIntervalBytes);
+  }
+
+  // Rewrites the checkpoint of 'ssdFile_' in the format from before entries
+  // could be compressed, i.e. without the compression kind and without the
+  // compressed size of each entry.
+  void rewriteCheckpointAsV1() {
+    // Same as the markers in SsdFile.h.
+    constexpr uint64_t kMapMarker = 0xfffffffffffffffe;
+    constexpr uint64_t kEndMarker = 0xcbedf11e;
+    const auto path = ssdFilePath() + ".cpt";
+    std::string checkpoint;
+    {
+      std::ifstream in(path, std::ios::binary);
+      checkpoint.assign(
+          std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    ASSERT_EQ("CPT2", checkpoint.substr(0, 4));
+    std::string v1 = "CPT1";
+    // Skips the magic and the compression kind.
+    size_t pos = 2 * sizeof(int32_t);
+    const auto copy = [&](size_t numBytes) {
+      v1.append(checkpoint, pos, numBytes);
+      pos += numBytes;
+    };
+    const auto peek = [&](auto value) {
+      memcpy(&value, checkpoint.data() + pos, sizeof(value));
+      return value;
+    };
+    const auto maxRegions = peek(int32_t{0});
+    // maxRegions, numRegions and the region scores.
+    copy(2 * sizeof(int32_t) + maxRegions * sizeof(uint64_t));
+    while (peek(uint64_t{0}) != kMapMarker) {
+      copy(sizeof(uint64_t));
+      copy(sizeof(int32_t) + peek(int32_t{0}));
+    }
+    copy(sizeof(uint64_t));
+    while (peek(uint64_t{0}) != kEndMarker) {
+      // File id, offset and SsdRun bits. The compressed size is dropped.
+      copy(3 * sizeof(uint64_t));
+      pos += sizeof(uint32_t);
+    }
+    copy(sizeof(uint64_t));
+    ASSERT_EQ(checkpoint.size(), pos);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(v1.data(), v1.size());
   }
 
   static void initializeContents(int64_t sequence, memory::Allocation& alloc) {
@@ -113,6 +191,52 @@ class SsdFileTest : public testing::Test {
     }
   }
 
+  // Fills 'alloc' with random data seeded by 'seed'. The data does not
+  // compress.
+  static void initializeRandomContents(
+      uint64_t seed,
+      memory::Allocation& alloc) {
+    std::mt19937_64 rng(seed);
+    for (auto i = 0; i < alloc.numRuns(); ++i) {
+      auto run = alloc.runAt(i);
+      auto* words = run.data<uint64_t>();
+      for (auto j = 0; j < run.numBytes() / sizeof(uint64_t); ++j) {
+        words[j] = rng();
+      }
+    }
+  }
+
+  // Checks that the first 'numBytes' of 'alloc' are as set by
+  // initializeRandomContents() with 'seed'.
+  static void checkRandomContents(
+      uint64_t seed,
+      const memory::Allocation& alloc,
+      int32_t numBytes) {
+    std::mt19937_64 rng(seed);
+    int32_t bytesChecked = 0;
+    for (auto i = 0; i < alloc.numRuns(); ++i) {
+      auto run = alloc.runAt(i);
+      const auto* words = run.data<uint64_t>();
+      for (auto j = 0; j < run.numBytes() / sizeof(uint64_t); ++j) {
+        if (bytesChecked + sizeof(uint64_t) > numBytes) {
+          return;
+        }
+        ASSERT_EQ(rng(), words[j]);
+        bytesChecked += sizeof(uint64_t);
+      }
+    }
+  }
+
+  // Gives every 'every'th entry of 'pins' random contents seeded by the
+  // entry's offset. These entries are stored uncompressed on a file with
+  // compression.
+  static void makeIncompressible(std::vector<CachePin>& pins, int32_t every) {
+    for (auto i = 0; i < pins.size(); i += every) {
+      auto* entry = pins[i].checkedEntry();
+      initializeRandomContents(entry->key().offset, entry->data());
+    }
+  }
+
   // Gets consecutive entries from file 'fileId' starting at 'startOffset'  with
   // sizes between 'minSize' and 'maxSize'. Sizes start at 'minSize' and double
   // each time and go back to 'minSize' after exceeding 'maxSize'. This stops
@@ -176,6 +300,28 @@ class SsdFileTest : public testing::Test {
     }
   }
 
+  // Loads 'pins' in one call and checks the contents. Every 'every'th entry
+  // is expected to be as set by makeIncompressible().
+  void readAndCheckMixedPins(const std::vector<CachePin>& pins, int32_t every) {
+    std::vector<SsdPin> ssdPins;
+    ssdPins.reserve(pins.size());
+    for (auto& pin : pins) {
+      ASSERT_TRUE(pin.entry()->isExclusive());
+      ssdPins.push_back(ssdFile_->find(
+          RawFileCacheKey{fileName_.id(), pin.entry()->key().offset}));
+      ASSERT_FALSE(ssdPins.back().empty());
+    }
+    ssdFile_->load(ssdPins, pins);
+    for (auto i = 0; i < pins.size(); ++i) {
+      auto* entry = pins[i].entry();
+      if (i % every == 0) {
+        checkRandomContents(entry->key().offset, entry->data(), entry->size());
+      } else {
+        checkContents(entry->data(), entry->size());
+      }
+    }
+  }
+
   void checkEvictionBlocked(
       std::vector<TestEntry>& allEntries,
       uint64_t ssdSize) {
@@ -299,6 +445,131 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, compression) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(128 * kMB, kSsdSize, false, common::CompressionKind_ZSTD);
+  FLAGS_ssd_verify_write = true;
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  // The first entry gets random data that does not compress.
+  initializeRandomContents(1, pins[0].entry()->data());
+  ssdFile_->write(pins);
+  for (auto& pin : pins) {
+    EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+  }
+
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(1, stats.entriesIncompressible);
+  EXPECT_EQ(pins.size() - 1, stats.entriesCompressed);
+  EXPECT_LT(stats.compressionOutputBytes, stats.compressionInputBytes);
+  EXPECT_LT(1, stats.compressionRatio());
+  // The entries take less space on SSD than in memory.
+  EXPECT_LT(stats.bytesWritten, stats.compressionInputBytes);
+
+  // Read back the compressible entries and check contents. The incompressible
+  // one was checked by 'ssd_verify_write'.
+  const auto numPins = pins.size();
+  pins.clear();
+  pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  ASSERT_EQ(numPins, pins.size());
+  pins.erase(pins.begin());
+  readAndCheckPins(pins);
+  stats = SsdCacheStats();
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(pins.size(), stats.entriesRead);
+}
+
+TEST_F(SsdFileTest, mixedCompressedLoad) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(128 * kMB, kSsdSize, false, common::CompressionKind_ZSTD);
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  makeIncompressible(pins, 2);
+  ssdFile_->write(pins);
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  const auto numPins = pins.size();
+  EXPECT_EQ((numPins + 1) / 2, stats.entriesIncompressible);
+  EXPECT_EQ(numPins / 2, stats.entriesCompressed);
+
+  // Compressed and uncompressed entries alternate and are read back in one
+  // coalesced load.
+  pins.clear();
+  cache_->clear();
+  pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  ASSERT_EQ(numPins, pins.size());
+  readAndCheckMixedPins(pins, 2);
+  stats = SsdCacheStats();
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(numPins, stats.entriesRead);
+}
+
+TEST_F(SsdFileTest, compressedCheckpoint) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(
+      128 * kMB, kSsdSize, false, common::CompressionKind_ZSTD, kSsdSize);
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  makeIncompressible(pins, 3);
+  ssdFile_->write(pins);
+  ssdFile_->checkpoint(true);
+  const auto numPins = pins.size();
+  pins.clear();
+
+  // A restarted file recovers the compressed sizes from the checkpoint and
+  // reads back both the compressed and the uncompressed entries.
+  reopenSsdFile(kSsdSize, common::CompressionKind_ZSTD, kSsdSize);
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(0, stats.readCheckpointErrors);
+  EXPECT_EQ(numPins, stats.entriesCached);
+  pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  ASSERT_EQ(numPins, pins.size());
+  readAndCheckMixedPins(pins, 3);
+}
+
+TEST_F(SsdFileTest, checkpointV1) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(
+      128 * kMB, kSsdSize, false, common::CompressionKind_NONE, kSsdSize);
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  ssdFile_->write(pins);
+  ssdFile_->checkpoint(true);
+  const auto numPins = pins.size();
+  pins.clear();
+
+  // A checkpoint written before compression is recovered by a file without
+  // compression.
+  rewriteCheckpointAsV1();
+  reopenSsdFile(kSsdSize, common::CompressionKind_NONE, kSsdSize);
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(0, stats.readCheckpointErrors);
+  EXPECT_EQ(numPins, stats.entriesCached);
+  pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  ASSERT_EQ(numPins, pins.size());
+  readAndCheckPins(pins);
+}
+
+TEST_F(SsdFileTest, checkpointCompressionMismatch) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(
+      128 * kMB, kSsdSize, false, common::CompressionKind_ZSTD, kSsdSize);
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  ssdFile_->write(pins);
+  ssdFile_->checkpoint(true);
+  const auto firstOffset = pins[0].entry()->key().offset;
+  pins.clear();
+
+  // A file with a different compression discards the checkpoint and starts
+  // empty.
+  reopenSsdFile(kSsdSize, common::CompressionKind_NONE, kSsdSize);
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(1, stats.readCheckpointErrors);
+  EXPECT_EQ(0, stats.entriesCached);
+  EXPECT_TRUE(
+      ssdFile_->find(RawFileCacheKey{fileName_.id(), firstOffset}).empty());
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
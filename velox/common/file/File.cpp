@@ -16,14 +16,24 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fmt/format.h>
+#include <folly/futures/Future.h>
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
 
 #include <fcntl.h>
 #include <folly/portability/SysUio.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+DEFINE_bool(
+    local_file_io_uring,
+    true,
+    "Read local files asynchronously with io_uring if available");
 
 namespace facebook::velox {
 
@@ -112,9 +122,16 @@ LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
       path,
       folly::errnoStr(errno));
   size_ = rc;
+  if (FLAGS_local_file_io_uring) {
+    ioUring_ = IoUring::getInstance();
+  }
 }
 
-LocalReadFile::LocalReadFile(int32_t fd) : fd_(fd) {}
+LocalReadFile::LocalReadFile(int32_t fd) : fd_(fd) {
+  if (FLAGS_local_file_io_uring) {
+    ioUring_ = IoUring::getInstance();
+  }
+}
 
 LocalReadFile::~LocalReadFile() {
   const int ret = close(fd_);
@@ -198,6 +215,51 @@ uint64_t LocalReadFile::preadv(
   return totalBytesRead;
 }
 
+void LocalReadFile::preadv(
+    folly::Range<const common::Region*> regions,
+    folly::Range<folly::IOBuf*> iobufs) const {
+  if (ioUring_ == nullptr) {
+    ReadFile::preadv(regions, iobufs);
+    return;
+  }
+  VELOX_CHECK_EQ(regions.size(), iobufs.size());
+  std::vector<IoUring::Request> requests;
+  requests.reserve(regions.size());
+  for (size_t i = 0; i < regions.size(); ++i) {
+    const auto& region = regions[i];
+    auto& output = iobufs[i];
+    output = folly::IOBuf(folly::IOBuf::CREATE, region.length);
+    output.append(region.length);
+    bytesRead_ += region.length;
+    requests.push_back(
+        {fd_,
+         region.offset,
+         false,
+         {folly::Range<char*>(
+             reinterpret_cast<char*>(output.writableData()),
+             region.length)}});
+  }
+  // All reads are waited for before throwing since they write into 'iobufs'.
+  auto results = folly::collectAll(ioUring_->submit(std::move(requests))).get();
+  for (auto& result : results) {
+    result.value();
+  }
+}
+
+folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (ioUring_ == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      bytesRead_ += range.size();
+    }
+  }
+  return ioUring_->preadv(fd_, offset, buffers);
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
@@ -210,6 +272,94 @@ uint64_t LocalReadFile::memoryUsage() const {
   return sizeof(FILE);
 }
 
+MmapReadFile::MmapReadFile(std::string_view path) : path_(path) {
+  fd_ = open(path_.c_str(), O_RDONLY);
+  VELOX_CHECK_GE(
+      fd_,
+      0,
+      "open failure in MmapReadFile constructor, {} {} {}.",
+      fd_,
+      path,
+      folly::errnoStr(errno));
+  const off_t rc = lseek(fd_, 0, SEEK_END);
+  VELOX_CHECK_GE(
+      rc,
+      0,
+      "fseek failure in MmapReadFile constructor, {} {} {}.",
+      rc,
+      path,
+      folly::errnoStr(errno));
+  size_ = rc;
+  if (size_ == 0) {
+    return;
+  }
+  void* data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+  if (data == MAP_FAILED) {
+    const auto error = errno;
+    close(fd_);
+    VELOX_FAIL(
+        "mmap failure in MmapReadFile constructor, {} {}.",
+        path,
+        folly::errnoStr(error));
+  }
+  data_ = static_cast<char*>(data);
+}
+
+MmapReadFile::~MmapReadFile() {
+  if (data_ != nullptr && munmap(data_, size_) < 0) {
+    LOG(WARNING) << "munmap failure in MmapReadFile destructor: "
+                 << folly::errnoStr(errno);
+  }
+  if (close(fd_) < 0) {
+    LOG(WARNING) << "close failure in MmapReadFile destructor: "
+                 << folly::errnoStr(errno);
+  }
+}
+
+std::string_view
+MmapReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
+  VELOX_CHECK_LE(
+      offset + length,
+      size_,
+      "Read past the end of {}: {} bytes at {}",
+      path_,
+      length,
+      offset);
+  bytesRead_ += length;
+  if (length > 0) {
+    memcpy(buf, data_ + offset, length);
+  }
+  return {static_cast<char*>(buf), length};
+}
+
+uint64_t MmapReadFile::memoryUsage() const {
+  // The mapped pages belong to the page cache.
+  return sizeof(*this);
+}
+
+void MmapReadFile::willNeed(uint64_t offset, uint64_t length) const {
+  advise(offset, length, MADV_WILLNEED);
+}
+
+void MmapReadFile::adviseSequential() const {
+  advise(0, size_, MADV_SEQUENTIAL);
+}
+
+void MmapReadFile::advise(uint64_t offset, uint64_t length, int32_t advice)
+    const {
+  if (data_ == nullptr || length == 0 || offset >= size_) {
+    return;
+  }
+  // madvise() takes a page aligned address.
+  static const uint64_t kPageSize = sysconf(_SC_PAGESIZE);
+  const auto begin = offset - offset % kPageSize;
+  const auto end = std::min(offset + length, size_);
+  if (madvise(data_ + begin, end - begin, advice) < 0) {
+    VLOG(1) << "madvise failure on " << path_ << ": "
+            << folly::errnoStr(errno);
+  }
+}
+
 LocalWriteFile::LocalWriteFile(
     std::string_view path,
     bool shouldCreateParentDirectories,
@@ -41,6 +41,8 @@
 
 namespace facebook::velox {
 
+class IoUring;
+
 // A read-only file.  All methods in this object should be thread safe.
 class ReadFile {
  public:
@@ -222,6 +224,11 @@ class InMemoryWriteFile final : public WriteFile {
 // Current implementation for the local version is quite simple (e.g. no
 // internal arenaing), as local disk writes are expected to be cheap. Local
 // files match against any filepath starting with '/'.
+//
+// If io_uring is available and --local_file_io_uring is set, LocalReadFile
+// reads asynchronously through the process-wide IoUring. preadvAsync() then
+// returns without blocking and the vectorized preadv() submits all regions
+// with a single system call.
 
 class LocalReadFile final : public ReadFile {
  public:
@@ -240,6 +247,20 @@ class LocalReadFile final : public ReadFile {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const final;
 
+  void preadv(
+      folly::Range<const common::Region*> regions,
+      folly::Range<folly::IOBuf*> iobufs) const final;
+
+  // The memory referenced by 'buffers' and 'this' must stay live until the
+  // returned future is realized.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return ioUring_ != nullptr;
+  }
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
@@ -264,6 +285,61 @@ class LocalReadFile final : public ReadFile {
   std::string path_;
   int32_t fd_;
   long size_;
+  // Ring for asynchronous reads. nullptr if reads are synchronous.
+  IoUring* ioUring_{nullptr};
+};
+
+// A local file mapped read only into memory. pread() copies from the
+// mapping. BufferedInput implementations can instead read the mapped page
+// cache directly through data(). The mapping is MAP_SHARED, so the file must
+// not be truncated while it is mapped: touching a mapped page past the new
+// end of file raises SIGBUS and kills the process instead of failing the
+// read.
+class MmapReadFile final : public ReadFile {
+ public:
+  explicit MmapReadFile(std::string_view path);
+
+  ~MmapReadFile();
+
+  std::string_view
+  pread(uint64_t offset, uint64_t length, void* FOLLY_NONNULL buf) const final;
+
+  uint64_t size() const final {
+    return size_;
+  }
+
+  uint64_t memoryUsage() const final;
+
+  bool shouldCoalesce() const final {
+    return false;
+  }
+
+  std::string getName() const override {
+    return path_;
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return 10 << 20;
+  }
+
+  // Returns the mapped file. nullptr if the file is empty.
+  const char* FOLLY_NULLABLE data() const {
+    return data_;
+  }
+
+  // Advises the kernel that [offset, offset + length) will be read soon.
+  void willNeed(uint64_t offset, uint64_t length) const;
+
+  // Advises the kernel that the file will be read from start to end.
+  void adviseSequential() const;
+
+ private:
+  void advise(uint64_t offset, uint64_t length, int32_t advice) const;
+
+  const std::string path_;
+  int32_t fd_;
+  uint64_t size_;
+  char* FOLLY_NULLABLE data_{nullptr};
 };
 
 class LocalWriteFile final : public WriteFile {
@@ -86,7 +86,11 @@ class LocalFileSystem : public FileSystem {
 
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
-      const FileOptions& /*unused*/) override {
+      const FileOptions& options) override {
+    auto it = options.values.find(FileOptions::kLocalMmap);
+    if (it != options.values.end() && it->second == "true") {
+      return std::make_unique<MmapReadFile>(extractPath(path));
+    }
     return std::make_unique<LocalReadFile>(extractPath(path));
   }
 
@@ -35,6 +35,9 @@ namespace facebook::velox::filesystems {
 /// MemoryPool to allocate buffers needed to read/write files on FileSystems
 /// such as S3.
 struct FileOptions {
+  /// If "true", local files are opened as MmapReadFile.
+  static constexpr const char* kLocalMmap = "local.mmap";
+
   std::unordered_map<std::string, std::string> values;
   memory::MemoryPool* pool{nullptr};
 };
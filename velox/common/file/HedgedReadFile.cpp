@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/HedgedReadFile.h"
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include <chrono>
+#include <cmath>
+
+namespace facebook::velox {
+
+namespace {
+uint64_t elapsedMicros(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+} // namespace
+
+// static
+std::shared_ptr<ReadLatencyTracker> ReadLatencyTracker::forFileSystem(
+    const std::string& name) {
+  static folly::Synchronized<
+      folly::F14FastMap<std::string, std::shared_ptr<ReadLatencyTracker>>>
+      trackers;
+  auto locked = trackers.wlock();
+  auto& tracker = (*locked)[name];
+  if (tracker == nullptr) {
+    tracker = std::make_shared<ReadLatencyTracker>();
+  }
+  return tracker;
+}
+
+// static
+int32_t ReadLatencyTracker::sizeClass(uint64_t bytes) {
+  // Reads under 64KB are in class 0, then each class is 4x larger.
+  constexpr uint64_t kSmallReadBytes = 64 << 10;
+  if (bytes < kSmallReadBytes) {
+    return 0;
+  }
+  const auto log2 = static_cast<int32_t>(std::log2(bytes / kSmallReadBytes));
+  return std::min<int32_t>(kNumSizeClasses - 1, 1 + log2 / 2);
+}
+
+// static
+int32_t ReadLatencyTracker::bucket(uint64_t micros) {
+  return std::min<int32_t>(
+      kNumBuckets - 1, static_cast<int32_t>(2 * std::log2(micros + 1)));
+}
+
+// static
+uint64_t ReadLatencyTracker::bucketLimit(int32_t bucket) {
+  return static_cast<uint64_t>(std::ceil(std::exp2((bucket + 1) / 2.0))) - 1;
+}
+
+void ReadLatencyTracker::recordLatency(uint64_t bytes, uint64_t micros) {
+  auto& sizeClass = sizeClasses_[ReadLatencyTracker::sizeClass(bytes)];
+  ++sizeClass.counts[bucket(micros)];
+  if (++sizeClass.numSamples == kMaxSamples) {
+    uint64_t numRemoved = 0;
+    for (auto& count : sizeClass.counts) {
+      const auto half = count / 2;
+      count -= half;
+      numRemoved += half;
+    }
+    sizeClass.numSamples -= numRemoved;
+  }
+}
+
+uint64_t ReadLatencyTracker::percentileUs(uint64_t bytes, double percentile)
+    const {
+  const auto& sizeClass = sizeClasses_[ReadLatencyTracker::sizeClass(bytes)];
+  uint64_t total = 0;
+  std::array<uint64_t, kNumBuckets> counts;
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    counts[i] = sizeClass.counts[i];
+    total += counts[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+  const auto target = static_cast<uint64_t>(std::ceil(percentile * total));
+  uint64_t cumulative = 0;
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    cumulative += counts[i];
+    if (cumulative >= target) {
+      return bucketLimit(i);
+    }
+  }
+  return bucketLimit(kNumBuckets - 1);
+}
+
+bool ReadLatencyTracker::tryStartHedge(double maxExtraFraction) {
+  if (++numHedges_ > maxExtraFraction * numReads_) {
+    --numHedges_;
+    return false;
+  }
+  return true;
+}
+
+HedgedReadFile::HedgedReadFile(
+    std::shared_ptr<ReadFile> file,
+    std::shared_ptr<folly::ThreadPoolExecutor> executor,
+    std::shared_ptr<ReadLatencyTracker> tracker,
+    Options options)
+    : file_(std::move(file)),
+      executor_(std::move(executor)),
+      tracker_(std::move(tracker)),
+      options_(options) {
+  VELOX_CHECK_NOT_NULL(file_);
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_NOT_NULL(tracker_);
+}
+
+std::optional<uint64_t> HedgedReadFile::hedgeDelayUs(uint64_t bytes) const {
+  if (tracker_->numSamples(bytes) < options_.minSamples ||
+      !tracker_->hasHedgeBudget(options_.maxExtraFraction) ||
+      !hasIdleThread()) {
+    return std::nullopt;
+  }
+  return std::max(
+      options_.minDelayUs, tracker_->percentileUs(bytes, options_.percentile));
+}
+
+bool HedgedReadFile::hasIdleThread() const {
+  const auto stats = executor_->getPoolStats();
+  return stats.pendingTaskCount == 0 &&
+      stats.activeThreadCount < executor_->numThreads();
+}
+
+folly::Future<HedgedReadFile::ReadResult> HedgedReadFile::startRead(
+    uint64_t bytes,
+    const Read& read,
+    std::shared_ptr<std::atomic<bool>> done) const {
+  return folly::via(
+      executor_.get(), [tracker = tracker_, bytes, read, done]() {
+        if (*done) {
+          return ReadResult();
+        }
+        const auto start = std::chrono::steady_clock::now();
+        auto result = read();
+        tracker->recordLatency(bytes, elapsedMicros(start));
+        return result;
+      });
+}
+
+HedgedReadFile::ReadResult
+HedgedReadFile::hedge(uint64_t bytes, uint64_t delayUs, const Read& read)
+    const {
+  auto done = std::make_shared<std::atomic<bool>>(false);
+  auto primary = startRead(bytes, read, done);
+  primary.wait(std::chrono::microseconds(delayUs));
+  ReadResult result;
+  if (primary.isReady() || !hasIdleThread() ||
+      !tracker_->tryStartHedge(options_.maxExtraFraction)) {
+    result = std::move(primary).get();
+  } else {
+    std::vector<folly::Future<ReadResult>> reads;
+    reads.push_back(std::move(primary));
+    reads.push_back(startRead(bytes, read, done));
+    // Fails only if both reads fail.
+    auto first = folly::collectAnyWithoutException(std::move(reads)).get();
+    if (first.first == 1) {
+      tracker_->recordHedgeWin();
+    }
+    result = std::move(first.second);
+  }
+  done->store(true);
+  return result;
+}
+
+std::string_view
+HedgedReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
+  preadv(offset, {folly::Range<char*>(static_cast<char*>(buf), length)});
+  return {static_cast<char*>(buf), length};
+}
+
+uint64_t HedgedReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  uint64_t length = 0;
+  uint64_t dataLength = 0;
+  for (const auto& buffer : buffers) {
+    length += buffer.size();
+    if (buffer.data() != nullptr) {
+      dataLength += buffer.size();
+    }
+  }
+  bytesRead_ += length;
+  tracker_->recordRead();
+  const auto delayUs = hedgeDelayUs(length);
+  if (!delayUs.has_value()) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto numRead = file_->preadv(offset, buffers);
+    tracker_->recordLatency(length, elapsedMicros(start));
+    return numRead;
+  }
+
+  // Each read fills a buffer of its own with the bytes outside of the gaps.
+  // 'layout' is used only to tell the gaps from the data.
+  auto read = [file = file_, offset, layout = buffers, dataLength]() {
+    ReadResult result;
+    folly::IOBuf data(folly::IOBuf::CREATE, dataLength);
+    auto* next = reinterpret_cast<char*>(data.writableData());
+    std::vector<folly::Range<char*>> ranges;
+    ranges.reserve(layout.size());
+    for (const auto& range : layout) {
+      if (range.data() == nullptr) {
+        ranges.emplace_back(nullptr, range.size());
+      } else {
+        ranges.emplace_back(next, range.size());
+        next += range.size();
+      }
+    }
+    result.numRead = file->preadv(offset, ranges);
+    data.append(dataLength);
+    result.iobufs.push_back(std::move(data));
+    return result;
+  };
+  auto result = hedge(length, delayUs.value(), read);
+  const auto* data = result.iobufs[0].data();
+  for (const auto& buffer : buffers) {
+    if (buffer.data() != nullptr) {
+      memcpy(buffer.data(), data, buffer.size());
+      data += buffer.size();
+    }
+  }
+  return result.numRead;
+}
+
+void HedgedReadFile::preadv(
+    folly::Range<const common::Region*> regions,
+    folly::Range<folly::IOBuf*> iobufs) const {
+  VELOX_CHECK_EQ(regions.size(), iobufs.size());
+  uint64_t length = 0;
+  for (const auto& region : regions) {
+    length += region.length;
+  }
+  bytesRead_ += length;
+  tracker_->recordRead();
+  const auto delayUs = hedgeDelayUs(length);
+  if (!delayUs.has_value()) {
+    const auto start = std::chrono::steady_clock::now();
+    file_->preadv(regions, iobufs);
+    tracker_->recordLatency(length, elapsedMicros(start));
+    return;
+  }
+
+  // The reads allocate their own IOBufs. The regions and their labels are
+  // copied since the read that loses may run after this returns.
+  struct OwnedRegions {
+    std::vector<std::string> labels;
+    std::vector<common::Region> regions;
+  };
+  auto owned = std::make_shared<OwnedRegions>();
+  owned->labels.reserve(regions.size());
+  owned->regions.reserve(regions.size());
+  for (const auto& region : regions) {
+    owned->labels.emplace_back(region.label);
+    owned->regions.emplace_back(
+        region.offset, region.length, owned->labels.back());
+  }
+  auto read = [file = file_, owned]() {
+    ReadResult result;
+    result.iobufs.resize(owned->regions.size());
+    file->preadv(
+        folly::Range<const common::Region*>(
+            owned->regions.data(), owned->regions.size()),
+        folly::Range<folly::IOBuf*>(
+            result.iobufs.data(), result.iobufs.size()));
+    return result;
+  };
+  auto result = hedge(length, delayUs.value(), read);
+  for (auto i = 0; i < iobufs.size(); ++i) {
+    iobufs[i] = std::move(result.iobufs[i]);
+  }
+}
+
+} // namespace facebook::velox
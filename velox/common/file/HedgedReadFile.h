@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/executors/ThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
+#include <folly/io/IOBuf.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "velox/common/file/File.h"
+
+namespace facebook::velox {
+
+// Latency distributions of reads from one file system and the number of
+// hedged reads made to it. Reads are split into size classes by powers of 4
+// bytes from 64KB to 64MB so that large reads are compared with reads of
+// similar size. Each size class has a histogram with two buckets per power of
+// two microseconds. Thread safe.
+class ReadLatencyTracker {
+ public:
+  static constexpr int32_t kNumBuckets = 64;
+
+  static constexpr int32_t kNumSizeClasses = 7;
+
+  // When this many latencies are recorded in a size class, its counts are
+  // halved so that the distribution follows changes in the file system.
+  static constexpr uint64_t kMaxSamples = 1 << 20;
+
+  // Returns the tracker for the file system 'name', e.g. "s3". The trackers
+  // live for the life of the process.
+  static std::shared_ptr<ReadLatencyTracker> forFileSystem(
+      const std::string& name);
+
+  // Returns the size class of a read of 'bytes'.
+  static int32_t sizeClass(uint64_t bytes);
+
+  // Records that a read of 'bytes' took 'micros'.
+  void recordLatency(uint64_t bytes, uint64_t micros);
+
+  // Returns a latency that at least 'percentile' of the recorded reads of the
+  // size class of 'bytes' completed within. 0 if there are no such reads.
+  uint64_t percentileUs(uint64_t bytes, double percentile) const;
+
+  // Returns the number of recorded reads of the size class of 'bytes'.
+  uint64_t numSamples(uint64_t bytes) const {
+    return sizeClasses_[sizeClass(bytes)].numSamples;
+  }
+
+  // Counts a read that may be hedged.
+  void recordRead() {
+    ++numReads_;
+  }
+
+  // Returns true if a hedge would keep the number of hedges within
+  // 'maxExtraFraction' of the reads.
+  bool hasHedgeBudget(double maxExtraFraction) const {
+    return numHedges_ + 1 <= maxExtraFraction * numReads_;
+  }
+
+  // Counts a hedge and returns true if there is budget for it.
+  bool tryStartHedge(double maxExtraFraction);
+
+  void recordHedgeWin() {
+    ++numHedgeWins_;
+  }
+
+  uint64_t numReads() const {
+    return numReads_;
+  }
+
+  uint64_t numHedges() const {
+    return numHedges_;
+  }
+
+  // Number of hedges that completed before the read they duplicate.
+  uint64_t numHedgeWins() const {
+    return numHedgeWins_;
+  }
+
+ private:
+  struct SizeClass {
+    std::array<std::atomic<uint64_t>, kNumBuckets> counts{};
+    std::atomic<uint64_t> numSamples{0};
+  };
+
+  static int32_t bucket(uint64_t micros);
+
+  // Returns the largest latency in 'bucket'.
+  static uint64_t bucketLimit(int32_t bucket);
+
+  std::array<SizeClass, kNumSizeClasses> sizeClasses_;
+  std::atomic<uint64_t> numReads_{0};
+  std::atomic<uint64_t> numHedges_{0};
+  std::atomic<uint64_t> numHedgeWins_{0};
+};
+
+// ReadFile that duplicates reads of a slow file system to cut tail latency.
+// A read that has not completed by a percentile of the latency distribution
+// of reads of its size is issued again, and the first of the two to complete
+// is returned. The other one is abandoned: it is skipped if it has not
+// started and its result is dropped otherwise. The number of duplicates is
+// capped at a fraction of the reads.
+//
+// Each pread() or preadv() is hedged as one call to the same method of the
+// wrapped file, so that a coalesced read stays one request to storage.
+//
+// Reads that cannot be hedged, because too few reads of their size are
+// recorded or the budget is used up, run on the calling thread into the
+// caller's buffers. So do reads made while all threads of 'executor' are
+// busy, so that the concurrency of reads is not limited by the size of
+// 'executor'. A read that may be hedged runs on 'executor' while the calling
+// thread waits for it, since the calling thread could not otherwise return
+// the duplicate when it completes first. Such a read is made into buffers of
+// its own and copied to the caller's on completion, because the read that
+// loses may still write after the winner is returned. preadv() into IOBufs
+// needs no copy. 'executor' must not be one whose threads wait for reads of
+// this file, since that could deadlock.
+class HedgedReadFile final : public ReadFile {
+ public:
+  struct Options {
+    // Percentile of the latency distribution after which a read is hedged.
+    double percentile{0.95};
+
+    // Number of recorded reads of a size class before its reads are hedged.
+    uint64_t minSamples{100};
+
+    // Maximum number of hedges as a fraction of the reads.
+    double maxExtraFraction{0.05};
+
+    // Minimum time before a read is hedged.
+    uint64_t minDelayUs{1'000};
+  };
+
+  HedgedReadFile(
+      std::shared_ptr<ReadFile> file,
+      std::shared_ptr<folly::ThreadPoolExecutor> executor,
+      std::shared_ptr<ReadLatencyTracker> tracker,
+      Options options);
+
+  HedgedReadFile(
+      std::shared_ptr<ReadFile> file,
+      std::shared_ptr<folly::ThreadPoolExecutor> executor,
+      std::shared_ptr<ReadLatencyTracker> tracker)
+      : HedgedReadFile(
+            std::move(file),
+            std::move(executor),
+            std::move(tracker),
+            Options{}) {}
+
+  std::string_view
+  pread(uint64_t offset, uint64_t length, void* FOLLY_NONNULL buf) const final;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  void preadv(
+      folly::Range<const common::Region*> regions,
+      folly::Range<folly::IOBuf*> iobufs) const final;
+
+  uint64_t size() const final {
+    return file_->size();
+  }
+
+  uint64_t memoryUsage() const final {
+    return file_->memoryUsage();
+  }
+
+  bool shouldCoalesce() const final {
+    return file_->shouldCoalesce();
+  }
+
+  std::string getName() const final {
+    return file_->getName();
+  }
+
+  uint64_t getNaturalReadSize() const final {
+    return file_->getNaturalReadSize();
+  }
+
+  const ReadLatencyTracker& tracker() const {
+    return *tracker_;
+  }
+
+ private:
+  // Result of one of the duplicate reads, in memory owned by the read.
+  struct ReadResult {
+    uint64_t numRead{0};
+    std::vector<folly::IOBuf> iobufs;
+  };
+
+  using Read = std::function<ReadResult()>;
+
+  // Returns the time after which a read of 'bytes' is hedged or std::nullopt
+  // if the read is made on the calling thread.
+  std::optional<uint64_t> hedgeDelayUs(uint64_t bytes) const;
+
+  // Returns true if 'executor_' has a thread free to start a read.
+  bool hasIdleThread() const;
+
+  // Runs 'read' on 'executor_' and, if it has not completed after 'delayUs',
+  // once more. Returns the result of the first to complete.
+  ReadResult hedge(uint64_t bytes, uint64_t delayUs, const Read& read) const;
+
+  // Runs 'read' on 'executor_'. Does nothing if 'done' is set when the read
+  // starts.
+  folly::Future<ReadResult> startRead(
+      uint64_t bytes,
+      const Read& read,
+      std::shared_ptr<std::atomic<bool>> done) const;
+
+  const std::shared_ptr<ReadFile> file_;
+  const std::shared_ptr<folly::ThreadPoolExecutor> executor_;
+  const std::shared_ptr<ReadLatencyTracker> tracker_;
+  const Options options_;
+};
+
+} // namespace facebook::velox
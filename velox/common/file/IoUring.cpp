@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include "velox/common/base/Exceptions.h"
+
+#include <fmt/format.h>
+#include <folly/String.h>
+#include <glog/logging.h>
+#include <limits.h>
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+namespace facebook::velox {
+
+struct IoUring::Pending {
+  folly::Promise<uint64_t> promise;
+  int32_t fd;
+  uint64_t offset;
+  bool isWrite;
+  // Referenced by the submission entry until completion.
+  std::vector<iovec> iovecs;
+  uint64_t size{0};
+};
+
+namespace {
+constexpr uint64_t kDroppedBytesSize = 64 << 10;
+
+// Target of skipped ranges in reads. Shared by all reads since the contents
+// are discarded.
+char* droppedBytes() {
+  static std::vector<char> bytes(kDroppedBytesSize);
+  return bytes.data();
+}
+
+// Converts 'buffers' to iovecs of at most IOV_MAX elements each.
+std::vector<std::vector<iovec>> makeIovecs(
+    const std::vector<folly::Range<char*>>& buffers) {
+  std::vector<std::vector<iovec>> result(1);
+  const auto add = [&](char* data, uint64_t size) {
+    if (result.back().size() >= IOV_MAX) {
+      result.emplace_back();
+    }
+    result.back().push_back({data, size});
+  };
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      add(range.data(), range.size());
+      continue;
+    }
+    for (auto skipSize = range.size(); skipSize > 0;) {
+      const auto bytes = std::min<uint64_t>(skipSize, kDroppedBytesSize);
+      add(droppedBytes(), bytes);
+      skipSize -= bytes;
+    }
+  }
+  return result;
+}
+
+void setError(folly::Promise<uint64_t>& promise, const std::string& message) {
+  try {
+    VELOX_FAIL(message);
+  } catch (const std::exception&) {
+    promise.setException(folly::exception_wrapper(std::current_exception()));
+  }
+}
+} // namespace
+
+std::vector<folly::SemiFuture<uint64_t>> IoUring::submit(
+    std::vector<Request> requests) {
+  std::vector<folly::SemiFuture<uint64_t>> futures;
+  futures.reserve(requests.size());
+  std::unique_lock<std::mutex> l(mutex_);
+  for (auto& request : requests) {
+    auto iovecs = makeIovecs(request.buffers);
+    std::vector<folly::SemiFuture<uint64_t>> parts;
+    uint64_t offset = request.offset;
+    for (auto& partIovecs : iovecs) {
+      auto pending = std::make_unique<Pending>();
+      pending->fd = request.fd;
+      pending->offset = offset;
+      pending->isWrite = request.isWrite;
+      for (const auto& iov : partIovecs) {
+        pending->size += iov.iov_len;
+      }
+      offset += pending->size;
+      pending->iovecs = std::move(partIovecs);
+      parts.push_back(pending->promise.getSemiFuture());
+      enqueueLocked(std::move(pending), l);
+    }
+    if (parts.size() == 1) {
+      futures.push_back(std::move(parts[0]));
+    } else {
+      futures.push_back(folly::collect(std::move(parts))
+                            .deferValue([](std::vector<uint64_t> sizes) {
+                              uint64_t total = 0;
+                              for (auto size : sizes) {
+                                total += size;
+                              }
+                              return total;
+                            }));
+    }
+  }
+  submitLocked();
+  return futures;
+}
+
+// static
+IoUring* IoUring::getInstance() {
+  // Leaked so that files read during static destruction do not find a
+  // destroyed ring.
+  static IoUring* instance = create().release();
+  return instance;
+}
+
+folly::SemiFuture<uint64_t> IoUring::preadv(
+    int32_t fd,
+    uint64_t offset,
+    std::vector<folly::Range<char*>> buffers) {
+  std::vector<Request> requests(1);
+  requests[0] = {fd, offset, false, std::move(buffers)};
+  return std::move(submit(std::move(requests))[0]);
+}
+
+folly::SemiFuture<uint64_t> IoUring::pwritev(
+    int32_t fd,
+    uint64_t offset,
+    std::vector<folly::Range<char*>> buffers) {
+  std::vector<Request> requests(1);
+  requests[0] = {fd, offset, true, std::move(buffers)};
+  return std::move(submit(std::move(requests))[0]);
+}
+
+#ifdef VELOX_ENABLE_IO_URING
+
+std::unique_ptr<IoUring> IoUring::create(int32_t queueDepth) {
+  auto ring = std::make_unique<::io_uring>();
+  const auto rc = io_uring_queue_init(queueDepth, ring.get(), 0);
+  if (rc < 0) {
+    LOG(WARNING) << "io_uring is not available: " << folly::errnoStr(-rc);
+    return nullptr;
+  }
+  io_uring_queue_exit(ring.get());
+  return std::unique_ptr<IoUring>(new IoUring(queueDepth));
+}
+
+IoUring::IoUring(int32_t queueDepth) : queueDepth_(queueDepth) {
+  ring_ = new ::io_uring();
+  const auto rc = io_uring_queue_init(queueDepth_, ring_, 0);
+  VELOX_CHECK_EQ(rc, 0, "io_uring_queue_init: {}", folly::errnoStr(-rc));
+  completionThread_ = std::thread([this]() { completionLoop(); });
+}
+
+IoUring::~IoUring() {
+  {
+    std::unique_lock<std::mutex> l(mutex_);
+    submitLocked();
+    completed_.wait(l, [&]() { return numInFlight_ == 0; });
+    // A no-op with no Pending tells the completion thread to stop.
+    auto* sqe = io_uring_get_sqe(ring_);
+    VELOX_CHECK_NOT_NULL(sqe);
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    ++numUnsubmitted_;
+    submitLocked();
+  }
+  completionThread_.join();
+  io_uring_queue_exit(ring_);
+  delete ring_;
+}
+
+void IoUring::enqueueLocked(
+    std::unique_ptr<Pending> pending,
+    std::unique_lock<std::mutex>& lock) {
+  if (numInFlight_ >= queueDepth_) {
+    // The queued entries must reach the kernel before any can complete.
+    submitLocked();
+    completed_.wait(lock, [&]() { return numInFlight_ < queueDepth_; });
+  }
+  auto* sqe = io_uring_get_sqe(ring_);
+  VELOX_CHECK_NOT_NULL(sqe, "io_uring submission queue full");
+  if (pending->isWrite) {
+    io_uring_prep_writev(
+        sqe,
+        pending->fd,
+        pending->iovecs.data(),
+        pending->iovecs.size(),
+        pending->offset);
+  } else {
+    io_uring_prep_readv(
+        sqe,
+        pending->fd,
+        pending->iovecs.data(),
+        pending->iovecs.size(),
+        pending->offset);
+  }
+  io_uring_sqe_set_data(sqe, pending.release());
+  ++numInFlight_;
+  ++numUnsubmitted_;
+}
+
+void IoUring::submitLocked() {
+  if (numUnsubmitted_ == 0) {
+    return;
+  }
+  const auto rc = io_uring_submit(ring_);
+  VELOX_CHECK_GE(rc, 0, "io_uring_submit: {}", folly::errnoStr(-rc));
+  numSubmitted_ += numUnsubmitted_;
+  ++numSubmitCalls_;
+  numUnsubmitted_ = 0;
+}
+
+void IoUring::completionLoop() {
+  for (;;) {
+    ::io_uring_cqe* cqe;
+    const auto rc = io_uring_wait_cqe(ring_, &cqe);
+    if (rc < 0) {
+      if (rc != -EINTR) {
+        LOG(ERROR) << "io_uring_wait_cqe: " << folly::errnoStr(-rc);
+      }
+      continue;
+    }
+    std::unique_ptr<Pending> pending(
+        reinterpret_cast<Pending*>(io_uring_cqe_get_data(cqe)));
+    const auto result = cqe->res;
+    io_uring_cqe_seen(ring_, cqe);
+    if (pending == nullptr) {
+      return;
+    }
+    if (result < 0) {
+      setError(
+          pending->promise,
+          fmt::format(
+              "io_uring {} of {} bytes at {} failed: {}",
+              pending->isWrite ? "write" : "read",
+              pending->size,
+              pending->offset,
+              folly::errnoStr(-result)));
+    } else if (static_cast<uint64_t>(result) != pending->size) {
+      setError(
+          pending->promise,
+          fmt::format(
+              "Short io_uring {}: {} of {} bytes at {}",
+              pending->isWrite ? "write" : "read",
+              result,
+              pending->size,
+              pending->offset));
+    } else {
+      pending->promise.setValue(result);
+    }
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      --numInFlight_;
+    }
+    completed_.notify_all();
+  }
+}
+
+#else
+
+std::unique_ptr<IoUring> IoUring::create(int32_t /*queueDepth*/) {
+  return nullptr;
+}
+
+IoUring::IoUring(int32_t queueDepth) : queueDepth_(queueDepth) {
+  VELOX_UNSUPPORTED("Velox is built without io_uring");
+}
+
+IoUring::~IoUring() = default;
+
+void IoUring::enqueueLocked(
+    std::unique_ptr<Pending> /*pending*/,
+    std::unique_lock<std::mutex>& /*lock*/) {
+  VELOX_UNSUPPORTED("Velox is built without io_uring");
+}
+
+void IoUring::submitLocked() {}
+
+void IoUring::completionLoop() {}
+
+#endif // VELOX_ENABLE_IO_URING
+
+} // namespace facebook::velox
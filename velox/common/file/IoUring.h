@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct io_uring;
+
+namespace facebook::velox {
+
+// Asynchronous file IO on a Linux io_uring. Requests are placed on the
+// submission ring in batches and their completions are delivered through
+// futures that are realized on a completion thread owned by 'this'. Thread
+// safe.
+class IoUring {
+ public:
+  static constexpr int32_t kDefaultQueueDepth = 256;
+
+  // A read or write of a contiguous range of a file.
+  struct Request {
+    int32_t fd;
+    uint64_t offset;
+    bool isWrite{false};
+    // Memory to read into or write from. For reads, a buffer with nullptr
+    // data causes its size worth of bytes to be skipped, as in
+    // ReadFile::preadv(). The memory must stay live until the future of the
+    // request is realized.
+    std::vector<folly::Range<char*>> buffers;
+  };
+
+  // Returns a ring with room for 'queueDepth' requests in flight or nullptr if
+  // io_uring is not available. This is the case if Velox is built without
+  // VELOX_ENABLE_IO_URING or if the kernel does not support io_uring.
+  static std::unique_ptr<IoUring> create(
+      int32_t queueDepth = kDefaultQueueDepth);
+
+  // Returns a ring shared by all users in the process or nullptr if io_uring
+  // is not available. The ring is created on first use and is never
+  // destroyed.
+  static IoUring* getInstance();
+
+  // Waits for requests in flight and stops the completion thread.
+  ~IoUring();
+
+  // Submits 'requests' with a single system call. Returns a future per
+  // request in the order of 'requests'. The future gives the number of bytes
+  // transferred or an exception if the IO failed or was short.
+  std::vector<folly::SemiFuture<uint64_t>> submit(
+      std::vector<Request> requests);
+
+  // Shorthand for submitting a single read.
+  folly::SemiFuture<uint64_t> preadv(
+      int32_t fd,
+      uint64_t offset,
+      std::vector<folly::Range<char*>> buffers);
+
+  // Shorthand for submitting a single write.
+  folly::SemiFuture<uint64_t> pwritev(
+      int32_t fd,
+      uint64_t offset,
+      std::vector<folly::Range<char*>> buffers);
+
+  int32_t queueDepth() const {
+    return queueDepth_;
+  }
+
+  // Number of requests submitted to the kernel. A Request with more than
+  // IOV_MAX buffers counts once for each IOV_MAX buffers.
+  uint64_t numSubmitted() const {
+    return numSubmitted_;
+  }
+
+  // Number of system calls made for submitting requests.
+  uint64_t numSubmitCalls() const {
+    return numSubmitCalls_;
+  }
+
+ private:
+  // A submitted IO. Owned by the ring while in flight.
+  struct Pending;
+
+  explicit IoUring(int32_t queueDepth);
+
+  // Places 'pending' on the submission ring. Submits the ring and waits for
+  // completions if 'queueDepth_' requests are in flight.
+  void enqueueLocked(
+      std::unique_ptr<Pending> pending,
+      std::unique_lock<std::mutex>& lock);
+
+  // Submits the queued submission entries to the kernel.
+  void submitLocked();
+
+  // Realizes the futures of completed requests until the ring is shut down.
+  void completionLoop();
+
+  const int32_t queueDepth_;
+
+  ::io_uring* ring_{nullptr};
+
+  // Serializes access to the submission side of 'ring_' and
+  // 'numInFlight_'.
+  std::mutex mutex_;
+
+  // Signaled when a request completes.
+  std::condition_variable completed_;
+
+  // Number of requests enqueued and not completed.
+  int32_t numInFlight_{0};
+
+  // Number of requests on the submission ring not yet submitted.
+  int32_t numUnsubmitted_{0};
+
+  std::atomic<uint64_t> numSubmitted_{0};
+  std::atomic<uint64_t> numSubmitCalls_{0};
+
+  std::thread completionThread_;
+};
+
+} // namespace facebook::velox
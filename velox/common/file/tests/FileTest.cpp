@@ -18,6 +18,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
 
@@ -126,6 +127,74 @@ TEST(LocalFile, writeAndRead) {
   readData(&readFile);
 }
 
+TEST(LocalFile, readAsync) {
+  if (IoUring::getInstance() == nullptr) {
+    GTEST_SKIP() << "io_uring not available";
+  }
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  LocalReadFile readFile(filename);
+  ASSERT_TRUE(readFile.hasPreadvAsync());
+  readData(&readFile);
+
+  char head[5];
+  char tail[5];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, 5 + kOneMB),
+      folly::Range<char*>(tail, sizeof(tail))};
+  auto future = readFile.preadvAsync(0, buffers);
+  ASSERT_EQ(15 + kOneMB, std::move(future).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaa");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ddddd");
+
+  // A read past the end fails.
+  char byte;
+  EXPECT_THROW(
+      readFile.preadvAsync(15 + kOneMB, {folly::Range<char*>(&byte, 1)}).get(),
+      VeloxRuntimeError);
+
+  std::vector<Region> regions = {
+      {5 + 5 + kOneMB, 5UL, {}}, {3, 4UL, {}}, {9, 2UL, {}}};
+  std::vector<folly::IOBuf> iobufs(regions.size());
+  readFile.preadv(regions, {iobufs.data(), iobufs.size()});
+  std::vector<std::string> values;
+  for (auto& iobuf : iobufs) {
+    values.push_back(std::string{
+        reinterpret_cast<const char*>(iobuf.data()), iobuf.length()});
+  }
+  EXPECT_EQ((std::vector<std::string>{"ddddd", "aabb", "bc"}), values);
+}
+
+TEST(LocalFile, mmap) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  MmapReadFile readFile(filename);
+  readData(&readFile);
+  ASSERT_EQ(std::string_view(readFile.data(), 5), "aaaaa");
+  readFile.willNeed(kOneMB, 15);
+  readFile.adviseSequential();
+  char byte;
+  EXPECT_THROW(readFile.pread(15 + kOneMB, 1, &byte), VeloxRuntimeError);
+
+  filesystems::registerLocalFileSystem();
+  filesystems::FileOptions options;
+  options.values[filesystems::FileOptions::kLocalMmap] = "true";
+  auto file = filesystems::getFileSystem(filename, nullptr)
+                  ->openFileForRead(filename, options);
+  ASSERT_NE(nullptr, dynamic_cast<MmapReadFile*>(file.get()));
+}
+
 TEST(LocalFile, viaRegistry) {
   filesystems::registerLocalFileSystem();
   auto tempFile = ::exec::test::TempFilePath::create();
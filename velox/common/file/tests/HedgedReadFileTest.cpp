@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/HedgedReadFile.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+
+namespace {
+
+// In-memory file whose reads take the time set by addDelay(), in order of
+// the reads. Reads without a set delay are immediate.
+class DelayedReadFile : public ReadFile {
+ public:
+  explicit DelayedReadFile(std::string content)
+      : content_(std::move(content)) {}
+
+  void addDelay(std::chrono::milliseconds delay) {
+    std::lock_guard<std::mutex> l(mutex_);
+    delays_.push_back(delay);
+  }
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf)
+      const override {
+    waitForRead(false);
+    memcpy(buf, content_.data() + offset, length);
+    return {static_cast<char*>(buf), length};
+  }
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    waitForRead(true);
+    uint64_t numRead = 0;
+    for (const auto& buffer : buffers) {
+      if (buffer.data() != nullptr) {
+        memcpy(buffer.data(), content_.data() + offset, buffer.size());
+      }
+      offset += buffer.size();
+      numRead += buffer.size();
+    }
+    return numRead;
+  }
+
+  void preadv(
+      folly::Range<const common::Region*> regions,
+      folly::Range<folly::IOBuf*> iobufs) const override {
+    waitForRead(true);
+    for (auto i = 0; i < regions.size(); ++i) {
+      iobufs[i] = folly::IOBuf(
+          folly::IOBuf::COPY_BUFFER,
+          content_.data() + regions[i].offset,
+          regions[i].length);
+    }
+  }
+
+  uint64_t size() const override {
+    return content_.size();
+  }
+
+  uint64_t memoryUsage() const override {
+    return content_.size();
+  }
+
+  bool shouldCoalesce() const override {
+    return true;
+  }
+
+  std::string getName() const override {
+    return "<DelayedReadFile>";
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return 1 << 20;
+  }
+
+  // Number of reads of any kind.
+  int32_t numReads() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numReads_;
+  }
+
+  // Number of preadv() calls.
+  int32_t numPreadv() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numPreadv_;
+  }
+
+ private:
+  // Counts a read and sleeps for its delay.
+  void waitForRead(bool isPreadv) const {
+    std::chrono::milliseconds delay{0};
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      ++numReads_;
+      if (isPreadv) {
+        ++numPreadv_;
+      }
+      if (!delays_.empty()) {
+        delay = delays_.front();
+        delays_.pop_front();
+      }
+    }
+    std::this_thread::sleep_for(delay);
+  }
+
+  const std::string content_;
+  mutable std::mutex mutex_;
+  mutable std::deque<std::chrono::milliseconds> delays_;
+  mutable int32_t numReads_{0};
+  mutable int32_t numPreadv_{0};
+};
+
+class HedgedReadFileTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    for (auto i = 0; i < 1000; ++i) {
+      content_.push_back('a' + i % 26);
+    }
+    delayedFile_ = std::make_shared<DelayedReadFile>(content_);
+    executor_ = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+    tracker_ = std::make_shared<ReadLatencyTracker>();
+  }
+
+  std::unique_ptr<HedgedReadFile> makeFile(HedgedReadFile::Options options) {
+    return std::make_unique<HedgedReadFile>(
+        delayedFile_, executor_, tracker_, options);
+  }
+
+  std::string content_;
+  std::shared_ptr<DelayedReadFile> delayedFile_;
+  std::shared_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::shared_ptr<ReadLatencyTracker> tracker_;
+};
+
+} // namespace
+
+TEST_F(HedgedReadFileTest, tracker) {
+  ReadLatencyTracker tracker;
+  EXPECT_EQ(0, tracker.percentileUs(100, 0.5));
+  for (auto i = 0; i < 90; ++i) {
+    tracker.recordLatency(100, 100);
+  }
+  for (auto i = 0; i < 10; ++i) {
+    tracker.recordLatency(100, 10'000);
+  }
+  EXPECT_EQ(100, tracker.numSamples(100));
+  // The percentiles are rounded up to the bucket limits.
+  const auto p50 = tracker.percentileUs(100, 0.5);
+  EXPECT_LE(100, p50);
+  EXPECT_GT(150, p50);
+  const auto p95 = tracker.percentileUs(100, 0.95);
+  EXPECT_LE(10'000, p95);
+  EXPECT_GT(15'000, p95);
+
+  // Large reads have a distribution of their own.
+  EXPECT_EQ(0, ReadLatencyTracker::sizeClass((64 << 10) - 1));
+  EXPECT_EQ(1, ReadLatencyTracker::sizeClass(64 << 10));
+  EXPECT_EQ(2, ReadLatencyTracker::sizeClass(256 << 10));
+  EXPECT_EQ(
+      ReadLatencyTracker::kNumSizeClasses - 1,
+      ReadLatencyTracker::sizeClass(1ULL << 40));
+  EXPECT_EQ(0, tracker.numSamples(8 << 20));
+  tracker.recordLatency(8 << 20, 100'000);
+  EXPECT_EQ(1, tracker.numSamples(8 << 20));
+  EXPECT_LE(100'000, tracker.percentileUs(8 << 20, 0.5));
+  EXPECT_GT(150, tracker.percentileUs(100, 0.5));
+
+  for (auto i = 0; i < 10; ++i) {
+    tracker.recordRead();
+  }
+  EXPECT_TRUE(tracker.tryStartHedge(0.1));
+  EXPECT_FALSE(tracker.tryStartHedge(0.1));
+  EXPECT_EQ(1, tracker.numHedges());
+
+  EXPECT_EQ(
+      ReadLatencyTracker::forFileSystem("s3").get(),
+      ReadLatencyTracker::forFileSystem("s3").get());
+}
+
+TEST_F(HedgedReadFileTest, hedge) {
+  HedgedReadFile::Options options;
+  options.minSamples = 20;
+  options.maxExtraFraction = 0.5;
+  options.minDelayUs = 10'000;
+  auto file = makeFile(options);
+
+  // Reads are not hedged before there are enough samples.
+  char buffer[10];
+  for (auto i = 0; i < 20; ++i) {
+    ASSERT_EQ(content_.substr(i, 10), file->pread(i, 10, buffer));
+  }
+  EXPECT_EQ(20, delayedFile_->numReads());
+  EXPECT_EQ(0, tracker_->numHedges());
+
+  // A read that is slower than the percentile is hedged and the duplicate
+  // returns first.
+  delayedFile_->addDelay(std::chrono::milliseconds(2'000));
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_EQ(content_.substr(100, 10), file->pread(100, 10, buffer));
+  EXPECT_GT(
+      std::chrono::milliseconds(1'000),
+      std::chrono::steady_clock::now() - start);
+  EXPECT_EQ(1, tracker_->numHedges());
+  EXPECT_EQ(1, tracker_->numHedgeWins());
+
+  // A fast read is not hedged.
+  ASSERT_EQ(content_.substr(200, 10), file->pread(200, 10, buffer));
+  EXPECT_EQ(1, tracker_->numHedges());
+}
+
+TEST_F(HedgedReadFileTest, budget) {
+  HedgedReadFile::Options options;
+  options.minSamples = 5;
+  options.maxExtraFraction = 0;
+  options.minDelayUs = 1'000;
+  auto file = makeFile(options);
+  char buffer[10];
+  for (auto i = 0; i < 5; ++i) {
+    file->pread(i, 10, buffer);
+  }
+  // Without budget for extra reads the slow read is waited for.
+  delayedFile_->addDelay(std::chrono::milliseconds(100));
+  ASSERT_EQ(content_.substr(100, 10), file->pread(100, 10, buffer));
+  EXPECT_EQ(0, tracker_->numHedges());
+  EXPECT_EQ(6, delayedFile_->numReads());
+}
+
+TEST_F(HedgedReadFileTest, preadv) {
+  HedgedReadFile::Options options;
+  options.minSamples = 5;
+  options.maxExtraFraction = 0.5;
+  options.minDelayUs = 10'000;
+  auto file = makeFile(options);
+
+  // A coalesced read with a gap is one preadv() of the wrapped file.
+  char first[10];
+  char second[20];
+  auto read = [&]() {
+    return file->preadv(
+        100,
+        {folly::Range<char*>(first, sizeof(first)),
+         folly::Range<char*>(nullptr, 50),
+         folly::Range<char*>(second, sizeof(second))});
+  };
+  for (auto i = 0; i < 5; ++i) {
+    ASSERT_EQ(80, read());
+  }
+  EXPECT_EQ(5, delayedFile_->numPreadv());
+  EXPECT_EQ(5, delayedFile_->numReads());
+  EXPECT_EQ(400, file->bytesRead());
+
+  // A slow coalesced read is hedged as a whole.
+  delayedFile_->addDelay(std::chrono::milliseconds(2'000));
+  ASSERT_EQ(80, read());
+  EXPECT_EQ(content_.substr(100, 10), std::string(first, sizeof(first)));
+  EXPECT_EQ(content_.substr(160, 20), std::string(second, sizeof(second)));
+  EXPECT_EQ(1, tracker_->numHedgeWins());
+  EXPECT_EQ(7, delayedFile_->numPreadv());
+  EXPECT_EQ(7, delayedFile_->numReads());
+
+  // Reads into IOBufs are hedged the same way.
+  std::vector<common::Region> regions{{0, 10, "a"}, {500, 30, "b"}};
+  std::vector<folly::IOBuf> iobufs(regions.size());
+  auto readRegions = [&]() {
+    file->preadv(
+        folly::Range<const common::Region*>(regions.data(), regions.size()),
+        folly::Range<folly::IOBuf*>(iobufs.data(), iobufs.size()));
+  };
+  for (auto i = 0; i < 5; ++i) {
+    readRegions();
+  }
+  delayedFile_->addDelay(std::chrono::milliseconds(2'000));
+  readRegions();
+  EXPECT_EQ(content_.substr(0, 10), iobufs[0].moveToFbString().toStdString());
+  EXPECT_EQ(
+      content_.substr(500, 30), iobufs[1].moveToFbString().toStdString());
+  EXPECT_EQ(2, tracker_->numHedgeWins());
+  EXPECT_EQ(14, delayedFile_->numPreadv());
+  EXPECT_EQ(14, delayedFile_->numReads());
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+
+TEST(IoUringTest, readAndWrite) {
+  auto ring = IoUring::create(4);
+  if (ring == nullptr) {
+    GTEST_SKIP() << "io_uring not available";
+  }
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto fd = ::open(tempFile->path.c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+
+  // More writes than the queue depth, each of more than IOV_MAX iovecs so that
+  // these are split.
+  constexpr int32_t kNumRequests = 10;
+  constexpr int32_t kNumRanges = 1500;
+  constexpr int32_t kRangeSize = 100;
+  constexpr int32_t kRequestSize = kNumRanges * kRangeSize;
+  std::string data(kNumRequests * kRequestSize, 0);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = i % 251;
+  }
+  std::vector<IoUring::Request> writes;
+  for (auto i = 0; i < kNumRequests; ++i) {
+    IoUring::Request request{fd, static_cast<uint64_t>(i) * kRequestSize};
+    request.isWrite = true;
+    for (auto j = 0; j < kNumRanges; ++j) {
+      request.buffers.push_back(folly::Range<char*>(
+          data.data() + i * kRequestSize + j * kRangeSize, kRangeSize));
+    }
+    writes.push_back(std::move(request));
+  }
+  auto writeFutures = ring->submit(std::move(writes));
+  ASSERT_EQ(kNumRequests, writeFutures.size());
+  for (auto& future : writeFutures) {
+    EXPECT_EQ(kRequestSize, std::move(future).get());
+  }
+  EXPECT_LT(kNumRequests, ring->numSubmitted());
+
+  // Reads every other range, skipping the ones in between.
+  std::string readData(data.size(), 0);
+  std::vector<folly::Range<char*>> buffers;
+  for (auto i = 0; i < data.size(); i += 2 * kRangeSize) {
+    buffers.push_back(folly::Range<char*>(readData.data() + i, kRangeSize));
+    buffers.push_back(folly::Range<char*>(nullptr, kRangeSize));
+  }
+  EXPECT_EQ(data.size(), ring->preadv(fd, 0, std::move(buffers)).get());
+  for (auto i = 0; i < data.size(); i += 2 * kRangeSize) {
+    EXPECT_EQ(0, memcmp(data.data() + i, readData.data() + i, kRangeSize));
+  }
+
+  // A read past the end is short.
+  char byte;
+  EXPECT_THROW(
+      ring->preadv(fd, data.size(), {folly::Range<char*>(&byte, 1)}).get(),
+      VeloxRuntimeError);
+  ::close(fd);
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/CoalesceTuner.h"
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace facebook::velox::io {
+
+namespace {
+std::string_view fileSystemName(std::string_view path) {
+  const auto pos = path.find("://");
+  if (pos == std::string_view::npos) {
+    return "file";
+  }
+  return path.substr(0, pos);
+}
+} // namespace
+
+// static
+CoalesceTuner& CoalesceTuner::forPath(std::string_view path) {
+  static folly::Synchronized<
+      folly::F14FastMap<std::string, std::unique_ptr<CoalesceTuner>>>
+      tuners;
+  const std::string name(fileSystemName(path));
+  {
+    auto readLocked = tuners.rlock();
+    auto it = readLocked->find(name);
+    if (it != readLocked->end()) {
+      return *it->second;
+    }
+  }
+  auto writeLocked = tuners.wlock();
+  auto& tuner = (*writeLocked)[name];
+  if (tuner == nullptr) {
+    tuner = std::make_unique<CoalesceTuner>();
+  }
+  return *tuner;
+}
+
+void CoalesceTuner::recordIo(uint64_t bytes, uint64_t micros) {
+  const double x = bytes;
+  const double y = micros;
+  std::lock_guard<std::mutex> l(mutex_);
+  weight_ = weight_ * kDecay + 1;
+  sumBytes_ = sumBytes_ * kDecay + x;
+  sumMicros_ = sumMicros_ * kDecay + y;
+  sumBytesSquared_ = sumBytesSquared_ * kDecay + x * x;
+  sumBytesMicros_ = sumBytesMicros_ * kDecay + x * y;
+  ++numSamples_;
+}
+
+std::optional<CoalesceTuner::Model> CoalesceTuner::model() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numSamples_ < kMinSamples) {
+    return std::nullopt;
+  }
+  const double meanBytes = sumBytes_ / weight_;
+  const double meanMicros = sumMicros_ / weight_;
+  const double variance = sumBytesSquared_ / weight_ - meanBytes * meanBytes;
+  const double covariance =
+      sumBytesMicros_ / weight_ - meanBytes * meanMicros;
+  // Without variation in size the latency and throughput cannot be told
+  // apart. A time that does not grow with size does not fit the model.
+  if (variance <= meanBytes * meanBytes * 1e-6 || covariance <= 0) {
+    return std::nullopt;
+  }
+  const double microsPerByte = covariance / variance;
+  const double latencyUs =
+      std::max(0.0, meanMicros - microsPerByte * meanBytes);
+  return Model{latencyUs, 1 / microsPerByte};
+}
+
+CoalesceParams CoalesceTuner::params(const CoalesceParams& defaults) const {
+  const auto fitted = model();
+  if (!fitted.has_value()) {
+    return defaults;
+  }
+  const double gap = fitted->latencyUs * fitted->bytesPerUs;
+  CoalesceParams params;
+  params.maxGap =
+      static_cast<int32_t>(std::clamp<double>(gap, kMinGap, kMaxGap));
+  params.maxBytes = std::min<int64_t>(
+      defaults.maxBytes,
+      std::max<int64_t>(
+          kMinIoBytes, static_cast<int64_t>(params.maxGap) * kIoSizeFactor));
+  return params;
+}
+
+} // namespace facebook::velox::io
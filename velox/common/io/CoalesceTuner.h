@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace facebook::velox::io {
+
+/// Parameters for coalescing reads of nearby ranges into fewer IOs.
+struct CoalesceParams {
+  /// Ranges separated by at most this many bytes are read in the same IO.
+  int32_t maxGap;
+
+  /// Maximum number of bytes read by a single coalesced IO.
+  int64_t maxBytes;
+};
+
+/// Learns the latency and throughput of a storage system from the IOs made to
+/// it and derives the coalescing parameters that minimize the expected time of
+/// a load. An IO of n bytes is modeled to take 'latency + n / throughput'.
+/// Reading through a gap of g bytes costs g / throughput and saves one
+/// latency, so gaps of up to latency * throughput bytes are worth reading. A
+/// coalesced IO is limited to a multiple of that size, which keeps the latency
+/// a small fraction of its time while still splitting large loads into IOs
+/// that can proceed in parallel. Thread safe.
+class CoalesceTuner {
+ public:
+  /// Fitted model of the storage system.
+  struct Model {
+    double latencyUs;
+    double bytesPerUs;
+  };
+
+  /// Number of IOs recorded before parameters are derived.
+  static constexpr int32_t kMinSamples = 16;
+
+  /// Weight of the previously recorded IOs relative to a new one.
+  static constexpr double kDecay = 0.98;
+
+  /// Bounds of the derived maximum gap.
+  static constexpr int32_t kMinGap = 4 << 10;
+  static constexpr int32_t kMaxGap = 16 << 20;
+
+  /// Ratio of the derived maximum IO size to the maximum gap.
+  static constexpr int32_t kIoSizeFactor = 8;
+
+  /// Lower bound of the derived maximum IO size.
+  static constexpr int64_t kMinIoBytes = 1 << 20;
+
+  /// Returns the tuner for the file system of 'path', e.g. "s3" for
+  /// 's3://bucket/key' and "file" for '/tmp/file'. The tuners live for the
+  /// life of the process.
+  static CoalesceTuner& forPath(std::string_view path);
+
+  /// Records an IO of 'bytes' that took 'micros'.
+  void recordIo(uint64_t bytes, uint64_t micros);
+
+  /// Returns the model fitted to the recorded IOs. Returns std::nullopt if
+  /// fewer than kMinSamples IOs are recorded or if the IOs do not fit the
+  /// model, e.g. if all IOs are of the same size.
+  std::optional<Model> model() const;
+
+  /// Returns the parameters derived from model() or 'defaults' if there is no
+  /// model. The maximum IO size is at most 'defaults.maxBytes'.
+  CoalesceParams params(const CoalesceParams& defaults) const;
+
+  int64_t numSamples() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numSamples_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+
+  // Exponentially decayed sums for a least squares fit of time over size.
+  double weight_{0};
+  double sumBytes_{0};
+  double sumMicros_{0};
+  double sumBytesSquared_{0};
+  double sumBytesMicros_{0};
+  int64_t numSamples_{0};
+};
+
+} // namespace facebook::velox::io
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/IoScheduler.h"
+
+#include <chrono>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/io/IoStatistics.h"
+
+namespace facebook::velox::io {
+
+namespace {
+IoScheduler*& instance() {
+  static IoScheduler* scheduler{nullptr};
+  return scheduler;
+}
+
+uint64_t nowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+} // namespace
+
+IoScheduler::Ticket& IoScheduler::Ticket::operator=(Ticket&& other) noexcept {
+  if (this != &other) {
+    release();
+    scheduler_ = other.scheduler_;
+    queryId_ = std::move(other.queryId_);
+    bytes_ = other.bytes_;
+    queueTimeUs_ = other.queueTimeUs_;
+    other.scheduler_ = nullptr;
+    other.bytes_ = 0;
+  }
+  return *this;
+}
+
+void IoScheduler::Ticket::release() {
+  if (scheduler_ == nullptr) {
+    return;
+  }
+  scheduler_->release(queryId_, bytes_);
+  scheduler_ = nullptr;
+}
+
+// static
+IoScheduler* IoScheduler::getInstance() {
+  return instance();
+}
+
+// static
+void IoScheduler::setInstance(IoScheduler* scheduler) {
+  instance() = scheduler;
+}
+
+IoScheduler::Ticket IoScheduler::admit(
+    const std::string& queryId,
+    double weight,
+    int64_t bytes,
+    Priority priority) {
+  VELOX_CHECK_GT(weight, 0);
+  VELOX_CHECK_GE(bytes, 0);
+  Waiter waiter{bytes, nowUs()};
+  std::unique_lock<std::mutex> l(mutex_);
+  auto it = queries_.find(queryId);
+  if (it == queries_.end()) {
+    double minVirtualBytes = 0;
+    bool first = true;
+    for (const auto& [id, query] : queries_) {
+      if (first || query.virtualBytes < minVirtualBytes) {
+        minVirtualBytes = query.virtualBytes;
+        first = false;
+      }
+    }
+    it = queries_.emplace(queryId, Query{weight, minVirtualBytes}).first;
+  }
+  auto& query = it->second;
+  if (priority == Priority::kBlocking) {
+    query.blocking.push_back(&waiter);
+  } else {
+    query.prefetch.push_back(&waiter);
+  }
+  ++numWaiting_;
+  admitLocked();
+  admitted_.wait(l, [&]() { return waiter.admitted; });
+  const auto queueTimeUs = nowUs() - waiter.enqueueUs;
+  queueTimeUs_ += queueTimeUs;
+  return Ticket(this, queryId, bytes, queueTimeUs);
+}
+
+// static
+IoScheduler::Ticket IoScheduler::schedule(
+    const std::string& queryId,
+    double weight,
+    int64_t bytes,
+    Priority priority,
+    IoStatistics* ioStats) {
+  auto* scheduler = getInstance();
+  if (scheduler == nullptr || queryId.empty()) {
+    return Ticket();
+  }
+  auto ticket = scheduler->admit(queryId, weight, bytes, priority);
+  if (ioStats != nullptr) {
+    ioStats->ioQueueTime().increment(ticket.queueTimeUs());
+  }
+  return ticket;
+}
+
+IoScheduler::Query* IoScheduler::nextLocked(
+    uint64_t now,
+    std::deque<Waiter*>*& queue) {
+  Query* next = nullptr;
+  bool nextIsBlocking = false;
+  for (auto& [id, query] : queries_) {
+    if (query.blocking.empty() && query.prefetch.empty()) {
+      continue;
+    }
+    const bool isBlocking = !query.blocking.empty() ||
+        now - query.prefetch.front()->enqueueUs >=
+            options_.prefetchPromotionUs;
+    if (next == nullptr || (isBlocking && !nextIsBlocking) ||
+        (isBlocking == nextIsBlocking &&
+         query.virtualBytes < next->virtualBytes)) {
+      next = &query;
+      nextIsBlocking = isBlocking;
+    }
+  }
+  if (next != nullptr) {
+    queue = next->blocking.empty() ? &next->prefetch : &next->blocking;
+  }
+  return next;
+}
+
+void IoScheduler::admitLocked() {
+  const auto now = nowUs();
+  bool anyAdmitted = false;
+  for (;;) {
+    std::deque<Waiter*>* queue = nullptr;
+    auto* query = nextLocked(now, queue);
+    if (query == nullptr) {
+      break;
+    }
+    auto* waiter = queue->front();
+    // The next read waits for bytes to be released even if a smaller read
+    // behind it would fit, so that large reads are not starved.
+    if (bytesInFlight_ > 0 &&
+        bytesInFlight_ + waiter->bytes > options_.maxBytesInFlight) {
+      break;
+    }
+    queue->pop_front();
+    --numWaiting_;
+    ++numAdmitted_;
+    bytesInFlight_ += waiter->bytes;
+    query->virtualBytes += waiter->bytes / query->weight;
+    ++query->numInFlight;
+    waiter->admitted = true;
+    anyAdmitted = true;
+  }
+  if (anyAdmitted) {
+    admitted_.notify_all();
+  }
+}
+
+void IoScheduler::release(const std::string& queryId, int64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  bytesInFlight_ -= bytes;
+  auto it = queries_.find(queryId);
+  VELOX_DCHECK(it != queries_.end());
+  --it->second.numInFlight;
+  if (it->second.empty()) {
+    queries_.erase(it);
+  }
+  admitLocked();
+}
+
+IoScheduler::Stats IoScheduler::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.bytesInFlight = bytesInFlight_;
+  stats.numWaiting = numWaiting_;
+  stats.numAdmitted = numAdmitted_;
+  stats.queueTimeUs = queueTimeUs_;
+  return stats;
+}
+
+} // namespace facebook::velox::io
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace facebook::velox::io {
+
+class IoStatistics;
+
+/// Admits reads from storage on behalf of queries so that the bytes in flight
+/// stay under a process-wide limit. Each query has a queue of waiting reads.
+/// When bytes become free, the next read comes from the query that has been
+/// admitted the fewest bytes relative to its weight, so that a query of
+/// weight 2 gets twice the bandwidth of a query of weight 1 when both have
+/// reads waiting. Reads a driver is blocked on go before prefetches of any
+/// query. A prefetch that has waited longer than
+/// Options::prefetchPromotionUs is treated as blocking, since a driver may by
+/// then be waiting for it. Thread safe.
+class IoScheduler {
+ public:
+  enum class Priority {
+    // A driver thread waits for the read.
+    kBlocking,
+    // The read is speculative and runs on a background executor.
+    kPrefetch,
+  };
+
+  struct Options {
+    /// Maximum number of bytes admitted and not released. A read larger than
+    /// this is admitted when nothing else is in flight.
+    int64_t maxBytesInFlight{256 << 20};
+
+    /// Age after which a waiting prefetch has blocking priority.
+    uint64_t prefetchPromotionUs{100'000};
+  };
+
+  struct Stats {
+    int64_t bytesInFlight{0};
+    int32_t numWaiting{0};
+    int64_t numAdmitted{0};
+    uint64_t queueTimeUs{0};
+  };
+
+  /// Permission to read 'bytes'. The bytes are released when the ticket is
+  /// destroyed, which admits the next waiting reads. A default constructed
+  /// ticket holds nothing.
+  class Ticket {
+   public:
+    Ticket() = default;
+
+    Ticket(Ticket&& other) noexcept {
+      *this = std::move(other);
+    }
+
+    Ticket& operator=(Ticket&& other) noexcept;
+
+    Ticket(const Ticket&) = delete;
+    Ticket& operator=(const Ticket&) = delete;
+
+    ~Ticket() {
+      release();
+    }
+
+    /// Returns the time the read waited to be admitted.
+    uint64_t queueTimeUs() const {
+      return queueTimeUs_;
+    }
+
+    void release();
+
+   private:
+    Ticket(
+        IoScheduler* scheduler,
+        std::string queryId,
+        int64_t bytes,
+        uint64_t queueTimeUs)
+        : scheduler_(scheduler),
+          queryId_(std::move(queryId)),
+          bytes_(bytes),
+          queueTimeUs_(queueTimeUs) {}
+
+    IoScheduler* scheduler_{nullptr};
+    std::string queryId_;
+    int64_t bytes_{0};
+    uint64_t queueTimeUs_{0};
+
+    friend class IoScheduler;
+  };
+
+  explicit IoScheduler(const Options& options) : options_(options) {}
+
+  /// Returns the process-wide scheduler or nullptr if IO is not scheduled.
+  static IoScheduler* getInstance();
+
+  /// Sets the process-wide scheduler. The caller keeps ownership and must keep
+  /// 'scheduler' alive until the instance is reset to nullptr.
+  static void setInstance(IoScheduler* scheduler);
+
+  /// Waits until a read of 'bytes' for 'queryId' with share 'weight' is
+  /// admitted. 'weight' is taken from the first read of the query that is
+  /// waiting or in flight.
+  Ticket admit(
+      const std::string& queryId,
+      double weight,
+      int64_t bytes,
+      Priority priority);
+
+  /// Admits the read through the process-wide scheduler and adds the time it
+  /// waited to the IO queue time of 'ioStats', if not nullptr. Returns an
+  /// empty ticket without waiting if there is no scheduler or 'queryId' is
+  /// empty.
+  static Ticket schedule(
+      const std::string& queryId,
+      double weight,
+      int64_t bytes,
+      Priority priority,
+      IoStatistics* ioStats);
+
+  Stats stats() const;
+
+ private:
+  struct Waiter {
+    int64_t bytes;
+    uint64_t enqueueUs;
+    bool admitted{false};
+  };
+
+  struct Query {
+    double weight;
+
+    // Bytes admitted divided by 'weight'. A query is created at the lowest
+    // value among the queries present, so that it does not get the bandwidth
+    // of a query that has been reading for long.
+    double virtualBytes;
+
+    std::deque<Waiter*> blocking;
+    std::deque<Waiter*> prefetch;
+    int32_t numInFlight{0};
+
+    bool empty() const {
+      return blocking.empty() && prefetch.empty() && numInFlight == 0;
+    }
+  };
+
+  // Admits waiting reads while they fit under the limit.
+  void admitLocked();
+
+  // Returns the query whose first waiting read is admitted next or nullptr
+  // if nothing is waiting. Sets 'queue' to the queue of the read.
+  Query* nextLocked(uint64_t now, std::deque<Waiter*>*& queue);
+
+  void release(const std::string& queryId, int64_t bytes);
+
+  const Options options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable admitted_;
+
+  // Queries with reads waiting or in flight. Node based so that references
+  // to a Query stay valid while other queries come and go.
+  std::unordered_map<std::string, Query> queries_;
+
+  int64_t bytesInFlight_{0};
+  int32_t numWaiting_{0};
+  int64_t numAdmitted_{0};
+  uint64_t queueTimeUs_{0};
+};
+
+} // namespace facebook::velox::io
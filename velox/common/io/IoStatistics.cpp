@@ -104,7 +104,11 @@ void IoStatistics::merge(const IoStatistics& other) {
   read_.merge(other.read_);
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
+  decompressedPageHit_.merge(other.decompressedPageHit_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  coalesceMaxGap_.merge(other.coalesceMaxGap_);
+  coalesceMaxBytes_.merge(other.coalesceMaxBytes_);
+  ioQueueTime_.merge(other.ioQueueTime_);
   std::lock_guard<std::mutex> l(operationStatsMutex_);
   for (auto& item : other.operationStats_) {
     operationStats_[item.first].merge(item.second);
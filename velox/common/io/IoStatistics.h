@@ -95,10 +95,26 @@ class IoStatistics {
     return ramHit_;
   }
 
+  IoCounter& decompressedPageHit() {
+    return decompressedPageHit_;
+  }
+
   IoCounter& queryThreadIoLatency() {
     return queryThreadIoLatency_;
   }
 
+  IoCounter& coalesceMaxGap() {
+    return coalesceMaxGap_;
+  }
+
+  IoCounter& coalesceMaxBytes() {
+    return coalesceMaxBytes_;
+  }
+
+  IoCounter& ioQueueTime() {
+    return ioQueueTime_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -135,10 +151,23 @@ class IoStatistics {
   // reads.
   IoCounter ssdRead_;
 
+  // Decompressed pages served from RAM cache instead of decompressing. The
+  // sum is in decompressed bytes.
+  IoCounter decompressedPageHit_;
+
   // Time spent by a query processing thread waiting for synchronously
   // issued IO or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // Coalescing parameters chosen for each batch of loads when coalescing is
+  // adaptive. The average is sum / count.
+  IoCounter coalesceMaxGap_;
+  IoCounter coalesceMaxBytes_;
+
+  // Time reads waited in the IoScheduler before being issued, in
+  // microseconds.
+  IoCounter ioQueueTime_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::io {
@@ -64,13 +66,18 @@ class ReaderOptions {
   int32_t loadQuantum_{kDefaultLoadQuantum};
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
+  bool adaptiveCoalesce_{false};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
+  int32_t decompressedPageCacheMinReadPct_{kNoDecompressedPageCache};
+  std::string ioSchedulingGroup_;
+  double ioSchedulingWeight_{1};
 
  public:
   static constexpr int32_t kDefaultLoadQuantum = 8 << 20; // 8MB
   static constexpr int32_t kDefaultCoalesceDistance = 512 << 10; // 512K
   static constexpr int32_t kDefaultCoalesceBytes = 128 << 20; // 128M
   static constexpr int32_t kDefaultPrefetchRowGroups = 1;
+  static constexpr int32_t kNoDecompressedPageCache = -1;
 
   explicit ReaderOptions(velox::memory::MemoryPool* pool)
       : memoryPool(pool),
@@ -83,7 +90,11 @@ class ReaderOptions {
     prefetchMode = other.prefetchMode;
     maxCoalesceDistance_ = other.maxCoalesceDistance_;
     maxCoalesceBytes_ = other.maxCoalesceBytes_;
+    adaptiveCoalesce_ = other.adaptiveCoalesce_;
     prefetchRowGroups_ = other.prefetchRowGroups_;
+    decompressedPageCacheMinReadPct_ = other.decompressedPageCacheMinReadPct_;
+    ioSchedulingGroup_ = other.ioSchedulingGroup_;
+    ioSchedulingWeight_ = other.ioSchedulingWeight_;
     return *this;
   }
 
@@ -137,6 +148,17 @@ class ReaderOptions {
     return *this;
   }
 
+  /**
+   * Derive the load coalesce distance and bytes from the measured latency and
+   * throughput of the file system. The maximum coalesce distance and bytes
+   * apply until there are enough measurements. The maximum coalesce bytes
+   * stays an upper bound.
+   */
+  ReaderOptions& setAdaptiveCoalesce(bool adaptive) {
+    adaptiveCoalesce_ = adaptive;
+    return *this;
+  }
+
   /**
    * Modify the number of row groups to prefetch.
    */
@@ -145,6 +167,35 @@ class ReaderOptions {
     return *this;
   }
 
+  /**
+   * Modify the admission of decompressed pages to AsyncDataCache. Pages of
+   * streams that the ScanTracker sees read at least 'pct' % of the times they
+   * are referenced are kept decompressed in the cache. A negative value
+   * disables caching decompressed pages.
+   */
+  ReaderOptions& setDecompressedPageCacheMinReadPct(int32_t pct) {
+    decompressedPageCacheMinReadPct_ = pct;
+    return *this;
+  }
+
+  /**
+   * Modify the group, e.g. the query, that reads from storage are scheduled
+   * for by the process-wide IoScheduler. Reads are not scheduled if empty.
+   */
+  ReaderOptions& setIoSchedulingGroup(std::string group) {
+    ioSchedulingGroup_ = std::move(group);
+    return *this;
+  }
+
+  /**
+   * Modify the share of the storage bandwidth of the IO scheduling group
+   * relative to other groups.
+   */
+  ReaderOptions& setIoSchedulingWeight(double weight) {
+    ioSchedulingWeight_ = weight;
+    return *this;
+  }
+
   /**
    * Get the memory allocator.
    */
@@ -172,8 +223,24 @@ class ReaderOptions {
     return maxCoalesceBytes_;
   }
 
+  bool adaptiveCoalesce() const {
+    return adaptiveCoalesce_;
+  }
+
   int64_t prefetchRowGroups() const {
     return prefetchRowGroups_;
   }
+
+  int32_t decompressedPageCacheMinReadPct() const {
+    return decompressedPageCacheMinReadPct_;
+  }
+
+  const std::string& ioSchedulingGroup() const {
+    return ioSchedulingGroup_;
+  }
+
+  double ioSchedulingWeight() const {
+    return ioSchedulingWeight_;
+  }
 };
 } // namespace facebook::velox::io
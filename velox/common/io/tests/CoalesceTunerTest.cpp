@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/CoalesceTuner.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::io;
+
+namespace {
+// Records IOs of varying size to a storage with 'latencyUs' and 'bytesPerUs'.
+void recordIos(CoalesceTuner& tuner, double latencyUs, double bytesPerUs) {
+  for (auto i = 0; i < 100; ++i) {
+    const uint64_t bytes = (1 + i % 10) * 100'000;
+    tuner.recordIo(bytes, latencyUs + bytes / bytesPerUs);
+  }
+}
+} // namespace
+
+TEST(CoalesceTunerTest, params) {
+  const CoalesceParams defaults{512 << 10, 128 << 20};
+
+  // Object store: 20ms latency, 100MB/s. Gaps up to 2MB are worth reading.
+  CoalesceTuner objectStore;
+  auto params = objectStore.params(defaults);
+  EXPECT_EQ(defaults.maxGap, params.maxGap);
+  EXPECT_EQ(defaults.maxBytes, params.maxBytes);
+  recordIos(objectStore, 20'000, 100);
+  auto model = objectStore.model();
+  ASSERT_TRUE(model.has_value());
+  EXPECT_NEAR(20'000, model->latencyUs, 1);
+  EXPECT_NEAR(100, model->bytesPerUs, 0.01);
+  params = objectStore.params(defaults);
+  EXPECT_NEAR(2'000'000, params.maxGap, 100);
+  EXPECT_NEAR(16'000'000, params.maxBytes, 1'000);
+
+  // NVMe: 100us latency, 2GB/s. Gaps up to 200K are worth reading.
+  CoalesceTuner nvme;
+  recordIos(nvme, 100, 2'000);
+  params = nvme.params(defaults);
+  EXPECT_NEAR(200'000, params.maxGap, 100);
+  EXPECT_NEAR(1'600'000, params.maxBytes, 1'000);
+
+  // The maximum IO size does not exceed the configured one.
+  params = objectStore.params({512 << 10, 8 << 20});
+  EXPECT_EQ(8 << 20, params.maxBytes);
+}
+
+TEST(CoalesceTunerTest, noFit) {
+  const CoalesceParams defaults{512 << 10, 128 << 20};
+  // IOs of the same size do not tell latency from throughput.
+  CoalesceTuner sameSize;
+  for (auto i = 0; i < 100; ++i) {
+    sameSize.recordIo(1 << 20, 1'000 + i % 3);
+  }
+  EXPECT_FALSE(sameSize.model().has_value());
+  EXPECT_EQ(defaults.maxGap, sameSize.params(defaults).maxGap);
+}
+
+TEST(CoalesceTunerTest, forPath) {
+  auto& s3 = CoalesceTuner::forPath("s3://bucket/a");
+  EXPECT_EQ(&s3, &CoalesceTuner::forPath("s3://other/b"));
+  auto& local = CoalesceTuner::forPath("/tmp/a");
+  EXPECT_NE(&s3, &local);
+  EXPECT_EQ(&local, &CoalesceTuner::forPath("/data/b"));
+}
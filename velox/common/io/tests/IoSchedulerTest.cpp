@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/IoScheduler.h"
+#include "velox/common/io/IoStatistics.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace facebook::velox::io;
+
+using Priority = IoScheduler::Priority;
+
+class IoSchedulerTest : public testing::Test {
+ protected:
+  void TearDown() override {
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  // Starts a thread that waits for a read of 'bytes' for 'queryId' to be
+  // admitted, appends 'queryId' to 'order_' and releases the read.
+  void startRead(
+      IoScheduler& scheduler,
+      const std::string& queryId,
+      double weight,
+      int64_t bytes,
+      Priority priority) {
+    threads_.emplace_back([&, queryId, weight, bytes, priority]() {
+      auto ticket = scheduler.admit(queryId, weight, bytes, priority);
+      std::lock_guard<std::mutex> l(mutex_);
+      order_.push_back(queryId);
+    });
+  }
+
+  // Waits until 'numWaiting' reads wait to be admitted.
+  static void waitForWaiting(IoScheduler& scheduler, int32_t numWaiting) {
+    while (scheduler.stats().numWaiting < numWaiting) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1)); // NOLINT
+    }
+  }
+
+  std::vector<std::string> finishReads() {
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+    threads_.clear();
+    return order_;
+  }
+
+  std::mutex mutex_;
+  std::vector<std::string> order_;
+  std::vector<std::thread> threads_;
+};
+
+TEST_F(IoSchedulerTest, bytesInFlight) {
+  IoScheduler scheduler({100, 1'000'000});
+  auto first = scheduler.admit("q1", 1, 60, Priority::kBlocking);
+  auto second = scheduler.admit("q2", 1, 40, Priority::kPrefetch);
+  EXPECT_EQ(100, scheduler.stats().bytesInFlight);
+
+  // A read over the limit waits for bytes to be released.
+  startRead(scheduler, "q3", 1, 10, Priority::kBlocking);
+  waitForWaiting(scheduler, 1);
+  second.release();
+  EXPECT_EQ(std::vector<std::string>{"q3"}, finishReads());
+
+  // A read larger than the limit is admitted alone.
+  startRead(scheduler, "q3", 1, 1'000, Priority::kBlocking);
+  waitForWaiting(scheduler, 1);
+  first = IoScheduler::Ticket();
+  finishReads();
+  const auto stats = scheduler.stats();
+  EXPECT_EQ(0, stats.bytesInFlight);
+  EXPECT_EQ(0, stats.numWaiting);
+  EXPECT_EQ(4, stats.numAdmitted);
+}
+
+TEST_F(IoSchedulerTest, blockingBeforePrefetch) {
+  IoScheduler scheduler({100, 1'000'000});
+  auto ticket = scheduler.admit("q1", 1, 100, Priority::kBlocking);
+  startRead(scheduler, "prefetch", 1, 100, Priority::kPrefetch);
+  waitForWaiting(scheduler, 1);
+  startRead(scheduler, "blocking", 1, 100, Priority::kBlocking);
+  waitForWaiting(scheduler, 2);
+  ticket.release();
+  EXPECT_EQ(
+      (std::vector<std::string>{"blocking", "prefetch"}), finishReads());
+}
+
+TEST_F(IoSchedulerTest, prefetchPromotion) {
+  IoScheduler scheduler({100, 1'000});
+  // 'q3' has the lowest admitted bytes, so that 'q1' starts there and below
+  // 'q2'.
+  auto q3Ticket = scheduler.admit("q3", 1, 0, Priority::kBlocking);
+  auto q2Ticket = scheduler.admit("q2", 1, 100, Priority::kBlocking);
+  startRead(scheduler, "q1", 1, 100, Priority::kPrefetch);
+  waitForWaiting(scheduler, 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  startRead(scheduler, "q2", 1, 100, Priority::kBlocking);
+  waitForWaiting(scheduler, 2);
+
+  // The prefetch has waited past the promotion age and competes with the
+  // blocking read on admitted bytes.
+  q2Ticket.release();
+  EXPECT_EQ((std::vector<std::string>{"q1", "q2"}), finishReads());
+}
+
+TEST_F(IoSchedulerTest, weightedFairShare) {
+  IoScheduler scheduler({10, 1'000'000});
+  auto ticket = scheduler.admit("blocker", 1, 10, Priority::kBlocking);
+  for (auto i = 0; i < 4; ++i) {
+    startRead(scheduler, "q1", 1, 10, Priority::kBlocking);
+    startRead(scheduler, "q2", 2, 10, Priority::kBlocking);
+  }
+  waitForWaiting(scheduler, 8);
+  ticket.release();
+  const auto order = finishReads();
+  ASSERT_EQ(8, order.size());
+
+  // 'q2' has twice the weight of 'q1' and is admitted twice as many reads
+  // while both have reads waiting.
+  EXPECT_EQ(2, std::count(order.begin(), order.begin() + 6, "q1"));
+  EXPECT_EQ(4, std::count(order.begin(), order.begin() + 6, "q2"));
+}
+
+TEST_F(IoSchedulerTest, schedule) {
+  IoStatistics ioStats;
+  auto ticket =
+      IoScheduler::schedule("q1", 1, 100, Priority::kBlocking, &ioStats);
+  EXPECT_EQ(0, ioStats.ioQueueTime().count());
+
+  IoScheduler scheduler({100, 1'000'000});
+  IoScheduler::setInstance(&scheduler);
+  ticket = IoScheduler::schedule("q1", 1, 100, Priority::kBlocking, &ioStats);
+  EXPECT_EQ(100, scheduler.stats().bytesInFlight);
+  EXPECT_EQ(1, ioStats.ioQueueTime().count());
+
+  // Reads without a scheduling group are not scheduled.
+  auto unscheduled =
+      IoScheduler::schedule("", 1, 100, Priority::kBlocking, &ioStats);
+  EXPECT_EQ(1, ioStats.ioQueueTime().count());
+
+  ticket.release();
+  EXPECT_EQ(0, scheduler.stats().bytesInFlight);
+  IoScheduler::setInstance(nullptr);
+}
@@ -18,7 +18,12 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/HedgedReadFile.h"
 #include "velox/common/time/Timer.h"
+#include "velox/connectors/hive/HiveConfig.h"
+
+#include <fmt/format.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 
 #include <atomic>
 
@@ -31,8 +36,32 @@ std::string groupName(const std::string& filename) {
   return slash ? std::string(filename.data(), slash - filename.data())
                : filename;
 }
+
+// Returns the scheme of a remote file, e.g. "s3", or an empty string for a
+// local file.
+std::string remoteScheme(const std::string& filename) {
+  const auto pos = filename.find("://");
+  if (pos == std::string::npos) {
+    return "";
+  }
+  auto scheme = filename.substr(0, pos);
+  return scheme == "file" ? "" : scheme;
+}
+
+// Number of threads for duplicate reads. These mostly wait for storage.
+constexpr int32_t kNumHedgedReadThreads = 32;
 } // namespace
 
+FileHandleGenerator::FileHandleGenerator(
+    std::shared_ptr<const Config> properties)
+    : properties_(std::move(properties)) {
+  if (properties_ &&
+      connector::hive::HiveConfig::hedgedReads(properties_.get())) {
+    hedgedReadExecutor_ = std::make_shared<folly::CPUThreadPoolExecutor>(
+        kNumHedgedReadThreads);
+  }
+}
+
 std::shared_ptr<FileHandle> FileHandleGenerator::operator()(
     const std::string& filename) {
   // We have seen cases where drivers are stuck when creating file handles.
@@ -43,10 +72,30 @@ std::shared_ptr<FileHandle> FileHandleGenerator::operator()(
   {
     MicrosecondTimer timer(&elapsedTimeUs);
     fileHandle = std::make_shared<FileHandle>();
+    filesystems::FileOptions options;
+    if (properties_ &&
+        connector::hive::HiveConfig::localFileMmap(properties_.get())) {
+      options.values[filesystems::FileOptions::kLocalMmap] = "true";
+    }
     fileHandle->file = filesystems::getFileSystem(filename, properties_)
-                           ->openFileForRead(filename);
+                           ->openFileForRead(filename, options);
+    const auto scheme = remoteScheme(filename);
+    if (hedgedReadExecutor_ && !scheme.empty()) {
+      HedgedReadFile::Options hedgeOptions;
+      hedgeOptions.maxExtraFraction =
+          connector::hive::HiveConfig::hedgedReadsMaxExtraPct(
+              properties_.get()) /
+          100.0;
+      fileHandle->file = std::make_shared<HedgedReadFile>(
+          std::move(fileHandle->file),
+          hedgedReadExecutor_,
+          ReadLatencyTracker::forFileSystem(scheme),
+          hedgeOptions);
+    }
     fileHandle->uuid = StringIdLease(fileIds(), filename);
     fileHandle->groupId = StringIdLease(fileIds(), groupName(filename));
+    fileHandle->metadataCacheKey =
+        fmt::format("{}:{}", filename, fileHandle->file->size());
     VLOG(1) << "Generating file handle for: " << filename
             << " uuid: " << fileHandle->uuid.id();
   }
@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <folly/executors/ThreadPoolExecutor.h>
+
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -52,6 +54,12 @@ struct FileHandle {
   // example to decide placing on SSD.
   StringIdLease groupId;
 
+  // Identifies the version of the file for caching its parsed metadata in
+  // dwio::common::FileMetadataCache. Consists of the path and size, so that a
+  // file rewritten under the same path with a different size is not served
+  // stale metadata.
+  std::string metadataCacheKey;
+
   // We'll want to have a hash map here to record the identifier->byte range
   // mappings. Different formats may have different identifiers, so we may need
   // a union of maps. For example in orc you need 3 integers (I think, to be
@@ -65,12 +73,15 @@ using FileHandleCache = SimpleLRUCache<std::string, FileHandle>;
 class FileHandleGenerator {
  public:
   FileHandleGenerator() {}
-  FileHandleGenerator(std::shared_ptr<const Config> properties)
-      : properties_(std::move(properties)) {}
+  FileHandleGenerator(std::shared_ptr<const Config> properties);
   std::shared_ptr<FileHandle> operator()(const std::string& filename);
 
  private:
   const std::shared_ptr<const Config> properties_;
+
+  // Runs reads of remote files that may be hedged if hedged reads are
+  // enabled.
+  std::shared_ptr<folly::ThreadPoolExecutor> hedgedReadExecutor_;
 };
 
 using FileHandleFactory = CachedFactory<
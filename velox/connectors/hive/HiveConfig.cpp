@@ -15,6 +15,7 @@
  */
 
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/common/io/Options.h"
 #include "velox/core/Config.h"
 #include "velox/core/QueryConfig.h"
 
@@ -161,11 +162,58 @@ int32_t HiveConfig::maxCoalescedDistanceBytes(const Config* config) {
   return config->get<int32_t>(kMaxCoalescedDistanceBytes, 512 << 10);
 }
 
+// static.
+bool HiveConfig::adaptiveCoalesce(const Config* config) {
+  return config->get<bool>(kAdaptiveCoalesce, false);
+}
+
+// static.
+int32_t HiveConfig::decompressedPageCacheMinReadPct(const Config* config) {
+  return config->get<int32_t>(
+      kDecompressedPageCacheMinReadPct,
+      io::ReaderOptions::kNoDecompressedPageCache);
+}
+
 // static.
 int32_t HiveConfig::numCacheFileHandles(const Config* config) {
   return config->get<int32_t>(kNumCacheFileHandles, 20'000);
 }
 
+// static.
+bool HiveConfig::localFileMmap(const Config* config) {
+  return config->get<bool>(kLocalFileMmap, false);
+}
+
+// static.
+bool HiveConfig::hedgedReads(const Config* config) {
+  return config->get<bool>(kHedgedReads, false);
+}
+
+// static.
+int32_t HiveConfig::hedgedReadsMaxExtraPct(const Config* config) {
+  return config->get<int32_t>(kHedgedReadsMaxExtraPct, 5);
+}
+
+// static.
+double HiveConfig::ioSchedulingWeight(const Config* config) {
+  return config->get<double>(kIoSchedulingWeight, 1.0);
+}
+
+// static.
+bool HiveConfig::parquetNativeWriter(const Config* config) {
+  return config->get<bool>(kParquetNativeWriter, false);
+}
+
+// static.
+bool HiveConfig::writerParallelEncoding(const Config* config) {
+  return config->get<bool>(kWriterParallelEncoding, false);
+}
+
+// static.
+bool HiveConfig::writerBackgroundFlush(const Config* config) {
+  return config->get<bool>(kWriterBackgroundFlush, false);
+}
+
 uint64_t HiveConfig::fileWriterFlushThresholdBytes(const Config* config) {
   return config->get<int32_t>(kFileWriterFlushThresholdBytes, 96L << 20);
 }
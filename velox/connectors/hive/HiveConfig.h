@@ -104,9 +104,53 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceBytes =
       "max-coalesced-distance-bytes";
 
+  /// Derives the coalesce distance and bytes from the measured latency and
+  /// throughput of the file system. 'max-coalesced-bytes' stays an upper
+  /// bound.
+  static constexpr const char* kAdaptiveCoalesce = "adaptive-coalesce";
+
+  /// Caches decompressed pages of streams that are read in at least this
+  /// percentage of the scans that reference them. -1 disables the
+  /// decompressed page cache.
+  static constexpr const char* kDecompressedPageCacheMinReadPct =
+      "decompressed-page-cache-min-read-pct";
+
+  /// Duplicates reads of remote files that are slower than the 95th
+  /// percentile of their file system and uses the first to complete.
+  static constexpr const char* kHedgedReads = "hedged-reads";
+
+  /// Maximum number of duplicate reads as a percentage of the reads.
+  static constexpr const char* kHedgedReadsMaxExtraPct =
+      "hedged-reads-max-extra-pct";
+
+  /// Share of the storage bandwidth of a query relative to other queries when
+  /// the process has an IoScheduler.
+  static constexpr const char* kIoSchedulingWeight = "io-scheduling-weight";
+
   /// Maximum number of entries in the file handle cache.
   static constexpr const char* kNumCacheFileHandles = "num_cached_file_handles";
 
+  /// Maps local files into memory and decodes them from the page cache
+  /// without copying. Applies only when there is no AsyncDataCache. Files
+  /// must not be truncated while a query reads them, since reading a mapped
+  /// page past the end of the truncated file raises SIGBUS.
+  static constexpr const char* kLocalFileMmap = "local-file-mmap";
+
+  /// Writes Parquet files with the native writer, which encodes Velox vectors
+  /// without converting them to Arrow. Supports top level columns of
+  /// primitive types.
+  static constexpr const char* kParquetNativeWriter = "parquet-native-writer";
+
+  /// Encodes and compresses the columns of a written file in parallel on the
+  /// connector executor. Applies to the DWRF and the native Parquet writers.
+  static constexpr const char* kWriterParallelEncoding =
+      "writer-parallel-encoding";
+
+  /// Writes flushed stripes to storage on the connector executor while the
+  /// DWRF writer encodes the next stripe.
+  static constexpr const char* kWriterBackgroundFlush =
+      "writer-background-flush";
+
   /// The memory arbitrator might flush a file write to reclaim used memory if
   /// its buffered data size is no less than this minimum threshold. The
   /// buffered data size is measured by a file writer's memory footprint.
@@ -163,8 +207,26 @@ class HiveConfig {
 
   static int32_t maxCoalescedDistanceBytes(const Config* config);
 
+  static bool adaptiveCoalesce(const Config* config);
+
+  static int32_t decompressedPageCacheMinReadPct(const Config* config);
+
   static int32_t numCacheFileHandles(const Config* config);
 
+  static bool localFileMmap(const Config* config);
+
+  static bool hedgedReads(const Config* config);
+
+  static int32_t hedgedReadsMaxExtraPct(const Config* config);
+
+  static double ioSchedulingWeight(const Config* config);
+
+  static bool parquetNativeWriter(const Config* config);
+
+  static bool writerParallelEncoding(const Config* config);
+
+  static bool writerBackgroundFlush(const Config* config);
+
   static uint64_t fileWriterFlushThresholdBytes(const Config* config);
 
   static uint64_t getOrcWriterMaxStripeSize(
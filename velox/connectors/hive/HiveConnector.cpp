@@ -38,6 +38,8 @@
 #include "velox/dwio/parquet/RegisterParquetReader.h" // @manual
 #include "velox/dwio/parquet/RegisterParquetWriter.h" // @manual
 #endif
+#include "velox/dwio/json/RegisterJsonReader.h"
+#include "velox/dwio/text/RegisterTextReader.h"
 #include "velox/expression/FieldReference.h"
 
 #include <boost/lexical_cast.hpp>
@@ -80,6 +82,13 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       HiveConfig::maxCoalescedBytes(connectorQueryCtx->config()));
   options.setMaxCoalesceDistance(
       HiveConfig::maxCoalescedDistanceBytes(connectorQueryCtx->config()));
+  options.setAdaptiveCoalesce(
+      HiveConfig::adaptiveCoalesce(connectorQueryCtx->config()));
+  options.setDecompressedPageCacheMinReadPct(
+      HiveConfig::decompressedPageCacheMinReadPct(connectorQueryCtx->config()));
+  options.setIoSchedulingGroup(connectorQueryCtx->queryId());
+  options.setIoSchedulingWeight(
+      HiveConfig::ioSchedulingWeight(connectorQueryCtx->config()));
   options.setFileColumnNamesReadAsLowerCase(
       HiveConfig::isFileColumnNamesReadAsLowerCase(
           connectorQueryCtx->config()));
@@ -112,7 +121,8 @@ std::unique_ptr<DataSink> HiveConnector::createDataSink(
       hiveInsertHandle,
       connectorQueryCtx,
       commitStrategy,
-      connectorProperties());
+      connectorProperties(),
+      executor_);
 }
 
 std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
@@ -140,6 +150,8 @@ void HiveConnectorFactory::initialize() {
     dwio::common::registerFileSinks();
     dwrf::registerDwrfReaderFactory();
     dwrf::registerDwrfWriterFactory();
+    text::registerTextReaderFactory();
+    json::registerJsonReaderFactory();
 // Meta's buck build system needs this check.
 #ifdef VELOX_ENABLE_PARQUET
     parquet::registerParquetReaderFactory();
@@ -294,7 +294,8 @@ HiveDataSink::HiveDataSink(
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
     const ConnectorQueryCtx* connectorQueryCtx,
     CommitStrategy commitStrategy,
-    const std::shared_ptr<const Config>& connectorProperties)
+    const std::shared_ptr<const Config>& connectorProperties,
+    folly::Executor* FOLLY_NULLABLE executor)
     : inputType_(std::move(inputType)),
       insertTableHandle_(std::move(insertTableHandle)),
       connectorQueryCtx_(connectorQueryCtx),
@@ -321,7 +322,8 @@ HiveDataSink::HiveDataSink(
                        : nullptr),
       writerFactory_(dwio::common::getWriterFactory(
           insertTableHandle_->tableStorageFormat())),
-      spillConfig_(connectorQueryCtx->spillConfig()) {
+      spillConfig_(connectorQueryCtx->spillConfig()),
+      executor_(executor) {
   VELOX_USER_CHECK(
       !isBucketed() || isPartitioned(), "A bucket table must be partitioned");
   if (isBucketed()) {
@@ -553,6 +555,14 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   options.maxDictionaryMemory =
       std::optional(HiveConfig::getOrcWriterMaxDictionaryMemory(
           connectorQueryCtx_->config(), connectorProperties_.get()));
+  options.parquetNativeWriter =
+      HiveConfig::parquetNativeWriter(connectorProperties_.get());
+  if (HiveConfig::writerParallelEncoding(connectorProperties_.get())) {
+    options.encodingExecutor = executor_;
+  }
+  if (HiveConfig::writerBackgroundFlush(connectorProperties_.get())) {
+    options.flushExecutor = executor_;
+  }
   ioStats_.emplace_back(std::make_shared<io::IoStatistics>());
   auto writer = writerFactory_->createWriter(
       dwio::common::FileSink::create(
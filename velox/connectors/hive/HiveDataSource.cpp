@@ -20,6 +20,7 @@
 #include <unordered_map>
 
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/dwio/common/MmapBufferedInput.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/expression/FieldReference.h"
@@ -548,6 +549,7 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   }
 
   auto fileHandle = fileHandleFactory_->generate(split_->filePath).second;
+  readerOpts_.setFileMetadataCacheKey(fileHandle->metadataCacheKey);
   auto input = createBufferedInput(*fileHandle, readerOpts_);
 
   if (splitReader_) {
@@ -667,6 +669,12 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
        {"numRamRead", RuntimeCounter(ioStats_->ramHit().count())},
        {"ramReadBytes",
         RuntimeCounter(ioStats_->ramHit().sum(), RuntimeCounter::Unit::kBytes)},
+       {"numDecompressedPageHit",
+        RuntimeCounter(ioStats_->decompressedPageHit().count())},
+       {"decompressedPageHitBytes",
+        RuntimeCounter(
+            ioStats_->decompressedPageHit().sum(),
+            RuntimeCounter::Unit::kBytes)},
        {"totalScanTime",
         RuntimeCounter(
             ioStats_->totalScanTime(), RuntimeCounter::Unit::kNanos)},
@@ -679,6 +687,24 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)},
        {"queryThreadIoLatency",
         RuntimeCounter(ioStats_->queryThreadIoLatency().count())}});
+  if (const auto count = ioStats_->coalesceMaxGap().count()) {
+    res.insert(
+        {{"coalesceMaxGap",
+          RuntimeCounter(
+              ioStats_->coalesceMaxGap().sum() / count,
+              RuntimeCounter::Unit::kBytes)},
+         {"coalesceMaxBytes",
+          RuntimeCounter(
+              ioStats_->coalesceMaxBytes().sum() / count,
+              RuntimeCounter::Unit::kBytes)}});
+  }
+  if (ioStats_->ioQueueTime().count() > 0) {
+    res.insert(
+        {"ioQueueWaitNanos",
+         RuntimeCounter(
+             ioStats_->ioQueueTime().sum() * 1000,
+             RuntimeCounter::Unit::kNanos)});
+  }
   return res;
 }
 
@@ -799,6 +825,14 @@ HiveDataSource::createBufferedInput(
         executor_,
         readerOpts);
   }
+  if (auto mmapFile =
+          std::dynamic_pointer_cast<MmapReadFile>(fileHandle.file)) {
+    return std::make_unique<dwio::common::MmapBufferedInput>(
+        std::move(mmapFile),
+        readerOpts.getMemoryPool(),
+        dwio::common::MetricsLog::voidLog(),
+        ioStats_.get());
+  }
   return std::make_unique<dwio::common::BufferedInput>(
       fileHandle.file,
       readerOpts.getMemoryPool(),
@@ -17,9 +17,11 @@
 #include <gtest/gtest.h>
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/core/Config.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -34,6 +36,23 @@ using namespace facebook::velox::exec::test;
 
 constexpr const char* kHiveConnectorId = "test-hive";
 
+// Counts the tasks the writers run on the connector executor.
+class CountingExecutor : public folly::Executor {
+ public:
+  void add(folly::Func func) override {
+    ++numTasks_;
+    executor_.add(std::move(func));
+  }
+
+  int32_t numTasks() const {
+    return numTasks_;
+  }
+
+ private:
+  std::atomic<int32_t> numTasks_{0};
+  folly::CPUThreadPoolExecutor executor_{4};
+};
+
 class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
  protected:
   void SetUp() override {
@@ -118,7 +137,8 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
       const std::vector<std::string>& partitionedBy = {},
       const std::shared_ptr<connector::hive::HiveBucketProperty>&
-          bucketProperty = nullptr) {
+          bucketProperty = nullptr,
+      folly::Executor* executor = nullptr) {
     return std::make_shared<HiveDataSink>(
         rowType,
         createHiveInsertTableHandle(
@@ -129,7 +149,8 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
             bucketProperty),
         connectorQueryCtx_.get(),
         CommitStrategy::kNoCommit,
-        connectorConfig_);
+        connectorConfig_,
+        executor);
   }
 
   std::vector<std::string> listFiles(const std::string& dirPath) {
@@ -464,6 +485,49 @@ TEST_F(HiveDataSinkTest, basic) {
   verifyWrittenData(outputDirectory->path);
 }
 
+TEST_F(HiveDataSinkTest, writerExecutor) {
+  for (const auto* config :
+       {HiveConfig::kWriterBackgroundFlush,
+        HiveConfig::kWriterParallelEncoding}) {
+    SCOPED_TRACE(config);
+    setConnectorConfig({{config, "true"}});
+    setConnectorQueryContext(std::make_unique<connector::ConnectorQueryCtx>(
+        opPool_.get(),
+        connectorPool_.get(),
+        connectorConfig_.get(),
+        nullptr,
+        nullptr,
+        nullptr,
+        "query.HiveDataSinkTest",
+        "task.HiveDataSinkTest",
+        "planNodeId.HiveDataSinkTest",
+        0));
+    CountingExecutor executor;
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType_,
+        outputDirectory->path,
+        dwio::common::FileFormat::DWRF,
+        {},
+        nullptr,
+        &executor);
+
+    VectorFuzzer::Options options;
+    options.vectorSize = 500;
+    VectorFuzzer fuzzer(options, pool());
+    std::vector<RowVectorPtr> vectors;
+    for (int i = 0; i < 10; ++i) {
+      vectors.push_back(fuzzer.fuzzRow(rowType_));
+      dataSink->appendData(vectors.back());
+    }
+    ASSERT_EQ(dataSink->close(true).size(), 1);
+    ASSERT_GT(executor.numTasks(), 0);
+
+    createDuckDbTable(vectors);
+    verifyWrittenData(outputDirectory->path);
+  }
+}
+
 TEST_F(HiveDataSinkTest, close) {
   for (bool empty : {true, false}) {
     SCOPED_TRACE(fmt::format("Data sink is empty: {}", empty));
@@ -162,6 +162,65 @@ std::vector<folly::Range<char*>> makeRanges(
   return buffers;
 }
 } // namespace
+
+bool CacheInputStream::readDecompressedPage(
+    uint64_t offset,
+    const std::function<char*(int32_t size)>& allocate) {
+  if (decompressedPageCacheMinReadPct_ < 0) {
+    return false;
+  }
+  auto pin = cache_->find(
+      cache::decompressedPageKey(fileNum_, region_.offset + offset));
+  if (pin.empty()) {
+    return false;
+  }
+  auto* entry = pin.checkedEntry();
+  auto* buffer = allocate(entry->size());
+  for (auto& range : makeRanges(entry, entry->size())) {
+    ::memcpy(buffer, range.data(), range.size());
+    buffer += range.size();
+  }
+  ioStats_->decompressedPageHit().increment(entry->size());
+  return true;
+}
+
+void CacheInputStream::cacheDecompressedPage(
+    uint64_t offset,
+    std::string_view page) {
+  if (decompressedPageCacheMinReadPct_ < 0 || tracker_ == nullptr ||
+      page.empty() ||
+      !tracker_->isFrequentlyRead(
+          trackingId_, decompressedPageCacheMinReadPct_)) {
+    return;
+  }
+  cache::CachePin pin;
+  try {
+    pin = cache_->findOrCreate(
+        cache::decompressedPageKey(fileNum_, region_.offset + offset),
+        page.size());
+  } catch (const VeloxRuntimeError& e) {
+    // Decompressed pages are an optimization. Do not fail the read if the
+    // cache is full of pinned data.
+    if (e.errorCode() == error_code::kNoCacheSpace) {
+      return;
+    }
+    throw;
+  }
+  // The page is being or has been added by another thread.
+  if (pin.empty() || !pin.checkedEntry()->isExclusive()) {
+    return;
+  }
+  auto* entry = pin.checkedEntry();
+  entry->setGroupId(groupId_);
+  entry->setTrackingId(trackingId_);
+  auto* data = page.data();
+  for (auto& range : makeRanges(entry, page.size())) {
+    ::memcpy(range.data(), data, range.size());
+    data += range.size();
+  }
+  entry->setExclusiveToShared();
+}
+
 void CacheInputStream::loadSync(Region region) {
   // rawBytesRead is the number of bytes touched. Whether they come
   // from disk, ssd or memory is itemized in different counters. A
@@ -213,6 +272,8 @@ void CacheInputStream::loadSync(Region region) {
       uint64_t usec = 0;
       {
         MicrosecondTimer timer(&usec);
+        auto ticket = bufferedInput_->scheduleIo(
+            region.length, io::IoScheduler::Priority::kBlocking);
         input_->read(ranges, region.offset, LogType::FILE);
       }
       ioStats_->read().increment(region.length);
@@ -20,6 +20,7 @@
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/io/IoStatistics.h"
+#include "velox/common/io/Options.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 
@@ -48,6 +49,17 @@ class CacheInputStream : public SeekableInputStream {
   std::string getName() const override;
   size_t positionSize() override;
 
+  /// Returns the decompressed page if it is in 'cache_'. Pages are found
+  /// regardless of the admission criteria, so that a scan benefits from pages
+  /// cached by earlier scans.
+  bool readDecompressedPage(
+      uint64_t offset,
+      const std::function<char*(int32_t size)>& allocate) override;
+
+  /// Adds 'page' to 'cache_' if decompressed page caching is enabled and the
+  /// stream is frequently read according to 'tracker_'.
+  void cacheDecompressedPage(uint64_t offset, std::string_view page) override;
+
   /// Returns a copy of 'this', ranging over the same bytes. The clone
   /// is initially positioned at the position of 'this' and can be
   /// moved independently within 'region_'.  This is used for first
@@ -70,6 +82,7 @@ class CacheInputStream : public SeekableInputStream {
         groupId_,
         loadQuantum_);
     copy->position_ = position_;
+    copy->decompressedPageCacheMinReadPct_ = decompressedPageCacheMinReadPct_;
     return copy;
   }
 
@@ -96,6 +109,12 @@ class CacheInputStream : public SeekableInputStream {
     noRetention_ = true;
   }
 
+  /// Enables caching decompressed pages of streams read at least 'pct' % of
+  /// the times they are referenced. See io::ReaderOptions.
+  void setDecompressedPageCacheMinReadPct(int32_t pct) {
+    decompressedPageCacheMinReadPct_ = pct;
+  }
+
  private:
   // Ensures that the current position is covered by 'pin_'.
   void loadPosition();
@@ -158,6 +177,11 @@ class CacheInputStream : public SeekableInputStream {
   // unpinning. This applies to sequential reads where a second access
   // to the page is not expected.
   bool noRetention_{false};
+
+  // Minimum read percentage for admitting decompressed pages to 'cache_'.
+  // Negative means decompressed pages are not cached.
+  int32_t decompressedPageCacheMinReadPct_{
+      io::ReaderOptions::kNoDecompressedPageCache};
 };
 
 } // namespace facebook::velox::dwio::common
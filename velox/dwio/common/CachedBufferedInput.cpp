@@ -15,8 +15,10 @@
  */
 
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include <folly/executors/QueuedImmediateExecutor.h>
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DEFINE_int32(
@@ -65,6 +67,8 @@ std::unique_ptr<SeekableInputStream> CachedBufferedInput::enqueue(
       id,
       groupId_,
       options_.loadQuantum());
+  stream->setDecompressedPageCacheMinReadPct(
+      options_.decompressedPageCacheMinReadPct());
   requests_.back().stream = stream.get();
   return stream;
 }
@@ -218,7 +222,10 @@ void CachedBufferedInput::makeLoads(
     return;
   }
   bool isSsd = !requests[0]->ssdPin.empty();
-  int32_t maxDistance = isSsd ? 20000 : options_.maxCoalesceDistance();
+  const auto params = isSsd
+      ? io::CoalesceParams{20000, options_.maxCoalesceBytes()}
+      : coalesceParams();
+  const int32_t maxDistance = params.maxGap;
   std::sort(
       requests.begin(),
       requests.end(),
@@ -248,7 +255,7 @@ void CachedBufferedInput::makeLoads(
         return size;
       },
       [&](int32_t index) {
-        if (coalescedBytes > options_.maxCoalesceBytes()) {
+        if (coalescedBytes > params.maxBytes) {
           coalescedBytes = 0;
           return kNoCoalesce;
         }
@@ -264,7 +271,7 @@ void CachedBufferedInput::makeLoads(
           uint64_t /*offset*/,
           const std::vector<CacheRequest*>& ranges) {
         ++numNewLoads;
-        readRegion(ranges, prefetch);
+        readRegion(ranges, prefetch, maxDistance);
       });
   if (prefetch && executor_) {
     std::vector<int32_t> doneIndices;
@@ -381,10 +388,16 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
       std::vector<CacheRequest*> requests,
-      int32_t maxCoalesceDistance)
+      int32_t maxCoalesceDistance,
+      io::CoalesceTuner* tuner,
+      std::string ioSchedulingGroup,
+      double ioSchedulingWeight)
       : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)),
         input_(std::move(input)),
-        maxCoalesceDistance_(maxCoalesceDistance) {}
+        maxCoalesceDistance_(maxCoalesceDistance),
+        tuner_(tuner),
+        ioSchedulingGroup_(std::move(ioSchedulingGroup)),
+        ioSchedulingWeight_(ioSchedulingWeight) {}
 
   std::vector<CachePin> loadData(bool isPrefetch) override {
     std::vector<CachePin> pins;
@@ -401,24 +414,82 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     if (pins.empty()) {
       return pins;
     }
-    auto stats = cache::readPins(
-        pins,
-        maxCoalesceDistance_,
-        1000,
-        [&](int32_t i) { return pins[i].entry()->offset(); },
-        [&](const std::vector<CachePin>& /*pins*/,
-            int32_t /*begin*/,
-            int32_t /*end*/,
-            uint64_t offset,
-            const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
-        });
+    // Waits for the IoScheduler, if any, to admit the load. A load run by a
+    // driver has priority over one started by prefetch.
+    auto ticket = io::IoScheduler::schedule(
+        ioSchedulingGroup_,
+        ioSchedulingWeight_,
+        size_,
+        isPrefetch ? io::IoScheduler::Priority::kPrefetch
+                   : io::IoScheduler::Priority::kBlocking,
+        ioStats_.get());
+    // If the file reads asynchronously, the coalesced reads are all started
+    // before waiting for any, so that one thread keeps them all in flight.
+    std::vector<folly::Future<uint64_t>> asyncReads;
+    const bool readAsync = input_->hasReadAsync();
+    CoalesceIoStats stats;
+    try {
+      stats = cache::readPins(
+          pins,
+          maxCoalesceDistance_,
+          1000,
+          [&](int32_t i) { return pins[i].entry()->offset(); },
+          [&](const std::vector<CachePin>& /*pins*/,
+              int32_t /*begin*/,
+              int32_t /*end*/,
+              uint64_t offset,
+              const std::vector<folly::Range<char*>>& buffers) {
+            if (readAsync) {
+              // Each read is timed from its submission to its completion.
+              const auto submitMicros = getCurrentTimeMicro();
+              asyncReads.push_back(
+                  input_->readAsync(buffers, offset, LogType::FILE)
+                      .via(&folly::QueuedImmediateExecutor::instance())
+                      .thenValue([tuner = tuner_,
+                                  bytes = ioSize(buffers),
+                                  submitMicros](uint64_t size) {
+                        if (tuner != nullptr) {
+                          tuner->recordIo(
+                              bytes, getCurrentTimeMicro() - submitMicros);
+                        }
+                        return size;
+                      }));
+              return;
+            }
+            uint64_t micros = 0;
+            {
+              MicrosecondTimer timer(&micros);
+              input_->read(buffers, offset, LogType::FILE);
+            }
+            if (tuner_ != nullptr) {
+              tuner_->recordIo(ioSize(buffers), micros);
+            }
+          });
+    } catch (const std::exception&) {
+      // The reads in flight write into 'pins'.
+      folly::collectAll(std::move(asyncReads)).wait();
+      throw;
+    }
+    for (auto& result : folly::collectAll(std::move(asyncReads)).get()) {
+      result.value();
+    }
     updateStats(stats, isPrefetch, false);
     return pins;
   }
 
+  static uint64_t ioSize(const std::vector<folly::Range<char*>>& buffers) {
+    uint64_t size = 0;
+    for (const auto& buffer : buffers) {
+      size += buffer.size();
+    }
+    return size;
+  }
+
   std::shared_ptr<ReadFileInputStream> input_;
   const int32_t maxCoalesceDistance_;
+  io::CoalesceTuner* const tuner_;
+  const std::string ioSchedulingGroup_;
+  const double ioSchedulingWeight_;
 };
 
 // Represents a CoalescedLoad from local SSD cache.
@@ -432,8 +503,19 @@ class SsdLoad : public DwioCoalescedLoadBase {
       : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)) {}
 
   std::vector<CachePin> loadData(bool isPrefetch) override {
-    std::vector<SsdPin> ssdPins;
-    std::vector<CachePin> pins;
+    return loadDataAsync(isPrefetch).get();
+  }
+
+  // Submits the reads and returns without waiting for them if the SsdFile
+  // reads through io_uring, so that a prefetch does not hold its thread.
+  folly::SemiFuture<std::vector<CachePin>> loadDataAsync(
+      bool isPrefetch) override {
+    // The pins must stay live until the reads into them are complete.
+    struct Pins {
+      std::vector<SsdPin> ssdPins;
+      std::vector<CachePin> pins;
+    };
+    auto pins = std::make_shared<Pins>();
     cache_.makePins(
         keys_,
         [&](int32_t index) { return sizes_[index]; },
@@ -441,16 +523,20 @@ class SsdLoad : public DwioCoalescedLoadBase {
           if (isPrefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
-          pins.push_back(std::move(pin));
-          ssdPins.push_back(std::move(requests_[index].ssdPin));
+          pins->pins.push_back(std::move(pin));
+          pins->ssdPins.push_back(std::move(requests_[index].ssdPin));
         });
-    if (pins.empty()) {
-      return pins;
+    if (pins->pins.empty()) {
+      return folly::makeSemiFuture(std::vector<CachePin>());
     }
-    assert(!ssdPins.empty()); // for lint.
-    auto stats = ssdPins[0].file()->load(ssdPins, pins);
-    updateStats(stats, isPrefetch, true);
-    return pins;
+    assert(!pins->ssdPins.empty()); // for lint.
+    return pins->ssdPins[0]
+        .file()
+        ->loadAsync(pins->ssdPins, pins->pins)
+        .deferValue([this, pins, isPrefetch](CoalesceIoStats stats) {
+          updateStats(stats, isPrefetch, true);
+          return std::move(pins->pins);
+        });
   }
 };
 
@@ -458,7 +544,8 @@ class SsdLoad : public DwioCoalescedLoadBase {
 
 void CachedBufferedInput::readRegion(
     std::vector<CacheRequest*> requests,
-    bool prefetch) {
+    bool prefetch,
+    int32_t maxCoalesceDistance) {
   if (requests.empty() || (requests.size() == 1 && !prefetch)) {
     return;
   }
@@ -472,7 +559,10 @@ void CachedBufferedInput::readRegion(
         ioStats_,
         groupId_,
         requests,
-        options_.maxCoalesceDistance());
+        maxCoalesceDistance,
+        tuner_,
+        options_.ioSchedulingGroup(),
+        options_.ioSchedulingWeight());
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
@@ -482,6 +572,20 @@ void CachedBufferedInput::readRegion(
   });
 }
 
+io::CoalesceParams CachedBufferedInput::coalesceParams() {
+  io::CoalesceParams params{
+      options_.maxCoalesceDistance(), options_.maxCoalesceBytes()};
+  if (tuner_ == nullptr) {
+    return params;
+  }
+  params = tuner_->params(params);
+  if (ioStats_) {
+    ioStats_->coalesceMaxGap().increment(params.maxGap);
+    ioStats_->coalesceMaxBytes().increment(params.maxBytes);
+  }
+  return params;
+}
+
 std::shared_ptr<cache::CoalescedLoad> CachedBufferedInput::coalescedLoad(
     const SeekableInputStream* stream) {
   return coalescedLoads_.withWLock(
@@ -21,6 +21,8 @@
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/SsdCache.h"
+#include "velox/common/io/CoalesceTuner.h"
+#include "velox/common/io/IoScheduler.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/common/io/Options.h"
 #include "velox/dwio/common/BufferedInput.h"
@@ -77,7 +79,8 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions),
+        tuner_(makeTuner()) {}
 
   CachedBufferedInput(
       std::shared_ptr<ReadFileInputStream> input,
@@ -96,7 +99,8 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions),
+        tuner_(makeTuner()) {}
 
   ~CachedBufferedInput() override {
     for (auto& load : allCoalescedLoads_) {
@@ -155,6 +159,20 @@ class CachedBufferedInput : public BufferedInput {
   std::shared_ptr<cache::CoalescedLoad> coalescedLoad(
       const SeekableInputStream* FOLLY_NONNULL stream);
 
+  /// Waits for the process-wide IoScheduler to admit a read of 'bytes' from
+  /// storage for the IO scheduling group of the reader options. The read is
+  /// to be made while the returned ticket is held.
+  io::IoScheduler::Ticket scheduleIo(
+      int64_t bytes,
+      io::IoScheduler::Priority priority) const {
+    return io::IoScheduler::schedule(
+        options_.ioSchedulingGroup(),
+        options_.ioSchedulingWeight(),
+        bytes,
+        priority,
+        ioStats_.get());
+  }
+
   folly::Executor* FOLLY_NULLABLE executor() const override {
     return executor_;
   }
@@ -173,7 +191,21 @@ class CachedBufferedInput : public BufferedInput {
   // on 'executor_'. Links the CoalescedLoad  to all CacheInputStreams that it
   // concerns.
 
-  void readRegion(std::vector<CacheRequest*> requests, bool prefetch);
+  void readRegion(
+      std::vector<CacheRequest*> requests,
+      bool prefetch,
+      int32_t maxCoalesceDistance);
+
+  // Returns the tuner for the file system of 'input_' if coalescing is
+  // adaptive, else nullptr.
+  io::CoalesceTuner* FOLLY_NULLABLE makeTuner() const {
+    return options_.adaptiveCoalesce()
+        ? &io::CoalesceTuner::forPath(input_->getName())
+        : nullptr;
+  }
+
+  // Returns the coalescing parameters for loads from storage.
+  io::CoalesceParams coalesceParams();
 
   cache::AsyncDataCache* FOLLY_NONNULL cache_;
   const uint64_t fileNum_;
@@ -197,6 +229,10 @@ class CachedBufferedInput : public BufferedInput {
   const uint64_t fileSize_;
   int64_t prefetchSize_{0};
   io::ReaderOptions options_;
+
+  // Learns coalescing parameters for storage loads. nullptr if coalescing is
+  // not adaptive.
+  io::CoalesceTuner* const FOLLY_NULLABLE tuner_;
 };
 
 } // namespace facebook::velox::dwio::common
@@ -463,6 +463,53 @@ class ColumnVisitor {
     numRows_ = newRows.size();
   }
 
+  // Processes 'numRows' rows starting at 'rowIndex_' that all have
+  // 'value'. Used from processRle for runs with no delta. 'passed'
+  // is the result of the filter on 'value', evaluated once for the
+  // whole run by the caller. If the run fails, its rows are skipped
+  // without expanding anything. Otherwise the row numbers are added to
+  // 'filterHits' if 'hasFilter' and 'value' is repeated into
+  // 'values'. The arguments are otherwise as in processRun. If all
+  // values of the read so far come from runs of the same value, tells
+  // 'reader_' so that it can produce a constant vector.
+  template <bool hasFilter, bool scatter>
+  void processConstantRun(
+      T value,
+      bool passed,
+      int32_t numRows,
+      const int32_t* scatterRows,
+      int32_t* filterHits,
+      T* values,
+      int32_t& numValues) {
+    constexpr bool kFilterOnly = std::is_same_v<Extract, DropValues>;
+    if (!passed) {
+      rowIndex_ += numRows;
+      return;
+    }
+    auto rows = (scatter ? scatterRows : rows_) + rowIndex_;
+    if (!hasFilter && scatter) {
+      for (auto i = 0; i < numRows; ++i) {
+        values[rows[i]] = value;
+      }
+      numValues = rows[numRows - 1] + 1;
+      rowIndex_ += numRows;
+      return;
+    }
+    if (hasFilter) {
+      std::copy(rows, rows + numRows, filterHits + numValues);
+    }
+    if (!kFilterOnly) {
+      if (!scatter && numValuesBias_ == 0 &&
+          reader_->constantRunValues() == numValues &&
+          (numValues == 0 || values[0] == value)) {
+        reader_->setConstantRunValues(numValues + numRows);
+      }
+      std::fill(values + numValues, values + numValues + numRows, value);
+    }
+    numValues += numRows;
+    rowIndex_ += numRows;
+  }
+
  protected:
   TFilter& filter_;
   SelectiveColumnReader* reader_;
@@ -942,6 +989,19 @@ class DictionaryColumnVisitor
       int32_t* filterHits,
       T* values,
       int32_t& numValues) {
+    if (delta == 0 && !hasHook && TFilter::deterministic &&
+        allInDict(numRows)) {
+      T valueInDictionary = dict()[value];
+      super::template processConstantRun<hasFilter, scatter>(
+          valueInDictionary,
+          !hasFilter || testCached(value, valueInDictionary),
+          numRows,
+          scatterRows,
+          filterHits,
+          values,
+          numValues);
+      return;
+    }
     auto indices = reinterpret_cast<typename make_index<T>::type*>(values);
     if (sizeof(T) == 8) {
       constexpr int32_t kWidth = xsimd::batch<int64_t>::size;
@@ -1058,6 +1118,30 @@ class DictionaryColumnVisitor
   }
 
  protected:
+  // True if the 'numRows' rows starting at 'rowIndex_' all refer to
+  // the dictionary, so that a run of the same index has one value.
+  bool allInDict(int32_t numRows) const {
+    return !inDict() ||
+        bits::isAllSet(
+               inDict(),
+               super::rows_[super::rowIndex_],
+               super::rows_[super::rowIndex_ + numRows - 1] + 1,
+               true);
+  }
+
+  // Returns the result of the filter on 'valueInDictionary', the
+  // dictionary entry at 'index'. Looks up and updates the filter cache.
+  bool testCached(typename make_index<T>::type index, T valueInDictionary) {
+    auto cached = filterCache()[index];
+    if (cached == FilterResult::kUnknown) {
+      cached = velox::common::applyFilter(super::filter_, valueInDictionary)
+          ? FilterResult::kSuccess
+          : FilterResult::kFailure;
+      filterCache()[index] = cached;
+    }
+    return cached == FilterResult::kSuccess;
+  }
+
   const uint64_t* inDict() const {
     return state_.inDictionary;
   }
@@ -1281,6 +1365,30 @@ class StringDictionaryColumnVisitor
       int32_t* filterHits,
       int32_t* values,
       int32_t& numValues) {
+    if (delta == 0 && !hasHook && TFilter::deterministic &&
+        DictSuper::allInDict(numRows)) {
+      bool passed = true;
+      if (hasFilter) {
+        auto cached = DictSuper::filterCache()[value];
+        if (cached == FilterResult::kUnknown) {
+          cached =
+              applyFilter(super::filter_, valueInDictionary(value, false))
+              ? FilterResult::kSuccess
+              : FilterResult::kFailure;
+          DictSuper::filterCache()[value] = cached;
+        }
+        passed = cached == FilterResult::kSuccess;
+      }
+      super::template processConstantRun<hasFilter, scatter>(
+          value,
+          passed,
+          numRows,
+          scatterRows,
+          filterHits,
+          values,
+          numValues);
+      return;
+    }
     constexpr int32_t kWidth = xsimd::batch<int32_t>::size;
     for (auto i = 0; i < numRows; i += kWidth) {
       ((xsimd::load_unaligned(super::rows_ + super::rowIndex_ + i) -
@@ -1441,6 +1549,17 @@ class DirectRleColumnVisitor
       int32_t* filterHits,
       T* values,
       int32_t& numValues) {
+    if (delta == 0 && !hasHook && TFilter::deterministic) {
+      super::template processConstantRun<hasFilter, scatter>(
+          value,
+          !hasFilter || velox::common::applyFilter(super::filter_, value),
+          numRows,
+          scatterRows,
+          filterHits,
+          values,
+          numValues);
+      return;
+    }
     if (sizeof(T) == 8) {
       constexpr int32_t kWidth = xsimd::batch<int64_t>::size;
       for (auto i = 0; i < numRows; i += kWidth) {
@@ -145,6 +145,7 @@ inline void processFixedFilter(
   }
 }
 
+struct DropValues;
 struct NoHook;
 
 template <
@@ -502,4 +503,104 @@ void processFixedWidthRun(
   }
 }
 
+// Finds the rows to read for the fast path of 'decoder' and calls
+// 'scan(rows, scatterRows)'. 'rows' are the rows of 'visitor' in terms of
+// non-null values of 'decoder'. If 'hasNulls', 'scatterRows' gives the
+// position of each of 'rows' in the rows of 'visitor', otherwise it is
+// nullptr. If all rows are null, sets the result of 'visitor' and does not
+// call 'scan'. Skips the non-null values of 'decoder' that follow the last row
+// of 'visitor' within 'nulls'. Shared by decoders with a bulk path.
+template <bool hasNulls, typename Decoder, typename Visitor, typename Scan>
+void fastPathRows(
+    Decoder& decoder,
+    const uint64_t* nulls,
+    Visitor& visitor,
+    Scan scan) {
+  constexpr bool hasFilter =
+      !std::is_same_v<typename Visitor::FilterType, velox::common::AlwaysTrue>;
+  constexpr bool hasHook =
+      !std::is_same_v<typename Visitor::HookType, NoHook>;
+  auto rows = visitor.rows();
+  auto numRows = visitor.numRows();
+  auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
+  if (!hasNulls) {
+    scan(rowsAsRange, static_cast<const int32_t*>(nullptr));
+    return;
+  }
+  auto& outerVector = visitor.outerNonNullRows();
+  // In non-DWRF formats, it can be the visitor is not dense but this run of
+  // rows is dense.
+  if (Visitor::dense || rowsAsRange.back() == rowsAsRange.size() - 1) {
+    nonNullRowsFromDense(nulls, numRows, outerVector);
+    if (outerVector.empty()) {
+      visitor.setAllNull(hasFilter ? 0 : numRows);
+      return;
+    }
+    scan(
+        folly::Range<const int32_t*>(rows, outerVector.size()),
+        outerVector.data());
+    return;
+  }
+  auto& innerVector = visitor.innerNonNullRows();
+  int32_t tailSkip = 0;
+  auto anyNulls = nonNullRowsFromSparse<hasFilter, !hasFilter && !hasHook>(
+      nulls,
+      rowsAsRange,
+      innerVector,
+      outerVector,
+      (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
+      tailSkip);
+  if (anyNulls) {
+    visitor.setHasNulls();
+  }
+  if (innerVector.empty()) {
+    decoder.template skip<false>(tailSkip, 0, nullptr);
+    visitor.setAllNull(hasFilter ? 0 : numRows);
+    return;
+  }
+  scan(folly::Range<const int32_t*>(innerVector), outerVector.data());
+  decoder.template skip<false>(tailSkip, 0, nullptr);
+}
+
+// Reads the values of 'rows' with bulkRead() or bulkReadRows() of 'decoder'
+// and passes them to the filter and hook of 'visitor'. 'rows' and
+// 'scatterRows' are from fastPathRows(). Sets the number of values of
+// 'visitor'.
+template <bool hasNulls, typename Decoder, typename Visitor>
+void bulkReadFixedWidth(
+    Decoder& decoder,
+    folly::Range<const int32_t*> rows,
+    const int32_t* scatterRows,
+    Visitor& visitor) {
+  using T = typename Visitor::DataType;
+  constexpr bool hasFilter =
+      !std::is_same_v<typename Visitor::FilterType, velox::common::AlwaysTrue>;
+  constexpr bool filterOnly =
+      std::is_same_v<typename Visitor::Extract, DropValues>;
+  constexpr bool hasHook =
+      !std::is_same_v<typename Visitor::HookType, NoHook>;
+  auto numRows = visitor.numRows();
+  auto data = visitor.rawValues(numRows);
+  if (rows.back() == rows.size() - 1) {
+    decoder.bulkRead(rows.size(), data);
+  } else {
+    decoder.bulkReadRows(rows, data);
+  }
+  if (!hasNulls && hasHook) {
+    scatterRows = velox::iota(numRows, visitor.innerNonNullRows());
+  }
+  int32_t numValues = 0;
+  processFixedWidthRun<T, filterOnly, hasNulls, Visitor::dense>(
+      rows,
+      0,
+      rows.size(),
+      scatterRows,
+      data,
+      hasFilter ? visitor.outputRows(numRows) : nullptr,
+      numValues,
+      visitor.filter(),
+      visitor.hook());
+  visitor.setNumValues(hasFilter ? numValues : numRows);
+}
+
 } // namespace facebook::velox::dwio::common
@@ -157,6 +157,16 @@ class DirectDecoder : public IntDecoder<isSigned> {
 
   template <bool hasNulls, typename Visitor>
   void fastPath(const uint64_t* FOLLY_NULLABLE nulls, Visitor& visitor) {
+    if (super::useVInts) {
+      fastPathRows<hasNulls>(
+          *this,
+          nulls,
+          visitor,
+          [&](folly::Range<const int32_t*> rows, const int32_t* scatterRows) {
+            bulkReadFixedWidth<hasNulls>(*this, rows, scatterRows, visitor);
+          });
+      return;
+    }
     using T = typename Visitor::DataType;
     constexpr bool hasFilter =
         !std::
@@ -165,119 +175,28 @@ class DirectDecoder : public IntDecoder<isSigned> {
         std::is_same_v<typename Visitor::Extract, DropValues>;
     constexpr bool hasHook =
         !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
-
-    int32_t numValues = 0;
-    auto rows = visitor.rows();
     auto numRows = visitor.numRows();
-    auto numNonNull = numRows;
-    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
-    auto data = visitor.rawValues(numRows);
-    if (hasNulls) {
-      int32_t tailSkip = 0;
-      raw_vector<int32_t>* innerVector = nullptr;
-      auto outerVector = &visitor.outerNonNullRows();
-      // In non-DWRF formats, it can be the visitor is not dense but
-      // this run of rows is dense.
-      if (Visitor::dense || rowsAsRange.back() == rowsAsRange.size() - 1) {
-        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
-        numNonNull = outerVector->size();
-        if (!numNonNull) {
-          visitor.setAllNull(hasFilter ? 0 : numRows);
-          return;
-        }
-      } else {
-        innerVector = &visitor.innerNonNullRows();
-        auto anyNulls = dwio::common::nonNullRowsFromSparse < hasFilter,
-             !hasFilter &&
-            !hasHook >
-                (nulls,
-                 rowsAsRange,
-                 *innerVector,
-                 *outerVector,
-                 (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
-                 tailSkip);
-        if (anyNulls) {
-          visitor.setHasNulls();
-        }
-        if (innerVector->empty()) {
-          skip<false>(tailSkip, 0, nullptr);
-          visitor.setAllNull(hasFilter ? 0 : numRows);
-          return;
-        }
-      }
-      if (super::useVInts) {
-        if (Visitor::dense) {
-          super::bulkRead(numNonNull, data);
-        } else {
-          super::bulkReadRows(*innerVector, data);
-        }
-        skip<false>(tailSkip, 0, nullptr);
-        auto dataRows = innerVector
-            ? folly::Range<const int*>(innerVector->data(), innerVector->size())
-            : folly::Range<const int32_t*>(rows, outerVector->size());
-        dwio::common::processFixedWidthRun<T, filterOnly, true, Visitor::dense>(
-            dataRows,
-            0,
-            dataRows.size(),
-            outerVector->data(),
-            data,
-            hasFilter ? visitor.outputRows(numRows) : nullptr,
-            numValues,
-            visitor.filter(),
-            visitor.hook());
-      } else {
-        dwio::common::fixedWidthScan<T, filterOnly, true>(
-            innerVector
-                ? folly::Range<const int32_t*>(*innerVector)
-                : folly::Range<const int32_t*>(rows, outerVector->size()),
-            outerVector->data(),
-            visitor.rawValues(numRows),
-            hasFilter ? visitor.outputRows(numRows) : nullptr,
-            numValues,
-            *super::inputStream,
-            super::bufferStart,
-            super::bufferEnd,
-            visitor.filter(),
-            visitor.hook());
-        skip<false>(tailSkip, 0, nullptr);
-      }
-    } else {
-      if (super::useVInts) {
-        if (Visitor::dense) {
-          super::bulkRead(numRows, visitor.rawValues(numRows));
-        } else {
-          super::bulkReadRows(
-              folly::Range<const int32_t*>(rows, numRows),
-              visitor.rawValues(numRows));
-        }
-        dwio::common::
-            processFixedWidthRun<T, filterOnly, false, Visitor::dense>(
-                rowsAsRange,
-                0,
-                rowsAsRange.size(),
-                hasHook ? velox::iota(numRows, visitor.innerNonNullRows())
-                        : nullptr,
-                visitor.rawValues(numRows),
-                hasFilter ? visitor.outputRows(numRows) : nullptr,
-                numValues,
-                visitor.filter(),
-                visitor.hook());
-      } else {
-        dwio::common::fixedWidthScan<T, filterOnly, false>(
-            rowsAsRange,
-            hasHook ? velox::iota(numRows, visitor.innerNonNullRows())
-                    : nullptr,
-            visitor.rawValues(numRows),
-            hasFilter ? visitor.outputRows(numRows) : nullptr,
-            numValues,
-            *super::inputStream,
-            super::bufferStart,
-            super::bufferEnd,
-            visitor.filter(),
-            visitor.hook());
-      }
-    }
-    visitor.setNumValues(hasFilter ? numValues : numRows);
+    fastPathRows<hasNulls>(
+        *this,
+        nulls,
+        visitor,
+        [&](folly::Range<const int32_t*> rows, const int32_t* scatterRows) {
+          int32_t numValues = 0;
+          dwio::common::fixedWidthScan<T, filterOnly, hasNulls>(
+              rows,
+              hasNulls || !hasHook
+                  ? scatterRows
+                  : velox::iota(numRows, visitor.innerNonNullRows()),
+              visitor.rawValues(numRows),
+              hasFilter ? visitor.outputRows(numRows) : nullptr,
+              numValues,
+              *super::inputStream,
+              super::bufferStart,
+              super::bufferEnd,
+              visitor.filter(),
+              visitor.hook());
+          visitor.setNumValues(hasFilter ? numValues : numRows);
+        });
   }
 };
 
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <fmt/format.h>
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+FileMetadataCache*& instance() {
+  static FileMetadataCache* cache{nullptr};
+  return cache;
+}
+} // namespace
+
+// static
+FileMetadataCache* FileMetadataCache::getInstance() {
+  return instance();
+}
+
+// static
+void FileMetadataCache::setInstance(FileMetadataCache* cache) {
+  instance() = cache;
+}
+
+// static
+std::string FileMetadataCache::makeKey(
+    const std::string& fileKey,
+    FileFormat format) {
+  return fmt::format("{}:{}", toString(format), fileKey);
+}
+
+std::shared_ptr<const void> FileMetadataCache::getImpl(
+    const std::string& fileKey,
+    FileFormat format) {
+  const auto key = makeKey(fileKey, format);
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numLookups_;
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  ++numHits_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->metadata;
+}
+
+void FileMetadataCache::put(
+    const std::string& fileKey,
+    FileFormat format,
+    std::shared_ptr<const void> metadata,
+    int64_t bytes) {
+  if (bytes > capacity_) {
+    return;
+  }
+  auto key = makeKey(fileKey, format);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    bytes_ -= it->second->bytes;
+    lru_.erase(it->second);
+    entries_.erase(it);
+  }
+  lru_.push_front(Entry{key, std::move(metadata), bytes});
+  entries_[std::move(key)] = lru_.begin();
+  bytes_ += bytes;
+  evictLocked();
+}
+
+void FileMetadataCache::evictLocked() {
+  while (bytes_ > capacity_ && !lru_.empty()) {
+    auto& entry = lru_.back();
+    bytes_ -= entry.bytes;
+    entries_.erase(entry.key);
+    lru_.pop_back();
+    ++numEvictions_;
+  }
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  bytes_ = 0;
+}
+
+FileMetadataCache::Stats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numEntries = entries_.size();
+  stats.bytes = bytes_;
+  stats.numLookups = numLookups_;
+  stats.numHits = numHits_;
+  stats.numEvictions = numEvictions_;
+  return stats;
+}
+
+} // namespace facebook::velox::dwio::common
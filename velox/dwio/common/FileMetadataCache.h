@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "velox/dwio/common/Options.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Process-wide cache of parsed file footers. Readers of the same file in
+/// different splits and queries share the parsed footer instead of reading
+/// and parsing it again. Entries are keyed by a string that identifies the
+/// file version, e.g. path and size, and by file format. The least recently
+/// used entries are evicted when the total size exceeds the capacity. Thread
+/// safe.
+class FileMetadataCache {
+ public:
+  struct Stats {
+    int64_t numEntries{0};
+    int64_t bytes{0};
+    int64_t numLookups{0};
+    int64_t numHits{0};
+    int64_t numEvictions{0};
+  };
+
+  /// Makes a cache holding up to 'capacity' bytes of metadata.
+  explicit FileMetadataCache(int64_t capacity) : capacity_(capacity) {}
+
+  /// Returns the process-wide cache or nullptr if there is none.
+  static FileMetadataCache* getInstance();
+
+  static void setInstance(FileMetadataCache* cache);
+
+  /// Returns the metadata of 'format' cached for 'fileKey' or nullptr if
+  /// there is none. The caller knows the type of the metadata for 'format'.
+  template <typename T>
+  std::shared_ptr<const T> get(const std::string& fileKey, FileFormat format) {
+    return std::static_pointer_cast<const T>(getImpl(fileKey, format));
+  }
+
+  /// Caches 'metadata' of 'format' for 'fileKey'. 'bytes' is the approximate
+  /// memory used by 'metadata'. Replaces any previous entry for the same key.
+  /// Does nothing if 'bytes' is larger than the capacity.
+  void put(
+      const std::string& fileKey,
+      FileFormat format,
+      std::shared_ptr<const void> metadata,
+      int64_t bytes);
+
+  void clear();
+
+  int64_t capacity() const {
+    return capacity_;
+  }
+
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const void> metadata;
+    int64_t bytes;
+  };
+
+  static std::string makeKey(const std::string& fileKey, FileFormat format);
+
+  std::shared_ptr<const void> getImpl(
+      const std::string& fileKey,
+      FileFormat format);
+
+  // Removes the least recently used entries until 'bytes_' is at most
+  // 'capacity_'.
+  void evictLocked();
+
+  const int64_t capacity_;
+
+  mutable std::mutex mutex_;
+
+  // Entries in order of use, most recent first.
+  std::list<Entry> lru_;
+
+  folly::F14FastMap<std::string, std::list<Entry>::iterator> entries_;
+
+  int64_t bytes_{0};
+  int64_t numLookups_{0};
+  int64_t numHits_{0};
+  int64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::dwio::common
@@ -15,7 +15,11 @@
  */
 
 #include "velox/dwio/common/IntDecoder.h"
+
+#include <map>
+
 #include "velox/common/base/SimdUtil.h"
+#include "velox/common/process/ProcessBase.h"
 #include "velox/dwio/common/DirectDecoder.h"
 
 namespace facebook::velox::dwio::common {
@@ -912,6 +916,221 @@ FOLLY_ALWAYS_INLINE void varintSwitch(
   }
 }
 
+#if XSIMD_WITH_AVX2
+
+namespace {
+
+// Number of bytes whose continuation bits select a shuffle for decoding
+// varints with SIMD.
+constexpr int32_t kMaskedVarintBytes = 12;
+
+// Describes the decoding of the varints at the start of 16 bytes of data for
+// one combination of continuation bits of the first 'kMaskedVarintBytes'.
+struct MaskedVarintEntry {
+  // Index of the shuffle in MaskedVarintTable::shuffles.
+  uint16_t shuffle{0};
+  // Number of varints decoded. 0 if the first varint has more than 3 bytes.
+  uint8_t numValues{0};
+  // Total size of the decoded varints.
+  uint8_t numBytes{0};
+  // True if the varints are shuffled into 32 bit lanes, false for 16 bit
+  // lanes.
+  bool wide{false};
+};
+
+// Lookup tables for decoding varints in the style of Masked VByte (Plaisance,
+// Kurz and Lemire). The continuation bits of the first 12 bytes of data select
+// a shuffle that moves the bytes of the leading varints into 16 bit lanes if
+// these have at most 2 bytes, or into 32 bit lanes if they have at most 3
+// bytes, whichever decodes more varints.
+struct MaskedVarintTable {
+  MaskedVarintTable() {
+    std::map<std::array<int8_t, 16>, uint16_t> shuffleIndices;
+    for (uint32_t mask = 0; mask < entries.size(); ++mask) {
+      std::vector<int32_t> lengths;
+      int32_t length = 0;
+      for (auto i = 0; i < kMaskedVarintBytes; ++i) {
+        ++length;
+        if ((mask & (1 << i)) == 0) {
+          lengths.push_back(length);
+          length = 0;
+        }
+      }
+      auto countLeading = [&](int32_t maxLength, int32_t maxValues) {
+        int32_t count = 0;
+        while (count < static_cast<int32_t>(lengths.size()) &&
+               count < maxValues && lengths[count] <= maxLength) {
+          ++count;
+        }
+        return count;
+      };
+      const auto numShort = countLeading(2, 8);
+      const auto numWide = countLeading(3, 4);
+      auto& entry = entries[mask];
+      entry.wide = numWide > numShort;
+      entry.numValues = entry.wide ? numWide : numShort;
+      if (entry.numValues == 0) {
+        continue;
+      }
+      const int32_t laneSize = entry.wide ? 4 : 2;
+      std::array<int8_t, 16> shuffle;
+      shuffle.fill(-1);
+      int32_t offset = 0;
+      for (auto i = 0; i < entry.numValues; ++i) {
+        for (auto j = 0; j < lengths[i]; ++j) {
+          shuffle[i * laneSize + j] = offset++;
+        }
+      }
+      entry.numBytes = offset;
+      auto it = shuffleIndices.find(shuffle);
+      if (it == shuffleIndices.end()) {
+        it = shuffleIndices.emplace(shuffle, shuffles.size()).first;
+        shuffles.push_back(shuffle);
+      }
+      entry.shuffle = it->second;
+    }
+  }
+
+  std::array<MaskedVarintEntry, 1 << kMaskedVarintBytes> entries;
+  std::vector<std::array<int8_t, 16>> shuffles;
+};
+
+const MaskedVarintTable& maskedVarintTable() {
+  static const MaskedVarintTable table;
+  return table;
+}
+
+// Decodes up to 'maxValues' varints at 'pos' into 'output' while there are at
+// least 16 bytes before 'end'. Advances 'pos' past the decoded varints and
+// returns their count. May write up to 16 values at 'output' but never past
+// output + maxValues. Stops before a varint that does not end within 16
+// bytes.
+template <typename T>
+int32_t decodeMaskedVarints(
+    const char*& pos,
+    const char* end,
+    T* output,
+    int32_t maxValues) {
+  const auto& table = maskedVarintTable();
+  int32_t numValues = 0;
+  while (end - pos >= 16 && maxValues - numValues >= 8) {
+    const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+    const uint32_t continuation = _mm_movemask_epi8(data);
+    if (continuation == 0 && maxValues - numValues >= 16) {
+      // 16 single byte varints.
+      for (auto i = 0; i < 16; ++i) {
+        output[i] = static_cast<uint8_t>(pos[i]);
+      }
+      pos += 16;
+      output += 16;
+      numValues += 16;
+      continue;
+    }
+    const auto& entry = table.entries[continuation & 0xfff];
+    if (entry.numValues == 0) {
+      // The first varint has more than 3 bytes.
+      const int32_t size = __builtin_ctz(~continuation) + 1;
+      if (size > folly::kMaxVarintLength64) {
+        break;
+      }
+      uint64_t value = bits::extractBits<uint64_t>(
+          folly::loadUnaligned<uint64_t>(pos),
+          0x7f7f7f7f7f7f7f7fULL >> (8 * (8 - std::min(size, 8))));
+      if (size > 8) {
+        value |= static_cast<uint64_t>(pos[8] & 0x7f) << 56;
+        if (size > 9) {
+          value |= static_cast<uint64_t>(pos[9] & 0x7f) << 63;
+        }
+      }
+      *output++ = value;
+      pos += size;
+      ++numValues;
+      continue;
+    }
+    const auto shuffled = _mm_shuffle_epi8(
+        data,
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+            table.shuffles[entry.shuffle].data())));
+    if (entry.wide) {
+      alignas(16) uint32_t values[4];
+      const auto low = _mm_and_si128(shuffled, _mm_set1_epi32(0x7f));
+      const auto middle = _mm_srli_epi32(
+          _mm_and_si128(shuffled, _mm_set1_epi32(0x7f00)), 1);
+      const auto high = _mm_srli_epi32(
+          _mm_and_si128(shuffled, _mm_set1_epi32(0x7f0000)), 2);
+      _mm_store_si128(
+          reinterpret_cast<__m128i*>(values),
+          _mm_or_si128(low, _mm_or_si128(middle, high)));
+      for (auto i = 0; i < 4; ++i) {
+        output[i] = values[i];
+      }
+    } else {
+      alignas(16) uint16_t values[8];
+      const auto low = _mm_and_si128(shuffled, _mm_set1_epi16(0x7f));
+      const auto high = _mm_srli_epi16(
+          _mm_and_si128(shuffled, _mm_set1_epi16(0x7f00)), 1);
+      _mm_store_si128(
+          reinterpret_cast<__m128i*>(values), _mm_or_si128(low, high));
+      for (auto i = 0; i < 8; ++i) {
+        output[i] = values[i];
+      }
+    }
+    pos += entry.numBytes;
+    output += entry.numValues;
+    numValues += entry.numValues;
+  }
+  return numValues;
+}
+
+} // namespace
+
+template <bool isSigned>
+template <typename T>
+void IntDecoder<isSigned>::bulkReadMaskedVarints(uint64_t size, T* result) {
+  auto output = result;
+  auto end = result + size;
+  while (output < end) {
+    output += decodeMaskedVarints(bufferStart, bufferEnd, output, end - output);
+    if (output < end) {
+      // Near the end of the buffer or a varint that does not fit 16 bytes.
+      *output++ = readVuLong();
+    }
+  }
+}
+
+template <bool isSigned>
+template <typename T>
+void IntDecoder<isSigned>::bulkReadRowsMaskedVarints(
+    RowSet rows,
+    int32_t initialRow,
+    T* result) {
+  constexpr int32_t kBatchSize = 256;
+  T values[kBatchSize];
+  const int32_t numRows = rows.size();
+  int32_t row = initialRow;
+  int32_t rowIndex = 0;
+  while (rowIndex < numRows) {
+    skipVarints(rows[rowIndex] - row);
+    row = rows[rowIndex];
+    const auto batchSize = std::min(kBatchSize, rows.back() + 1 - row);
+    if (rowIndex + batchSize <= numRows &&
+        rows[rowIndex + batchSize - 1] == row + batchSize - 1) {
+      // All rows of the batch are selected.
+      bulkReadMaskedVarints(batchSize, result + rowIndex);
+      rowIndex += batchSize;
+    } else {
+      bulkReadMaskedVarints(batchSize, values);
+      for (; rowIndex < numRows && rows[rowIndex] < row + batchSize;
+           ++rowIndex) {
+        result[rowIndex] = values[rows[rowIndex] - row];
+      }
+    }
+    row += batchSize;
+  }
+}
+
+#endif
+
 template <bool isSigned>
 template <typename T>
 void IntDecoder<isSigned>::bulkRead(uint64_t size, T* result) {
@@ -919,6 +1138,15 @@ void IntDecoder<isSigned>::bulkRead(uint64_t size, T* result) {
     bulkReadFixed(size, result);
     return;
   }
+#if XSIMD_WITH_AVX2
+  if (process::hasAvx2() && process::hasBmi2()) {
+    bulkReadMaskedVarints(size, result);
+    if (isSigned) {
+      bulkZigzagDecode(size, result);
+    }
+    return;
+  }
+#endif
   constexpr uint64_t mask = 0x8080808080808080;
   constexpr int32_t maskSize = 6;
   uint64_t carryover = 0;
@@ -970,6 +1198,18 @@ void IntDecoder<isSigned>::bulkReadRows(
     bulkReadRowsFixed(rows, initialRow, result);
     return;
   }
+#if XSIMD_WITH_AVX2
+  // Decodes all values in the range of 'rows' if at least half are selected.
+  // Sparser rows are cheaper to skip word by word below.
+  if (process::hasAvx2() && process::hasBmi2() &&
+      2 * rows.size() >= rows.back() + 1 - initialRow) {
+    bulkReadRowsMaskedVarints(rows, initialRow, result);
+    if (isSigned) {
+      bulkZigzagDecode(rows.size(), result);
+    }
+    return;
+  }
+#endif
   constexpr uint64_t mask = 0x8080808080808080;
   constexpr int32_t maskSize = 6;
   uint64_t carryover = 0;
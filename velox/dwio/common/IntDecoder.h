@@ -149,6 +149,17 @@ class IntDecoder {
   void
   bulkReadRowsFixed(RowSet rows, int32_t initialRow, T* FOLLY_NONNULL result);
 
+  // Variants of bulkRead() and bulkReadRows() for varints that decode up to 8
+  // values per step with SSE shuffles. Used when AVX2 and BMI2 are enabled.
+  template <typename T>
+  void bulkReadMaskedVarints(uint64_t size, T* FOLLY_NONNULL result);
+
+  template <typename T>
+  void bulkReadRowsMaskedVarints(
+      RowSet rows,
+      int32_t initialRow,
+      T* FOLLY_NONNULL result);
+
   template <typename T>
   T readInt();
 
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/LineReader.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+// Bytes read from the file at a time.
+constexpr int32_t kBlockSize = 1 << 20;
+
+} // namespace
+
+LineReader::LineReader(
+    std::shared_ptr<BufferedInput> input,
+    uint64_t offset,
+    uint64_t length,
+    uint64_t numHeaderLines,
+    int32_t padding,
+    memory::MemoryPool& pool)
+    : pool_(pool),
+      input_(std::move(input)),
+      offset_(offset),
+      numHeaderLines_(numHeaderLines),
+      padding_(padding),
+      fileLength_(input_->getInputStream()->getLength()),
+      rangeEnd_(
+          length > fileLength_ || offset + length > fileLength_
+              ? fileLength_
+              : offset + length) {}
+
+void LineReader::initialize() {
+  initialized_ = true;
+  buffer_ = AlignedBuffer::allocate<char>(kBlockSize + padding_, &pool_);
+  bufferOffset_ = offset_;
+  // The line in progress at the start of the range is read with the previous
+  // range.
+  const uint64_t numSkippedLines = offset_ > 0 ? 1 : numHeaderLines_;
+  for (uint64_t i = 0; i < numSkippedLines; ++i) {
+    bufferPosition_ = std::min(findNewline() + 1, bufferSize_);
+  }
+}
+
+bool LineReader::loadBlock() {
+  const auto readOffset = bufferOffset_ + bufferSize_;
+  if (readOffset >= fileLength_) {
+    return false;
+  }
+  const auto size = static_cast<int32_t>(
+      std::min<uint64_t>(kBlockSize, fileLength_ - readOffset));
+  const auto newSize = static_cast<uint64_t>(bufferSize_) + size;
+  VELOX_CHECK_LE(
+      newSize + padding_,
+      std::numeric_limits<int32_t>::max(),
+      "Line in text file is too long");
+  if (newSize + padding_ > buffer_->size()) {
+    AlignedBuffer::reallocate<char>(
+        &buffer_, std::max<uint64_t>(newSize + padding_, 2 * buffer_->size()));
+  }
+  input_->getInputStream()->read(
+      buffer_->asMutable<char>() + bufferSize_,
+      size,
+      readOffset,
+      LogType::STREAM);
+  bufferSize_ = newSize;
+  return true;
+}
+
+int32_t LineReader::findNewline() {
+  auto from = bufferPosition_;
+  for (;;) {
+    const auto* buffer = data();
+    const auto* newline = static_cast<const char*>(
+        memchr(buffer + from, '\n', bufferSize_ - from));
+    if (newline) {
+      return newline - buffer;
+    }
+    from = bufferSize_;
+    if (!loadBlock()) {
+      return bufferSize_;
+    }
+  }
+}
+
+vector_size_t LineReader::next(vector_size_t maxLines) {
+  if (!initialized_) {
+    initialize();
+  }
+  // The lines of the previous batch are no longer referenced.
+  if (bufferPosition_ > 0) {
+    auto* buffer = buffer_->asMutable<char>();
+    memmove(buffer, buffer + bufferPosition_, bufferSize_ - bufferPosition_);
+    bufferOffset_ += bufferPosition_;
+    bufferSize_ -= bufferPosition_;
+    bufferPosition_ = 0;
+  }
+  lineBegins_.clear();
+  lineEnds_.clear();
+  while (!atEnd_ && lineBegins_.size() < static_cast<size_t>(maxLines)) {
+    if (bufferOffset_ + bufferPosition_ > rangeEnd_) {
+      atEnd_ = true;
+      break;
+    }
+    const auto newline = findNewline();
+    if (bufferPosition_ == bufferSize_) {
+      atEnd_ = true;
+      break;
+    }
+    auto lineEnd = newline;
+    if (lineEnd > bufferPosition_ && data()[lineEnd - 1] == '\r') {
+      --lineEnd;
+    }
+    lineBegins_.push_back(bufferPosition_);
+    lineEnds_.push_back(lineEnd);
+    bufferPosition_ = std::min(newline + 1, bufferSize_);
+  }
+  return lineBegins_.size();
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/buffer/Buffer.h"
+#include "velox/dwio/common/BufferedInput.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Finds the lines of a text file that start in a byte range, e.g. for
+/// delimited text or JSON lines files. A line belongs to the range that
+/// contains the newline ending the previous line, so that the ranges of
+/// consecutive splits read each line of a file exactly once. Lines are
+/// returned in batches that stay in memory until the next batch is read.
+class LineReader {
+ public:
+  /// Reads the lines of 'input' starting in the 'length' bytes at 'offset'.
+  /// If 'offset' is 0, the first 'numHeaderLines' lines are skipped.
+  /// 'padding' bytes past the end of the read data are kept allocated, for
+  /// parsers that read past the end of their input.
+  LineReader(
+      std::shared_ptr<BufferedInput> input,
+      uint64_t offset,
+      uint64_t length,
+      uint64_t numHeaderLines,
+      int32_t padding,
+      memory::MemoryPool& pool);
+
+  /// Finds up to 'maxLines' next lines. Returns the number of lines found, 0
+  /// at the end of the range. Offsets and data from a previous call are no
+  /// longer valid.
+  vector_size_t next(vector_size_t maxLines);
+
+  /// True if all lines of the range have been returned.
+  bool atEnd() const {
+    return atEnd_;
+  }
+
+  /// The data the line bounds are relative to. 'bytesReadable(i)' bytes
+  /// starting at the line at 'i' are allocated.
+  const char* data() const {
+    return buffer_->as<char>();
+  }
+
+  /// Offsets in data() of the first byte of each line of the last batch.
+  const std::vector<int32_t>& lineBegins() const {
+    return lineBegins_;
+  }
+
+  /// Offsets in data() of the end of each line of the last batch. The newline
+  /// and a carriage return before it are not part of the line.
+  const std::vector<int32_t>& lineEnds() const {
+    return lineEnds_;
+  }
+
+  /// Number of allocated bytes in data() starting at the line at 'index'.
+  int32_t bytesReadable(vector_size_t index) const {
+    return bufferSize_ + padding_ - lineBegins_[index];
+  }
+
+ private:
+  // Skips the line in progress at the start of the range and the header
+  // lines of the file.
+  void initialize();
+
+  // Reads the next block of the file at the end of 'buffer_'. Returns false
+  // at end of file.
+  bool loadBlock();
+
+  // Returns the offset in 'buffer_' of the first newline at or after
+  // 'bufferPosition_', loading more of the file as needed. Returns
+  // 'bufferSize_' if the file ends without a newline.
+  int32_t findNewline();
+
+  memory::MemoryPool& pool_;
+  const std::shared_ptr<BufferedInput> input_;
+  const uint64_t offset_;
+  const uint64_t numHeaderLines_;
+  const int32_t padding_;
+  const uint64_t fileLength_;
+  // Lines starting after this offset belong to the next range.
+  const uint64_t rangeEnd_;
+
+  // Holds the lines being read. 'bufferOffset_' is the file offset of the
+  // first byte, 'bufferPosition_' is the first byte not consumed and
+  // 'bufferSize_' is the number of bytes read from the file.
+  BufferPtr buffer_;
+  uint64_t bufferOffset_{0};
+  int32_t bufferPosition_{0};
+  int32_t bufferSize_{0};
+
+  std::vector<int32_t> lineBegins_;
+  std::vector<int32_t> lineEnds_;
+
+  bool initialized_{false};
+  bool atEnd_{false};
+};
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/MmapBufferedInput.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+const MmapReadFile* toMmapReadFile(const ReadFileInputStream& input) {
+  auto* file = dynamic_cast<const MmapReadFile*>(input.getReadFile().get());
+  VELOX_CHECK_NOT_NULL(
+      file, "MmapBufferedInput requires a MmapReadFile: {}", input.getName());
+  return file;
+}
+} // namespace
+
+MmapBufferedInput::MmapBufferedInput(
+    std::shared_ptr<MmapReadFile> file,
+    memory::MemoryPool& pool,
+    const MetricsLogPtr& metricsLog,
+    IoStatistics* stats)
+    : BufferedInput(std::move(file), pool, metricsLog, stats),
+      file_(toMmapReadFile(*input_)) {}
+
+MmapBufferedInput::MmapBufferedInput(
+    std::shared_ptr<ReadFileInputStream> input,
+    memory::MemoryPool& pool)
+    : BufferedInput(std::move(input), pool), file_(toMmapReadFile(*input_)) {}
+
+std::unique_ptr<SeekableInputStream> MmapBufferedInput::enqueue(
+    velox::common::Region region,
+    const StreamIdentifier* /*si*/) {
+  if (region.length == 0) {
+    return std::make_unique<SeekableArrayInputStream>(
+        static_cast<const char*>(nullptr), 0);
+  }
+  enqueued_.push_back(region);
+  return makeStream(region.offset, region.length);
+}
+
+void MmapBufferedInput::load(const LogType /*logType*/) {
+  for (const auto& region : enqueued_) {
+    if (region.offset == 0 && region.length >= file_->size()) {
+      file_->adviseSequential();
+    } else {
+      file_->willNeed(region.offset, region.length);
+    }
+    if (auto* stats = input_->getStats()) {
+      stats->read().increment(region.length);
+    }
+  }
+  enqueued_.clear();
+}
+
+std::unique_ptr<SeekableInputStream> MmapBufferedInput::read(
+    uint64_t offset,
+    uint64_t length,
+    LogType /*logType*/) const {
+  if (auto* stats = input_->getStats()) {
+    stats->read().increment(length);
+  }
+  return makeStream(offset, length);
+}
+
+std::unique_ptr<SeekableInputStream> MmapBufferedInput::makeStream(
+    uint64_t offset,
+    uint64_t length) const {
+  VELOX_CHECK_LE(
+      offset + length,
+      file_->size(),
+      "Read past the end of {}: {} bytes at {}",
+      getName(),
+      length,
+      offset);
+  return std::make_unique<SeekableArrayInputStream>(
+      file_->data() + offset, length);
+}
+
+} // namespace facebook::velox::dwio::common
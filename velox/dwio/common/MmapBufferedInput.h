@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/file/File.h"
+#include "velox/dwio/common/BufferedInput.h"
+
+namespace facebook::velox::dwio::common {
+
+/// BufferedInput over a MmapReadFile. The streams read the mapped file
+/// directly, so that uncompressed data is decoded from the page cache without
+/// a copy. load() does no IO but advises the kernel to read ahead the
+/// enqueued regions. A region covering the whole file switches the mapping to
+/// sequential read ahead.
+class MmapBufferedInput : public BufferedInput {
+ public:
+  MmapBufferedInput(
+      std::shared_ptr<MmapReadFile> file,
+      memory::MemoryPool& pool,
+      const MetricsLogPtr& metricsLog = MetricsLog::voidLog(),
+      IoStatistics* FOLLY_NULLABLE stats = nullptr);
+
+  MmapBufferedInput(
+      std::shared_ptr<ReadFileInputStream> input,
+      memory::MemoryPool& pool);
+
+  std::unique_ptr<SeekableInputStream> enqueue(
+      velox::common::Region region,
+      const StreamIdentifier* FOLLY_NULLABLE si = nullptr) override;
+
+  void load(const LogType) override;
+
+  bool isBuffered(uint64_t offset, uint64_t length) const override {
+    return offset + length <= file_->size();
+  }
+
+  std::unique_ptr<SeekableInputStream>
+  read(uint64_t offset, uint64_t length, LogType logType) const override;
+
+  std::unique_ptr<BufferedInput> clone() const override {
+    return std::make_unique<MmapBufferedInput>(input_, pool_);
+  }
+
+ private:
+  // Returns a stream over the mapped bytes of [offset, offset + length).
+  std::unique_ptr<SeekableInputStream> makeStream(
+      uint64_t offset,
+      uint64_t length) const;
+
+  const MmapReadFile* const file_;
+
+  // Regions enqueued since the last load().
+  std::vector<velox::common::Region> enqueued_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -346,7 +346,7 @@ class RowReaderOptions {
     skipRows_ = skipRows;
   }
 
-  bool getSkipRows() const {
+  uint64_t getSkipRows() const {
     return skipRows_;
   }
 
@@ -370,6 +370,7 @@ class ReaderOptions : public io::ReaderOptions {
   bool fileColumnNamesReadAsLowerCase{false};
   bool useColumnNamesForColumnMapping_{false};
   std::shared_ptr<folly::Executor> ioExecutor_;
+  std::string fileMetadataCacheKey_;
 
  public:
   static constexpr uint64_t kDefaultDirectorySizeGuess = 1024 * 1024; // 1MB
@@ -397,6 +398,7 @@ class ReaderOptions : public io::ReaderOptions {
     filePreloadThreshold = other.filePreloadThreshold;
     fileColumnNamesReadAsLowerCase = other.fileColumnNamesReadAsLowerCase;
     useColumnNamesForColumnMapping_ = other.useColumnNamesForColumnMapping_;
+    fileMetadataCacheKey_ = other.fileMetadataCacheKey_;
     return *this;
   }
 
@@ -410,8 +412,8 @@ class ReaderOptions : public io::ReaderOptions {
         directorySizeGuess(other.directorySizeGuess),
         filePreloadThreshold(other.filePreloadThreshold),
         fileColumnNamesReadAsLowerCase(other.fileColumnNamesReadAsLowerCase),
-        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_) {
-  }
+        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_),
+        fileMetadataCacheKey_(other.fileMetadataCacheKey_) {}
 
   /**
    * Set the format of the file, such as "rc" or "dwrf".  The
@@ -480,6 +482,14 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets the key identifying the version of the file to read in the
+  /// process-wide FileMetadataCache. If empty, the parsed footer is not
+  /// cached.
+  ReaderOptions& setFileMetadataCacheKey(std::string key) {
+    fileMetadataCacheKey_ = std::move(key);
+    return *this;
+  }
+
   /**
    * Get the desired tail location.
    * @return if not set, return the maximum long.
@@ -534,6 +544,10 @@ class ReaderOptions : public io::ReaderOptions {
   bool isUseColumnNamesForColumnMapping() const {
     return useColumnNamesForColumnMapping_;
   }
+
+  const std::string& fileMetadataCacheKey() const {
+    return fileMetadataCacheKey_;
+  }
 };
 
 struct WriterMemoryReclaimConfig {
@@ -550,6 +564,15 @@ struct WriterOptions {
   std::optional<velox::common::CompressionKind> compressionKind;
   std::optional<uint64_t> maxStripeSize{std::nullopt};
   std::optional<uint64_t> maxDictionaryMemory{std::nullopt};
+  /// Writes Parquet files with parquet::NativeWriter, which encodes Velox
+  /// vectors directly, instead of the Arrow based parquet::Writer.
+  bool parquetNativeWriter{false};
+  /// If set, the writer encodes and compresses the columns in parallel on
+  /// this executor. Not owned.
+  folly::Executor* encodingExecutor{nullptr};
+  /// If set, the writer writes flushed data to the file sink on this
+  /// executor while it encodes the next data. Not owned.
+  folly::Executor* flushExecutor{nullptr};
 };
 
 } // namespace facebook::velox::dwio::common
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <functional>
+#include <string_view>
 #include <vector>
 
 #include "velox/dwio/common/DataBuffer.h"
@@ -57,6 +59,22 @@ class SeekableInputStream : public google::protobuf::io::ZeroCopyInputStream {
   // ORC/DWRF stream address.
   virtual size_t positionSize() = 0;
 
+  // Support for caching the decompressed pages of a compressed stream read
+  // from 'this'. 'offset' is the position of the compressed page in 'this'.
+  // If the decompressed page is cached, calls 'allocate' with its size, copies
+  // the page to the returned buffer and returns true.
+  virtual bool readDecompressedPage(
+      uint64_t /*offset*/,
+      const std::function<char*(int32_t size)>& /*allocate*/) {
+    return false;
+  }
+
+  // Offers 'page', decompressed from the compressed page at 'offset', to the
+  // cache. The implementation decides whether to keep it.
+  virtual void cacheDecompressedPage(
+      uint64_t /*offset*/,
+      std::string_view /*page*/) {}
+
   void readFully(char* buffer, size_t bufferSize);
 };
 
@@ -287,6 +287,18 @@ class SelectiveColumnReader {
     allNull_ = true;
   }
 
+  // The number of leading values of the last read() that are known to
+  // be copies of the same value because they came from runs of one
+  // value. If this covers all values and there are no nulls,
+  // getValues() may return a constant vector.
+  vector_size_t constantRunValues() const {
+    return constantRunValues_;
+  }
+
+  void setConstantRunValues(vector_size_t numValues) {
+    constantRunValues_ = numValues;
+  }
+
   void incrementNumValues(vector_size_t size) {
     numValues_ += size;
   }
@@ -432,6 +444,10 @@ class SelectiveColumnReader {
   static constexpr int8_t kNoValueSize = -1;
   static constexpr uint32_t kRowGroupNotSet = ~0;
 
+  // Minimum number of values of a read that must come from runs of one
+  // value for getValues() to return a constant vector.
+  static constexpr vector_size_t kMinConstantRunValues = 256;
+
   // True if we have an is null filter and optionally return column
   // values or we have an is not null filter and do not return column
   // values. This means that only null flags need be accessed.
@@ -631,6 +647,9 @@ class SelectiveColumnReader {
   // True if all values in scope for last read() are null.
   bool allNull_ = false;
 
+  // See constantRunValues().
+  vector_size_t constantRunValues_{0};
+
   // Number of clocks spent initializing.
   uint64_t initTimeClocks_{0};
 
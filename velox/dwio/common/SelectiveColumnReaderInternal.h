@@ -92,6 +92,7 @@ void SelectiveColumnReader::prepareRead(
   mayGetValues_ = true;
   numOutConfirmed_ = 0;
   numValues_ = 0;
+  constantRunValues_ = 0;
   valueSize_ = sizeof(T);
   inputRows_ = rows;
   if (scanSpec_->filter() || hasMutation()) {
@@ -126,6 +127,9 @@ void SelectiveColumnReader::getFlatValues(
         sizeof(TVector) * rows.size());
     return;
   }
+  // All values come from runs of the same value.
+  bool isConstant = !anyNulls_ && !rows.empty() &&
+      numValues_ >= kMinConstantRunValues && constantRunValues_ == numValues_;
   if (valueSize_ == sizeof(TVector)) {
     compactScalarValues<TVector, TVector>(rows, isFinal);
   } else if (sizeof(T) >= sizeof(TVector)) {
@@ -134,6 +138,17 @@ void SelectiveColumnReader::getFlatValues(
     upcastScalarValues<T, TVector>(rows);
   }
   valueSize_ = sizeof(TVector);
+  if (isConstant) {
+    *result = std::make_shared<ConstantVector<TVector>>(
+        &memoryPool_,
+        rows.size(),
+        false,
+        type,
+        TVector(reinterpret_cast<const TVector*>(rawValues_)[0]),
+        SimpleVectorStats<TVector>{},
+        sizeof(TVector) * rows.size());
+    return;
+  }
   *result = std::make_shared<FlatVector<TVector>>(
       &memoryPool_,
       type,
@@ -523,6 +523,10 @@ struct ColumnReaderStatistics {
   // Number of rows returned by string dictionary reader that is flattened
   // instead of keeping dictionary encoding.
   int64_t flattenStringDictionaryValues{0};
+
+  // Number of data pages not read because the page index shows that none of
+  // their rows pass the filters.
+  int64_t skippedPages{0};
 };
 
 struct RuntimeStatistics {
@@ -544,7 +548,8 @@ struct RuntimeStatistics {
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
         {"skippedStrides", RuntimeCounter(skippedStrides)},
         {"flattenStringDictionaryValues",
-         RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)}};
+         RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)},
+        {"skippedPages", RuntimeCounter(columnReaderStatistics.skippedPages)}};
   }
 };
 
@@ -406,6 +406,16 @@ bool ZlibDecompressionStream::readOrSkip(const void** data, int32_t* size) {
         getName(),
         " Info: ",
         ZlibDecompressor::streamDebugInfo_);
+    if (auto cachedSize = readCachedPage()) {
+      if (data) {
+        *data = outputBuffer_->data();
+      }
+      *size = *cachedSize;
+      outputBufferPtr_ = outputBuffer_->data() + *cachedSize;
+      outputBufferLength_ = 0;
+      bytesReturned_ += *size;
+      return true;
+    }
     prepareOutputBuffer(
         getDecompressedLength(inputBufferPtr_, availSize).first);
 
@@ -446,6 +456,7 @@ bool ZlibDecompressionStream::readOrSkip(const void** data, int32_t* size) {
       }
     } while (result != Z_STREAM_END);
     *size = static_cast<int32_t>(blockSize_ - zstream_.avail_out);
+    cachePage(*size);
     if (data) {
       *data = outputBufferPtr_;
     }
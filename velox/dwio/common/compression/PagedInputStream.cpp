@@ -71,6 +71,37 @@ void PagedInputStream::readHeader() {
   }
 }
 
+std::optional<int32_t> PagedInputStream::readCachedPage() {
+  if (decrypter_ != nullptr) {
+    // Decrypted data is not kept in the cache.
+    return std::nullopt;
+  }
+  int32_t pageSize = 0;
+  if (!input_->readDecompressedPage(lastHeaderOffset_, [&](int32_t size) {
+        pageSize = size;
+        prepareOutputBuffer(size);
+        return outputBuffer_->data();
+      })) {
+    return std::nullopt;
+  }
+  const size_t available = inputBufferPtrEnd_ - inputBufferPtr_;
+  if (remainingLength_ <= available) {
+    inputBufferPtr_ += remainingLength_;
+  } else {
+    input_->Skip(remainingLength_ - available);
+    inputBufferPtr_ = inputBufferPtrEnd_;
+  }
+  remainingLength_ = 0;
+  return pageSize;
+}
+
+void PagedInputStream::cachePage(int32_t size) {
+  if (decrypter_ == nullptr) {
+    input_->cacheDecompressedPage(
+        lastHeaderOffset_, std::string_view(outputBuffer_->data(), size));
+  }
+}
+
 const char* PagedInputStream::ensureInput(size_t availableInputBytes) {
   auto input = inputBufferPtr_;
   if (remainingLength_ <= availableInputBytes) {
@@ -137,6 +168,20 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   if (state_ == State::END) {
     return false;
   }
+  if (state_ == State::START) {
+    if (auto cachedSize = readCachedPage()) {
+      if (data) {
+        *data = outputBuffer_->data();
+      }
+      *size = *cachedSize;
+      outputBufferPtr_ = outputBuffer_->data() + *cachedSize;
+      state_ = State::HEADER;
+      outputBufferLength_ = 0;
+      bytesReturned_ += *size;
+      lastWindowSize_ = *size;
+      return true;
+    }
+  }
   if (inputBufferPtr_ == inputBufferPtrEnd_) {
     readBuffer(true);
   }
@@ -191,6 +236,7 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
           remainingLength_,
           outputBuffer_->data(),
           outputBuffer_->capacity());
+      cachePage(outputBufferLength_);
       if (data) {
         *data = outputBuffer_->data();
       }
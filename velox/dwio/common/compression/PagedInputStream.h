@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
 
@@ -114,6 +116,15 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
 
   void clearDecompressionState();
 
+  // If 'input_' has the decompressed page for the compressed page whose header
+  // was read last, copies it to 'outputBuffer_', skips the compressed page in
+  // 'input_' and returns the size of the page.
+  std::optional<int32_t> readCachedPage();
+
+  // Offers the first 'size' bytes of 'outputBuffer_', decompressed from the
+  // page whose header was read last, to the cache of 'input_'.
+  void cachePage(int32_t size);
+
   enum class State { HEADER, START, ORIGINAL, END };
 
   // make sure input is contiguous for decompression/decryption
@@ -136,6 +136,32 @@ void E2EFilterTestBase::readWithoutFilter(
   ASSERT_EQ(rowIndex, 0);
 }
 
+std::vector<RowVectorPtr> E2EFilterTestBase::readBatches(
+    const std::shared_ptr<ScanSpec>& spec,
+    int32_t batchSize) {
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  dwio::common::RowReaderOptions rowReaderOpts;
+  std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+  auto input = std::make_unique<BufferedInput>(
+      std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+  auto reader = makeReader(readerOpts, std::move(input));
+  setUpRowReaderOptions(rowReaderOpts, spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  std::vector<RowVectorPtr> batches;
+  for (;;) {
+    VectorPtr result = BaseVector::create(rowType_, 1, leafPool_.get());
+    if (!rowReader->next(batchSize, result)) {
+      break;
+    }
+    auto batch = std::static_pointer_cast<RowVector>(result);
+    for (auto i = 0; i < batch->childrenSize(); ++i) {
+      batch->childAt(i) = BaseVector::loadedVectorShared(batch->childAt(i));
+    }
+    batches.push_back(std::move(batch));
+  }
+  return batches;
+}
+
 void E2EFilterTestBase::readWithFilter(
     std::shared_ptr<ScanSpec> spec,
     const MutationSpec& mutationSpec,
@@ -187,6 +187,12 @@ class E2EFilterTestBase : public testing::Test {
       const std::vector<RowVectorPtr>& batches,
       uint64_t& time);
 
+  // Reads the file in 'sinkPtr_' with 'spec' in batches of up to 'batchSize'
+  // rows. Lazy vectors in the batches are loaded.
+  std::vector<RowVectorPtr> readBatches(
+      const std::shared_ptr<common::ScanSpec>& spec,
+      int32_t batchSize);
+
   void readWithFilter(
       std::shared_ptr<common::ScanSpec> spec,
       const MutationSpec&,
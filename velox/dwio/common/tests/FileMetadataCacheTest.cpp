@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwio::common;
+
+TEST(FileMetadataCacheTest, getAndPut) {
+  FileMetadataCache cache(100);
+  EXPECT_EQ(nullptr, cache.get<std::string>("f1:10", FileFormat::DWRF));
+
+  cache.put("f1:10", FileFormat::DWRF, std::make_shared<std::string>("a"), 10);
+  auto metadata = cache.get<std::string>("f1:10", FileFormat::DWRF);
+  ASSERT_NE(nullptr, metadata);
+  EXPECT_EQ("a", *metadata);
+  // The format is part of the key.
+  EXPECT_EQ(nullptr, cache.get<std::string>("f1:10", FileFormat::PARQUET));
+
+  // A new entry for the same key replaces the old one.
+  cache.put("f1:10", FileFormat::DWRF, std::make_shared<std::string>("b"), 20);
+  EXPECT_EQ("b", *cache.get<std::string>("f1:10", FileFormat::DWRF));
+  // Readers holding the old entry are not affected.
+  EXPECT_EQ("a", *metadata);
+
+  // An entry larger than the capacity is not cached.
+  cache.put("f2:10", FileFormat::DWRF, std::make_shared<std::string>("c"), 101);
+  EXPECT_EQ(nullptr, cache.get<std::string>("f2:10", FileFormat::DWRF));
+
+  auto stats = cache.stats();
+  EXPECT_EQ(1, stats.numEntries);
+  EXPECT_EQ(20, stats.bytes);
+  EXPECT_EQ(5, stats.numLookups);
+  EXPECT_EQ(2, stats.numHits);
+
+  cache.clear();
+  EXPECT_EQ(nullptr, cache.get<std::string>("f1:10", FileFormat::DWRF));
+  EXPECT_EQ(0, cache.stats().bytes);
+}
+
+TEST(FileMetadataCacheTest, evict) {
+  FileMetadataCache cache(100);
+  for (auto i = 0; i < 4; ++i) {
+    cache.put(
+        std::to_string(i),
+        FileFormat::DWRF,
+        std::make_shared<std::string>(std::to_string(i)),
+        30);
+  }
+  // The first entry is evicted to make room for the fourth.
+  EXPECT_EQ(nullptr, cache.get<std::string>("0", FileFormat::DWRF));
+  EXPECT_EQ(1, cache.stats().numEvictions);
+
+  // A hit makes '1' the most recently used, so '2' is evicted next.
+  EXPECT_NE(nullptr, cache.get<std::string>("1", FileFormat::DWRF));
+  cache.put("4", FileFormat::DWRF, std::make_shared<std::string>("4"), 30);
+  EXPECT_NE(nullptr, cache.get<std::string>("1", FileFormat::DWRF));
+  EXPECT_EQ(nullptr, cache.get<std::string>("2", FileFormat::DWRF));
+  EXPECT_NE(nullptr, cache.get<std::string>("3", FileFormat::DWRF));
+  EXPECT_NE(nullptr, cache.get<std::string>("4", FileFormat::DWRF));
+
+  auto stats = cache.stats();
+  EXPECT_EQ(3, stats.numEntries);
+  EXPECT_EQ(90, stats.bytes);
+  EXPECT_EQ(2, stats.numEvictions);
+}
+
+TEST(FileMetadataCacheTest, instance) {
+  EXPECT_EQ(nullptr, FileMetadataCache::getInstance());
+  FileMetadataCache cache(100);
+  FileMetadataCache::setInstance(&cache);
+  EXPECT_EQ(&cache, FileMetadataCache::getInstance());
+  FileMetadataCache::setInstance(nullptr);
+}
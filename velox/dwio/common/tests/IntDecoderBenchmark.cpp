@@ -21,11 +21,15 @@
 #include "folly/Varint.h"
 #include "folly/init/Init.h"
 #include "folly/lang/Bits.h"
+#include "gflags/gflags.h"
 #include "velox/common/base/BitUtil.h"
+#include "velox/dwio/common/DirectDecoder.h"
 #include "velox/dwio/common/IntCodecCommon.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
+DECLARE_bool(avx2); // NOLINT
+
 using namespace facebook::velox;
 using namespace facebook::velox::dwio;
 using namespace facebook::velox::dwio::common;
@@ -938,6 +942,78 @@ BENCHMARK_RELATIVE(decodeNew_64) {
       randomInts_u64.size(), buffer_u64.data(), randomInts_u64_result.data());
 }
 
+// Decodes 'numValues' varints from 'buffer' with IntDecoder::bulkRead() or,
+// if 'rows' is set, IntDecoder::bulkReadRows(). 'masked' selects the SIMD
+// decoding used when AVX2 is enabled.
+void decodeBulk(
+    const std::vector<char>& buffer,
+    size_t length,
+    size_t numValues,
+    const std::vector<int32_t>* rows,
+    bool masked) {
+  std::vector<uint64_t> result;
+  BENCHMARK_SUSPEND {
+    FLAGS_avx2 = masked; // NOLINT
+    result.resize(numValues);
+  }
+  DirectDecoder<false> decoder(
+      std::make_unique<SeekableArrayInputStream>(buffer.data(), length),
+      true,
+      sizeof(uint64_t));
+  if (rows) {
+    decoder.bulkReadRows(*rows, result.data());
+  } else {
+    decoder.bulkRead(numValues, result.data());
+  }
+  folly::doNotOptimizeAway(result);
+  BENCHMARK_SUSPEND {
+    FLAGS_avx2 = true; // NOLINT
+  }
+}
+
+// Every other row of the values of each width for bulkReadRows().
+std::vector<int32_t> halfRows_u16;
+std::vector<int32_t> halfRows_u32;
+std::vector<int32_t> halfRows_u64;
+
+#define DECODE_BULK_BENCHMARKS(_width_)                                   \
+  BENCHMARK(decodeBulkSwitch_##_width_) {                                 \
+    decodeBulk(                                                           \
+        buffer_u##_width_,                                                \
+        len_u##_width_,                                                   \
+        randomInts_u##_width_.size(),                                     \
+        nullptr,                                                          \
+        false);                                                           \
+  }                                                                       \
+  BENCHMARK_RELATIVE(decodeBulkMasked_##_width_) {                        \
+    decodeBulk(                                                           \
+        buffer_u##_width_,                                                \
+        len_u##_width_,                                                   \
+        randomInts_u##_width_.size(),                                     \
+        nullptr,                                                          \
+        true);                                                            \
+  }                                                                       \
+  BENCHMARK(decodeBulkRowsSwitch_##_width_) {                             \
+    decodeBulk(                                                           \
+        buffer_u##_width_,                                                \
+        len_u##_width_,                                                   \
+        halfRows_u##_width_.size(),                                       \
+        &halfRows_u##_width_,                                             \
+        false);                                                           \
+  }                                                                       \
+  BENCHMARK_RELATIVE(decodeBulkRowsMasked_##_width_) {                    \
+    decodeBulk(                                                           \
+        buffer_u##_width_,                                                \
+        len_u##_width_,                                                   \
+        halfRows_u##_width_.size(),                                       \
+        &halfRows_u##_width_,                                             \
+        true);                                                            \
+  }
+
+DECODE_BULK_BENCHMARKS(16)
+DECODE_BULK_BENCHMARKS(32)
+DECODE_BULK_BENCHMARKS(64)
+
 int32_t main(int32_t argc, char* argv[]) {
   folly::init(&argc, &argv);
 
@@ -975,6 +1051,16 @@ int32_t main(int32_t argc, char* argv[]) {
   randomInts_u64_result.resize(randomInts_u64.size());
   len_u64 = pos;
 
+  for (auto i = 0; i < randomInts_u16.size(); i += 2) {
+    halfRows_u16.push_back(i);
+  }
+  for (auto i = 0; i < randomInts_u32.size(); i += 2) {
+    halfRows_u32.push_back(i);
+  }
+  for (auto i = 0; i < randomInts_u64.size(); i += 2) {
+    halfRows_u64.push_back(i);
+  }
+
   folly::runBenchmarks();
   return 0;
 }
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/MmapBufferedInput.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+std::string nextBytes(SeekableInputStream& stream) {
+  const void* data;
+  int32_t size;
+  if (!stream.Next(&data, &size)) {
+    return "";
+  }
+  return std::string(static_cast<const char*>(data), size);
+}
+
+} // namespace
+
+TEST(MmapBufferedInputTest, read) {
+  auto pool = memory::addDefaultLeafMemoryPool();
+  auto tempFile = exec::test::TempFilePath::create();
+  std::string content;
+  for (auto i = 0; i < 100'000; ++i) {
+    content.push_back('a' + i % 26);
+  }
+  {
+    LocalWriteFile writeFile(tempFile->path, false, false);
+    writeFile.append(content);
+  }
+  auto file = std::make_shared<MmapReadFile>(tempFile->path);
+  IoStatistics stats;
+  MmapBufferedInput input(file, *pool, MetricsLog::voidLog(), &stats);
+
+  auto first = input.enqueue({10, 5});
+  auto second = input.enqueue({50'000, 26});
+  auto empty = input.enqueue({20, 0});
+  input.load(LogType::FILE);
+  EXPECT_EQ(31, stats.read().sum());
+
+  // The streams point into the mapped file.
+  const void* data;
+  int32_t size;
+  ASSERT_TRUE(first->Next(&data, &size));
+  EXPECT_EQ(file->data() + 10, data);
+  EXPECT_EQ(5, size);
+  EXPECT_EQ(content.substr(50'000, 26), nextBytes(*second));
+  EXPECT_EQ("", nextBytes(*empty));
+
+  EXPECT_TRUE(input.isBuffered(0, content.size()));
+  EXPECT_FALSE(input.isBuffered(1, content.size()));
+  auto tail = input.read(99'990, 10, LogType::FILE);
+  EXPECT_EQ(content.substr(99'990), nextBytes(*tail));
+  EXPECT_THROW(input.read(99'990, 11, LogType::FILE), VeloxRuntimeError);
+
+  auto clone = input.clone();
+  auto whole = clone->loadCompleteFile();
+  EXPECT_EQ(content, nextBytes(*whole));
+}
@@ -209,4 +209,8 @@ Config::Entry<uint64_t> Config::RAW_DATA_SIZE_PER_BATCH(
     50UL * 1024 * 1024);
 
 Config::Entry<bool> Config::MAP_STATISTICS("orc.map.statistics", false);
+
+Config::Entry<uint64_t> Config::MAX_PENDING_WRITE_BYTES(
+    "orc.max.pending.write.bytes",
+    256L * 1024L * 1024L);
 } // namespace facebook::velox::dwrf
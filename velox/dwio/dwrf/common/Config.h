@@ -74,6 +74,9 @@ class Config : public common::ConfigBase<Config> {
   /// stripes.
   static Entry<uint64_t> RAW_DATA_SIZE_PER_BATCH;
   static Entry<bool> MAP_STATISTICS;
+  /// Maximum bytes of flushed stripes waiting to be written when writes go
+  /// through WriterOptions::flushExecutor.
+  static Entry<uint64_t> MAX_PENDING_WRITE_BYTES;
 
   static std::shared_ptr<Config> fromMap(
       const std::map<std::string, std::string>& map) {
@@ -18,6 +18,8 @@
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
 
+#include <folly/lang/Bits.h>
+
 namespace facebook::velox::dwrf {
 
 using memory::MemoryPool;
@@ -135,6 +137,8 @@ RleDecoderV2<isSigned>::RleDecoderV2(
       bitsLeft(0),
       curByte(0),
       patchBitSize(0),
+      patchGapWidth(0),
+      patchListLength(0),
       unpackedIdx(0),
       patchIdx(0),
       base(0),
@@ -143,7 +147,10 @@ RleDecoderV2<isSigned>::RleDecoderV2(
       patchMask(0),
       actualGap(0),
       unpacked(pool, 0),
-      unpackedPatch(pool, 0) {
+      unpackedPatch(pool, 0),
+      runDecoded(false),
+      decoded(pool, 0),
+      packed(pool, 0) {
   // PASS
 }
 
@@ -210,6 +217,10 @@ void RleDecoderV2<isSigned>::next(
 
     uint64_t offset = nRead, length = numValues - nRead;
 
+    if (runDecoded) {
+      nRead += nextDecoded(data, offset, length, nulls);
+      continue;
+    }
     switch (type) {
       case SHORT_REPEAT:
         nRead += nextShortRepeats(data, offset, length, nulls);
@@ -344,6 +355,85 @@ template uint64_t RleDecoderV2<false>::nextDirect(
     uint64_t numValues,
     const uint64_t* const nulls);
 
+template <bool isSigned>
+void RleDecoderV2<isSigned>::readPatchedHeader() {
+  // extract the number of fixed bits
+  unsigned char fbo = (firstByte >> 1) & 0x1f;
+  bitSize = decodeBitWidth(fbo);
+
+  // extract the run length
+  runLength = static_cast<uint64_t>(firstByte & 0x01) << 8;
+  runLength |= readByte();
+  // runs are one off
+  runLength += 1;
+  runRead = 0;
+
+  // extract the number of bytes occupied by base
+  uint64_t thirdByte = readByte();
+  byteSize = (thirdByte >> 5) & 0x07;
+  // base width is one off
+  byteSize += 1;
+
+  // extract patch width
+  uint32_t pwo = thirdByte & 0x1f;
+  patchBitSize = decodeBitWidth(pwo);
+
+  // read fourth byte and extract patch gap width
+  uint64_t fourthByte = readByte();
+  patchGapWidth = (fourthByte >> 5) & 0x07;
+  // patch gap width is one off
+  patchGapWidth += 1;
+
+  // extract the length of the patch list
+  patchListLength = fourthByte & 0x1f;
+  DWIO_ENSURE_NE(
+      patchListLength,
+      0,
+      "Corrupt PATCHED_BASE encoded data (pl==0)! ",
+      dwio::common::IntDecoder<isSigned>::inputStream->getName());
+
+  // read the next base width number of bytes to extract base value
+  base = readLongBE(byteSize);
+  int64_t mask = (static_cast<int64_t>(1) << ((byteSize * 8) - 1));
+  // if mask of base value is 1 then base is negative value else positive
+  if ((base & mask) != 0) {
+    base = base & ~mask;
+    base = -base;
+  }
+}
+
+template void RleDecoderV2<true>::readPatchedHeader();
+template void RleDecoderV2<false>::readPatchedHeader();
+
+template <bool isSigned>
+void RleDecoderV2<isSigned>::unpackPatched() {
+  // TODO: something more efficient than resize
+  unpacked.resize(runLength);
+  unpackedIdx = 0;
+  unpack(unpacked.data(), runLength, bitSize);
+
+  // TODO: something more efficient than resize
+  unpackedPatch.resize(patchListLength);
+  patchIdx = 0;
+  // TODO: Skip corrupt?
+  //    if ((patchBitSize + pgw) > 64 && !skipCorrupt) {
+  DWIO_ENSURE_LE(
+      (patchBitSize + patchGapWidth),
+      64,
+      "Corrupt PATCHED_BASE encoded data (patchBitSize + pgw > 64)! ",
+      dwio::common::IntDecoder<isSigned>::inputStream->getName());
+  uint32_t cfb = getClosestFixedBits(patchBitSize + patchGapWidth);
+  unpack(unpackedPatch.data(), patchListLength, cfb);
+
+  // apply the patch directly when decoding the packed data
+  patchMask = ((static_cast<int64_t>(1) << patchBitSize) - 1);
+
+  adjustGapAndPatch();
+}
+
+template void RleDecoderV2<true>::unpackPatched();
+template void RleDecoderV2<false>::unpackPatched();
+
 template <bool isSigned>
 uint64_t RleDecoderV2<isSigned>::nextPatched(
     int64_t* const data,
@@ -351,76 +441,8 @@ uint64_t RleDecoderV2<isSigned>::nextPatched(
     uint64_t numValues,
     const uint64_t* const nulls) {
   if (runRead == runLength) {
-    // extract the number of fixed bits
-    unsigned char fbo = (firstByte >> 1) & 0x1f;
-    bitSize = decodeBitWidth(fbo);
-
-    // extract the run length
-    runLength = static_cast<uint64_t>(firstByte & 0x01) << 8;
-    runLength |= readByte();
-    // runs are one off
-    runLength += 1;
-    runRead = 0;
-
-    // extract the number of bytes occupied by base
-    uint64_t thirdByte = readByte();
-    byteSize = (thirdByte >> 5) & 0x07;
-    // base width is one off
-    byteSize += 1;
-
-    // extract patch width
-    uint32_t pwo = thirdByte & 0x1f;
-    patchBitSize = decodeBitWidth(pwo);
-
-    // read fourth byte and extract patch gap width
-    uint64_t fourthByte = readByte();
-    uint32_t pgw = (fourthByte >> 5) & 0x07;
-    // patch gap width is one off
-    pgw += 1;
-
-    // extract the length of the patch list
-    size_t pl = fourthByte & 0x1f;
-    DWIO_ENSURE_NE(
-        pl,
-        0,
-        "Corrupt PATCHED_BASE encoded data (pl==0)! ",
-        dwio::common::IntDecoder<isSigned>::inputStream->getName());
-
-    // read the next base width number of bytes to extract base value
-    base = readLongBE(byteSize);
-    int64_t mask = (static_cast<int64_t>(1) << ((byteSize * 8) - 1));
-    // if mask of base value is 1 then base is negative value else positive
-    if ((base & mask) != 0) {
-      base = base & ~mask;
-      base = -base;
-    }
-
-    // TODO: something more efficient than resize
-    unpacked.resize(runLength);
-    unpackedIdx = 0;
-    readLongs(unpacked.data(), 0, runLength, bitSize);
-    // any remaining bits are thrown out
-    resetReadLongs();
-
-    // TODO: something more efficient than resize
-    unpackedPatch.resize(pl);
-    patchIdx = 0;
-    // TODO: Skip corrupt?
-    //    if ((patchBitSize + pgw) > 64 && !skipCorrupt) {
-    DWIO_ENSURE_LE(
-        (patchBitSize + pgw),
-        64,
-        "Corrupt PATCHED_BASE encoded data (patchBitSize + pgw > 64)! ",
-        dwio::common::IntDecoder<isSigned>::inputStream->getName());
-    uint32_t cfb = getClosestFixedBits(patchBitSize + pgw);
-    readLongs(unpackedPatch.data(), 0, pl, cfb);
-    // any remaining bits are thrown out
-    resetReadLongs();
-
-    // apply the patch directly when decoding the packed data
-    patchMask = ((static_cast<int64_t>(1) << patchBitSize) - 1);
-
-    adjustGapAndPatch();
+    readPatchedHeader();
+    unpackPatched();
   }
 
   uint64_t nRead = std::min(runLength - runRead, numValues);
@@ -582,6 +604,243 @@ template uint64_t RleDecoderV2<false>::nextDelta(
     uint64_t numValues,
     const uint64_t* const nulls);
 
+template <bool isSigned>
+uint64_t RleDecoderV2<isSigned>::nextDecoded(
+    int64_t* const data,
+    uint64_t offset,
+    uint64_t numValues,
+    const uint64_t* const nulls) {
+  uint64_t nRead = std::min(runLength - runRead, numValues);
+  for (uint64_t pos = offset; pos < offset + nRead; ++pos) {
+    // skip null positions
+    if (nulls && bits::isBitNull(nulls, pos)) {
+      continue;
+    }
+    data[pos] = decoded[runRead++];
+  }
+  return nRead;
+}
+
+template uint64_t RleDecoderV2<true>::nextDecoded(
+    int64_t* const data,
+    uint64_t offset,
+    uint64_t numValues,
+    const uint64_t* const nulls);
+
+template uint64_t RleDecoderV2<false>::nextDecoded(
+    int64_t* const data,
+    uint64_t offset,
+    uint64_t numValues,
+    const uint64_t* const nulls);
+
+template <bool isSigned>
+void RleDecoderV2<isSigned>::unpack(
+    int64_t* const data,
+    uint64_t numValues,
+    uint32_t bitWidth) {
+  using Decoder = dwio::common::IntDecoder<isSigned>;
+  VELOX_DCHECK_EQ(bitsLeft, 0);
+  const uint64_t numBytes = bits::roundUp(numValues * bitWidth, 8) / 8;
+  const char* bytes;
+  if (Decoder::bufferEnd - Decoder::bufferStart >=
+      static_cast<int64_t>(numBytes + sizeof(uint64_t))) {
+    // Unpack in place if 8 bytes past the packed bytes can be loaded.
+    bytes = Decoder::bufferStart;
+    Decoder::bufferStart += numBytes;
+  } else {
+    packed.resize(numBytes + sizeof(uint64_t));
+    dwio::common::readBytes(
+        numBytes,
+        Decoder::inputStream.get(),
+        packed.data(),
+        Decoder::bufferStart,
+        Decoder::bufferEnd);
+    memset(packed.data() + numBytes, 0, sizeof(uint64_t));
+    bytes = packed.data();
+  }
+  if (bitWidth == 64) {
+    for (uint64_t i = 0; i < numValues; ++i) {
+      data[i] = folly::Endian::big(
+          folly::loadUnaligned<uint64_t>(bytes + i * sizeof(uint64_t)));
+    }
+    return;
+  }
+  // A value of up to 56 bits is within the 8 bytes starting at its first
+  // byte. Load these as a big endian word and shift the value out of it.
+  uint64_t bitOffset = 0;
+  for (uint64_t i = 0; i < numValues; ++i) {
+    const auto word = folly::Endian::big(
+        folly::loadUnaligned<uint64_t>(bytes + bitOffset / 8));
+    data[i] = (word << (bitOffset % 8)) >> (64 - bitWidth);
+    bitOffset += bitWidth;
+  }
+}
+
+template void RleDecoderV2<true>::unpack(
+    int64_t* const data,
+    uint64_t numValues,
+    uint32_t bitWidth);
+
+template void RleDecoderV2<false>::unpack(
+    int64_t* const data,
+    uint64_t numValues,
+    uint32_t bitWidth);
+
+template <bool isSigned>
+void RleDecoderV2<isSigned>::readRunHeader() {
+  // Reading 0 values reads the header of the run.
+  switch (type) {
+    case SHORT_REPEAT:
+      nextShortRepeats(nullptr, 0, 0, nullptr);
+      break;
+    case DIRECT:
+      nextDirect(nullptr, 0, 0, nullptr);
+      break;
+    case PATCHED_BASE:
+      readPatchedHeader();
+      break;
+    case DELTA:
+      nextDelta(nullptr, 0, 0, nullptr);
+      break;
+    default:
+      DWIO_RAISE("unknown encoding");
+  }
+}
+
+template void RleDecoderV2<true>::readRunHeader();
+
+template void RleDecoderV2<false>::readRunHeader();
+
+template <bool isSigned>
+void RleDecoderV2<isSigned>::decodeRun() {
+  VELOX_DCHECK(!runDecoded);
+  if (runRead > 0) {
+    // The run is partially read by next(). Its remaining values are finished
+    // into 'decoded'.
+    decoded.resize(runLength);
+    const auto numRead = runRead;
+    next(decoded.data() + numRead, runLength - numRead, nullptr);
+    runRead = numRead;
+    runDecoded = true;
+    return;
+  }
+  switch (type) {
+    case DIRECT:
+      decoded.resize(runLength);
+      unpack(decoded.data(), runLength, bitSize);
+      if constexpr (isSigned) {
+        for (uint64_t i = 0; i < runLength; ++i) {
+          decoded[i] =
+              ZigZag::decode<uint64_t>(static_cast<uint64_t>(decoded[i]));
+        }
+      }
+      break;
+    case PATCHED_BASE: {
+      unpackPatched();
+      decoded.resize(runLength);
+      auto values = decoded.data();
+      std::copy(unpacked.data(), unpacked.data() + runLength, values);
+      // Each patch is at a gap from the previous one. A gap of over 255 is
+      // split into entries of gap 255 and patch 0.
+      uint64_t index = 0;
+      for (uint64_t i = 0; i < unpackedPatch.size(); ++i) {
+        const uint64_t gap =
+            static_cast<uint64_t>(unpackedPatch[i]) >> patchBitSize;
+        const int64_t patch = unpackedPatch[i] & patchMask;
+        index += gap;
+        if (gap == 255 && patch == 0) {
+          continue;
+        }
+        DWIO_ENSURE_LT(
+            index,
+            runLength,
+            "Corrupt PATCHED_BASE encoded data (patch past end of run)! ",
+            dwio::common::IntDecoder<isSigned>::inputStream->getName());
+        values[index] |= patch << bitSize;
+      }
+      for (uint64_t i = 0; i < runLength; ++i) {
+        values[i] += base;
+      }
+      break;
+    }
+    case DELTA: {
+      VELOX_DCHECK(!isFixedDeltaRun());
+      decoded.resize(runLength);
+      auto values = decoded.data();
+      values[0] = firstValue;
+      if (runLength > 1) {
+        values[1] = firstValue + deltaBase;
+      }
+      if (runLength > 2) {
+        unpack(values + 2, runLength - 2, bitSize);
+        // The deltas after the first are unsigned. Their sign is the sign of
+        // the first delta.
+        if (deltaBase < 0) {
+          for (uint64_t i = 2; i < runLength; ++i) {
+            values[i] = values[i - 1] - values[i];
+          }
+        } else {
+          for (uint64_t i = 2; i < runLength; ++i) {
+            values[i] = values[i - 1] + values[i];
+          }
+        }
+      }
+      break;
+    }
+    default:
+      VELOX_FAIL("Run of type {} has no packed values", static_cast<int>(type));
+  }
+  runDecoded = true;
+}
+
+template void RleDecoderV2<true>::decodeRun();
+
+template void RleDecoderV2<false>::decodeRun();
+
+template <bool isSigned>
+void RleDecoderV2<isSigned>::skipRun() {
+  if (runDecoded || type == SHORT_REPEAT || isFixedDeltaRun()) {
+    advanceRun(runLength - runRead);
+    return;
+  }
+  if (runRead > 0) {
+    // The run is partially read by next(), which may have consumed part of a
+    // byte.
+    skip(runLength - runRead);
+    return;
+  }
+  uint64_t numBits = 0;
+  switch (type) {
+    case DIRECT:
+      numBits = bits::roundUp(runLength * bitSize, 8);
+      break;
+    case PATCHED_BASE:
+      numBits = bits::roundUp(runLength * bitSize, 8) +
+          bits::roundUp(
+              patchListLength *
+                  getClosestFixedBits(patchBitSize + patchGapWidth),
+              8);
+      break;
+    case DELTA:
+      // The first two values are in the header.
+      numBits =
+          runLength > 2 ? bits::roundUp((runLength - 2) * bitSize, 8) : 0;
+      break;
+    default:
+      DWIO_RAISE("unknown encoding");
+  }
+  dwio::common::skipBytes(
+      numBits / 8,
+      dwio::common::IntDecoder<isSigned>::inputStream.get(),
+      dwio::common::IntDecoder<isSigned>::bufferStart,
+      dwio::common::IntDecoder<isSigned>::bufferEnd);
+  runRead = runLength;
+}
+
+template void RleDecoderV2<true>::skipRun();
+
+template void RleDecoderV2<false>::skipRun();
+
 template <bool isSigned>
 int64_t RleDecoderV2<isSigned>::readValue() {
   if (runRead == runLength) {
@@ -590,6 +849,11 @@ int64_t RleDecoderV2<isSigned>::readValue() {
 
   uint64_t nRead = 0;
   int64_t value = 0;
+  if (runDecoded) {
+    nRead = nextDecoded(&value, 0, 1, nullptr);
+    VELOX_CHECK(nRead == (uint64_t)1);
+    return value;
+  }
   switch (type) {
     case SHORT_REPEAT:
       nRead = nextShortRepeats(&value, 0, 1, nullptr);
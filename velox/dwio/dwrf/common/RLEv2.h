@@ -20,6 +20,7 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/Adaptor.h"
 #include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -72,6 +73,10 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
 
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    if (dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+      fastPath<hasNulls>(nulls, visitor);
+      return;
+    }
     int32_t current = visitor.start();
     skip<hasNulls>(current, 0, nulls);
 
@@ -110,6 +115,195 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
  private:
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* nulls, Visitor& visitor) {
+    constexpr bool hasFilter =
+        !std::is_same_v<typename Visitor::FilterType, common::AlwaysTrue>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
+    if (hasNulls) {
+      raw_vector<int32_t>* innerVector = nullptr;
+      auto outerVector = &visitor.outerNonNullRows();
+      if (Visitor::dense) {
+        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
+        if (outerVector->empty()) {
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            folly::Range<const int32_t*>(rows, outerVector->size()),
+            outerVector->data(),
+            visitor);
+      } else {
+        innerVector = &visitor.innerNonNullRows();
+        int32_t tailSkip = -1;
+        auto anyNulls = dwio::common::
+            nonNullRowsFromSparse<hasFilter, !hasFilter && !hasHook>(
+                nulls,
+                rowsAsRange,
+                *innerVector,
+                *outerVector,
+                (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
+                tailSkip);
+        if (anyNulls) {
+          visitor.setHasNulls();
+        }
+        if (innerVector->empty()) {
+          skip<false>(tailSkip, 0, nullptr);
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            *innerVector, outerVector->data(), visitor);
+        skip<false>(tailSkip, 0, nullptr);
+      }
+    } else {
+      bulkScan<hasFilter, hasHook, false>(rowsAsRange, nullptr, visitor);
+    }
+  }
+
+  // Returns 1. how many of 'rows' are in the 'remaining' values of the
+  // current run 2. the distance in rows from the current row to the first
+  // row after the last in rows that falls in the current run.
+  template <bool dense>
+  std::pair<int32_t, std::int32_t> findNumInRun(
+      const int32_t* rows,
+      int32_t rowIndex,
+      int32_t numRows,
+      int32_t currentRow,
+      int32_t remaining) {
+    DCHECK_LT(rowIndex, numRows);
+    if (dense) {
+      auto left = std::min<int32_t>(remaining, numRows - rowIndex);
+      return std::make_pair(left, left);
+    }
+    if (rows[rowIndex] - currentRow >= remaining) {
+      return std::make_pair(0, 0);
+    }
+    if (rows[numRows - 1] - currentRow < remaining) {
+      return std::pair(numRows - rowIndex, rows[numRows - 1] - currentRow + 1);
+    }
+    auto range = folly::Range<const int32_t*>(
+        rows + rowIndex, std::min<int32_t>(remaining, numRows - rowIndex));
+    auto endOfRun = currentRow + remaining;
+    auto bound = std::lower_bound(range.begin(), range.end(), endOfRun);
+    return std::make_pair(bound - range.begin(), bound[-1] - currentRow + 1);
+  }
+
+  // Passes the values of 'nonNullRows' to 'visitor' a run at a time. SHORT_
+  // REPEAT runs and DELTA runs with a fixed delta are given to the visitor as
+  // a start value and a delta without materializing them. Other runs are
+  // decoded as a whole by decodeRun() if they have rows of interest and their
+  // packed values are skipped otherwise.
+  template <bool hasFilter, bool hasHook, bool scatter, typename Visitor>
+  void bulkScan(
+      folly::Range<const int32_t*> nonNullRows,
+      const int32_t* scatterRows,
+      Visitor& visitor) {
+    using T = typename Visitor::DataType;
+    auto numAllRows = visitor.numRows();
+    visitor.setRows(nonNullRows);
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowIndex = 0;
+    int32_t currentRow = 0;
+    auto values = visitor.rawValues(numRows);
+    auto filterHits = hasFilter ? visitor.outputRows(numRows) : nullptr;
+    int32_t numValues = 0;
+    for (;;) {
+      if (runRead == runLength) {
+        resetRun();
+        readRunHeader();
+      }
+      const int32_t remaining = runLength - runRead;
+      auto [numInRun, numAdvanced] = findNumInRun<Visitor::dense>(
+          rows, rowIndex, numRows, currentRow, remaining);
+      if (!numInRun) {
+        // We are not at end and the next row of interest is after this run.
+        VELOX_CHECK(!numAdvanced, "Would advance past end of RLEv2 run");
+      } else {
+        if (!runDecoded && type != SHORT_REPEAT && !isFixedDeltaRun()) {
+          decodeRun();
+        }
+        if (runDecoded) {
+          auto input = values + numValues;
+          const auto run = decoded.data() + runRead;
+          if (Visitor::dense) {
+            for (auto i = 0; i < numInRun; ++i) {
+              input[i] = run[i];
+            }
+          } else {
+            for (auto i = 0; i < numInRun; ++i) {
+              input[i] = run[rows[rowIndex + i] - currentRow];
+            }
+          }
+          visitor.template processRun<hasFilter, hasHook, scatter>(
+              input, numInRun, scatterRows, filterHits, values, numValues);
+        } else {
+          const int64_t delta = type == DELTA ? deltaBase : 0;
+          visitor.template processRle<hasFilter, hasHook, scatter>(
+              static_cast<T>(firstValue + runRead * delta),
+              static_cast<T>(delta),
+              numInRun,
+              currentRow,
+              scatterRows,
+              filterHits,
+              values,
+              numValues);
+        }
+        advanceRun(numAdvanced);
+        currentRow += numAdvanced;
+        rowIndex += numInRun;
+        if (visitor.atEnd()) {
+          visitor.setNumValues(hasFilter ? numValues : numAllRows);
+          return;
+        }
+      }
+      currentRow += runLength - runRead;
+      skipRun();
+    }
+  }
+
+  // True if the current run is a DELTA run with a fixed delta.
+  bool isFixedDeltaRun() const {
+    return type == DELTA && bitSize == 0;
+  }
+
+  // Reads the header of the run started by resetRun(). The packed values of
+  // DIRECT, PATCHED_BASE and DELTA runs with varying deltas are left for
+  // decodeRun() or skipRun().
+  void readRunHeader();
+
+  // Decodes the values of the current run that are not read into 'decoded'.
+  // The run is either partially read by next() or has only its header read.
+  void decodeRun();
+
+  // Moves to the end of the current run. Packed values that are not decoded
+  // are skipped without unpacking them.
+  void skipRun();
+
+  // Reads the header of a PATCHED_BASE run up to and including the base.
+  void readPatchedHeader();
+
+  // Unpacks the values and the patch list of a PATCHED_BASE run whose header
+  // is read.
+  void unpackPatched();
+
+  // Moves 'numValues' forward in a run whose header is read.
+  void advanceRun(uint64_t numValues) {
+    runRead += numValues;
+    if (type == DELTA && runRead > 0) {
+      prevValue = firstValue + (runRead - 1) * deltaBase;
+    }
+  }
+
+  // Reads 'numValues' big endian bit packed values of 'bitWidth' bits into
+  // 'data'. Unused bits in the last byte are skipped.
+  void unpack(int64_t* data, uint64_t numValues, uint32_t bitWidth);
+
   // Used by PATCHED_BASE
   void adjustGapAndPatch() {
     curGap = static_cast<uint64_t>(unpackedPatch[patchIdx]) >> patchBitSize;
@@ -135,6 +329,7 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
 
   void resetRun() {
     resetReadLongs();
+    runDecoded = false;
     bitSize = 0;
     firstByte = readByte();
     type = static_cast<EncodingType>((firstByte >> 6) & 0x03);
@@ -219,6 +414,12 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t offset,
       uint64_t numValues,
       const uint64_t* nulls);
+  // Reads values of a run decoded by decodeRun().
+  uint64_t nextDecoded(
+      int64_t* data,
+      uint64_t offset,
+      uint64_t numValues,
+      const uint64_t* nulls);
 
   int64_t readValue();
 
@@ -233,6 +434,8 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   uint32_t bitsLeft; // Used by anything that uses readLongs
   uint32_t curByte; // Used by anything that uses readLongs
   uint32_t patchBitSize; // Used by PATCHED_BASE
+  uint32_t patchGapWidth; // Used by PATCHED_BASE
+  uint64_t patchListLength; // Used by PATCHED_BASE
   uint64_t unpackedIdx; // Used by PATCHED_BASE
   uint64_t patchIdx; // Used by PATCHED_BASE
   int64_t base; // Used by PATCHED_BASE
@@ -243,6 +446,12 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   EncodingType type;
   dwio::common::DataBuffer<int64_t> unpacked; // Used by PATCHED_BASE
   dwio::common::DataBuffer<int64_t> unpackedPatch; // Used by PATCHED_BASE
+  // True if the values of the current run are in 'decoded'.
+  bool runDecoded;
+  // All values of the current run, indexed by 'runRead'.
+  dwio::common::DataBuffer<int64_t> decoded;
+  // Bit packed bytes that are not contiguous in the input.
+  dwio::common::DataBuffer<char> packed;
 };
 
 } // namespace facebook::velox::dwrf
@@ -748,7 +748,8 @@ DwrfReader::DwrfReader(
           options.getFilePreloadThreshold(),
           options.getFileFormat() == FileFormat::ORC ? FileFormat::ORC
                                                      : FileFormat::DWRF,
-          options.isFileColumnNamesReadAsLowerCase())),
+          options.isFileColumnNamesReadAsLowerCase(),
+          options.fileMetadataCacheKey())),
       options_(options) {
   // If we are not using column names to map table columns to file columns, then
   // we use indices. In that case we need to ensure the names completely match,
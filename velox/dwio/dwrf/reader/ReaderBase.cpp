@@ -18,6 +18,7 @@
 
 #include <fmt/format.h>
 
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/exception/Exception.h"
 
 namespace facebook::velox::dwrf {
@@ -93,19 +94,92 @@ ReaderBase::ReaderBase(
     uint64_t directorySizeGuess,
     uint64_t filePreloadThreshold,
     FileFormat fileFormat,
-    bool fileColumnNamesReadAsLowerCase)
+    bool fileColumnNamesReadAsLowerCase,
+    const std::string& fileMetadataCacheKey)
     : pool_{pool},
       arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
       directorySizeGuess_(directorySizeGuess),
       filePreloadThreshold_(filePreloadThreshold),
       input_(std::move(input)) {
-  // read last bytes into buffer to get PostScript
-  // If file is small, load the entire file.
-  // TODO: make a config
   fileLength_ = input_->getReadFile()->size();
   DWIO_ENSURE(fileLength_ > 0, "ORC file is empty");
 
+  auto* metadataCache = fileMetadataCacheKey.empty()
+      ? nullptr
+      : dwio::common::FileMetadataCache::getInstance();
+  if (metadataCache != nullptr) {
+    tail_ = metadataCache->get<FileTail>(fileMetadataCacheKey, fileFormat);
+  }
+  if (tail_ == nullptr) {
+    tail_ = readTail(fileFormat);
+    if (metadataCache != nullptr) {
+      metadataCache->put(
+          fileMetadataCacheKey, fileFormat, tail_, tail_->bytes());
+    }
+  } else if (fileLength_ <= filePreloadThreshold_) {
+    // The tail is cached but small files are still read in one IO.
+    input_->enqueue({0, fileLength_, "file"});
+    input_->load(LogType::FILE);
+  }
+  psLength_ = tail_->psLength;
+  postScript_ = tail_->postScript;
+  footer_ = std::make_unique<FooterWrapper>(*tail_->footer);
+
+  const uint64_t footerSize = postScript_->footerLength();
+  const uint64_t cacheSize =
+      postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
+  const uint64_t tailSize = 1 + psLength_ + footerSize + cacheSize;
+
+  schema_ = std::dynamic_pointer_cast<const RowType>(
+      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
+  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
+
+  // load stripe index/footer cache
+  if (cacheSize > 0) {
+    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
+    if (input_->shouldPrefetchStripes()) {
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(),
+          *footer_,
+          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
+      input_->load(LogType::FOOTER);
+    } else {
+      if (!input_->isBuffered(fileLength_ - tailSize, cacheSize)) {
+        // The tail came from the metadata cache and was not read.
+        input_->enqueue({fileLength_ - tailSize, cacheSize, "footer"});
+        input_->load(LogType::FOOTER);
+      }
+      auto cacheBuffer =
+          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
+      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
+          ->readFully(cacheBuffer->data(), cacheSize);
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
+    }
+  }
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    auto numStripes = getFooter().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = getFooter().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+}
+
+std::shared_ptr<const FileTail> ReaderBase::readTail(FileFormat fileFormat) {
+  auto tail = std::make_shared<FileTail>();
+  // read last bytes into buffer to get PostScript
+  // If file is small, load the entire file.
+  // TODO: make a config
   auto preloadFile = fileLength_ <= filePreloadThreshold_;
   uint64_t readSize =
       preloadFile ? fileLength_ : std::min(fileLength_, directorySizeGuess_);
@@ -127,16 +201,18 @@ ReaderBase::ReaderBase(
       psLength_ + 4, // 1 byte for post script len, 3 byte "ORC" header.
       fileLength_,
       "Corrupted file, Post script size is invalid");
+  tail->psLength = psLength_;
 
   if (fileFormat == FileFormat::DWRF) {
     auto postScript = ProtoUtils::readProto<proto::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    postScript_ = std::make_shared<PostScript>(std::move(postScript));
   } else {
     auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    postScript_ = std::make_shared<PostScript>(std::move(postScript));
   }
+  tail->postScript = postScript_;
 
   uint64_t footerSize = postScript_->footerLength();
   uint64_t cacheSize =
@@ -164,61 +240,26 @@ ReaderBase::ReaderBase(
     input_->load(LogType::FOOTER);
   }
 
+  // The footer is in an arena of its own so that it can outlive 'this'.
+  tail->arena = std::make_unique<google::protobuf::Arena>();
   auto footerStream = input_->read(
       fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
   if (fileFormat == FileFormat::DWRF) {
-    auto footer =
-        google::protobuf::Arena::CreateMessage<proto::Footer>(arena_.get());
+    auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(
+        tail->arena.get());
     ProtoUtils::readProtoInto<proto::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    tail->footer = std::make_unique<FooterWrapper>(footer);
   } else {
     auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
-        arena_.get());
+        tail->arena.get());
     ProtoUtils::readProtoInto<proto::orc::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    tail->footer = std::make_unique<FooterWrapper>(footer);
   }
-
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
-  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
-
-  // load stripe index/footer cache
-  if (cacheSize > 0) {
-    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
-    if (input_->shouldPrefetchStripes()) {
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(),
-          *footer_,
-          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
-      input_->load(LogType::FOOTER);
-    } else {
-      auto cacheBuffer =
-          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
-      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
-          ->readFully(cacheBuffer->data(), cacheSize);
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
-    }
-  }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    auto numStripes = getFooter().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = getFooter().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes) {
-      input_->load(LogType::FOOTER);
-    }
-  }
-  // initialize file decrypter
-  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+  return tail;
 }
 
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
@@ -57,9 +57,26 @@ class FooterStatisticsImpl : public dwio::common::Statistics {
   }
 };
 
+// Parsed postscript and footer of a DWRF or ORC file. Shared between the
+// readers of the same file through dwio::common::FileMetadataCache.
+struct FileTail {
+  // Owns the footer.
+  std::unique_ptr<google::protobuf::Arena> arena;
+  std::shared_ptr<const PostScript> postScript;
+  std::unique_ptr<FooterWrapper> footer;
+  uint64_t psLength{0};
+
+  // Returns the approximate memory used by 'this'.
+  int64_t bytes() const {
+    return sizeof(*this) + arena->SpaceUsed();
+  }
+};
+
 class ReaderBase {
  public:
-  // create reader base from buffered input
+  // create reader base from buffered input. If 'fileMetadataCacheKey' is not
+  // empty, the parsed tail of the file is shared with other readers of the
+  // same file through the process-wide dwio::common::FileMetadataCache.
   ReaderBase(
       memory::MemoryPool& pool,
       std::unique_ptr<dwio::common::BufferedInput> input,
@@ -70,7 +87,8 @@ class ReaderBase {
       uint64_t filePreloadThreshold =
           dwio::common::ReaderOptions::kDefaultFilePreloadThreshold,
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
-      bool fileColumnNamesReadAsLowerCase = false);
+      bool fileColumnNamesReadAsLowerCase = false,
+      const std::string& fileMetadataCacheKey = "");
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -232,6 +250,9 @@ class ReaderBase {
   }
 
  private:
+  // Reads and parses the postscript and footer.
+  std::shared_ptr<const FileTail> readTail(dwio::common::FileFormat fileFormat);
+
   static std::shared_ptr<const Type> convertType(
       const FooterWrapper& footer,
       uint32_t index = 0,
@@ -239,7 +260,9 @@ class ReaderBase {
 
   memory::MemoryPool& pool_;
   std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
+  // Keeps the footer alive if it comes from the metadata cache.
+  std::shared_ptr<const FileTail> tail_;
+  std::shared_ptr<const PostScript> postScript_;
   std::unique_ptr<FooterWrapper> footer_ = nullptr;
   std::unique_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
@@ -95,6 +95,7 @@ void SelectiveDecimalColumnReader<DataT>::readHelper(RowSet rows) {
 
   // reset numValues_ before reading values
   numValues_ = 0;
+  setConstantRunValues(0);
   valueSize_ = sizeof(DataT);
   ensureValuesCapacity<DataT>(numRows);
 
@@ -153,6 +153,8 @@ void SelectiveTimestampColumnReader::readHelper(
   }
   values_ = tsValues;
   rawValues_ = values_->asMutable<char>();
+  // Runs of equal seconds or nanos do not make equal timestamps.
+  setConstantRunValues(0);
 
   // Treat the filter as kAlwaysTrue if any of the following conditions are met:
   // 1) No filter found;
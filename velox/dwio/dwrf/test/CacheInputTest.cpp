@@ -761,3 +761,53 @@ TEST_F(CacheTest, readAhead) {
 
   LOG(INFO) << count << " prefetches with total " << bytes << " bytes";
 }
+
+TEST_F(CacheTest, adaptiveCoalesce) {
+  constexpr int32_t kStreamSize = 100'000;
+  initializeCache(64 << 20);
+  uint64_t fileId;
+  uint64_t groupId;
+  auto file = inputByPath("adaptiveCoalesce", fileId, groupId);
+  // The tuner for the file system of 'file' has seen a storage with 20ms
+  // latency and 100MB/s, for which gaps larger than the default are worth
+  // reading.
+  auto& tuner = io::CoalesceTuner::forPath(file->getName());
+  for (auto i = 0; i < 100; ++i) {
+    const uint64_t bytes = (1 + i % 10) * 100'000;
+    tuner.recordIo(bytes, 20'000 + bytes / 100);
+  }
+  io::ReaderOptions options(pool_.get());
+  options.setAdaptiveCoalesce(true);
+  const auto expected = tuner.params(
+      {options.maxCoalesceDistance(), options.maxCoalesceBytes()});
+  EXPECT_LT(options.maxCoalesceDistance(), expected.maxGap);
+
+  auto input = std::make_unique<CachedBufferedInput>(
+      file,
+      MetricsLog::voidLog(),
+      fileId,
+      cache_.get(),
+      nullptr,
+      groupId,
+      ioStats_,
+      nullptr,
+      options);
+  std::vector<std::unique_ptr<SeekableInputStream>> streams;
+  for (uint64_t offset : {0UL, 1'000'000UL}) {
+    streams.push_back(input->enqueue(Region{offset, kStreamSize}));
+  }
+  input->load(LogType::TEST);
+  // The loads are planned with the tuned parameters.
+  EXPECT_EQ(1, ioStats_->coalesceMaxGap().count());
+  EXPECT_EQ(expected.maxGap, ioStats_->coalesceMaxGap().sum());
+  EXPECT_EQ(expected.maxBytes, ioStats_->coalesceMaxBytes().sum());
+
+  // Each IO of the loads is recorded on its own.
+  const auto numSamples = tuner.numSamples();
+  const void* buffer;
+  int32_t size;
+  for (auto& stream : streams) {
+    EXPECT_TRUE(stream->Next(&buffer, &size));
+  }
+  EXPECT_EQ(numSamples + streams.size(), tuner.numSamples());
+}
@@ -218,6 +218,81 @@ TEST_F(E2EFilterTest, integerDictionary) {
       true);
 }
 
+TEST_F(E2EFilterTest, integerLongRuns) {
+  // Long runs of one value are filtered once per run and may be
+  // returned as constant vectors. Reads of up to 10000 rows fall
+  // inside or straddle the runs.
+  readSizes_ = {10, 300, 1000, 3000, 10000};
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint",
+      [&]() {
+        for (auto batch = 0; batch < batchCount_; ++batch) {
+          for (auto run = 0; run < 10; ++run) {
+            auto firstRow = run * batchSize_ / 10;
+            auto lastRow = (run + 1) * batchSize_ / 10;
+            makeReapeatingValues<int64_t>(
+                "long_val", batch, firstRow, lastRow, batch * 10 + run);
+            makeReapeatingValues<int32_t>(
+                "int_val", batch, firstRow, lastRow, run % 3);
+          }
+        }
+      },
+      true,
+      {"short_val", "int_val", "long_val"},
+      20,
+      true,
+      true);
+
+  // Reads that fall inside a run of one value return constant vectors, with
+  // and without a filter.
+  constexpr vector_size_t kRows = 10'000;
+  constexpr int32_t kReadSize = 1'000;
+  rowType_ = ROW({"long_val"}, {BIGINT()});
+  auto longs = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kRows, leafPool_.get());
+  for (auto row = 0; row < kRows; ++row) {
+    longs->set(row, row < kRows / 2 ? 7 : 8);
+  }
+  writeToMemory(
+      rowType_,
+      {std::make_shared<RowVector>(
+          leafPool_.get(),
+          rowType_,
+          nullptr,
+          kRows,
+          std::vector<VectorPtr>{longs})},
+      false);
+  auto spec = std::make_shared<ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType_);
+  auto batches = readBatches(spec, kReadSize);
+  ASSERT_EQ(kRows / kReadSize, batches.size());
+  for (auto i = 0; i < batches.size(); ++i) {
+    auto& column = batches[i]->childAt(0);
+    ASSERT_EQ(VectorEncoding::Simple::CONSTANT, column->encoding());
+    EXPECT_EQ(
+        i < batches.size() / 2 ? 7 : 8,
+        column->as<SimpleVector<int64_t>>()->valueAt(0));
+  }
+
+  auto filterSpec = std::make_shared<ScanSpec>("<root>");
+  filterSpec->addAllChildFields(*rowType_);
+  filterSpec->getOrCreateChild(Subfield("long_val"))
+      ->addFilter(BigintRange(8, 8, false));
+  vector_size_t numHits = 0;
+  for (auto& batch : readBatches(filterSpec, kReadSize)) {
+    if (batch->size() == 0) {
+      continue;
+    }
+    auto& column = batch->childAt(0);
+    ASSERT_EQ(VectorEncoding::Simple::CONSTANT, column->encoding());
+    EXPECT_EQ(8, column->as<SimpleVector<int64_t>>()->valueAt(0));
+    numHits += batch->size();
+  }
+  EXPECT_EQ(kRows / 2, numHits);
+}
+
 TEST_F(E2EFilterTest, byteRle) {
   testWithTypes(
       "tiny_val:tinyint,"
@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
@@ -351,6 +352,104 @@ TEST_F(E2EWriterTests, E2E) {
   E2EWriterTestUtil::testWriter(*leafPool_, type, batches, 1, 1, config);
 }
 
+TEST_F(E2EWriterTests, AsyncFlush) {
+  const size_t batchCount = 10;
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "int_val:int,"
+      "long_val:bigint,"
+      "string_val:string,"
+      "array_val:array<float>"
+      ">");
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::COMPRESSION, velox::common::CompressionKind_ZSTD);
+  // Small enough that some flushes wait for earlier stripes to be written.
+  config->set(dwrf::Config::MAX_PENDING_WRITE_BYTES, uint64_t(64 << 10));
+
+  std::vector<VectorPtr> batches;
+  for (size_t i = 0; i < batchCount; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, 1000, *leafPool_, nullptr, i));
+  }
+
+  folly::CPUThreadPoolExecutor executor(2);
+  E2EWriterTestUtil::testWriter(
+      *leafPool_,
+      type,
+      batches,
+      batchCount,
+      batchCount,
+      config,
+      E2EWriterTestUtil::simpleFlushPolicyFactory(true),
+      nullptr,
+      std::numeric_limits<int64_t>::max(),
+      true,
+      &executor);
+}
+
+TEST_F(E2EWriterTests, ParallelEncoding) {
+  const size_t batchCount = 10;
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "int_val:int,"
+      "long_val:bigint,"
+      "string_val:string,"
+      "array_val:array<float>,"
+      "map_val:map<int,string>,"
+      "flat_map_val:map<bigint,double>,"
+      "struct_val:struct<a:float,b:double>"
+      ">");
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::COMPRESSION, velox::common::CompressionKind_ZSTD);
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set(dwrf::Config::MAP_FLAT_COLS, {5});
+
+  std::vector<VectorPtr> batches;
+  for (size_t i = 0; i < batchCount; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, 1000, *leafPool_, nullptr, i));
+  }
+
+  auto writeFile = [&](folly::Executor* encodingExecutor) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    auto writer = E2EWriterTestUtil::writeData(
+        std::move(sink),
+        type,
+        batches,
+        config,
+        E2EWriterTestUtil::simpleFlushPolicyFactory(true),
+        nullptr,
+        std::numeric_limits<int64_t>::max(),
+        nullptr,
+        encodingExecutor);
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  folly::CPUThreadPoolExecutor executor(4);
+  // The stream layout and the stripe footers do not depend on the order in
+  // which the columns are encoded.
+  ASSERT_EQ(writeFile(nullptr), writeFile(&executor));
+
+  E2EWriterTestUtil::testWriter(
+      *leafPool_,
+      type,
+      batches,
+      batchCount,
+      batchCount,
+      config,
+      E2EWriterTestUtil::simpleFlushPolicyFactory(true),
+      nullptr,
+      std::numeric_limits<int64_t>::max(),
+      true,
+      nullptr,
+      &executor);
+}
+
 TEST_F(E2EWriterTests, FlatMapDictionaryEncoding) {
   const size_t batchCount = 4;
   // Start with a size larger than stride to cover splitting into
@@ -18,8 +18,10 @@
 #include <gtest/gtest.h>
 #include <velox/buffer/Buffer.h>
 #include "folly/Random.h"
+#include "folly/ScopeGuard.h"
 #include "folly/lang/Assume.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/FileSink.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -2361,6 +2363,37 @@ TEST(TestReader, testOrcReaderVarchar) {
   EXPECT_EQ(counter, 6000);
 }
 
+TEST(TestReader, testOrcReaderSelectiveInt) {
+  // The int column is a sequence encoded in RLEv2 DELTA runs with a fixed
+  // delta. The other kinds of runs are covered in TestRle.cpp.
+  const std::string intOrc(getExampleFilePath("orc_index_int_string.orc"));
+  dwio::common::ReaderOptions readerOpts{getDefaultPool().get()};
+  readerOpts.setFileFormat(dwio::common::FileFormat::ORC);
+  auto reader = DwrfReader::create(
+      createFileBufferedInput(intOrc, readerOpts.getMemoryPool()),
+      readerOpts);
+  auto& name = reader->rowType()->nameOf(0);
+  for (auto [lower, upper] :
+       {std::pair<int64_t, int64_t>{1, 6000}, {1500, 4500}, {5999, 7000}}) {
+    SCOPED_TRACE(fmt::format("lower={} upper={}", lower, upper));
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addField(name, 0)->setFilter(
+        std::make_unique<common::BigintRange>(lower, upper, false));
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    VectorPtr batch;
+    int64_t expected = lower;
+    while (rowReader->next(700, batch)) {
+      auto ints = batch->as<RowVector>()->childAt(0)->loadedVector();
+      for (auto i = 0; i < batch->size(); ++i) {
+        ASSERT_EQ(expected++, ints->as<SimpleVector<int32_t>>()->valueAt(i));
+      }
+    }
+    EXPECT_EQ(expected, std::min<int64_t>(upper, 6000) + 1);
+  }
+}
+
 TEST(TestReader, testOrcReaderDate) {
   const std::string dateOrc(getExampleFilePath("TestOrcFile.testDate1900.orc"));
   dwio::common::ReaderOptions readerOpts{getDefaultPool().get()};
@@ -2455,6 +2488,69 @@ createWriterReader(
 
 } // namespace
 
+TEST(TestReader, fileMetadataCache) {
+  dwio::common::FileMetadataCache cache(1 << 20);
+  dwio::common::FileMetadataCache::setInstance(&cache);
+  SCOPE_EXIT {
+    dwio::common::FileMetadataCache::setInstance(nullptr);
+  };
+  auto pool = memory::addDefaultLeafMemoryPool();
+  VectorMaker maker(pool.get());
+  auto batch = maker.rowVector(
+      {maker.flatVector<int64_t>(1'000, [](auto row) { return row * 3; }),
+       maker.flatVector<int32_t>(1'000, [](auto row) { return row % 7; })});
+  // One stripe per batch. The default config writes a stripe cache with the
+  // index and footer of each stripe.
+  auto sink = std::make_unique<MemorySink>(
+      1 << 20, FileSink::Options{.pool = pool.get()});
+  auto* sinkPtr = sink.get();
+  auto writer = E2EWriterTestUtil::writeData(
+      std::move(sink),
+      asRowType(batch->type()),
+      {batch, batch, batch},
+      std::make_shared<dwrf::Config>(),
+      E2EWriterTestUtil::simpleFlushPolicyFactory(true));
+  std::string_view data(sinkPtr->data(), sinkPtr->size());
+
+  dwio::common::ReaderOptions readerOpts(pool.get());
+  readerOpts.setFileFormat(FileFormat::DWRF);
+  // Only the tail is read when the reader is made.
+  readerOpts.setFilePreloadThreshold(0);
+  readerOpts.setFileMetadataCacheKey("fileMetadataCache.dwrf");
+  for (auto i = 0; i < 2; ++i) {
+    SCOPED_TRACE(fmt::format("Open {}", i));
+    auto file = std::make_shared<InMemoryReadFile>(data);
+    auto reader = DwrfReader::create(
+        std::make_unique<BufferedInput>(file, *pool), readerOpts);
+    ASSERT_TRUE(reader->getPostscript().hasCacheSize());
+    const auto cacheSize = reader->getPostscript().cacheSize();
+    ASSERT_GT(cacheSize, 0);
+    // The second reader takes the postscript and footer from the cache and
+    // reads only the stripe cache, which the cache does not hold.
+    if (i == 0) {
+      EXPECT_GT(file->bytesRead(), cacheSize);
+    } else {
+      EXPECT_EQ(cacheSize, file->bytesRead());
+    }
+    EXPECT_EQ(i, cache.stats().numHits);
+    EXPECT_EQ(3'000, reader->numberOfRows().value());
+
+    RowReaderOptions rowReaderOpts;
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    VectorPtr result;
+    vector_size_t numRows = 0;
+    while (rowReader->next(500, result)) {
+      for (auto row = 0; row < result->size(); ++row) {
+        ASSERT_TRUE(result->equalValueAt(
+            batch.get(), row, (numRows + row) % batch->size()));
+      }
+      numRows += result->size();
+    }
+    EXPECT_EQ(3'000, numRows);
+  }
+  EXPECT_EQ(1, cache.stats().numEntries);
+}
+
 TEST(TestReader, appendRowNumberColumn) {
   std::vector<std::vector<int32_t>> integerValues{
       {0, 1, 2, 3, 4},
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <fmt/format.h>
 #include <folly/Random.h>
 #include "velox/common/base/Nulls.h"
 #include "velox/dwio/common/IntDecoder.h"
@@ -22,8 +23,11 @@
 #include "velox/dwio/dwrf/common/IntEncoder.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
+DECLARE_bool(avx2); // NOLINT
+
 using namespace facebook::velox::dwio::common;
 using namespace facebook::velox;
 using namespace facebook::velox::dwrf;
@@ -222,3 +226,61 @@ TEST(TestDirect, corruptedInts) {
   testCorruptedVarInts<false>();
   testCorruptedVarInts<true>();
 }
+
+TEST(TestDirect, bulkReadMaskedVarints) {
+  // Reads varints of mixed sizes with and without the SIMD path of
+  // IntDecoder and compares the results for dense and sparse rows.
+  auto pool = memory::addDefaultLeafMemoryPool();
+  constexpr int32_t kCount = 20'000;
+  folly::Random::DefaultGenerator rng;
+  rng.seed(1);
+  std::vector<uint64_t> values(kCount);
+  std::string data;
+  for (auto i = 0; i < kCount; ++i) {
+    // Runs of values of similar size exercise the different shuffles.
+    auto numBytes = 1 + (i / 64 + folly::Random::rand32(rng) % 3) % 10;
+    values[i] = numBytes == 10
+        ? folly::Random::rand64(rng)
+        : folly::Random::rand64(rng) & ((1UL << (7 * numBytes)) - 1);
+    for (auto value = values[i];; value >>= 7) {
+      if (value < 0x80) {
+        data.push_back(value);
+        break;
+      }
+      data.push_back(0x80 | (value & 0x7f));
+    }
+  }
+  std::vector<int32_t> sparseRows;
+  std::vector<int32_t> denseRows;
+  for (auto i = 3; i < kCount; ++i) {
+    if (folly::Random::rand32(rng) % 10 < 7) {
+      denseRows.push_back(i);
+    }
+    if (i % 11 == 0) {
+      sparseRows.push_back(i);
+    }
+  }
+  auto makeDecoder = [&](uint64_t blockSize) {
+    return createDirectDecoder<false>(
+        std::make_unique<SeekableArrayInputStream>(
+            data.data(), data.size(), blockSize),
+        true,
+        sizeof(int64_t));
+  };
+  for (auto avx2 : {false, true}) {
+    SCOPED_TRACE(fmt::format("avx2={}", avx2));
+    FLAGS_avx2 = avx2; // NOLINT
+    for (uint64_t blockSize : {100, 1'000, 0}) {
+      std::vector<uint64_t> result(kCount);
+      makeDecoder(blockSize)->bulkRead(kCount, result.data());
+      ASSERT_EQ(values, result);
+      for (auto* rows : {&denseRows, &sparseRows}) {
+        makeDecoder(blockSize)->bulkReadRows(*rows, result.data());
+        for (auto i = 0; i < rows->size(); ++i) {
+          ASSERT_EQ(values[(*rows)[i]], result[i]);
+        }
+      }
+    }
+  }
+  FLAGS_avx2 = true; // NOLINT
+}
@@ -16,11 +16,15 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 #include "velox/common/base/Nulls.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
+#include "velox/dwio/dwrf/common/RLEv2.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
+#include "velox/type/Filter.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::dwrf;
@@ -666,6 +670,262 @@ TEST(RLEv2, bitsLeftByPreviousStream) {
   }
 };
 
+namespace {
+
+// Visitor with the bulk interface of dwio::common::ColumnVisitor that
+// collects the values of 'rows' into 'values' without a filter.
+template <bool isDense>
+class CollectingVisitor {
+ public:
+  using FilterType = common::AlwaysTrue;
+  using HookType = dwio::common::NoHook;
+  using DataType = int64_t;
+  static constexpr bool dense = isDense;
+  static constexpr bool kHasBulkPath = true;
+
+  CollectingVisitor(
+      const std::vector<int32_t>& rows,
+      std::vector<int64_t>& values)
+      : rows_(rows.data()), numRows_(rows.size()), values_(&values) {}
+
+  const int32_t* rows() const {
+    return rows_;
+  }
+
+  int32_t numRows() const {
+    return numRows_;
+  }
+
+  void setRows(folly::Range<const int32_t*> rows) {
+    rows_ = rows.data();
+    numRows_ = rows.size();
+  }
+
+  int32_t start() const {
+    return rows_[0];
+  }
+
+  bool allowNulls() const {
+    return false;
+  }
+
+  bool atEnd() const {
+    return rowIndex_ >= numRows_;
+  }
+
+  int64_t* rawValues(int32_t numRows) {
+    values_->resize(numRows);
+    return values_->data();
+  }
+
+  int32_t* outputRows(int32_t /*numRows*/) {
+    return nullptr;
+  }
+
+  uint64_t* rawNulls(int32_t /*numRows*/) {
+    return nullptr;
+  }
+
+  raw_vector<int32_t>& outerNonNullRows() {
+    return outerNonNullRows_;
+  }
+
+  raw_vector<int32_t>& innerNonNullRows() {
+    return innerNonNullRows_;
+  }
+
+  void setHasNulls() {}
+
+  void setAllNull(int32_t /*numValues*/) {}
+
+  void setNumValues(int32_t numValues) {
+    values_->resize(numValues);
+  }
+
+  int32_t processNull(bool& /*atEnd*/) {
+    VELOX_UNREACHABLE();
+  }
+
+  int32_t checkAndSkipNulls(
+      const uint64_t* /*nulls*/,
+      int32_t& /*current*/,
+      bool& /*atEnd*/) {
+    VELOX_UNREACHABLE();
+  }
+
+  // Used instead of the bulk path on machines without AVX2.
+  int32_t process(int64_t value, bool& atEnd) {
+    values_->push_back(value);
+    if (++rowIndex_ == numRows_) {
+      atEnd = true;
+      return 0;
+    }
+    return rows_[rowIndex_] - rows_[rowIndex_ - 1] - 1;
+  }
+
+  template <bool hasFilter, bool hasHook, bool scatter>
+  void processRun(
+      const int64_t* input,
+      int32_t numInput,
+      const int32_t* /*scatterRows*/,
+      int32_t* /*filterHits*/,
+      int64_t* values,
+      int32_t& numValues) {
+    std::copy(input, input + numInput, values + numValues);
+    numValues += numInput;
+    rowIndex_ += numInput;
+  }
+
+  template <bool hasFilter, bool hasHook, bool scatter>
+  void processRle(
+      int64_t value,
+      int64_t delta,
+      int32_t numRows,
+      int32_t currentRow,
+      const int32_t* /*scatterRows*/,
+      int32_t* /*filterHits*/,
+      int64_t* values,
+      int32_t& numValues) {
+    for (auto i = 0; i < numRows; ++i) {
+      values[numValues + i] =
+          value + (rows_[rowIndex_ + i] - currentRow) * delta;
+    }
+    numValues += numRows;
+    rowIndex_ += numRows;
+  }
+
+ private:
+  const int32_t* rows_;
+  int32_t numRows_;
+  int32_t rowIndex_{0};
+  std::vector<int64_t>* values_;
+  raw_vector<int32_t> outerNonNullRows_;
+  raw_vector<int32_t> innerNonNullRows_;
+};
+
+// Returns the values at 'rows' after reading 'numRead' values with next().
+// 'rows' are relative to the first value not read.
+template <bool dense>
+std::vector<int64_t> bulkDecodeRLEv2(
+    const std::vector<unsigned char>& bytes,
+    int32_t numRead,
+    const std::vector<int32_t>& rows) {
+  auto pool = memory::addDefaultLeafMemoryPool();
+  RleDecoderV2<true> rle(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          bytes.data(), bytes.size()),
+      *pool);
+  std::vector<int64_t> values(numRead);
+  rle.next(values.data(), numRead, nullptr);
+  values.clear();
+  rle.readWithVisitor<false>(
+      nullptr, CollectingVisitor<dense>(rows, values));
+  return values;
+}
+
+} // namespace
+
+TEST(RLEv2, bulkScan) {
+  // Runs of each kind, with the DIRECT and PATCHED_BASE runs also in the
+  // middle of the stream.
+  const std::vector<std::vector<unsigned char>> runs = {
+      // DIRECT: 0, 2 repeated 10 times.
+      {0x46, 0x13, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},
+      // PATCHED_BASE: 10 values, one of them patched.
+      {0x8e,
+       0x09,
+       0x2b,
+       0x21,
+       0x07,
+       0xd0,
+       0x1e,
+       0x00,
+       0x14,
+       0x70,
+       0x28,
+       0x32,
+       0x3c,
+       0x46,
+       0x50,
+       0x5a,
+       0xfc,
+       0xe8},
+      // DELTA with varying deltas: -500, -400, -350, -325, -310.
+      {0xce, 0x04, 0xe7, 0x07, 0xc8, 0x01, 0x32, 0x19, 0x0f},
+      // SHORT_REPEAT: 1 repeated 3 times.
+      {0x00, 0x02},
+      // DELTA with a fixed delta: 0 to 19.
+      {0xc0, 0x13, 0x00, 0x02},
+      // DIRECT: 0, 1 repeated 10 times.
+      {0x42, 0x13, 0x22, 0x22, 0x22, 0x22, 0x22},
+      // DELTA with varying deltas: -500, -600, -650, -675, -710.
+      {0xce, 0x04, 0xe7, 0x07, 0xc7, 0x01, 0x32, 0x19, 0x23},
+      // PATCHED_BASE as above.
+      {0x8e,
+       0x09,
+       0x2b,
+       0x21,
+       0x07,
+       0xd0,
+       0x1e,
+       0x00,
+       0x14,
+       0x70,
+       0x28,
+       0x32,
+       0x3c,
+       0x46,
+       0x50,
+       0x5a,
+       0xfc,
+       0xe8},
+  };
+  std::vector<unsigned char> bytes;
+  for (const auto& run : runs) {
+    bytes.insert(bytes.end(), run.begin(), run.end());
+  }
+  const int32_t numValues = 20 + 10 + 5 + 3 + 20 + 20 + 5 + 10;
+  const auto expected = decodeRLEv2(bytes.data(), bytes.size(), 1, numValues);
+  ASSERT_EQ(-400, expected[31]);
+  ASSERT_EQ(19, expected[57]);
+
+  // Rows in a subset of the runs after reading 'numRead' values. The runs
+  // without rows are skipped without decoding them.
+  for (auto numRead : {0, 3, 25, 31, 60}) {
+    SCOPED_TRACE(fmt::format("numRead={}", numRead));
+    const int32_t numRows = numValues - numRead;
+    std::vector<std::vector<int32_t>> rowSets;
+    rowSets.push_back({numRows - 1});
+    std::vector<int32_t> everyThird;
+    for (auto row = 0; row < numRows; row += 3) {
+      everyThird.push_back(row);
+    }
+    rowSets.push_back(std::move(everyThird));
+    // Rows in every other run, so that runs of each kind are skipped.
+    std::vector<int32_t> sparse;
+    for (auto row : {1, 31, 60, 90}) {
+      if (row >= numRead) {
+        sparse.push_back(row - numRead);
+      }
+    }
+    rowSets.push_back(std::move(sparse));
+    for (const auto& rows : rowSets) {
+      const auto values = bulkDecodeRLEv2<false>(bytes, numRead, rows);
+      ASSERT_EQ(rows.size(), values.size());
+      for (auto i = 0; i < rows.size(); ++i) {
+        ASSERT_EQ(expected[numRead + rows[i]], values[i]) << "row " << rows[i];
+      }
+    }
+
+    std::vector<int32_t> allRows(numRows);
+    std::iota(allRows.begin(), allRows.end(), 0);
+    const auto values = bulkDecodeRLEv2<true>(bytes, numRead, allRows);
+    ASSERT_EQ(
+        std::vector<int64_t>(expected.begin() + numRead, expected.end()),
+        values);
+  }
+}
+
 TEST(RLEv1, simpleTest) {
   auto pool = memory::addDefaultLeafMemoryPool();
   const unsigned char buffer[] = {
@@ -17,6 +17,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "folly/Random.h"
+#include "folly/executors/CPUThreadPoolExecutor.h"
 #include "velox/dwio/dwrf/writer/WriterSink.h"
 
 using namespace ::testing;
@@ -492,3 +493,54 @@ TEST_F(WriterSinkTests, SetModeOutOfOrder) {
   sink.addBuffer(*pool, data.data(), 10);
   ASSERT_EQ(sink.getChecksum()->getDigest(false), 977966233);
 }
+
+TEST_F(WriterSinkTests, AsyncWrite) {
+  auto pool = addDefaultLeafMemoryPool();
+  constexpr int32_t kNumFlushes = 8;
+  MemorySink out{3 + kNumFlushes * 1024, {.pool = pool.get()}};
+  Config config;
+  config.set(Config::CHECKSUM_ALGORITHM, proto::ChecksumAlgorithm::NULL_);
+  config.set(Config::STRIPE_CACHE_MODE, StripeCacheMode::NA);
+  folly::CPUThreadPoolExecutor executor(2);
+  WriterSink sink{out, *pool, config};
+  auto offset = out.size();
+  // At most two flushes are pending at any time.
+  sink.setExecutor(&executor, 2 * data.size());
+
+  sink.setMode(WriterSink::Mode::Data);
+  for (auto i = 0; i < kNumFlushes; ++i) {
+    sink.addBuffer(*pool, data.data(), 512);
+    sink.addBuffer(*pool, data.data() + 512, 512);
+    ASSERT_EQ(sink.size(), offset + (i + 1) * data.size());
+    sink.flush();
+    ASSERT_EQ(sink.size(), offset + (i + 1) * data.size());
+  }
+  sink.setMode(WriterSink::Mode::None);
+
+  sink.waitForWrites();
+  ASSERT_EQ(out.size() - offset, kNumFlushes * data.size());
+  for (auto i = 0; i < kNumFlushes; ++i) {
+    ASSERT_EQ(
+        std::string(out.data() + offset + i * data.size(), data.size()),
+        std::string(data.data(), data.size()));
+  }
+}
+
+TEST_F(WriterSinkTests, AsyncWriteError) {
+  auto pool = addDefaultLeafMemoryPool();
+  // Too small for the data, so that the background write fails.
+  MemorySink out{1024, {.pool = pool.get()}};
+  Config config;
+  config.set(Config::CHECKSUM_ALGORITHM, proto::ChecksumAlgorithm::NULL_);
+  config.set(Config::STRIPE_CACHE_MODE, StripeCacheMode::NA);
+  folly::CPUThreadPoolExecutor executor(1);
+  WriterSink sink{out, *pool, config};
+  sink.setExecutor(&executor, 1 << 20);
+
+  sink.setMode(WriterSink::Mode::Data);
+  sink.addBuffer(*pool, data.data(), data.size());
+  sink.flush();
+  sink.setMode(WriterSink::Mode::None);
+  EXPECT_ANY_THROW(sink.waitForWrites());
+  EXPECT_ANY_THROW(sink.flush());
+}
@@ -37,7 +37,9 @@ namespace facebook::velox::dwrf {
     std::function<std::unique_ptr<DWRFFlushPolicy>()> flushPolicyFactory,
     std::function<std::unique_ptr<LayoutPlanner>(const TypeWithId&)>
         layoutPlannerFactory,
-    const int64_t writerMemoryCap) {
+    const int64_t writerMemoryCap,
+    folly::Executor* flushExecutor,
+    folly::Executor* encodingExecutor) {
   // write file to memory
   dwrf::WriterOptions options;
   options.config = config;
@@ -45,6 +47,8 @@ namespace facebook::velox::dwrf {
   options.memoryBudget = writerMemoryCap;
   options.flushPolicyFactory = flushPolicyFactory;
   options.layoutPlannerFactory = layoutPlannerFactory;
+  options.flushExecutor = flushExecutor;
+  options.encodingExecutor = encodingExecutor;
 
   auto writer = std::make_unique<dwrf::Writer>(
       std::move(sink),
@@ -72,7 +76,9 @@ namespace facebook::velox::dwrf {
     std::function<std::unique_ptr<LayoutPlanner>(const TypeWithId&)>
         layoutPlannerFactory,
     const int64_t writerMemoryCap,
-    const bool verifyContent) {
+    const bool verifyContent,
+    folly::Executor* flushExecutor,
+    folly::Executor* encodingExecutor) {
   // write file to memory
   auto sink = std::make_unique<MemorySink>(
       200 * 1024 * 1024, FileSink::Options{.pool = &pool});
@@ -86,7 +92,9 @@ namespace facebook::velox::dwrf {
       config,
       flushPolicyFactory,
       layoutPlannerFactory,
-      writerMemoryCap);
+      writerMemoryCap,
+      flushExecutor,
+      encodingExecutor);
   // read it back and compare
   auto readFile = std::make_shared<InMemoryReadFile>(
       std::string_view(sinkPtr->data(), sinkPtr->size()));
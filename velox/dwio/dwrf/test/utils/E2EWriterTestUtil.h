@@ -37,6 +37,10 @@ class E2EWriterTestUtil {
    *    layoutPlannerFactory    supplies the layout planner and determine how
    *                            order of the data streams prior to flush
    *    writerMemoryCap         total memory budget for the writer
+   *    flushExecutor           if set, writes flushed stripes on this
+   *                            executor
+   *    encodingExecutor        if set, encodes the columns in parallel on
+   *                            this executor
    */
   static std::unique_ptr<Writer> writeData(
       std::unique_ptr<dwio::common::FileSink> sink,
@@ -47,7 +51,9 @@ class E2EWriterTestUtil {
           nullptr,
       std::function<std::unique_ptr<LayoutPlanner>(
           const dwio::common::TypeWithId&)> layoutPlannerFactory = nullptr,
-      const int64_t writerMemoryCap = std::numeric_limits<int64_t>::max());
+      const int64_t writerMemoryCap = std::numeric_limits<int64_t>::max(),
+      folly::Executor* flushExecutor = nullptr,
+      folly::Executor* encodingExecutor = nullptr);
 
   /**
    * Creates a writer with the supplied configuration and check the IO
@@ -68,7 +74,9 @@ class E2EWriterTestUtil {
       std::function<std::unique_ptr<LayoutPlanner>(
           const dwio::common::TypeWithId&)> layoutPlannerFactory = nullptr,
       const int64_t writerMemoryCap = std::numeric_limits<int64_t>::max(),
-      const bool verifyContent = true);
+      const bool verifyContent = true,
+      folly::Executor* flushExecutor = nullptr,
+      folly::Executor* encodingExecutor = nullptr);
 
   static std::vector<VectorPtr> generateBatches(
       const std::shared_ptr<const Type>& type,
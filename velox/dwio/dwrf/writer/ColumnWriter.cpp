@@ -15,7 +15,14 @@
  */
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
+
+#include <atomic>
+#include <deque>
+#include <optional>
+
+#include <folly/ScopeGuard.h>
 #include <velox/dwio/common/exception/Exception.h>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/dwio/common/ChainedBuffer.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
@@ -35,7 +42,12 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  // Column writers running on the encoding executor cannot share the
+  // selectivity vector.
+  std::optional<SelectivityVector> localSelected;
+  auto& selected = context_.encodingExecutor() == nullptr
+      ? context_.getSharedSelectivityVector(slice->size())
+      : localSelected.emplace(slice->size());
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -1594,27 +1606,110 @@ class StructColumnWriter : public BaseColumnWriter {
       std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
       std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
     BaseColumnWriter::flush(encodingFactory, encodingOverride);
-    for (auto& c : children_) {
-      c->flush(encodingFactory);
+    if (!runsChildrenInParallel()) {
+      for (auto& c : children_) {
+        c->flush(encodingFactory);
+      }
+      return;
+    }
+    // The children add their encodings to the footer in child order, as when
+    // flushing serially.
+    std::vector<std::deque<std::pair<uint32_t, proto::ColumnEncoding>>>
+        encodings(children_.size());
+    forEachChild([&](size_t i) {
+      children_[i]->flush([&childEncodings = encodings[i]](
+                              uint32_t nodeId) -> proto::ColumnEncoding& {
+        return childEncodings.emplace_back(nodeId, proto::ColumnEncoding{})
+            .second;
+      });
+    });
+    for (auto& childEncodings : encodings) {
+      for (auto& [nodeId, encoding] : childEncodings) {
+        encodingFactory(nodeId).Swap(&encoding);
+      }
     }
   }
 
+  bool tryAbandonDictionaries(bool force) override {
+    std::atomic_bool result{false};
+    forEachChild([&](size_t i) {
+      if (children_[i]->tryAbandonDictionaries(force)) {
+        result = true;
+      }
+    });
+    return result;
+  }
+
  private:
+  // True if the children of the root are written and flushed concurrently on
+  // the encoding executor.
+  bool runsChildrenInParallel() const {
+    return isRoot() && context_.encodingExecutor() != nullptr &&
+        children_.size() > 1;
+  }
+
+  // Calls 'func' with the index of each child. If runsChildrenInParallel(),
+  // the calls run as tasks on the encoding executor. Each child owns its
+  // streams, so the stream contents do not depend on the scheduling.
+  void forEachChild(const std::function<void(size_t)>& func);
+
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
 };
 
+void StructColumnWriter::forEachChild(const std::function<void(size_t)>& func) {
+  if (!runsChildrenInParallel()) {
+    for (size_t i = 0; i < children_.size(); ++i) {
+      func(i);
+    }
+    return;
+  }
+  auto* executor = context_.encodingExecutor();
+  std::vector<std::shared_ptr<AsyncSource<bool>>> tasks;
+  tasks.reserve(children_.size());
+  auto sync = folly::makeGuard([&]() {
+    // The tasks reference 'func' and must all be finished before returning,
+    // also when one of them failed. The first error is already rethrown.
+    for (auto& task : tasks) {
+      try {
+        task->move();
+      } catch (const std::exception&) {
+      }
+    }
+  });
+  for (size_t i = 0; i < children_.size(); ++i) {
+    tasks.push_back(std::make_shared<AsyncSource<bool>>([&func, i]() {
+      func(i);
+      return std::make_unique<bool>(true);
+    }));
+    executor->add([task = tasks.back()]() { task->prepare(); });
+  }
+  // Tasks not yet started on 'executor' run on this thread.
+  for (auto& task : tasks) {
+    task->move();
+  }
+}
+
 uint64_t StructColumnWriter::writeChildrenAndStats(
     const RowVector* rowSlice,
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
   if (ranges.size() > 0) {
-    for (size_t i = 0; i < children_.size(); ++i) {
-      rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+    if (runsChildrenInParallel()) {
+      // Lazy vectors are loaded on this thread before the children are
+      // written in parallel.
+      for (auto& child : rowSlice->children()) {
+        child->loadedVector();
+      }
     }
+    std::atomic<uint64_t> childrenRawSize{0};
+    forEachChild([&](size_t i) {
+      childrenRawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+    });
+    rawSize = childrenRawSize;
   }
   if (nullCount) {
     indexStatsBuilder_->setHasNull();
@@ -66,6 +66,12 @@ Writer::Writer(
   writerBase_->initContext(options.config, pool, std::move(handler));
   auto& context = writerBase_->getContext();
   context.buildPhysicalSizeAggregators(*schema_);
+  if (options.flushExecutor != nullptr) {
+    writerBase_->getSink().setExecutor(
+        options.flushExecutor,
+        context.getConfig(Config::MAX_PENDING_WRITE_BYTES));
+  }
+  context.setEncodingExecutor(options.encodingExecutor);
   if (options.flushPolicyFactory == nullptr) {
     flushPolicy_ = std::make_unique<DefaultFlushPolicy>(
         context.stripeSizeFlushThreshold(),
@@ -681,6 +687,8 @@ dwrf::WriterOptions getDwrfOptions(const dwio::common::WriterOptions& options) {
   dwrfOptions.schema = options.schema;
   dwrfOptions.memoryPool = options.memoryPool;
   dwrfOptions.memoryReclaimConfig = options.memoryReclaimConfig;
+  dwrfOptions.flushExecutor = options.flushExecutor;
+  dwrfOptions.encodingExecutor = options.encodingExecutor;
   return dwrfOptions;
 }
 
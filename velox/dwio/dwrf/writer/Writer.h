@@ -44,6 +44,13 @@ struct WriterOptions {
   std::shared_ptr<encryption::EncryptionSpecification> encryptionSpec;
   std::shared_ptr<dwio::common::encryption::EncrypterFactory> encrypterFactory;
   int64_t memoryBudget = std::numeric_limits<int64_t>::max();
+  /// If set, flushed stripes are written to the sink on this executor while
+  /// the writer encodes the next stripe. Config::MAX_PENDING_WRITE_BYTES
+  /// bounds the flushed data not yet written.
+  folly::Executor* flushExecutor{nullptr};
+  /// If set, the columns of the schema are written and flushed as parallel
+  /// tasks on this executor. The file is the same as when writing serially.
+  folly::Executor* encodingExecutor{nullptr};
   std::function<std::unique_ptr<ColumnWriter>(
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include <limits>
+#include <mutex>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -71,18 +74,24 @@ class WriterContext : public CompressionBufferPool {
   // flush policy evaluation and would be more accurate after flush.
   std::unique_ptr<BufferedOutputStream> newStream(
       const DwrfStreamIdentifier& stream) {
+    // Column writers create streams lazily, e.g. when choosing the encoding at
+    // flush, and may run concurrently on the encoding executor.
+    std::unique_lock<std::mutex> l(streamMutex_);
     VELOX_CHECK(
         !hasStream(stream), "Stream already exists: {}", stream.toString());
 
-    streams_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(stream),
-        std::forward_as_tuple(
-            getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
-            compressionBlockSize(),
-            getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
-            getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)));
-    auto& holder = streams_.at(stream);
+    auto& holder =
+        streams_
+            .emplace(
+                std::piecewise_construct,
+                std::forward_as_tuple(stream),
+                std::forward_as_tuple(
+                    getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
+                    compressionBlockSize(),
+                    getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
+                    getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)))
+            .first->second;
+    l.unlock();
     auto encrypter = handler_->isEncrypted(stream.encodingKey().node())
         ? std::addressof(
               handler_->getEncryptionProvider(stream.encodingKey().node()))
@@ -112,6 +121,7 @@ class WriterContext : public CompressionBufferPool {
       const EncodingKey& encodingKey,
       velox::memory::MemoryPool& dictionaryPool,
       velox::memory::MemoryPool& generalPool) {
+    std::lock_guard<std::mutex> l(dictEncoderMutex_);
     auto result = dictEncoders_.find(encodingKey);
     if (result == dictEncoders_.end()) {
       auto emplaceResult = dictEncoders_.emplace(
@@ -143,6 +153,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void suppressStream(const DwrfStreamIdentifier& stream) {
+    std::lock_guard<std::mutex> l(streamMutex_);
     VELOX_CHECK(hasStream(stream));
     auto& collector = streams_.at(stream);
     collector.suppress();
@@ -247,6 +258,12 @@ class WriterContext : public CompressionBufferPool {
 
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (compressionBuffer_ == nullptr && encodingExecutor_ != nullptr) {
+      // Another column writer is compressing a page concurrently.
+      return std::make_unique<dwio::common::DataBuffer<char>>(
+          *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+    }
     VELOX_CHECK_NOT_NULL(compressionBuffer_);
     VELOX_CHECK_GE(compressionBuffer_->size(), size);
     return std::move(compressionBuffer_);
@@ -255,10 +272,25 @@ class WriterContext : public CompressionBufferPool {
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
+    std::lock_guard<std::mutex> l(mutex_);
+    if (compressionBuffer_ != nullptr && encodingExecutor_ != nullptr) {
+      return;
+    }
     VELOX_CHECK_NULL(compressionBuffer_);
     compressionBuffer_ = std::move(buffer);
   }
 
+  /// Sets the executor on which the root column writer writes and flushes its
+  /// children concurrently. Pages compressed while the shared compression
+  /// buffer is in use get a buffer of their own. Must be set before writing.
+  void setEncodingExecutor(folly::Executor* executor) {
+    encodingExecutor_ = executor;
+  }
+
+  folly::Executor* encodingExecutor() const {
+    return encodingExecutor_;
+  }
+
   void incrementNodeSize(uint32_t node, uint64_t size) {
     nodeSize_[node] += size;
   }
@@ -578,6 +610,7 @@ class WriterContext : public CompressionBufferPool {
   void setMemoryReclaimers();
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(mutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -587,6 +620,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(mutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
@@ -629,6 +663,13 @@ class WriterContext : public CompressionBufferPool {
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
   std::unique_ptr<velox::SelectivityVector> selectivityVector_;
+  folly::Executor* encodingExecutor_{nullptr};
+  // Serialize the state shared by column writers running on
+  // 'encodingExecutor_'. 'mutex_' guards 'compressionBuffer_' and
+  // 'decodedVectorPool_'.
+  std::mutex mutex_;
+  std::mutex streamMutex_;
+  std::mutex dictEncoderMutex_;
 
   std::unique_ptr<encryption::EncryptionHandler> handler_;
   folly::F14FastMap<uint32_t, uint64_t> nodeSize_;
@@ -17,6 +17,110 @@
 #include "velox/dwio/dwrf/writer/WriterSink.h"
 
 namespace facebook::velox::dwrf {
+
+WriterSink::~WriterSink() {
+  if (executor_) {
+    std::unique_lock<std::mutex> l(mutex_);
+    // Data not yet written is dropped, as when the writer is aborted.
+    pending_.clear();
+    pendingChanged_.wait(l, [&]() { return !writing_; });
+  }
+  if (!buffers_.empty() || size_ != 0) {
+    LOG(WARNING) << "Unflushed data in writer sink!";
+  }
+}
+
+void WriterSink::setExecutor(
+    folly::Executor* executor,
+    uint64_t maxPendingBytes) {
+  DWIO_ENSURE_NOT_NULL(executor);
+  DWIO_ENSURE(executor_ == nullptr, "Executor is already set");
+  flushedSize_ = sink_->size();
+  maxPendingBytes_ = maxPendingBytes;
+  executor_ = executor;
+}
+
+void WriterSink::flush() {
+  if (!executor_) {
+    sink_->write(buffers_);
+    buffers_.clear();
+    size_ = 0;
+    return;
+  }
+  bool schedule = false;
+  {
+    std::unique_lock<std::mutex> l(mutex_);
+    pendingChanged_.wait(l, [&]() {
+      return writeError_ || pendingBytes_ == 0 ||
+          pendingBytes_ + size_ <= maxPendingBytes_;
+    });
+    if (writeError_) {
+      std::rethrow_exception(writeError_);
+    }
+    if (buffers_.empty()) {
+      return;
+    }
+    pending_.push_back(std::move(buffers_));
+    pendingBytes_ += size_;
+    if (!writing_) {
+      writing_ = true;
+      schedule = true;
+    }
+  }
+  buffers_.clear();
+  flushedSize_ += size_;
+  size_ = 0;
+  if (schedule) {
+    executor_->add([this]() { writePending(); });
+  }
+}
+
+void WriterSink::writePending() {
+  for (;;) {
+    std::vector<dwio::common::DataBuffer<char>> buffers;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (pending_.empty()) {
+        writing_ = false;
+        // Notify under the lock, the destructor may run as soon as it is
+        // released.
+        pendingChanged_.notify_all();
+        return;
+      }
+      buffers = std::move(pending_.front());
+      pending_.pop_front();
+    }
+    uint64_t bytes = 0;
+    for (const auto& buffer : buffers) {
+      bytes += buffer.size();
+    }
+    try {
+      sink_->write(buffers);
+    } catch (const std::exception&) {
+      std::lock_guard<std::mutex> l(mutex_);
+      writeError_ = std::current_exception();
+      // Nothing after a failed write can be placed in the file.
+      pending_.clear();
+    }
+    // Frees the written buffers before waking up the producer.
+    buffers.clear();
+    std::lock_guard<std::mutex> l(mutex_);
+    pendingBytes_ = pending_.empty() ? 0 : pendingBytes_ - bytes;
+    pendingChanged_.notify_all();
+  }
+}
+
+void WriterSink::waitForWrites() {
+  if (!executor_) {
+    return;
+  }
+  std::unique_lock<std::mutex> l(mutex_);
+  pendingChanged_.wait(l, [&]() { return !writing_; });
+  if (writeError_) {
+    std::rethrow_exception(writeError_);
+  }
+}
+
 void WriterSink::addBuffer(dwio::common::DataBuffer<char> buffer) {
   const auto length = buffer.size();
   if (length > 0) {
@@ -51,7 +155,7 @@ void WriterSink::addBuffer(dwio::common::DataBuffer<char> buffer) {
       }
     }
   }
-  if (shouldBuffer_) {
+  if (shouldBuffer_ || executor_) {
     buffers_.push_back(std::move(buffer));
     size_ += length;
   } else {
@@ -16,8 +16,13 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <folly/container/Array.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 #include "velox/dwio/common/DataBufferHolder.h"
 #include "velox/dwio/dwrf/common/Checksum.h"
 #include "velox/dwio/dwrf/common/Config.h"
@@ -60,16 +65,25 @@ class WriterSink {
     addBuffer(pool, ORC_MAGIC.data(), ORC_MAGIC_LEN);
   }
 
-  ~WriterSink() {
-    if (!buffers_.empty() || size_ != 0) {
-      LOG(WARNING) << "Unflushed data in writer sink!";
-    }
-  }
+  ~WriterSink();
 
   uint64_t size() const {
-    return sink_->size() + size_;
+    return (executor_ ? flushedSize_ : sink_->size()) + size_;
   }
 
+  // Makes flush() hand the buffered data to 'executor' for writing to the
+  // FileSink so that the caller can continue with the next stripe while
+  // the previous one is written. Writes complete in file order. flush()
+  // waits while more than 'maxPendingBytes' would be handed off and not
+  // yet written, except that it always accepts data when nothing is
+  // pending. Pending buffers stay allocated from the pool they were
+  // created in until written.
+  void setExecutor(folly::Executor* executor, uint64_t maxPendingBytes);
+
+  // Waits for all data handed off by flush() to be written. Rethrows the
+  // first error from a background write.
+  void waitForWrites();
+
   void addBuffer(memory::MemoryPool& pool, const char* data, size_t size) {
     dwio::common::DataBuffer<char> buf{pool, size};
     std::memcpy(buf.data(), data, size);
@@ -86,11 +100,7 @@ class WriterSink {
     other.clear();
   }
 
-  void flush() {
-    sink_->write(buffers_);
-    buffers_.clear();
-    size_ = 0;
-  }
+  void flush();
 
   Checksum* getChecksum() {
     return checksum_.get();
@@ -148,6 +158,10 @@ class WriterSink {
         !exceedsLimit_;
   }
 
+  // Writes the batches in 'pending_' until none is left. Runs on
+  // 'executor_'.
+  void writePending();
+
   uint32_t getCurrentCacheSize() const {
     return static_cast<uint32_t>(cacheHolder_.size() + cacheBuffer_.size());
   }
@@ -186,6 +200,22 @@ class WriterSink {
   bool exceedsLimit_;
 
   std::vector<dwio::common::DataBuffer<char>> buffers_;
+
+  // members used for writing on 'executor_'
+  folly::Executor* executor_{nullptr};
+  uint64_t maxPendingBytes_{0};
+  // Size of 'sink_' plus all bytes handed off to 'executor_'. Used instead
+  // of 'sink_->size()', which changes on the executor.
+  uint64_t flushedSize_{0};
+  std::mutex mutex_;
+  std::condition_variable pendingChanged_;
+  // Flushed batches not yet written, in file order.
+  std::deque<std::vector<dwio::common::DataBuffer<char>>> pending_;
+  // Bytes in 'pending_' and in the batch being written.
+  uint64_t pendingBytes_{0};
+  // True while writePending() is scheduled or running.
+  bool writing_{false};
+  std::exception_ptr writeError_;
 };
 
 } // namespace facebook::velox::dwrf
@@ -0,0 +1,796 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/json/reader/JsonReader.h"
+
+#include <cctype>
+
+#include <folly/Conv.h>
+#include <folly/container/F14Map.h>
+#include <simdjson.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/dwio/common/LineReader.h"
+#include "velox/type/Filter.h"
+#include "velox/type/TimestampConversion.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::json {
+
+namespace {
+
+using simdjson::ondemand::json_type;
+
+void checkError(simdjson::error_code error) {
+  if (error) {
+    VELOX_USER_FAIL("Malformed JSON line: {}", simdjson::error_message(error));
+  }
+}
+
+bool isSupportedKeyType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return !type.isDate() && !type.isDecimal();
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void checkSupportedType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return;
+    case TypeKind::BIGINT:
+      if (!type.isDecimal()) {
+        return;
+      }
+      break;
+    case TypeKind::ARRAY:
+      checkSupportedType(*type.childAt(0));
+      return;
+    case TypeKind::MAP:
+      if (isSupportedKeyType(*type.childAt(0))) {
+        checkSupportedType(*type.childAt(1));
+        return;
+      }
+      break;
+    case TypeKind::ROW:
+      for (auto& child : type.asRow().children()) {
+        checkSupportedType(*child);
+      }
+      return;
+    default:
+      break;
+  }
+  VELOX_UNSUPPORTED("Unsupported type {} in JSON file", type.toString());
+}
+
+// Describes how the values of a column or nested field are read.
+struct JsonField {
+  TypePtr type;
+  // For a ROW, the indices of the fields that are read by key. Other fields
+  // are null.
+  folly::F14FastMap<std::string_view, column_index_t> fieldIndices;
+  // The fields of a ROW with nullptr for the fields not read, the elements of
+  // an ARRAY or the keys and values of a MAP.
+  std::vector<std::unique_ptr<JsonField>> children;
+  // For the elements, keys and values of an ARRAY or MAP, the number of
+  // values read in the current batch.
+  vector_size_t size{0};
+};
+
+// Makes a JsonField for 'type'. Only the fields of a ROW that are in 'spec'
+// are read, unless 'spec' is null or has no children.
+std::unique_ptr<JsonField> makeField(
+    const TypePtr& type,
+    const common::ScanSpec* spec) {
+  auto field = std::make_unique<JsonField>();
+  field->type = type;
+  switch (type->kind()) {
+    case TypeKind::ROW: {
+      auto& rowType = type->asRow();
+      field->children.resize(rowType.size());
+      for (column_index_t i = 0; i < rowType.size(); ++i) {
+        const common::ScanSpec* childSpec = nullptr;
+        if (spec && !spec->children().empty()) {
+          childSpec = spec->childByName(rowType.nameOf(i));
+          if (!childSpec || childSpec->isConstant()) {
+            continue;
+          }
+        }
+        field->children[i] = makeField(rowType.childAt(i), childSpec);
+        field->fieldIndices[rowType.nameOf(i)] = i;
+      }
+      break;
+    }
+    case TypeKind::ARRAY:
+      field->children.push_back(makeField(
+          type->childAt(0),
+          spec ? spec->childByName(common::ScanSpec::kArrayElementsFieldName)
+               : nullptr));
+      break;
+    case TypeKind::MAP:
+      field->children.push_back(makeField(
+          type->childAt(0),
+          spec ? spec->childByName(common::ScanSpec::kMapKeysFieldName)
+               : nullptr));
+      field->children.push_back(makeField(
+          type->childAt(1),
+          spec ? spec->childByName(common::ScanSpec::kMapValuesFieldName)
+               : nullptr));
+      break;
+    default:
+      break;
+  }
+  return field;
+}
+
+// Resizes 'vector' and the children of a ROW 'vector' to 'size'.
+void resizeVector(BaseVector& vector, vector_size_t size) {
+  vector.resize(size);
+  if (vector.typeKind() == TypeKind::ROW) {
+    for (auto& child : vector.asUnchecked<RowVector>()->children()) {
+      resizeVector(*child, size);
+    }
+  }
+}
+
+// Makes room for a value at 'index' in 'vector'.
+void reserveVector(BaseVector& vector, vector_size_t index) {
+  if (index >= vector.size()) {
+    resizeVector(vector, std::max(index + 1, 2 * vector.size()));
+  }
+}
+
+// Sets the size of 'vector' to 'size' and the sizes of its nested vectors to
+// the number of values read into them. Resets these numbers for the next
+// batch.
+void finishVector(JsonField& field, BaseVector& vector, vector_size_t size) {
+  resizeVector(vector, size);
+  switch (field.type->kind()) {
+    case TypeKind::ARRAY: {
+      auto& elementsField = *field.children[0];
+      auto& elements = *vector.asUnchecked<ArrayVector>()->elements();
+      finishVector(elementsField, elements, elementsField.size);
+      elementsField.size = 0;
+      break;
+    }
+    case TypeKind::MAP: {
+      auto* map = vector.asUnchecked<MapVector>();
+      auto& keys = *field.children[0];
+      auto& values = *field.children[1];
+      finishVector(keys, *map->mapKeys(), keys.size);
+      finishVector(values, *map->mapValues(), values.size);
+      keys.size = 0;
+      values.size = 0;
+      break;
+    }
+    case TypeKind::ROW: {
+      auto* row = vector.asUnchecked<RowVector>();
+      for (column_index_t i = 0; i < field.children.size(); ++i) {
+        if (field.children[i]) {
+          finishVector(*field.children[i], *row->childAt(i), size);
+        }
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+// Returns the JSON text of 'value', e.g. for a VARCHAR column holding a number
+// or an object.
+std::string_view rawJson(simdjson::ondemand::value& value, json_type jsonType) {
+  if (jsonType == json_type::object || jsonType == json_type::array) {
+    std::string_view json;
+    checkError(simdjson::to_json_string(value).get(json));
+    return json;
+  }
+  auto token = value.raw_json_token();
+  // A scalar token includes the white space after it.
+  while (!token.empty() && std::isspace(token.back())) {
+    token.remove_suffix(1);
+  }
+  return token;
+}
+
+// Converts the JSON 'value' into 'result' of 'type'. Returns false if 'value'
+// is null or cannot be converted, in which case the value is null.
+template <typename T>
+bool getScalar(
+    simdjson::ondemand::value& value,
+    json_type jsonType,
+    const Type& type,
+    T& result) {
+  if (jsonType == json_type::null) {
+    return false;
+  }
+  if constexpr (std::is_same_v<T, bool>) {
+    return !value.get_bool().get(result);
+  } else if constexpr (std::is_same_v<T, StringView>) {
+    std::string_view string;
+    if (jsonType != json_type::string) {
+      string = rawJson(value, jsonType);
+    } else if (value.get_string().get(string)) {
+      return false;
+    }
+    result = StringView(string.data(), string.size());
+    return true;
+  } else if constexpr (std::is_same_v<T, Timestamp>) {
+    std::string_view string;
+    if (jsonType != json_type::string || value.get_string().get(string)) {
+      return false;
+    }
+    try {
+      result = util::fromTimestampString(string.data(), string.size());
+    } catch (const VeloxUserError&) {
+      return false;
+    }
+    return true;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    double number;
+    if (value.get_double().get(number)) {
+      return false;
+    }
+    result = number;
+    return true;
+  } else if constexpr (std::is_same_v<T, int128_t>) {
+    return false;
+  } else {
+    if constexpr (std::is_same_v<T, int32_t>) {
+      if (type.isDate()) {
+        std::string_view string;
+        if (jsonType != json_type::string || value.get_string().get(string)) {
+          return false;
+        }
+        try {
+          result = util::castFromDateString(string.data(), string.size(), true);
+        } catch (const VeloxUserError&) {
+          return false;
+        }
+        return true;
+      }
+    }
+    int64_t number;
+    if (value.get_int64().get(number) ||
+        number < std::numeric_limits<T>::min() ||
+        number > std::numeric_limits<T>::max()) {
+      return false;
+    }
+    result = number;
+    return true;
+  }
+}
+
+template <TypeKind kKind>
+void readScalar(
+    simdjson::ondemand::value& value,
+    json_type jsonType,
+    const Type& type,
+    BaseVector& vector,
+    vector_size_t index) {
+  using T = typename TypeTraits<kKind>::NativeType;
+  auto* flat = vector.asUnchecked<FlatVector<T>>();
+  T result;
+  if (getScalar(value, jsonType, type, result)) {
+    // Copies a string into the string buffers of 'flat' unless it is
+    // inlined.
+    flat->set(index, result);
+  } else {
+    flat->setNull(index, true);
+  }
+}
+
+template <TypeKind kKind>
+bool testScalar(
+    simdjson::ondemand::value& value,
+    json_type jsonType,
+    const Type& type,
+    common::Filter& filter) {
+  using T = typename TypeTraits<kKind>::NativeType;
+  T result;
+  if (getScalar(value, jsonType, type, result)) {
+    return common::applyFilter(filter, result);
+  }
+  return filter.testNull();
+}
+
+template <TypeKind kKind>
+bool readKey(std::string_view key, BaseVector& keys, vector_size_t index) {
+  using T = typename TypeTraits<kKind>::NativeType;
+  auto* flat = keys.asUnchecked<FlatVector<T>>();
+  if constexpr (std::is_same_v<T, StringView>) {
+    flat->set(index, StringView(key.data(), key.size()));
+  } else {
+    auto result = folly::tryTo<T>(folly::StringPiece(key));
+    if (result.hasError()) {
+      return false;
+    }
+    flat->set(index, result.value());
+  }
+  return true;
+}
+
+// Writes 'key' at 'index' of 'keys'. Returns false if 'key' is not a value of
+// the type of 'keys'.
+bool readKey(std::string_view key, BaseVector& keys, vector_size_t index) {
+  switch (keys.typeKind()) {
+    case TypeKind::TINYINT:
+      return readKey<TypeKind::TINYINT>(key, keys, index);
+    case TypeKind::SMALLINT:
+      return readKey<TypeKind::SMALLINT>(key, keys, index);
+    case TypeKind::INTEGER:
+      return readKey<TypeKind::INTEGER>(key, keys, index);
+    case TypeKind::BIGINT:
+      return readKey<TypeKind::BIGINT>(key, keys, index);
+    case TypeKind::VARCHAR:
+      return readKey<TypeKind::VARCHAR>(key, keys, index);
+    case TypeKind::VARBINARY:
+      return readKey<TypeKind::VARBINARY>(key, keys, index);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Reads 'value' into 'vector' at 'index'.
+void readValue(
+    simdjson::ondemand::value& value,
+    JsonField& field,
+    BaseVector& vector,
+    vector_size_t index);
+
+void readArray(
+    simdjson::ondemand::value& value,
+    JsonField& field,
+    BaseVector& vector,
+    vector_size_t index) {
+  simdjson::ondemand::array array;
+  checkError(value.get_array().get(array));
+  auto* arrayVector = vector.asUnchecked<ArrayVector>();
+  auto& elementsField = *field.children[0];
+  auto& elements = *arrayVector->elements();
+  const auto offset = elementsField.size;
+  for (auto element : array) {
+    simdjson::ondemand::value elementValue;
+    checkError(element.get(elementValue));
+    const auto elementIndex = elementsField.size++;
+    reserveVector(elements, elementIndex);
+    readValue(elementValue, elementsField, elements, elementIndex);
+  }
+  arrayVector->setOffsetAndSize(index, offset, elementsField.size - offset);
+  arrayVector->setNull(index, false);
+}
+
+void readMap(
+    simdjson::ondemand::value& value,
+    JsonField& field,
+    BaseVector& vector,
+    vector_size_t index) {
+  simdjson::ondemand::object object;
+  checkError(value.get_object().get(object));
+  auto* map = vector.asUnchecked<MapVector>();
+  auto& keysField = *field.children[0];
+  auto& valuesField = *field.children[1];
+  auto& keys = *map->mapKeys();
+  auto& values = *map->mapValues();
+  const auto offset = keysField.size;
+  for (auto entry : object) {
+    std::string_view key;
+    checkError(entry.unescaped_key().get(key));
+    reserveVector(keys, keysField.size);
+    if (!readKey(key, keys, keysField.size)) {
+      // Map keys cannot be null. The value is skipped.
+      continue;
+    }
+    simdjson::ondemand::value entryValue;
+    checkError(entry.value().get(entryValue));
+    reserveVector(values, valuesField.size);
+    readValue(entryValue, valuesField, values, valuesField.size);
+    ++keysField.size;
+    ++valuesField.size;
+  }
+  map->setOffsetAndSize(index, offset, keysField.size - offset);
+  map->setNull(index, false);
+}
+
+void readRow(
+    simdjson::ondemand::value& value,
+    JsonField& field,
+    BaseVector& vector,
+    vector_size_t index) {
+  simdjson::ondemand::object object;
+  checkError(value.get_object().get(object));
+  auto* row = vector.asUnchecked<RowVector>();
+  for (auto& child : row->children()) {
+    child->setNull(index, true);
+  }
+  for (auto entry : object) {
+    std::string_view key;
+    checkError(entry.unescaped_key().get(key));
+    auto it = field.fieldIndices.find(key);
+    if (it == field.fieldIndices.end()) {
+      continue;
+    }
+    simdjson::ondemand::value entryValue;
+    checkError(entry.value().get(entryValue));
+    auto& child = *row->childAt(it->second);
+    readValue(entryValue, *field.children[it->second], child, index);
+  }
+  row->setNull(index, false);
+}
+
+void readValue(
+    simdjson::ondemand::value& value,
+    JsonField& field,
+    BaseVector& vector,
+    vector_size_t index) {
+  json_type jsonType;
+  checkError(value.type().get(jsonType));
+  switch (field.type->kind()) {
+    case TypeKind::ARRAY:
+      if (jsonType == json_type::array) {
+        readArray(value, field, vector, index);
+        return;
+      }
+      break;
+    case TypeKind::MAP:
+      if (jsonType == json_type::object) {
+        readMap(value, field, vector, index);
+        return;
+      }
+      break;
+    case TypeKind::ROW:
+      if (jsonType == json_type::object) {
+        readRow(value, field, vector, index);
+        return;
+      }
+      break;
+    default:
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          readScalar,
+          field.type->kind(),
+          value,
+          jsonType,
+          *field.type,
+          vector,
+          index);
+      return;
+  }
+  // A null or a value of a mismatching type.
+  vector.setNull(index, true);
+}
+
+// Returns true if 'value' of a column of 'type' passes 'filter'. Values of
+// complex types only support null filters.
+bool testFilter(
+    simdjson::ondemand::value& value,
+    const Type& type,
+    common::Filter& filter) {
+  json_type jsonType;
+  checkError(value.type().get(jsonType));
+  if (jsonType == json_type::null) {
+    return filter.testNull();
+  }
+  switch (type.kind()) {
+    case TypeKind::ARRAY:
+      return jsonType == json_type::array ? filter.testNonNull()
+                                          : filter.testNull();
+    case TypeKind::MAP:
+    case TypeKind::ROW:
+      return jsonType == json_type::object ? filter.testNonNull()
+                                           : filter.testNull();
+    default:
+      return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          testScalar, type.kind(), value, jsonType, type, filter);
+  }
+}
+
+class JsonRowReader : public dwio::common::RowReader {
+ public:
+  JsonRowReader(
+      std::shared_ptr<dwio::common::BufferedInput> input,
+      RowTypePtr rowType,
+      const dwio::common::RowReaderOptions& options,
+      memory::MemoryPool& pool);
+
+  int64_t nextRowNumber() override {
+    if (lineReader_.atEnd() && (!linesRead_ || numLines_ == 0)) {
+      return kAtEnd;
+    }
+    return rowNumber_;
+  }
+
+  int64_t nextReadSize(uint64_t size) override {
+    if (!linesRead_) {
+      numLines_ = lineReader_.next(std::min<uint64_t>(
+          size, std::numeric_limits<vector_size_t>::max()));
+      linesRead_ = true;
+    }
+    return numLines_ == 0 ? kAtEnd : numLines_;
+  }
+
+  uint64_t next(
+      uint64_t size,
+      velox::VectorPtr& result,
+      const dwio::common::Mutation* mutation = nullptr) override;
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& /*stats*/) const override {}
+
+  void resetFilterCaches() override {}
+
+  std::optional<size_t> estimatedRowSize() const override {
+    return std::nullopt;
+  }
+
+ private:
+  // Reads the line at 'line' of the current batch into 'row' of 'columns'.
+  // Returns false if the line is empty or does not pass the filters, in which
+  // case 'columns' are not changed.
+  bool readLine(
+      vector_size_t line,
+      vector_size_t row,
+      const std::vector<VectorPtr>& columns);
+
+  // Returns the columns of the ScanSpec, or all columns if there is no
+  // ScanSpec.
+  VectorPtr makeOutput(std::vector<VectorPtr> columns, vector_size_t numRows);
+
+  memory::MemoryPool& pool_;
+  const RowTypePtr rowType_;
+  const dwio::common::RowReaderOptions options_;
+  dwio::common::LineReader lineReader_;
+  simdjson::ondemand::parser parser_;
+
+  // The projected columns with nullptr for the other columns.
+  std::vector<std::unique_ptr<JsonField>> columns_;
+  // Indices of the projected columns by key.
+  folly::F14FastMap<std::string_view, column_index_t> columnIndices_;
+  // Bits for the columns found on the current line, so that a key that
+  // repeats is counted once.
+  std::vector<uint64_t> foundColumns_;
+  // The filtered columns and their filters.
+  std::vector<std::pair<column_index_t, common::Filter*>> filters_;
+
+  // True if the lines of the next batch have been found by nextReadSize().
+  bool linesRead_{false};
+  vector_size_t numLines_{0};
+  // Lines returned so far. Row numbers are relative to the start of the
+  // range.
+  int64_t rowNumber_{0};
+};
+
+JsonRowReader::JsonRowReader(
+    std::shared_ptr<dwio::common::BufferedInput> input,
+    RowTypePtr rowType,
+    const dwio::common::RowReaderOptions& options,
+    memory::MemoryPool& pool)
+    : pool_(pool),
+      rowType_(std::move(rowType)),
+      options_(options),
+      lineReader_(
+          std::move(input),
+          options_.getOffset(),
+          options_.getLength(),
+          options_.getSkipRows(),
+          simdjson::SIMDJSON_PADDING,
+          pool_) {
+  columns_.resize(rowType_->size());
+  foundColumns_.resize(bits::nwords(rowType_->size()));
+  auto& scanSpec = options_.getScanSpec();
+  for (column_index_t i = 0; i < rowType_->size(); ++i) {
+    auto& name = rowType_->nameOf(i);
+    const common::ScanSpec* childSpec = nullptr;
+    if (scanSpec) {
+      childSpec = scanSpec->childByName(name);
+      if (!childSpec || childSpec->isConstant() ||
+          !(childSpec->projectOut() || childSpec->filter())) {
+        continue;
+      }
+      for (auto& nestedSpec : childSpec->children()) {
+        if (nestedSpec->hasFilter()) {
+          VELOX_NYI("Filters on nested fields of JSON column {}", name);
+        }
+      }
+    }
+    checkSupportedType(*rowType_->childAt(i));
+    if (childSpec && childSpec->filter()) {
+      filters_.emplace_back(i, childSpec->filter());
+    }
+    if (!childSpec || childSpec->projectOut()) {
+      columns_[i] = makeField(rowType_->childAt(i), childSpec);
+      columnIndices_[name] = i;
+    }
+  }
+}
+
+uint64_t JsonRowReader::next(
+    uint64_t size,
+    velox::VectorPtr& result,
+    const dwio::common::Mutation* mutation) {
+  if (mutation && mutation->deletedRows) {
+    VELOX_NYI("Deleted rows are not supported for JSON files");
+  }
+  if (nextReadSize(size) == kAtEnd) {
+    return 0;
+  }
+  const auto numLines = numLines_;
+  linesRead_ = false;
+  std::vector<VectorPtr> columns(rowType_->size());
+  for (column_index_t i = 0; i < rowType_->size(); ++i) {
+    if (columns_[i]) {
+      columns[i] = BaseVector::create(rowType_->childAt(i), numLines, &pool_);
+    }
+  }
+  vector_size_t numRows = 0;
+  for (vector_size_t line = 0; line < numLines; ++line) {
+    if (readLine(line, numRows, columns)) {
+      ++numRows;
+    }
+  }
+  for (column_index_t i = 0; i < rowType_->size(); ++i) {
+    if (columns_[i]) {
+      finishVector(*columns_[i], *columns[i], numRows);
+    }
+  }
+  result = makeOutput(std::move(columns), numRows);
+  rowNumber_ += numLines;
+  return numLines;
+}
+
+bool JsonRowReader::readLine(
+    vector_size_t line,
+    vector_size_t row,
+    const std::vector<VectorPtr>& columns) {
+  const auto begin = lineReader_.lineBegins()[line];
+  const auto end = lineReader_.lineEnds()[line];
+  if (begin == end) {
+    return false;
+  }
+  simdjson::ondemand::document document;
+  checkError(parser_
+                 .iterate(
+                     lineReader_.data() + begin,
+                     end - begin,
+                     lineReader_.bytesReadable(line))
+                 .get(document));
+  simdjson::ondemand::object object;
+  checkError(document.get_object().get(object));
+  if (!filters_.empty()) {
+    for (auto& [column, filter] : filters_) {
+      simdjson::ondemand::value value;
+      auto error =
+          object.find_field_unordered(rowType_->nameOf(column)).get(value);
+      if (error == simdjson::NO_SUCH_FIELD) {
+        if (!filter->testNull()) {
+          return false;
+        }
+        continue;
+      }
+      checkError(error);
+      if (!testFilter(value, *rowType_->childAt(column), *filter)) {
+        return false;
+      }
+    }
+    if (columnIndices_.empty()) {
+      return true;
+    }
+    checkError(object.reset().error());
+  }
+  for (column_index_t i = 0; i < columns.size(); ++i) {
+    if (columns_[i]) {
+      columns[i]->setNull(row, true);
+    }
+  }
+  std::fill(foundColumns_.begin(), foundColumns_.end(), 0);
+  size_t numFound = 0;
+  for (auto field : object) {
+    std::string_view key;
+    checkError(field.unescaped_key().get(key));
+    auto it = columnIndices_.find(key);
+    if (it == columnIndices_.end()) {
+      continue;
+    }
+    simdjson::ondemand::value value;
+    checkError(field.value().get(value));
+    readValue(value, *columns_[it->second], *columns[it->second], row);
+    if (bits::isBitSet(foundColumns_.data(), it->second)) {
+      continue;
+    }
+    bits::setBit(foundColumns_.data(), it->second);
+    // The rest of the line is not parsed once all projected keys are found.
+    if (++numFound == columnIndices_.size()) {
+      break;
+    }
+  }
+  return true;
+}
+
+VectorPtr JsonRowReader::makeOutput(
+    std::vector<VectorPtr> columns,
+    vector_size_t numRows) {
+  auto& scanSpec = options_.getScanSpec();
+  if (!scanSpec) {
+    return std::make_shared<RowVector>(
+        &pool_, rowType_, nullptr, numRows, std::move(columns));
+  }
+  column_index_t numChannels = 0;
+  for (auto& childSpec : scanSpec->children()) {
+    if (childSpec->projectOut()) {
+      numChannels = std::max(numChannels, childSpec->channel() + 1);
+    }
+  }
+  std::vector<std::string> names(numChannels);
+  std::vector<TypePtr> types(numChannels);
+  std::vector<VectorPtr> children(numChannels);
+  for (auto& childSpec : scanSpec->children()) {
+    if (!childSpec->projectOut()) {
+      continue;
+    }
+    VectorPtr child;
+    if (childSpec->isConstant()) {
+      child =
+          BaseVector::wrapInConstant(numRows, 0, childSpec->constantValue());
+    } else {
+      child = std::move(columns[rowType_->getChildIdx(childSpec->fieldName())]);
+    }
+    const auto channel = childSpec->channel();
+    names[channel] = childSpec->fieldName();
+    types[channel] = child->type();
+    children[channel] = std::move(child);
+  }
+  return std::make_shared<RowVector>(
+      &pool_,
+      ROW(std::move(names), std::move(types)),
+      nullptr,
+      numRows,
+      std::move(children));
+}
+
+} // namespace
+
+JsonReader::JsonReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& options)
+    : pool_(options.getMemoryPool()),
+      input_(std::move(input)),
+      rowType_(options.getFileSchema()) {
+  VELOX_CHECK_NOT_NULL(rowType_, "Reading a JSON file requires its schema");
+  typeWithId_ = dwio::common::TypeWithId::create(rowType_);
+}
+
+std::unique_ptr<dwio::common::RowReader> JsonReader::createRowReader(
+    const dwio::common::RowReaderOptions& options) const {
+  return std::make_unique<JsonRowReader>(input_, rowType_, options, pool_);
+}
+
+} // namespace facebook::velox::json
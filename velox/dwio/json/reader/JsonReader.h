@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::json {
+
+/// Implements the reader interface for JSON lines files, i.e. files with one
+/// JSON object per line as written by Hive's JsonSerDe. A JSON file has no
+/// metadata, so the schema is given by ReaderOptions::getFileSchema(). The
+/// keys of the objects are matched to the column names of the schema and to
+/// the field names of nested ROW columns.
+///
+/// The row readers parse lines with the simdjson on-demand API. Only the keys
+/// of the columns the ScanSpec projects or filters are parsed, and the values
+/// of other keys are skipped without being parsed. Filters on top level
+/// columns are evaluated before the projected columns of a line are parsed,
+/// so that these are parsed only for the lines that pass. Lines are read from
+/// the byte range of the RowReaderOptions, so that a file can be scanned in
+/// parallel by several splits.
+class JsonReader : public dwio::common::Reader {
+ public:
+  JsonReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options);
+
+  ~JsonReader() override = default;
+
+  std::optional<uint64_t> numberOfRows() const override {
+    return std::nullopt;
+  }
+
+  std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
+      uint32_t /*index*/) const override {
+    return nullptr;
+  }
+
+  const velox::RowTypePtr& rowType() const override {
+    return rowType_;
+  }
+
+  const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
+      const override {
+    return typeWithId_;
+  }
+
+  std::unique_ptr<dwio::common::RowReader> createRowReader(
+      const dwio::common::RowReaderOptions& options = {}) const override;
+
+ private:
+  memory::MemoryPool& pool_;
+  const std::shared_ptr<dwio::common::BufferedInput> input_;
+  const RowTypePtr rowType_;
+  std::shared_ptr<const dwio::common::TypeWithId> typeWithId_;
+};
+
+class JsonReaderFactory : public dwio::common::ReaderFactory {
+ public:
+  JsonReaderFactory() : ReaderFactory(dwio::common::FileFormat::JSON) {}
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options) override {
+    return std::make_unique<JsonReader>(std::move(input), options);
+  }
+};
+
+} // namespace facebook::velox::json
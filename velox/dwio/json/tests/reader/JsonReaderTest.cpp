@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/json/reader/JsonReader.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+#include "velox/type/Filter.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::json;
+
+namespace {
+
+class JsonReaderTest : public testing::Test, public test::VectorTestBase {
+ protected:
+  std::unique_ptr<dwio::common::Reader> makeReader(
+      const std::string& data,
+      const RowTypePtr& type) {
+    dwio::common::ReaderOptions options(pool());
+    options.setFileSchema(type);
+    auto input = std::make_unique<dwio::common::BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), *pool());
+    return JsonReaderFactory().createReader(std::move(input), options);
+  }
+
+  // Reads all rows of 'reader' with 'options' in batches of 'batchSize'.
+  RowVectorPtr read(
+      const dwio::common::Reader& reader,
+      const dwio::common::RowReaderOptions& options = {},
+      uint64_t batchSize = 1'000) {
+    auto rowReader = reader.createRowReader(options);
+    RowVectorPtr result;
+    VectorPtr batch;
+    while (rowReader->next(batchSize, batch) > 0) {
+      if (!result) {
+        result = std::static_pointer_cast<RowVector>(
+            BaseVector::create(batch->type(), 0, pool()));
+      }
+      result->append(batch.get());
+    }
+    EXPECT_EQ(rowReader->nextRowNumber(), dwio::common::RowReader::kAtEnd);
+    return result;
+  }
+};
+
+TEST_F(JsonReaderTest, scalars) {
+  auto type =
+      ROW({"b", "i", "bi", "d", "s", "dt"},
+          {BOOLEAN(), INTEGER(), BIGINT(), DOUBLE(), VARCHAR(), DATE()});
+  auto reader = makeReader(
+      "{\"b\": true, \"i\": 1, \"bi\": 10, \"d\": 1.5, \"s\": \"apple\", "
+      "\"dt\": \"2023-01-02\"}\n"
+      "{\"s\": 12, \"i\": \"x\", \"bi\": null, \"extra\": [1, {\"a\": 2}]}\n"
+      "\n"
+      "{\"i\": 3, \"d\": 4, \"s\": {\"k\": [1, 2]}, \"dt\": \"bad\"}\n"
+      "{\"b\": false, \"i\": 3000000000, \"s\": \"esc\\\"aped string\"}",
+      type);
+  EXPECT_EQ(reader->numberOfRows(), std::nullopt);
+  auto expected = makeRowVector(
+      type->names(),
+      {
+          makeNullableFlatVector<bool>(
+              {true, std::nullopt, std::nullopt, false}),
+          makeNullableFlatVector<int32_t>(
+              {1, std::nullopt, 3, std::nullopt}),
+          makeNullableFlatVector<int64_t>(
+              {10, std::nullopt, std::nullopt, std::nullopt}),
+          makeNullableFlatVector<double>(
+              {1.5, std::nullopt, 4, std::nullopt}),
+          makeFlatVector<std::string>(
+              {"apple", "12", "{\"k\": [1, 2]}", "esc\"aped string"}),
+          makeNullableFlatVector<int32_t>(
+              {19359, std::nullopt, std::nullopt, std::nullopt}, DATE()),
+      });
+  test::assertEqualVectors(expected, read(*reader));
+}
+
+TEST_F(JsonReaderTest, nested) {
+  auto type =
+      ROW({"a", "m", "r"},
+          {ARRAY(BIGINT()),
+           MAP(VARCHAR(), ARRAY(INTEGER())),
+           ROW({"x", "y"}, {VARCHAR(), ARRAY(ROW({"z"}, {DOUBLE()}))})});
+  auto reader = makeReader(
+      "{\"a\": [1, 2, null], \"m\": {\"k1\": [1], \"k2\": null}, "
+      "\"r\": {\"y\": [{\"z\": 1.5}, null, {}], \"x\": \"first\"}}\n"
+      "{\"a\": null, \"m\": {}, \"r\": null}\n"
+      "{\"a\": [], \"r\": {\"x\": \"third\", \"ignored\": true}}\n",
+      type);
+  auto expected = makeRowVector(
+      type->names(),
+      {
+          makeNullableArrayVector<int64_t>(
+              {{{1, 2, std::nullopt}}, std::nullopt, {{}}}),
+          makeMapVector(
+              {0, 2, 2},
+              makeFlatVector<std::string>({"k1", "k2"}),
+              makeNullableArrayVector<int32_t>({{{1}}, std::nullopt}),
+              {2}),
+          makeRowVector(
+              {"x", "y"},
+              {
+                  makeFlatVector<std::string>({"first", "", "third"}),
+                  makeArrayVector(
+                      {0, 3, 3},
+                      makeRowVector(
+                          {"z"},
+                          {makeNullableFlatVector<double>(
+                              {1.5, std::nullopt, std::nullopt})},
+                          [](auto row) { return row == 1; }),
+                      {1, 2}),
+              },
+              [](auto row) { return row == 1; }),
+      });
+  auto result = read(*reader);
+  ASSERT_EQ(result->size(), 3);
+  test::assertEqualVectors(expected->childAt(0), result->childAt(0));
+  EXPECT_TRUE(result->childAt(1)->isNullAt(2));
+  for (auto row : {0, 1}) {
+    EXPECT_TRUE(expected->childAt(1)->equalValueAt(
+        result->childAt(1).get(), row, row))
+        << row;
+  }
+  for (auto row : {0, 2}) {
+    EXPECT_TRUE(expected->childAt(2)->equalValueAt(
+        result->childAt(2).get(), row, row))
+        << row;
+  }
+  EXPECT_TRUE(result->childAt(2)->isNullAt(1));
+}
+
+TEST_F(JsonReaderTest, projectionAndFilter) {
+  // 'c3' is of a type the reader cannot read. It is never parsed because it is
+  // not in the ScanSpec.
+  auto type =
+      ROW({"c0", "c1", "c2", "c3"},
+          {BIGINT(), VARCHAR(), ROW({"x", "y"}, {BIGINT(), BIGINT()}),
+           HUGEINT()});
+  std::string data;
+  for (auto i = 0; i < 10; ++i) {
+    data += fmt::format(
+        "{{\"c3\": \"unused\", \"c2\": {{\"y\": {}, \"x\": {}}}, "
+        "\"c1\": \"s{}\", \"c0\": {}}}\n",
+        i * 2,
+        i,
+        i,
+        i);
+  }
+  auto reader = makeReader(data, type);
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addField("c1", 0);
+  scanSpec->addField("c2", 1)->addField("y", 0);
+  scanSpec->getOrCreateChild(common::Subfield("c0"))
+      ->setFilter(std::make_unique<common::BigintRange>(2, 4, false));
+  dwio::common::RowReaderOptions options;
+  options.setScanSpec(scanSpec);
+  auto result = read(*reader, options, 3);
+  auto expected = makeRowVector(
+      {"c1", "c2"},
+      {
+          makeFlatVector<std::string>({"s2", "s3", "s4"}),
+          makeRowVector(
+              {"x", "y"},
+              {
+                  makeNullConstant(TypeKind::BIGINT, 3),
+                  makeFlatVector<int64_t>({4, 6, 8}),
+              }),
+      });
+  test::assertEqualVectors(expected, result);
+
+  scanSpec->addField("c3", 2);
+  VELOX_ASSERT_THROW(
+      reader->createRowReader(options), "Unsupported type HUGEINT");
+}
+
+TEST_F(JsonReaderTest, duplicateKeys) {
+  // A repeated key must not count as another column found, which would stop
+  // the line before 'b'.
+  auto type = ROW({"a", "b"}, {BIGINT(), BIGINT()});
+  auto reader = makeReader(
+      "{\"a\": 1, \"a\": 2, \"b\": 3}\n"
+      "{\"b\": 4, \"a\": 5}\n",
+      type);
+  auto expected = makeRowVector(
+      type->names(),
+      {
+          makeFlatVector<int64_t>({2, 5}),
+          makeFlatVector<int64_t>({3, 4}),
+      });
+  test::assertEqualVectors(expected, read(*reader));
+}
+
+TEST_F(JsonReaderTest, ranges) {
+  constexpr int32_t kNumRows = 1'000;
+  auto type = ROW({"c0", "c1"}, {INTEGER(), VARCHAR()});
+  std::string data;
+  for (auto i = 0; i < kNumRows; ++i) {
+    data += fmt::format(
+        "{{\"c1\": \"{}\", \"c0\": {}}}\n", std::string(i % 37, 'x'), i);
+  }
+  auto reader = makeReader(data, type);
+  for (uint64_t rangeSize : {1, 7, 100, 4'096, 1 << 20}) {
+    SCOPED_TRACE(fmt::format("rangeSize={}", rangeSize));
+    std::vector<int32_t> values;
+    for (uint64_t offset = 0; offset < data.size(); offset += rangeSize) {
+      dwio::common::RowReaderOptions options;
+      options.range(offset, rangeSize);
+      if (auto result = read(*reader, options, 100)) {
+        auto* c0 = result->childAt(0)->asFlatVector<int32_t>();
+        for (auto i = 0; i < result->size(); ++i) {
+          values.push_back(c0->valueAt(i));
+        }
+      }
+    }
+    ASSERT_EQ(values.size(), kNumRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      ASSERT_EQ(values[i], i);
+    }
+  }
+}
+
+TEST_F(JsonReaderTest, malformed) {
+  auto reader = makeReader("{\"c0\": 1}\n[1, 2]\n", ROW({"c0"}, {BIGINT()}));
+  VELOX_ASSERT_THROW(read(*reader), "Malformed JSON line");
+}
+
+} // namespace
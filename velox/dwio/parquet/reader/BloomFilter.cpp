@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include "velox/common/base/SimdUtil.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+// The salts from the Parquet specification. Word i of a block gets bit
+// (key * kSalt[i]) >> 27.
+alignas(32) constexpr uint32_t kSalt[SplitBlockBloomFilter::kWordsPerBlock] =
+    {0x47b6137bU,
+     0x44974d91U,
+     0x8824ad5bU,
+     0xa2b7289dU,
+     0x705495c7U,
+     0x2df1424bU,
+     0x9efc4947U,
+     0x5c6bfb31U};
+
+template <typename T>
+uint64_t hashBytes(T value) {
+  return XXH64(&value, sizeof(T), 0);
+}
+
+#if XSIMD_WITH_AVX2
+inline __m256i blockMask(uint32_t key) {
+  auto salt = _mm256_load_si256(reinterpret_cast<const __m256i*>(kSalt));
+  auto shifts =
+      _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(key), salt), 27);
+  return _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+}
+#endif
+
+} // namespace
+
+uint64_t SplitBlockBloomFilter::hash(int32_t value) {
+  return hashBytes(value);
+}
+
+uint64_t SplitBlockBloomFilter::hash(int64_t value) {
+  return hashBytes(value);
+}
+
+uint64_t SplitBlockBloomFilter::hash(float value) {
+  return hashBytes(value);
+}
+
+uint64_t SplitBlockBloomFilter::hash(double value) {
+  return hashBytes(value);
+}
+
+uint64_t SplitBlockBloomFilter::hash(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+void SplitBlockBloomFilter::insertHash(uint64_t hash) {
+  auto words = words_.data() + blockStart(hash);
+  const uint32_t key = hash;
+#if XSIMD_WITH_AVX2
+  auto data = reinterpret_cast<__m256i*>(words);
+  _mm256_storeu_si256(
+      data, _mm256_or_si256(_mm256_loadu_si256(data), blockMask(key)));
+#else
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    words[i] |= 1U << ((key * kSalt[i]) >> 27);
+  }
+#endif
+}
+
+bool SplitBlockBloomFilter::findHash(uint64_t hash) const {
+  auto words = words_.data() + blockStart(hash);
+  const uint32_t key = hash;
+#if XSIMD_WITH_AVX2
+  // testc is true if all bits of the mask are set in the block.
+  return _mm256_testc_si256(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words)),
+      blockMask(key));
+#else
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    if (!(words[i] & (1U << ((key * kSalt[i]) >> 27)))) {
+      return false;
+    }
+  }
+  return true;
+#endif
+}
+
+} // namespace facebook::velox::parquet
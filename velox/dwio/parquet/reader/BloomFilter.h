@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::parquet {
+
+/// Split block Bloom filter as specified by Parquet. The bitset is divided
+/// into blocks of 8 32 bit words. The upper 32 bits of a hash select the block
+/// and the lower 32 bits set one bit in each word of the block. A probe is
+/// thus one masked compare of a 256 bit block, which is done with AVX2 if
+/// available.
+class SplitBlockBloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+  static constexpr int32_t kWordsPerBlock = 8;
+
+  /// Makes an empty filter of 'numBytes' bytes. 'numBytes' must be a multiple
+  /// of kBytesPerBlock.
+  explicit SplitBlockBloomFilter(int32_t numBytes)
+      : SplitBlockBloomFilter(
+            std::vector<uint32_t>(numBytes / sizeof(uint32_t))) {}
+
+  /// Makes a filter with the bitset 'words' read from a Parquet file.
+  explicit SplitBlockBloomFilter(std::vector<uint32_t> words)
+      : words_(std::move(words)), numBlocks_(words_.size() / kWordsPerBlock) {
+    VELOX_CHECK(
+        numBlocks_ > 0 && words_.size() % kWordsPerBlock == 0,
+        "Bloom filter size must be a positive multiple of {} bytes",
+        kBytesPerBlock);
+  }
+
+  /// The hashes of values as Parquet defines them: the XXH64 hash with seed 0
+  /// of the plain encoding of the value, without a length for byte arrays.
+  static uint64_t hash(int32_t value);
+  static uint64_t hash(int64_t value);
+  static uint64_t hash(float value);
+  static uint64_t hash(double value);
+  static uint64_t hash(std::string_view value);
+
+  void insertHash(uint64_t hash);
+
+  /// Returns false if no value with 'hash' was inserted. Returns true if one
+  /// may have been inserted.
+  bool findHash(uint64_t hash) const;
+
+  int32_t numBytes() const {
+    return words_.size() * sizeof(uint32_t);
+  }
+
+  /// The bitset as it is written to a Parquet file.
+  std::string_view bytes() const {
+    return std::string_view(
+        reinterpret_cast<const char*>(words_.data()), numBytes());
+  }
+
+ private:
+  // Returns the index of the first word of the block for 'hash'.
+  uint64_t blockStart(uint64_t hash) const {
+    return (((hash >> 32) * numBlocks_) >> 32) * kWordsPerBlock;
+  }
+
+  std::vector<uint32_t> words_;
+  const uint64_t numBlocks_;
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+
+#include "velox/common/base/SimdUtil.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+template <int32_t kValueBytes>
+void decodeScalar(
+    const char* streams,
+    int64_t stride,
+    int64_t begin,
+    int32_t numValues,
+    char* result) {
+  for (auto i = 0; i < numValues; ++i) {
+    for (auto k = 0; k < kValueBytes; ++k) {
+      result[i * kValueBytes + k] = streams[k * stride + begin + i];
+    }
+  }
+}
+
+#if XSIMD_WITH_AVX2
+
+inline __m256i load(const char* data) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+}
+
+inline void store(__m256i value, char* data) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value);
+}
+
+// Transposes 32 4 byte values. The byte interleaves work within 128 bit
+// lanes, so the low lanes end up with values 0-15 and the high lanes with
+// values 16-31. The final permutes put the halves in order.
+inline void decode32x4(const char* streams, int64_t stride, char* result) {
+  auto s0 = load(streams);
+  auto s1 = load(streams + stride);
+  auto s2 = load(streams + 2 * stride);
+  auto s3 = load(streams + 3 * stride);
+  auto lo01 = _mm256_unpacklo_epi8(s0, s1);
+  auto hi01 = _mm256_unpackhi_epi8(s0, s1);
+  auto lo23 = _mm256_unpacklo_epi8(s2, s3);
+  auto hi23 = _mm256_unpackhi_epi8(s2, s3);
+  // Values 0-3 and 16-19, 4-7 and 20-23, 8-11 and 24-27, 12-15 and 28-31.
+  auto v0 = _mm256_unpacklo_epi16(lo01, lo23);
+  auto v1 = _mm256_unpackhi_epi16(lo01, lo23);
+  auto v2 = _mm256_unpacklo_epi16(hi01, hi23);
+  auto v3 = _mm256_unpackhi_epi16(hi01, hi23);
+  store(_mm256_permute2x128_si256(v0, v1, 0x20), result);
+  store(_mm256_permute2x128_si256(v2, v3, 0x20), result + 32);
+  store(_mm256_permute2x128_si256(v0, v1, 0x31), result + 64);
+  store(_mm256_permute2x128_si256(v2, v3, 0x31), result + 96);
+}
+
+// Transposes 32 8 byte values. Same as decode32x4 with one more level of
+// interleaving.
+inline void decode32x8(const char* streams, int64_t stride, char* result) {
+  __m256i bytes[8];
+  for (auto k = 0; k < 8; ++k) {
+    bytes[k] = load(streams + k * stride);
+  }
+  // Byte pairs 01, 23, 45 and 67 of values 0-7 and 16-23 in 'lo' and of
+  // values 8-15 and 24-31 in 'hi'.
+  __m256i lo[4];
+  __m256i hi[4];
+  for (auto k = 0; k < 4; ++k) {
+    lo[k] = _mm256_unpacklo_epi8(bytes[2 * k], bytes[2 * k + 1]);
+    hi[k] = _mm256_unpackhi_epi8(bytes[2 * k], bytes[2 * k + 1]);
+  }
+  // Bytes 0-3 in 'low' and bytes 4-7 in 'high' of values 4 * i + 0-3 and 16 +
+  // 4 * i + 0-3.
+  __m256i low[4];
+  __m256i high[4];
+  low[0] = _mm256_unpacklo_epi16(lo[0], lo[1]);
+  low[1] = _mm256_unpackhi_epi16(lo[0], lo[1]);
+  low[2] = _mm256_unpacklo_epi16(hi[0], hi[1]);
+  low[3] = _mm256_unpackhi_epi16(hi[0], hi[1]);
+  high[0] = _mm256_unpacklo_epi16(lo[2], lo[3]);
+  high[1] = _mm256_unpackhi_epi16(lo[2], lo[3]);
+  high[2] = _mm256_unpacklo_epi16(hi[2], hi[3]);
+  high[3] = _mm256_unpackhi_epi16(hi[2], hi[3]);
+  for (auto i = 0; i < 4; ++i) {
+    auto first = _mm256_unpacklo_epi32(low[i], high[i]);
+    auto second = _mm256_unpackhi_epi32(low[i], high[i]);
+    store(_mm256_permute2x128_si256(first, second, 0x20), result + i * 32);
+    store(
+        _mm256_permute2x128_si256(first, second, 0x31),
+        result + (16 + i * 4) * 8);
+  }
+}
+
+#endif
+
+} // namespace
+
+void byteStreamSplitDecode(
+    const char* FOLLY_NONNULL streams,
+    int64_t stride,
+    int64_t begin,
+    int32_t numValues,
+    int32_t valueBytes,
+    char* FOLLY_NONNULL result) {
+  int32_t i = 0;
+#if XSIMD_WITH_AVX2
+  constexpr int32_t kBatch = 32;
+  const int32_t numBatched = numValues & ~(kBatch - 1);
+  if (valueBytes == 4) {
+    for (; i < numBatched; i += kBatch) {
+      decode32x4(streams + begin + i, stride, result + i * 4);
+    }
+  } else {
+    for (; i < numBatched; i += kBatch) {
+      decode32x8(streams + begin + i, stride, result + i * 8);
+    }
+  }
+#endif
+  if (valueBytes == 4) {
+    decodeScalar<4>(
+        streams, stride, begin + i, numValues - i, result + i * 4);
+  } else {
+    decodeScalar<8>(
+        streams, stride, begin + i, numValues - i, result + i * 8);
+  }
+}
+
+} // namespace facebook::velox::parquet
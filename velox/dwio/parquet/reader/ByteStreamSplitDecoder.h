@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/Nulls.h"
+#include "velox/common/base/RawVector.h"
+#include "velox/dwio/common/DecoderUtil.h"
+
+namespace facebook::velox::dwio::common {
+struct DropValues;
+} // namespace facebook::velox::dwio::common
+
+namespace facebook::velox::parquet {
+
+/// Reassembles 'numValues' values of 'valueBytes' bytes starting at value
+/// 'begin' from BYTE_STREAM_SPLIT encoded data. 'streams' is the start of the
+/// encoded data, which consists of 'valueBytes' streams of 'stride' bytes.
+/// Stream k has byte k of each value. The values are written to 'result'.
+/// Uses AVX2 byte shuffles if available.
+void byteStreamSplitDecode(
+    const char* FOLLY_NONNULL streams,
+    int64_t stride,
+    int64_t begin,
+    int32_t numValues,
+    int32_t valueBytes,
+    char* FOLLY_NONNULL result);
+
+/// Decoder for BYTE_STREAM_SPLIT encoded FLOAT and DOUBLE values. The page
+/// has no header, so any value can be accessed directly. Runs of values are
+/// transposed straight into the visitor's values with
+/// byteStreamSplitDecode(). Skipped values are never touched.
+class ByteStreamSplitDecoder {
+ public:
+  /// 'valueBytes' is the width of the Parquet physical type, 4 for FLOAT and
+  /// 8 for DOUBLE.
+  ByteStreamSplitDecoder(
+      const char* FOLLY_NONNULL start,
+      const char* FOLLY_NONNULL end,
+      int32_t valueBytes)
+      : streams_(start),
+        valueBytes_(valueBytes),
+        numValues_((end - start) / valueBytes) {
+    VELOX_CHECK(
+        valueBytes_ == 4 || valueBytes_ == 8,
+        "BYTE_STREAM_SPLIT supports only FLOAT and DOUBLE");
+    VELOX_CHECK_EQ(
+        (end - start) % valueBytes_,
+        0,
+        "BYTE_STREAM_SPLIT data size is not a multiple of the value size");
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(
+      int32_t numValues,
+      int32_t current,
+      const uint64_t* FOLLY_NULLABLE nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_CHECK_LE(valueIndex_ + numValues, numValues_);
+    valueIndex_ += numValues;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(
+      const uint64_t* FOLLY_NULLABLE nulls,
+      Visitor visitor,
+      bool useFastPath = true) {
+    using T = typename Visitor::DataType;
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+      if (useFastPath &&
+          dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+        fastPath<hasNulls>(nulls, visitor);
+        return;
+      }
+    }
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(
+            valueBytes_ == 4 ? static_cast<T>(readValue<float>())
+                             : static_cast<T>(readValue<double>()),
+            atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  /// Reads the next 'numValues' values into 'result'. T must have the width
+  /// of the physical type.
+  template <typename T>
+  void bulkRead(int32_t numValues, T* FOLLY_NONNULL result) {
+    VELOX_DCHECK_EQ(static_cast<int32_t>(sizeof(T)), valueBytes_);
+    VELOX_CHECK_LE(valueIndex_ + numValues, numValues_);
+    byteStreamSplitDecode(
+        streams_,
+        numValues_,
+        valueIndex_,
+        numValues,
+        valueBytes_,
+        reinterpret_cast<char*>(result));
+    valueIndex_ += numValues;
+  }
+
+  /// Reads the values at positions 'rows' relative to the current position
+  /// into 'result'. Positions the decoder after rows.back(). Runs of
+  /// consecutive rows are transposed together, other rows are gathered one
+  /// at a time.
+  template <typename T>
+  void bulkReadRows(RowSet rows, T* FOLLY_NONNULL result) {
+    VELOX_CHECK_LE(valueIndex_ + rows.back() + 1, numValues_);
+    int32_t i = 0;
+    const int32_t numRows = rows.size();
+    while (i < numRows) {
+      // The run continues while rows are consecutive.
+      int32_t end = i + 1;
+      while (end < numRows && rows[end] == rows[end - 1] + 1) {
+        ++end;
+      }
+      if (end - i == 1) {
+        result[i] = valueAt<T>(valueIndex_ + rows[i]);
+      } else {
+        byteStreamSplitDecode(
+            streams_,
+            numValues_,
+            valueIndex_ + rows[i],
+            end - i,
+            valueBytes_,
+            reinterpret_cast<char*>(result + i));
+      }
+      i = end;
+    }
+    valueIndex_ += rows.back() + 1;
+  }
+
+ private:
+  template <typename T>
+  T valueAt(int64_t index) const {
+    T value;
+    auto bytes = reinterpret_cast<char*>(&value);
+    for (int32_t i = 0; i < static_cast<int32_t>(sizeof(T)); ++i) {
+      bytes[i] = streams_[i * numValues_ + index];
+    }
+    return value;
+  }
+
+  template <typename T>
+  T readValue() {
+    VELOX_DCHECK_LT(valueIndex_, numValues_);
+    return valueAt<T>(valueIndex_++);
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* FOLLY_NULLABLE nulls, Visitor& visitor) {
+    dwio::common::fastPathRows<hasNulls>(
+        *this,
+        nulls,
+        visitor,
+        [&](folly::Range<const int32_t*> rows, const int32_t* scatterRows) {
+          dwio::common::bulkReadFixedWidth<hasNulls>(
+              *this, rows, scatterRows, visitor);
+        });
+  }
+
+  // Start of the encoded data. Stream k starts at 'streams_' + k *
+  // 'numValues_'.
+  const char* FOLLY_NONNULL const streams_;
+  const int32_t valueBytes_;
+
+  // Number of values in the page. This is also the length of each stream.
+  const int64_t numValues_;
+
+  // Index of the next value to read.
+  int64_t valueIndex_{0};
+};
+
+} // namespace facebook::velox::parquet
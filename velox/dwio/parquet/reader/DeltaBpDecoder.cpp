@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/dwio/common/BitPackDecoder.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+// Adds 'minDelta' + deltas[i] to 'last' for each delta and stores the running
+// sums into 'values' with the width of 'TValue'. Returns the last sum.
+template <typename TValue, typename TDelta>
+uint64_t prefixSum(
+    const TDelta* deltas,
+    int32_t numValues,
+    uint64_t minDelta,
+    uint64_t last,
+    int64_t* values) {
+  for (auto i = 0; i < numValues; ++i) {
+    last += minDelta + deltas[i];
+    values[i] = static_cast<TValue>(last);
+  }
+  return last;
+}
+
+// Fills 'values' for a miniblock of bit width 0, where every delta is
+// 'minDelta'.
+template <typename TValue>
+uint64_t constantDelta(
+    int32_t numValues,
+    uint64_t minDelta,
+    uint64_t last,
+    int64_t* values) {
+  for (auto i = 0; i < numValues; ++i) {
+    values[i] = static_cast<TValue>(last + (i + 1) * minDelta);
+  }
+  return last + numValues * minDelta;
+}
+
+template <typename TDelta>
+uint64_t sumDeltas(const TDelta* deltas, int32_t numValues) {
+  uint64_t sum = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    sum += deltas[i];
+  }
+  return sum;
+}
+
+} // namespace
+
+DeltaBpDecoder::DeltaBpDecoder(
+    const char* FOLLY_NONNULL start,
+    const char* FOLLY_NONNULL end,
+    int32_t typeBytes)
+    : bufferStart_(start), bufferEnd_(end), typeBytes_(typeBytes) {
+  VELOX_CHECK(
+      typeBytes_ == 4 || typeBytes_ == 8,
+      "DELTA_BINARY_PACKED supports only INT32 and INT64");
+  readHeader();
+}
+
+uint64_t DeltaBpDecoder::readVarint() {
+  uint64_t result = 0;
+  for (int32_t shift = 0; shift < 64; shift += 7) {
+    VELOX_CHECK(
+        bufferStart_ < bufferEnd_,
+        "Unexpected end of DELTA_BINARY_PACKED data");
+    uint8_t byte = *bufferStart_++;
+    result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return result;
+    }
+  }
+  VELOX_FAIL("Invalid varint in DELTA_BINARY_PACKED data");
+}
+
+void DeltaBpDecoder::readHeader() {
+  valuesPerBlock_ = readVarint();
+  numMiniblocks_ = readVarint();
+  totalValues_ = readVarint();
+  auto firstValue = readZigZagVarint();
+  VELOX_CHECK(
+      valuesPerBlock_ > 0 && valuesPerBlock_ % 128 == 0,
+      "Invalid DELTA_BINARY_PACKED block size {}",
+      valuesPerBlock_);
+  VELOX_CHECK(
+      numMiniblocks_ > 0 && valuesPerBlock_ % numMiniblocks_ == 0,
+      "Invalid DELTA_BINARY_PACKED miniblock count {}",
+      numMiniblocks_);
+  valuesPerMiniblock_ = valuesPerBlock_ / numMiniblocks_;
+  VELOX_CHECK_EQ(
+      valuesPerMiniblock_ % 32,
+      0,
+      "Invalid DELTA_BINARY_PACKED miniblock size");
+  miniblockIndex_ = numMiniblocks_;
+  lastValue_ = firstValue;
+  values_.resize(valuesPerMiniblock_);
+  valueIndex_ = 0;
+  if (totalValues_ > 0) {
+    values_[0] = narrow(firstValue);
+    numDecoded_ = 1;
+    valuesRemaining_ = totalValues_ - 1;
+  } else {
+    numDecoded_ = 0;
+    valuesRemaining_ = 0;
+  }
+}
+
+void DeltaBpDecoder::readBlockHeader() {
+  minDelta_ = static_cast<uint64_t>(readZigZagVarint());
+  VELOX_CHECK_LE(
+      numMiniblocks_,
+      bufferEnd_ - bufferStart_,
+      "Unexpected end of DELTA_BINARY_PACKED data");
+  bitWidths_ = reinterpret_cast<const uint8_t*>(bufferStart_);
+  bufferStart_ += numMiniblocks_;
+  miniblockIndex_ = 0;
+}
+
+uint8_t DeltaBpDecoder::nextMiniblock() {
+  if (miniblockIndex_ == numMiniblocks_) {
+    readBlockHeader();
+  }
+  auto bitWidth = bitWidths_[miniblockIndex_++];
+  VELOX_CHECK_LE(
+      static_cast<int32_t>(bitWidth),
+      typeBytes_ * 8,
+      "Invalid DELTA_BINARY_PACKED miniblock bit width");
+  return bitWidth;
+}
+
+void DeltaBpDecoder::unpackDeltas(uint8_t bitWidth) {
+  VELOX_DCHECK_GT(bitWidth, 0);
+  // Miniblocks are always padded to a full 'valuesPerMiniblock_' values, a
+  // multiple of 32, so the size is a whole number of bytes.
+  const int64_t numBytes =
+      static_cast<int64_t>(valuesPerMiniblock_) * bitWidth / 8;
+  const char* miniblock = bufferStart_;
+  const int64_t available = bufferEnd_ - bufferStart_;
+  if (available < numBytes + simd::kPadding) {
+    // The unpacking kernels may read a few bytes past the miniblock. A
+    // miniblock at the end of the page is copied to a padded buffer. A
+    // truncated final miniblock is padded with zeros.
+    const auto numCopy = std::min(available, numBytes);
+    paddedMiniblock_.resize(numBytes + simd::kPadding);
+    memcpy(paddedMiniblock_.data(), bufferStart_, numCopy);
+    memset(
+        paddedMiniblock_.data() + numCopy,
+        0,
+        paddedMiniblock_.size() - numCopy);
+    miniblock = paddedMiniblock_.data();
+    bufferStart_ += numCopy;
+  } else {
+    bufferStart_ += numBytes;
+  }
+  if (bitWidth <= 32) {
+    narrowDeltas_.resize(valuesPerMiniblock_);
+    auto input = reinterpret_cast<const uint8_t*>(miniblock);
+    auto output = narrowDeltas_.data();
+    dwio::common::unpack<uint32_t>(
+        input, numBytes, valuesPerMiniblock_, bitWidth, output);
+    return;
+  }
+  deltas_.resize(valuesPerMiniblock_);
+  auto words = reinterpret_cast<const uint64_t*>(miniblock);
+  const uint64_t mask = bitWidth == 64 ? ~0UL : bits::lowMask(bitWidth);
+  for (auto i = 0; i < valuesPerMiniblock_; ++i) {
+    deltas_[i] = bits::detail::loadBits<uint64_t>(
+                     words, static_cast<uint64_t>(i) * bitWidth, bitWidth) &
+        mask;
+  }
+}
+
+void DeltaBpDecoder::decodeMiniblock() {
+  VELOX_CHECK_GT(
+      valuesRemaining_, 0, "Reading past end of DELTA_BINARY_PACKED data");
+  auto bitWidth = nextMiniblock();
+  const int32_t numValues = valuesInNextMiniblock();
+  auto values = values_.data();
+  if (bitWidth == 0) {
+    lastValue_ = typeBytes_ == 4
+        ? constantDelta<int32_t>(numValues, minDelta_, lastValue_, values)
+        : constantDelta<int64_t>(numValues, minDelta_, lastValue_, values);
+  } else {
+    unpackDeltas(bitWidth);
+    if (bitWidth <= 32) {
+      auto deltas = narrowDeltas_.data();
+      lastValue_ = typeBytes_ == 4
+          ? prefixSum<int32_t>(deltas, numValues, minDelta_, lastValue_, values)
+          : prefixSum<int64_t>(
+                deltas, numValues, minDelta_, lastValue_, values);
+    } else {
+      lastValue_ = prefixSum<int64_t>(
+          deltas_.data(), numValues, minDelta_, lastValue_, values);
+    }
+  }
+  valuesRemaining_ -= numValues;
+  numDecoded_ = numValues;
+  valueIndex_ = 0;
+}
+
+int32_t DeltaBpDecoder::skipMiniblock() {
+  auto bitWidth = nextMiniblock();
+  const int32_t numValues = valuesInNextMiniblock();
+  uint64_t sum = minDelta_ * numValues;
+  if (bitWidth != 0) {
+    unpackDeltas(bitWidth);
+    sum += bitWidth <= 32 ? sumDeltas(narrowDeltas_.data(), numValues)
+                          : sumDeltas(deltas_.data(), numValues);
+  }
+  lastValue_ += sum;
+  valuesRemaining_ -= numValues;
+  return numValues;
+}
+
+void DeltaBpDecoder::skipValues(int64_t numValues) {
+  const int32_t numAvailable = numDecoded_ - valueIndex_;
+  if (numValues <= numAvailable) {
+    valueIndex_ += numValues;
+    return;
+  }
+  numValues -= numAvailable;
+  valueIndex_ = numDecoded_;
+  // Whole miniblocks are skipped by summing their deltas.
+  while (numValues > 0 && numValues >= valuesInNextMiniblock()) {
+    VELOX_CHECK_GT(
+        valuesRemaining_, 0, "Skipping past end of DELTA_BINARY_PACKED data");
+    numValues -= skipMiniblock();
+  }
+  if (numValues > 0) {
+    decodeMiniblock();
+    valueIndex_ = numValues;
+  }
+}
+
+} // namespace facebook::velox::parquet
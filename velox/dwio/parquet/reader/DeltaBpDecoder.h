@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/Nulls.h"
+#include "velox/common/base/RawVector.h"
+#include "velox/dwio/common/DecoderUtil.h"
+
+namespace facebook::velox::dwio::common {
+struct DropValues;
+} // namespace facebook::velox::dwio::common
+
+namespace facebook::velox::parquet {
+
+/// Decoder for DELTA_BINARY_PACKED encoded INT32 and INT64 values. The encoded
+/// data is a header followed by blocks. Each block has a minimum delta and is
+/// divided into miniblocks of bit packed deltas with a per-miniblock bit
+/// width. Values are decoded a miniblock at a time into 'values_' using the
+/// bit unpacking kernels of BitPackDecoder.h. Miniblocks that are skipped as a
+/// whole only have their deltas summed and are never materialized.
+class DeltaBpDecoder {
+ public:
+  /// 'typeBytes' is the width of the Parquet physical type, 4 for INT32 and 8
+  /// for INT64. Deltas of INT32 columns wrap around at 32 bits.
+  DeltaBpDecoder(
+      const char* FOLLY_NONNULL start,
+      const char* FOLLY_NONNULL end,
+      int32_t typeBytes);
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(
+      int32_t numValues,
+      int32_t current,
+      const uint64_t* FOLLY_NULLABLE nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    skipValues(numValues);
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(
+      const uint64_t* FOLLY_NULLABLE nulls,
+      Visitor visitor,
+      bool useFastPath = true) {
+    if constexpr (!std::is_same_v<typename Visitor::DataType, int128_t>) {
+      if (useFastPath &&
+          dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+        fastPath<hasNulls>(nulls, visitor);
+        return;
+      }
+    }
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(
+            static_cast<typename Visitor::DataType>(readValue()), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  /// Returns the first byte after the miniblocks consumed so far. After all
+  /// values are read this is the end of the encoded data, which is where the
+  /// suffixes of DELTA_LENGTH_BYTE_ARRAY and DELTA_BYTE_ARRAY start.
+  const char* FOLLY_NONNULL bufferStart() const {
+    return bufferStart_;
+  }
+
+  /// Total number of values in the encoded data.
+  int64_t totalValues() const {
+    return totalValues_;
+  }
+
+  /// Reads the next 'numValues' values into 'result'.
+  template <typename T>
+  void bulkRead(int32_t numValues, T* FOLLY_NONNULL result) {
+    while (numValues > 0) {
+      if (valueIndex_ == numDecoded_) {
+        decodeMiniblock();
+      }
+      auto numCopy = std::min<int32_t>(numValues, numDecoded_ - valueIndex_);
+      auto source = values_.data() + valueIndex_;
+      for (auto i = 0; i < numCopy; ++i) {
+        result[i] = source[i];
+      }
+      result += numCopy;
+      valueIndex_ += numCopy;
+      numValues -= numCopy;
+    }
+  }
+
+  /// Reads the values at positions 'rows' relative to the current position
+  /// into 'result'. Positions the decoder after rows.back(). Miniblocks
+  /// that contain none of 'rows' are skipped without materializing.
+  template <typename T>
+  void bulkReadRows(RowSet rows, T* FOLLY_NONNULL result) {
+    int32_t current = 0;
+    for (auto i = 0; i < rows.size(); ++i) {
+      auto row = rows[i];
+      if (row > current) {
+        skipValues(row - current);
+      }
+      result[i] = readValue();
+      current = row + 1;
+    }
+  }
+
+ private:
+  int64_t readValue() {
+    if (valueIndex_ == numDecoded_) {
+      decodeMiniblock();
+    }
+    return values_[valueIndex_++];
+  }
+
+  // Advances by 'numValues' values.
+  void skipValues(int64_t numValues);
+
+  // Reads the page header and sets up decoding of the first value.
+  void readHeader();
+
+  // Reads the min delta and miniblock bit widths of the next block.
+  void readBlockHeader();
+
+  // Positions at the next miniblock, reading the block header if needed.
+  // Returns the bit width of the miniblock.
+  uint8_t nextMiniblock();
+
+  // Number of values in the next miniblock, which may be less than
+  // 'valuesPerMiniblock_' for the last one.
+  int32_t valuesInNextMiniblock() const {
+    return std::min<int64_t>(valuesPerMiniblock_, valuesRemaining_);
+  }
+
+  // Unpacks the deltas of the miniblock at 'bufferStart_' into 'deltas_' and
+  // advances past the miniblock.
+  void unpackDeltas(uint8_t bitWidth);
+
+  // Decodes the next miniblock into 'values_'.
+  void decodeMiniblock();
+
+  // Advances past the next miniblock, updating 'lastValue_' with the sum
+  // of its deltas. Returns the number of values skipped.
+  int32_t skipMiniblock();
+
+  uint64_t readVarint();
+
+  int64_t readZigZagVarint() {
+    auto value = readVarint();
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+  }
+
+  // Returns 'value' with the wraparound semantics of the physical type.
+  int64_t narrow(uint64_t value) const {
+    return typeBytes_ == 4 ? static_cast<int32_t>(value)
+                           : static_cast<int64_t>(value);
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* FOLLY_NULLABLE nulls, Visitor& visitor) {
+    dwio::common::fastPathRows<hasNulls>(
+        *this,
+        nulls,
+        visitor,
+        [&](folly::Range<const int32_t*> rows, const int32_t* scatterRows) {
+          dwio::common::bulkReadFixedWidth<hasNulls>(
+              *this, rows, scatterRows, visitor);
+        });
+  }
+
+  const char* FOLLY_NONNULL bufferStart_;
+  const char* FOLLY_NONNULL const bufferEnd_;
+  const int32_t typeBytes_;
+
+  // Values per block and miniblock, from the page header.
+  int64_t valuesPerBlock_{0};
+  int32_t numMiniblocks_{0};
+  int32_t valuesPerMiniblock_{0};
+
+  // Number of values in the page, including the first value in the header.
+  int64_t totalValues_{0};
+
+  // Number of values after the last decoded or skipped miniblock.
+  int64_t valuesRemaining_{0};
+
+  // Min delta of the current block.
+  uint64_t minDelta_{0};
+
+  // Bit widths of the miniblocks of the current block.
+  const uint8_t* FOLLY_NULLABLE bitWidths_{nullptr};
+
+  // Index of the next miniblock in the current block. Equals
+  // 'numMiniblocks_' when the next block header must be read.
+  int32_t miniblockIndex_{0};
+
+  // The last value decoded or skipped over. Deltas of the next miniblock are
+  // relative to this.
+  uint64_t lastValue_{0};
+
+  // Decoded values of the current miniblock. Holds the first value of the
+  // page before the first miniblock.
+  raw_vector<int64_t> values_;
+  int32_t numDecoded_{0};
+  int32_t valueIndex_{0};
+
+  // Unpacked deltas of the current miniblock.
+  raw_vector<uint64_t> deltas_;
+  raw_vector<uint32_t> narrowDeltas_;
+
+  // Zero padded copy of a miniblock that ends too close to 'bufferEnd_' to
+  // be unpacked in place.
+  raw_vector<char> paddedMiniblock_;
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+namespace facebook::velox::parquet {
+
+DeltaLengthByteArrayDecoder::DeltaLengthByteArrayDecoder(
+    const char* FOLLY_NONNULL start,
+    const char* FOLLY_NONNULL end) {
+  DeltaBpDecoder lengthDecoder(start, end, sizeof(int32_t));
+  lengths_.resize(lengthDecoder.totalValues());
+  lengthDecoder.bulkRead(lengths_.size(), lengths_.data());
+  bufferStart_ = lengthDecoder.bufferStart();
+  int64_t totalLength = 0;
+  for (auto length : lengths_) {
+    VELOX_CHECK_GE(length, 0, "Negative length in DELTA_LENGTH_BYTE_ARRAY");
+    totalLength += length;
+  }
+  VELOX_CHECK_LE(
+      totalLength,
+      end - bufferStart_,
+      "DELTA_LENGTH_BYTE_ARRAY values extend past end of page");
+}
+
+DeltaByteArrayDecoder::DeltaByteArrayDecoder(
+    const char* FOLLY_NONNULL start,
+    const char* FOLLY_NONNULL end,
+    memory::MemoryPool& pool) {
+  DeltaBpDecoder prefixDecoder(start, end, sizeof(int32_t));
+  numValues_ = prefixDecoder.totalValues();
+  raw_vector<int32_t> prefixLengths(numValues_);
+  prefixDecoder.bulkRead(numValues_, prefixLengths.data());
+
+  DeltaLengthByteArrayDecoder suffixDecoder(prefixDecoder.bufferStart(), end);
+  const auto& suffixLengths = suffixDecoder.lengths();
+  VELOX_CHECK_EQ(
+      static_cast<int32_t>(suffixLengths.size()),
+      numValues_,
+      "DELTA_BYTE_ARRAY prefix and suffix counts differ");
+
+  offsets_.resize(numValues_ + 1);
+  offsets_[0] = 0;
+  int64_t totalLength = 0;
+  int32_t previousLength = 0;
+  for (auto i = 0; i < numValues_; ++i) {
+    auto prefixLength = prefixLengths[i];
+    VELOX_CHECK(
+        prefixLength >= 0 && prefixLength <= previousLength,
+        "Invalid prefix length {} in DELTA_BYTE_ARRAY",
+        prefixLength);
+    previousLength = prefixLength + suffixLengths[i];
+    totalLength += previousLength;
+    VELOX_CHECK_LE(
+        totalLength,
+        std::numeric_limits<int32_t>::max(),
+        "DELTA_BYTE_ARRAY page expands to more than 2GB");
+    offsets_[i + 1] = totalLength;
+  }
+
+  // Expands all values into one buffer. The prefix of each value is copied
+  // from the previous value, which is already expanded.
+  values_ = AlignedBuffer::allocate<char>(totalLength, &pool);
+  auto data = values_->asMutable<char>();
+  auto suffixes = suffixDecoder.bufferStart();
+  for (auto i = 0; i < numValues_; ++i) {
+    auto prefixLength = prefixLengths[i];
+    auto target = data + offsets_[i];
+    if (prefixLength > 0) {
+      memcpy(target, data + offsets_[i - 1], prefixLength);
+    }
+    memcpy(target + prefixLength, suffixes, suffixLengths[i]);
+    suffixes += suffixLengths[i];
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/buffer/Buffer.h"
+#include "velox/common/base/Nulls.h"
+#include "velox/common/base/RawVector.h"
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox::parquet {
+
+/// Decoder for DELTA_LENGTH_BYTE_ARRAY. The lengths of all values are
+/// DELTA_BINARY_PACKED at the start of the page and are followed by the
+/// concatenated values. The lengths are decoded when constructing the
+/// decoder. The produced StringPieces point into the page data.
+class DeltaLengthByteArrayDecoder {
+ public:
+  DeltaLengthByteArrayDecoder(
+      const char* FOLLY_NONNULL start,
+      const char* FOLLY_NONNULL end);
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(
+      int32_t numValues,
+      int32_t current,
+      const uint64_t* FOLLY_NULLABLE nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_CHECK_LE(lengthIndex_ + numValues, numLengths());
+    int64_t numBytes = 0;
+    for (auto i = 0; i < numValues; ++i) {
+      numBytes += lengths_[lengthIndex_ + i];
+    }
+    lengthIndex_ += numValues;
+    bufferStart_ += numBytes;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* FOLLY_NULLABLE nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  /// Returns the lengths of all values in the page.
+  const raw_vector<int32_t>& lengths() const {
+    return lengths_;
+  }
+
+  /// Returns the start of the data of the next value.
+  const char* FOLLY_NONNULL bufferStart() const {
+    return bufferStart_;
+  }
+
+ private:
+  int32_t numLengths() const {
+    return lengths_.size();
+  }
+
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(lengthIndex_, numLengths());
+    auto length = lengths_[lengthIndex_++];
+    bufferStart_ += length;
+    return folly::StringPiece(bufferStart_ - length, length);
+  }
+
+  const char* FOLLY_NONNULL bufferStart_;
+  raw_vector<int32_t> lengths_;
+  int32_t lengthIndex_{0};
+};
+
+/// Decoder for DELTA_BYTE_ARRAY, also known as incremental or front
+/// compression. The page has the DELTA_BINARY_PACKED lengths of the prefixes
+/// shared with the previous value, followed by the suffixes encoded as
+/// DELTA_LENGTH_BYTE_ARRAY. Since each value depends on the previous one, the
+/// whole page is expanded into a single buffer allocated from 'pool' when
+/// constructing the decoder. The produced StringPieces point into that buffer.
+class DeltaByteArrayDecoder {
+ public:
+  DeltaByteArrayDecoder(
+      const char* FOLLY_NONNULL start,
+      const char* FOLLY_NONNULL end,
+      memory::MemoryPool& pool);
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(
+      int32_t numValues,
+      int32_t current,
+      const uint64_t* FOLLY_NULLABLE nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_CHECK_LE(valueIndex_ + numValues, numValues_);
+    valueIndex_ += numValues;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* FOLLY_NULLABLE nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+ private:
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(valueIndex_, numValues_);
+    auto begin = offsets_[valueIndex_];
+    auto end = offsets_[++valueIndex_];
+    return folly::StringPiece(values_->as<char>() + begin, end - begin);
+  }
+
+  // Concatenation of the expanded values.
+  BufferPtr values_;
+
+  // Offset of each value in 'values_'. Has 'numValues_' + 1 elements.
+  raw_vector<int32_t> offsets_;
+  int32_t numValues_{0};
+  int32_t valueIndex_{0};
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/reader/Statistics.h"
+
+namespace facebook::velox::parquet {
+
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right) {
+  std::vector<RowRange> result;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < left.size() && j < right.size()) {
+    auto begin = std::max(left[i].begin, right[j].begin);
+    auto end = std::min(left[i].end, right[j].end);
+    if (begin < end) {
+      result.push_back({begin, end});
+    }
+    if (left[i].end < right[j].end) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return result;
+}
+
+ColumnPageIndex::ColumnPageIndex(
+    std::unique_ptr<thrift::ColumnIndex> columnIndex,
+    std::unique_ptr<thrift::OffsetIndex> offsetIndex,
+    int64_t numRowsInRowGroup)
+    : columnIndex_(std::move(columnIndex)),
+      offsetIndex_(std::move(offsetIndex)),
+      numRowsInRowGroup_(numRowsInRowGroup) {}
+
+RowRange ColumnPageIndex::pageRows(int32_t page) const {
+  VELOX_DCHECK_NOT_NULL(offsetIndex_);
+  auto& locations = offsetIndex_->page_locations;
+  VELOX_DCHECK_LT(page, numPages());
+  return {
+      locations[page].first_row_index,
+      page + 1 < numPages() ? locations[page + 1].first_row_index
+                            : numRowsInRowGroup_};
+}
+
+std::optional<std::vector<RowRange>> ColumnPageIndex::filterPages(
+    common::Filter& filter,
+    const TypePtr& type) const {
+  if (!columnIndex_ || !offsetIndex_) {
+    return std::nullopt;
+  }
+  const size_t numPages = this->numPages();
+  auto& index = *columnIndex_;
+  if (index.null_pages.size() != numPages ||
+      index.min_values.size() != numPages ||
+      index.max_values.size() != numPages) {
+    return std::nullopt;
+  }
+  const bool hasNullCounts =
+      index.__isset.null_counts && index.null_counts.size() == numPages;
+  std::vector<RowRange> ranges;
+  for (size_t i = 0; i < numPages; ++i) {
+    auto rows = pageRows(i);
+    auto numRows = rows.end - rows.begin;
+    // The page stats have the same format as the column chunk stats.
+    thrift::Statistics pageStats;
+    if (index.null_pages[i]) {
+      pageStats.__set_null_count(numRows);
+    } else {
+      pageStats.__set_min_value(index.min_values[i]);
+      pageStats.__set_max_value(index.max_values[i]);
+      if (hasNullCounts) {
+        pageStats.__set_null_count(index.null_counts[i]);
+      }
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(pageStats, *type, numRows);
+    if (!common::testFilter(&filter, columnStats.get(), numRows, type)) {
+      continue;
+    }
+    if (!ranges.empty() && ranges.back().end == rows.begin) {
+      ranges.back().end = rows.end;
+    } else {
+      ranges.push_back(rows);
+    }
+  }
+  return ranges;
+}
+
+std::vector<bool> ColumnPageIndex::pagesInRanges(
+    const std::vector<RowRange>& ranges) const {
+  const auto numPages = this->numPages();
+  std::vector<bool> result(numPages);
+  size_t range = 0;
+  for (auto i = 0; i < numPages; ++i) {
+    auto rows = pageRows(i);
+    while (range < ranges.size() && ranges[range].end <= rows.begin) {
+      ++range;
+    }
+    result[i] = range < ranges.size() && ranges[range].begin < rows.end;
+  }
+  return result;
+}
+
+bool PageRangesInputStream::Next(const void** data, int32_t* size) {
+  const int32_t numRanges = ranges_.size();
+  while (current_ < numRanges &&
+         position_ >= ranges_[current_].offset + ranges_[current_].size) {
+    ++current_;
+  }
+  if (current_ == numRanges) {
+    return false;
+  }
+  auto& range = ranges_[current_];
+  VELOX_CHECK_GE(
+      position_,
+      range.offset,
+      "Reading a byte range of a column chunk that is not loaded");
+  // Catches up with the bytes skipped since the last Next().
+  auto offsetInRange = position_ - range.offset;
+  VELOX_CHECK_LE(consumed_[current_], offsetInRange);
+  if (consumed_[current_] < offsetInRange) {
+    range.stream->Skip(offsetInRange - consumed_[current_]);
+    consumed_[current_] = offsetInRange;
+  }
+  if (!range.stream->Next(data, size)) {
+    return false;
+  }
+  consumed_[current_] += *size;
+  position_ += *size;
+  return true;
+}
+
+void PageRangesInputStream::BackUp(int32_t count) {
+  VELOX_CHECK_LT(current_, static_cast<int32_t>(ranges_.size()));
+  ranges_[current_].stream->BackUp(count);
+  consumed_[current_] -= count;
+  position_ -= count;
+}
+
+bool PageRangesInputStream::Skip(int32_t count) {
+  position_ += count;
+  return true;
+}
+
+void PageRangesInputStream::seekToPosition(
+    dwio::common::PositionProvider& position) {
+  const int64_t target = position.next();
+  if (target < position_) {
+    // The streams of the ranges that were read past 'target' are rewound to
+    // their start. Next() skips from there to 'target'.
+    const std::vector<uint64_t> start{0};
+    for (size_t i = 0; i < ranges_.size(); ++i) {
+      if (consumed_[i] > 0 && ranges_[i].offset + consumed_[i] > target) {
+        dwio::common::PositionProvider startPosition(start);
+        ranges_[i].stream->seekToPosition(startPosition);
+        consumed_[i] = 0;
+      }
+    }
+    current_ = 0;
+  }
+  position_ = target;
+}
+
+size_t PageRangesInputStream::positionSize() {
+  // Only the offset in the column chunk.
+  return 1;
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// Range of rows [begin, end) in a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+
+  bool operator==(const RowRange& other) const {
+    return begin == other.begin && end == other.end;
+  }
+};
+
+/// Returns the rows that are in both 'left' and 'right'. The inputs and the
+/// result are sorted and non-overlapping.
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right);
+
+/// The ColumnIndex and OffsetIndex of a column chunk. The ColumnIndex has
+/// min/max values and null counts for each data page and the OffsetIndex has
+/// the file offset, size and first row of each data page. Either may be
+/// missing.
+class ColumnPageIndex {
+ public:
+  ColumnPageIndex(
+      std::unique_ptr<thrift::ColumnIndex> columnIndex,
+      std::unique_ptr<thrift::OffsetIndex> offsetIndex,
+      int64_t numRowsInRowGroup);
+
+  const thrift::ColumnIndex* FOLLY_NULLABLE columnIndex() const {
+    return columnIndex_.get();
+  }
+
+  const thrift::OffsetIndex* FOLLY_NULLABLE offsetIndex() const {
+    return offsetIndex_.get();
+  }
+
+  int64_t numRowsInRowGroup() const {
+    return numRowsInRowGroup_;
+  }
+
+  int32_t numPages() const {
+    return offsetIndex_ ? offsetIndex_->page_locations.size() : 0;
+  }
+
+  /// Returns the rows in data page 'page'. Requires the OffsetIndex.
+  RowRange pageRows(int32_t page) const;
+
+  /// Returns the rows of the pages that may contain values passing 'filter'
+  /// according to the ColumnIndex. Returns std::nullopt if the pages cannot be
+  /// filtered, e.g. because either index is missing.
+  std::optional<std::vector<RowRange>> filterPages(
+      common::Filter& filter,
+      const TypePtr& type) const;
+
+  /// Returns a flag for each data page telling whether the page has rows in
+  /// 'ranges'. Requires the OffsetIndex.
+  std::vector<bool> pagesInRanges(const std::vector<RowRange>& ranges) const;
+
+ private:
+  const std::unique_ptr<thrift::ColumnIndex> columnIndex_;
+  const std::unique_ptr<thrift::OffsetIndex> offsetIndex_;
+  const int64_t numRowsInRowGroup_;
+};
+
+/// Input stream over a column chunk of which only some byte ranges are
+/// loaded. Offsets are relative to the start of the column chunk. Skip() and
+/// seekToPosition() may move over ranges that are not loaded but reading from
+/// one is an error. Seeking backward rewinds the streams of the ranges read
+/// past the target. Used for reading the data pages that are selected by the
+/// page index without loading the pages in between.
+class PageRangesInputStream : public dwio::common::SeekableInputStream {
+ public:
+  struct Range {
+    // Offset of the range from the start of the column chunk.
+    int64_t offset;
+    int64_t size;
+    std::unique_ptr<dwio::common::SeekableInputStream> stream;
+  };
+
+  /// 'ranges' must be sorted by offset and non-overlapping.
+  PageRangesInputStream(std::vector<Range> ranges, std::string name)
+      : ranges_(std::move(ranges)),
+        consumed_(ranges_.size(), 0),
+        name_(std::move(name)) {}
+
+  bool Next(const void** data, int32_t* size) override;
+
+  void BackUp(int32_t count) override;
+
+  bool Skip(int32_t count) override;
+
+  google::protobuf::int64 ByteCount() const override {
+    return position_;
+  }
+
+  void seekToPosition(dwio::common::PositionProvider& position) override;
+
+  std::string getName() const override {
+    return name_;
+  }
+
+  size_t positionSize() override;
+
+ private:
+  std::vector<Range> ranges_;
+
+  // Number of bytes consumed from the stream of each range.
+  std::vector<int64_t> consumed_;
+
+  const std::string name_;
+
+  // Index of the range the last Next() returned data from.
+  int32_t current_{0};
+
+  // Offset of the next byte to read from the start of the column chunk.
+  int64_t position_{0};
+};
+
+} // namespace facebook::velox::parquet
@@ -36,6 +36,7 @@ using thrift::PageHeader;
 void PageReader::seekToPage(int64_t row) {
   defineDecoder_.reset();
   repeatDecoder_.reset();
+  pageNotLoaded_ = false;
   // 'rowOfPage_' is the row number of the first row of the next page.
   rowOfPage_ += numRowsInPage_;
   for (;;) {
@@ -46,6 +47,9 @@ void PageReader::seekToPage(int64_t row) {
       numRowsInPage_ = 0;
       break;
     }
+    if (pageIndex_ && row != kRepDefOnly && seekWithPageIndex(row)) {
+      break;
+    }
     PageHeader pageHeader = readPageHeader();
     pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
 
@@ -77,6 +81,53 @@ void PageReader::seekToPage(int64_t row) {
   }
 }
 
+bool PageReader::seekWithPageIndex(int64_t row) {
+  auto& locations = pageIndex_->offsetIndex()->page_locations;
+  const int64_t pageStart = pageStart_;
+  // The dictionary page precedes the first data page and is read first.
+  if (pageStart < locations[0].offset - chunkOffset_) {
+    return false;
+  }
+  auto it = std::upper_bound(
+      locations.begin(),
+      locations.end(),
+      row,
+      [](int64_t target, const thrift::PageLocation& location) {
+        return target < location.first_row_index;
+      });
+  VELOX_CHECK(it != locations.begin());
+  const int32_t page = it - locations.begin() - 1;
+  const int64_t pageOffset = locations[page].offset - chunkOffset_;
+  if (pageOffset < pageStart) {
+    return false;
+  }
+  if (pageOffset > pageStart) {
+    dwio::common::skipBytes(
+        pageOffset - pageStart, inputStream_.get(), bufferStart_, bufferEnd_);
+    pageStart_ = pageOffset;
+    rowOfPage_ = locations[page].first_row_index;
+    numRowsInPage_ = 0;
+  }
+  if (loadedPages_.empty() || loadedPages_[page]) {
+    return false;
+  }
+  // The page is not loaded because none of its rows are read. This happens
+  // when seeking to the end of the previous page. The compressed page size in
+  // the OffsetIndex includes the page header.
+  auto rows = pageIndex_->pageRows(page);
+  dwio::common::skipBytes(
+      locations[page].compressed_page_size,
+      inputStream_.get(),
+      bufferStart_,
+      bufferEnd_);
+  pageStart_ = pageOffset + locations[page].compressed_page_size;
+  rowOfPage_ = rows.begin;
+  numRowsInPage_ = rows.end - rows.begin;
+  numRepDefsInPage_ = numRowsInPage_;
+  pageNotLoaded_ = true;
+  return true;
+}
+
 PageHeader PageReader::readPageHeader() {
   if (bufferEnd_ == bufferStart_) {
     const void* buffer;
@@ -261,6 +312,32 @@ const char* FOLLY_NONNULL PageReader::decompressData(
   return decompressedData_->as<char>();
 }
 
+const char* FOLLY_NONNULL
+PageReader::readPageData(const PageHeader& pageHeader) {
+  const bool compressed = codec_ != thrift::CompressionCodec::UNCOMPRESSED;
+  if (compressed &&
+      inputStream_->readDecompressedPage(pageDataStart_, [&](int32_t size) {
+        dwio::common::ensureCapacity<char>(decompressedData_, size, &pool_);
+        return decompressedData_->asMutable<char>();
+      })) {
+    dwio::common::skipBytes(
+        pageHeader.compressed_page_size,
+        inputStream_.get(),
+        bufferStart_,
+        bufferEnd_);
+    return decompressedData_->as<char>();
+  }
+  auto data = readBytes(pageHeader.compressed_page_size, pageBuffer_);
+  data = decompressData(
+      data, pageHeader.compressed_page_size, pageHeader.uncompressed_page_size);
+  if (compressed) {
+    inputStream_->cacheDecompressedPage(
+        pageDataStart_,
+        std::string_view(data, pageHeader.uncompressed_page_size));
+  }
+  return data;
+}
+
 void PageReader::setPageRowInfo(bool forRepDef) {
   if (isTopLevel_ || forRepDef || maxRepeat_ == 0) {
     numRowsInPage_ = numRepDefsInPage_;
@@ -319,11 +396,7 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
 
     return;
   }
-  pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
-  pageData_ = decompressData(
-      pageData_,
-      pageHeader.compressed_page_size,
-      pageHeader.uncompressed_page_size);
+  pageData_ = readPageData(pageHeader);
   auto pageEnd = pageData_ + pageHeader.uncompressed_page_size;
   if (maxRepeat_ > 0) {
     uint32_t repeatLength = readField<int32_t>(pageData_);
@@ -431,11 +504,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       dictionaryEncoding_ == Encoding::PLAIN);
 
   if (codec_ != thrift::CompressionCodec::UNCOMPRESSED) {
-    pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
-    pageData_ = decompressData(
-        pageData_,
-        pageHeader.compressed_page_size,
-        pageHeader.uncompressed_page_size);
+    pageData_ = readPageData(pageHeader);
   }
 
   auto parquetType = type_->parquetType_.value();
@@ -577,17 +646,94 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
   }
 }
 
-void PageReader::makeFilterCache(dwio::common::ScanState& state) {
+void PageReader::makeFilterCache(
+    dwio::common::ScanState& state,
+    const common::Filter* filter) {
   VELOX_CHECK(
       !state.dictionary2.values, "Parquet supports only one dictionary");
   state.filterCache.resize(state.dictionary.numValues);
-  simd::memset(
-      state.filterCache.data(),
-      dwio::common::FilterResult::kUnknown,
-      state.filterCache.size());
+  // A dictionary page is followed by the pages of its column chunk, which
+  // usually refer to most of the entries. Evaluating the filter on the whole
+  // dictionary up front leaves only cache lookups for the rows.
+  if (!filter || !filterDictionary(*filter, state.filterCache.data())) {
+    simd::memset(
+        state.filterCache.data(),
+        dwio::common::FilterResult::kUnknown,
+        state.filterCache.size());
+  }
   state.rawState.filterCache = state.filterCache.data();
 }
 
+const dwio::common::DictionaryValues& PageReader::readDictionaryPage() {
+  auto pageHeader = readPageHeader();
+  VELOX_CHECK(
+      pageHeader.type == thrift::PageType::DICTIONARY_PAGE,
+      "Column chunk does not start with a dictionary page");
+  prepareDictionary(pageHeader);
+  return dictionary_;
+}
+
+bool PageReader::filterDictionary(
+    const common::Filter& filter,
+    uint8_t* results) const {
+  using dwio::common::FilterResult;
+  if (!dictionary_.values) {
+    return false;
+  }
+  auto setResults = [&](auto test) {
+    for (auto i = 0; i < dictionary_.numValues; ++i) {
+      results[i] = test(i) ? FilterResult::kSuccess : FilterResult::kFailure;
+    }
+  };
+  // The dictionary values have the width of the Parquet type, except for
+  // short decimals which are widened to 8 bytes.
+  auto parquetType = type_->parquetType_.value();
+  auto& type = type_->type();
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      if (parquetType == thrift::Type::INT32 && !type->isShortDecimal()) {
+        auto values = dictionary_.values->as<int32_t>();
+        setResults([&](auto i) { return filter.testInt64(values[i]); });
+        return true;
+      }
+      if (parquetType == thrift::Type::INT64 || type->isShortDecimal()) {
+        auto values = dictionary_.values->as<int64_t>();
+        setResults([&](auto i) { return filter.testInt64(values[i]); });
+        return true;
+      }
+      return false;
+    case TypeKind::REAL:
+      if (parquetType == thrift::Type::FLOAT) {
+        auto values = dictionary_.values->as<float>();
+        setResults([&](auto i) { return filter.testFloat(values[i]); });
+        return true;
+      }
+      return false;
+    case TypeKind::DOUBLE:
+      if (parquetType == thrift::Type::DOUBLE) {
+        auto values = dictionary_.values->as<double>();
+        setResults([&](auto i) { return filter.testDouble(values[i]); });
+        return true;
+      }
+      return false;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      if (parquetType == thrift::Type::BYTE_ARRAY) {
+        auto values = dictionary_.values->as<StringView>();
+        setResults([&](auto i) {
+          return filter.testBytes(values[i].data(), values[i].size());
+        });
+        return true;
+      }
+      return false;
+    default:
+      return false;
+  }
+}
+
 namespace {
 int32_t parquetTypeBytes(thrift::Type::type type) {
   switch (type) {
@@ -750,6 +896,53 @@ void PageReader::makeDecoder() {
       }
       break;
     case Encoding::DELTA_BINARY_PACKED:
+      switch (parquetType) {
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+          deltaBpDecoder_ = std::make_unique<DeltaBpDecoder>(
+              pageData_,
+              pageData_ + encodedDataSize_,
+              parquetTypeBytes(parquetType));
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "DELTA_BINARY_PACKED not supported for Parquet type {}",
+              parquetType);
+      }
+      break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        VELOX_UNSUPPORTED(
+            "DELTA_LENGTH_BYTE_ARRAY not supported for Parquet type {}",
+            parquetType);
+      }
+      deltaLengthByteArrayDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(
+              pageData_, pageData_ + encodedDataSize_);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        VELOX_UNSUPPORTED(
+            "DELTA_BYTE_ARRAY not supported for Parquet type {}", parquetType);
+      }
+      deltaByteArrayDecoder_ = std::make_unique<DeltaByteArrayDecoder>(
+          pageData_, pageData_ + encodedDataSize_, pool_);
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      switch (parquetType) {
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+          byteStreamSplitDecoder_ = std::make_unique<ByteStreamSplitDecoder>(
+              pageData_,
+              pageData_ + encodedDataSize_,
+              parquetTypeBytes(parquetType));
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT not supported for Parquet type {}",
+              parquetType);
+      }
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
@@ -769,6 +962,10 @@ void PageReader::skip(int64_t numRows) {
     toSkip -= rowOfPage_ - firstUnvisited_;
   }
   firstUnvisited_ += numRows;
+  if (pageNotLoaded_) {
+    VELOX_CHECK_EQ(toSkip, 0, "Skipping into a page that is not loaded");
+    return;
+  }
 
   // Skip nulls
   toSkip = skipNulls(toSkip);
@@ -776,6 +973,14 @@ void PageReader::skip(int64_t numRows) {
   // Skip the decoder
   if (isDictionary()) {
     dictionaryIdDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_BINARY_PACKED) {
+    deltaBpDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    deltaLengthByteArrayDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_BYTE_ARRAY) {
+    deltaByteArrayDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::BYTE_STREAM_SPLIT) {
+    byteStreamSplitDecoder_->skip(toSkip);
   } else if (directDecoder_) {
     directDecoder_->skip(toSkip);
   } else if (stringDecoder_) {
@@ -821,6 +1026,10 @@ void PageReader::skipNullsOnly(int64_t numRows) {
   } else {
     firstUnvisited_ += numRows;
   }
+  if (pageNotLoaded_) {
+    VELOX_CHECK_EQ(toSkip, 0, "Skipping into a page that is not loaded");
+    return;
+  }
 
   // Skip nulls
   skipNulls(toSkip);
@@ -837,6 +1046,7 @@ void PageReader::readNullsOnly(int64_t numValues, BufferPtr& buffer) {
     auto availableOnPage = rowOfPage_ + numRowsInPage_ - firstUnvisited_;
     if (!availableOnPage) {
       seekToPage(firstUnvisited_);
+      VELOX_CHECK(!pageNotLoaded_, "Reading a page that is not loaded");
       availableOnPage = numRowsInPage_;
     }
     auto numRead = std::min(availableOnPage, toRead);
@@ -899,12 +1109,13 @@ bool PageReader::rowsForPage(
       numLeafNullsConsumed_ = rowOfPage_;
     }
   }
+  VELOX_CHECK(!pageNotLoaded_, "Reading a page that is not loaded");
   auto& scanState = reader.scanState();
   if (isDictionary()) {
     if (scanState.dictionary.values != dictionary_.values) {
       scanState.dictionary = dictionary_;
       if (hasFilter) {
-        makeFilterCache(scanState);
+        makeFilterCache(scanState, reader.scanSpec()->filter());
       }
       scanState.updateRawState();
     }
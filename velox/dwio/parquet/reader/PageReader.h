@@ -23,6 +23,10 @@
 #include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -110,6 +114,21 @@ class PageReader {
   /// Advances 'numRows' top level rows.
   void skip(int64_t numRows);
 
+  /// Sets the page index of the column chunk. Seeking to a row then goes
+  /// directly to the data page containing the row without reading the
+  /// headers of the pages in between. 'chunkOffset' is the file offset of the
+  /// start of the input stream. If 'loadedPages' is not empty, only the data
+  /// pages flagged in it are in the input stream and the others must not be
+  /// read.
+  void setPageIndex(
+      std::unique_ptr<ColumnPageIndex> pageIndex,
+      int64_t chunkOffset,
+      std::vector<bool> loadedPages) {
+    pageIndex_ = std::move(pageIndex);
+    chunkOffset_ = chunkOffset;
+    loadedPages_ = std::move(loadedPages);
+  }
+
   /// Decodes repdefs for 'numTopLevelRows'. Use getLengthsAndNulls()
   /// to access the lengths and nulls for the different nesting
   /// levels.
@@ -171,6 +190,16 @@ class PageReader {
   // bufferEnd_ to the corresponding positions.
   thrift::PageHeader readPageHeader();
 
+  /// Reads the dictionary page at the start of the column chunk. Used for
+  /// evaluating filters on the dictionary before reading the data pages.
+  const dwio::common::DictionaryValues& readDictionaryPage();
+
+  /// Evaluates 'filter' on each value of the current dictionary and sets the
+  /// corresponding element of 'results' to FilterResult::kSuccess or
+  /// kFailure. Returns false without setting 'results' if the filter cannot
+  /// be evaluated on the dictionary values of this column.
+  bool filterDictionary(const common::Filter& filter, uint8_t* results) const;
+
  private:
   // Indicates that we only want the repdefs for the next page. Used when
   // prereading repdefs with seekToPage.
@@ -189,8 +218,13 @@ class PageReader {
   // current page.
   int32_t skipNulls(int32_t numRows);
 
-  // Initializes a filter result cache for the dictionary in 'state'.
-  void makeFilterCache(dwio::common::ScanState& state);
+  // Initializes a filter result cache for the dictionary in 'state'. The
+  // cache is filled with the results of 'filter' for all dictionary entries
+  // if the filter can be evaluated on the dictionary, so that the rows are
+  // filtered by dictionary index only.
+  void makeFilterCache(
+      dwio::common::ScanState& state,
+      const common::Filter* FOLLY_NULLABLE filter);
 
   // Makes a decoder based on 'encoding_' for bytes from ''pageData_' to
   // 'pageData_' + 'encodedDataSize_'.
@@ -205,6 +239,11 @@ class PageReader {
   // allowed for non-top level columns.
   void seekToPage(int64_t row);
 
+  // Uses 'pageIndex_' to skip to the data page containing 'row' if the page is
+  // after 'pageStart_'. Returns true if the page is not loaded, in which case
+  // 'this' is positioned after the page with the row info set to the page.
+  bool seekWithPageIndex(int64_t row);
+
   // Preloads the repdefs for the column chunk. To avoid preloading,
   // would need a way too clone the input stream so that one stream
   // reads ahead for repdefs and the other tracks the data. This is
@@ -245,6 +284,12 @@ class PageReader {
       uint32_t compressedSize,
       uint32_t uncompressedSize);
 
+  // Returns the uncompressed contents of the page described by
+  // 'pageHeader', whose data starts at the current position. Serves the page
+  // from the decompressed page cache when 'inputStream_' has it and offers
+  // newly decompressed pages to that cache.
+  const char* FOLLY_NONNULL readPageData(const thrift::PageHeader& pageHeader);
+
   template <typename T>
   T readField(const char* FOLLY_NONNULL& ptr) {
     T data = *reinterpret_cast<const T*>(ptr);
@@ -301,6 +346,12 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
+        deltaBpDecoder_->readWithVisitor<true>(
+            nulls, visitor, nullsFromFastPath);
+      } else if (encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT) {
+        byteStreamSplitDecoder_->readWithVisitor<true>(
+            nulls, visitor, nullsFromFastPath);
       } else {
         directDecoder_->readWithVisitor<true>(
             nulls, visitor, nullsFromFastPath);
@@ -309,6 +360,11 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
+        deltaBpDecoder_->readWithVisitor<false>(
+            nulls, visitor, !this->type_->type()->isShortDecimal());
+      } else if (encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT) {
+        byteStreamSplitDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<false>(
             nulls, visitor, !this->type_->type()->isShortDecimal());
@@ -332,14 +388,34 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
       } else {
         nullsFromFastPath = false;
-        stringDecoder_->readWithVisitor<true>(nulls, visitor);
+        switch (encoding_) {
+          case thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY:
+            deltaLengthByteArrayDecoder_->readWithVisitor<true>(
+                nulls, visitor);
+            break;
+          case thrift::Encoding::DELTA_BYTE_ARRAY:
+            deltaByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+            break;
+          default:
+            stringDecoder_->readWithVisitor<true>(nulls, visitor);
+        }
       }
     } else {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else {
-        stringDecoder_->readWithVisitor<false>(nulls, visitor);
+        switch (encoding_) {
+          case thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY:
+            deltaLengthByteArrayDecoder_->readWithVisitor<false>(
+                nulls, visitor);
+            break;
+          case thrift::Encoding::DELTA_BYTE_ARRAY:
+            deltaByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
+            break;
+          default:
+            stringDecoder_->readWithVisitor<false>(nulls, visitor);
+        }
       }
     }
   }
@@ -433,6 +509,21 @@ class PageReader {
   // Encoding of current page.
   thrift::Encoding::type encoding_;
 
+  // Page index of the column chunk, if used for seeking.
+  std::unique_ptr<ColumnPageIndex> pageIndex_;
+
+  // File offset of the start of 'inputStream_'. Page offsets in 'pageIndex_'
+  // are relative to the file.
+  int64_t chunkOffset_{0};
+
+  // Flags for the data pages that are in 'inputStream_'. Empty if all pages
+  // are.
+  std::vector<bool> loadedPages_;
+
+  // True if the current page is one that is not loaded. There is no data or
+  // decoder for the page and none of its rows may be read.
+  bool pageNotLoaded_{false};
+
   // Row number of first value in current page from start of ColumnChunk.
   int64_t rowOfPage_{0};
 
@@ -513,6 +604,10 @@ class PageReader {
   std::unique_ptr<RleBpDataDecoder> dictionaryIdDecoder_;
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
+  std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrayDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
+  std::unique_ptr<ByteStreamSplitDecoder> byteStreamSplitDecoder_;
   // Add decoders for other encodings here.
 };
 
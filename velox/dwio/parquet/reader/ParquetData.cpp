@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/parquet/reader/ParquetData.h"
+#include "velox/dwio/common/StreamUtil.h"
 #include "velox/dwio/parquet/reader/Statistics.h"
 
 namespace facebook::velox::parquet {
@@ -24,7 +25,8 @@ using thrift::RowGroup;
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_.row_groups, pool());
+  return std::make_unique<ParquetData>(
+      type, metaData_.row_groups, pool(), runtimeStatistics());
 }
 
 void ParquetData::filterRowGroups(
@@ -82,11 +84,9 @@ bool ParquetData::rowGroupMatches(
   return true;
 }
 
-void ParquetData::enqueueRowGroup(
-    uint32_t index,
-    dwio::common::BufferedInput& input) {
+std::pair<uint64_t, uint64_t> ParquetData::columnChunkRegion(
+    uint32_t index) const {
   auto& chunk = rowGroups_[index].columns[type_->column()];
-  streams_.resize(rowGroups_.size());
   VELOX_CHECK(
       chunk.__isset.meta_data,
       "ColumnMetaData does not exist for schema Id ",
@@ -104,11 +104,372 @@ void ParquetData::enqueueRowGroup(
   uint64_t readSize = (metaData.codec == thrift::CompressionCodec::UNCOMPRESSED)
       ? metaData.total_uncompressed_size
       : metaData.total_compressed_size;
+  return {chunkReadOffset, readSize};
+}
 
+void ParquetData::enqueueRowGroup(
+    uint32_t index,
+    dwio::common::BufferedInput& input,
+    const std::vector<RowRange>* rowRanges) {
+  streams_.resize(rowGroups_.size());
+  loadedPages_.resize(rowGroups_.size());
+  auto [chunkReadOffset, readSize] = columnChunkRegion(index);
+  if (rowRanges && index < pageIndexes_.size() && pageIndexes_[index] &&
+      pageIndexes_[index]->numPages() > 0) {
+    streams_[index] = enqueuePages(index, input, *rowRanges);
+    return;
+  }
   auto id = dwio::common::StreamIdentifier(type_->column());
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
 }
 
+std::unique_ptr<dwio::common::SeekableInputStream> ParquetData::enqueuePages(
+    uint32_t index,
+    dwio::common::BufferedInput& input,
+    const std::vector<RowRange>& rowRanges) {
+  auto& pageIndex = *pageIndexes_[index];
+  auto& locations = pageIndex.offsetIndex()->page_locations;
+  auto chunkOffset = columnChunkRegion(index).first;
+  auto loadedPages = pageIndex.pagesInRanges(rowRanges);
+
+  // Offset and size of the regions to load. The region before the first data
+  // page has the dictionary, if any.
+  std::vector<std::pair<uint64_t, uint64_t>> regions;
+  if (locations[0].offset > chunkOffset) {
+    regions.emplace_back(chunkOffset, locations[0].offset - chunkOffset);
+  }
+  for (size_t i = 0; i < locations.size(); ++i) {
+    if (!loadedPages[i]) {
+      ++stats_.skippedPages;
+      continue;
+    }
+    uint64_t offset = locations[i].offset;
+    uint64_t size = locations[i].compressed_page_size;
+    if (!regions.empty() &&
+        regions.back().first + regions.back().second == offset) {
+      regions.back().second += size;
+    } else {
+      regions.emplace_back(offset, size);
+    }
+  }
+
+  auto id = dwio::common::StreamIdentifier(type_->column());
+  std::vector<PageRangesInputStream::Range> ranges;
+  ranges.reserve(regions.size());
+  for (auto& [offset, size] : regions) {
+    ranges.push_back(
+        {static_cast<int64_t>(offset - chunkOffset),
+         static_cast<int64_t>(size),
+         input.enqueue({offset, size}, &id)});
+  }
+  loadedPages_[index] = std::move(loadedPages);
+  return std::make_unique<PageRangesInputStream>(
+      std::move(ranges),
+      fmt::format("Parquet column {} data pages", type_->column()));
+}
+
+void ParquetData::pageIndexRegion(
+    uint32_t index,
+    bool withColumnIndex,
+    uint64_t& begin,
+    uint64_t& end) const {
+  auto& chunk = rowGroups_[index].columns[type_->column()];
+  if (!chunk.__isset.offset_index_offset ||
+      !chunk.__isset.offset_index_length) {
+    return;
+  }
+  begin = std::min<uint64_t>(begin, chunk.offset_index_offset);
+  end = std::max<uint64_t>(
+      end, chunk.offset_index_offset + chunk.offset_index_length);
+  if (withColumnIndex && chunk.__isset.column_index_offset &&
+      chunk.__isset.column_index_length) {
+    begin = std::min<uint64_t>(begin, chunk.column_index_offset);
+    end = std::max<uint64_t>(
+        end, chunk.column_index_offset + chunk.column_index_length);
+  }
+}
+
+namespace {
+template <typename T>
+std::unique_ptr<T> readThrift(const char* data, uint64_t size) {
+  auto transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(data, size);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  auto result = std::make_unique<T>();
+  result->read(&protocol);
+  return result;
+}
+} // namespace
+
+void ParquetData::loadPageIndex(
+    uint32_t index,
+    bool withColumnIndex,
+    const char* data,
+    uint64_t dataOffset) {
+  auto& chunk = rowGroups_[index].columns[type_->column()];
+  if (!chunk.__isset.offset_index_offset ||
+      !chunk.__isset.offset_index_length) {
+    return;
+  }
+  auto offsetIndex = readThrift<thrift::OffsetIndex>(
+      data + chunk.offset_index_offset - dataOffset,
+      chunk.offset_index_length);
+  if (offsetIndex->page_locations.empty()) {
+    return;
+  }
+  std::unique_ptr<thrift::ColumnIndex> columnIndex;
+  if (withColumnIndex && chunk.__isset.column_index_offset &&
+      chunk.__isset.column_index_length) {
+    columnIndex = readThrift<thrift::ColumnIndex>(
+        data + chunk.column_index_offset - dataOffset,
+        chunk.column_index_length);
+  }
+  pageIndexes_.resize(rowGroups_.size());
+  pageIndexes_[index] = std::make_unique<ColumnPageIndex>(
+      std::move(columnIndex),
+      std::move(offsetIndex),
+      rowGroups_[index].num_rows);
+}
+
+std::optional<std::vector<RowRange>> ParquetData::filterDataPages(
+    uint32_t index,
+    common::Filter& filter) const {
+  if (index >= pageIndexes_.size() || !pageIndexes_[index]) {
+    return std::nullopt;
+  }
+  return pageIndexes_[index]->filterPages(filter, type_->type());
+}
+
+namespace {
+// Upper bound for the size of a BloomFilterHeader. The header has 4 small
+// fields.
+constexpr uint64_t kMaxBloomFilterHeaderSize = 64;
+
+bool mayHaveNulls(const thrift::ColumnMetaData& metaData) {
+  return !metaData.__isset.statistics ||
+      !metaData.statistics.__isset.null_count ||
+      metaData.statistics.null_count > 0;
+}
+
+// True if all data pages of the column chunk are dictionary encoded.
+bool isOnlyDictionaryEncoded(const thrift::ColumnMetaData& metaData) {
+  auto isDictionary = [](thrift::Encoding::type encoding) {
+    return encoding == thrift::Encoding::PLAIN_DICTIONARY ||
+        encoding == thrift::Encoding::RLE_DICTIONARY;
+  };
+  if (metaData.__isset.encoding_stats) {
+    for (auto& stats : metaData.encoding_stats) {
+      if ((stats.page_type == thrift::PageType::DATA_PAGE ||
+           stats.page_type == thrift::PageType::DATA_PAGE_V2) &&
+          !isDictionary(stats.encoding)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Without the page stats, RLE and BIT_PACKED can only be level encodings
+  // since booleans are not dictionary encoded.
+  for (auto encoding : metaData.encodings) {
+    if (!isDictionary(encoding) && encoding != thrift::Encoding::RLE &&
+        encoding != thrift::Encoding::BIT_PACKED) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Adds the Bloom filter hashes of the values passing 'filter' to 'hashes'.
+// The values are hashed as 'physicalType'. Integers outside of the range of
+// INT32 cannot be in an INT32 column and are left out. Returns false if the
+// filter does not consist of a set of values that can be checked.
+bool bloomFilterHashes(
+    const common::Filter& filter,
+    thrift::Type::type physicalType,
+    std::vector<uint64_t>& hashes) {
+  auto addIntegers = [&](const auto& values) {
+    for (int64_t value : values) {
+      if (physicalType == thrift::Type::INT64) {
+        hashes.push_back(SplitBlockBloomFilter::hash(value));
+      } else if (
+          value >= std::numeric_limits<int32_t>::min() &&
+          value <= std::numeric_limits<int32_t>::max()) {
+        hashes.push_back(
+            SplitBlockBloomFilter::hash(static_cast<int32_t>(value)));
+      }
+    }
+  };
+  const bool isInteger = physicalType == thrift::Type::INT32 ||
+      physicalType == thrift::Type::INT64;
+  const bool isBytes = physicalType == thrift::Type::BYTE_ARRAY;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto range = filter.as<common::BigintRange>();
+      if (!isInteger || !range->isSingleValue()) {
+        return false;
+      }
+      addIntegers(std::vector<int64_t>{range->lower()});
+      return true;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      if (!isInteger) {
+        return false;
+      }
+      addIntegers(filter.as<common::BigintValuesUsingHashTable>()->values());
+      return true;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      if (!isInteger) {
+        return false;
+      }
+      addIntegers(filter.as<common::BigintValuesUsingBitmask>()->values());
+      return true;
+    case common::FilterKind::kBytesRange: {
+      auto range = filter.as<common::BytesRange>();
+      if (!isBytes || !range->isSingleValue()) {
+        return false;
+      }
+      hashes.push_back(SplitBlockBloomFilter::hash(range->lower()));
+      return true;
+    }
+    case common::FilterKind::kBytesValues:
+      if (!isBytes) {
+        return false;
+      }
+      for (auto& value : filter.as<common::BytesValues>()->values()) {
+        hashes.push_back(SplitBlockBloomFilter::hash(value));
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+} // namespace
+
+bool ParquetData::rowGroupMatchesBloomFilter(
+    uint32_t index,
+    const common::Filter& filter,
+    dwio::common::BufferedInput& input) const {
+  auto& chunk = rowGroups_[index].columns[type_->column()];
+  if (!chunk.__isset.meta_data ||
+      !chunk.meta_data.__isset.bloom_filter_offset) {
+    return true;
+  }
+  auto& metaData = chunk.meta_data;
+  // Nulls are not in the Bloom filter.
+  if (filter.testNull() && mayHaveNulls(metaData)) {
+    return true;
+  }
+  std::vector<uint64_t> hashes;
+  if (!bloomFilterHashes(filter, metaData.type, hashes)) {
+    return true;
+  }
+  if (hashes.empty()) {
+    return false;
+  }
+
+  // The header is followed by the bitset. The size of the header is not known
+  // before parsing it.
+  const uint64_t offset = metaData.bloom_filter_offset;
+  const uint64_t fileSize = input.getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileSize, "Bloom filter offset is past end of file");
+  char headerBuffer[kMaxBloomFilterHeaderSize];
+  const auto headerReadSize =
+      std::min(kMaxBloomFilterHeaderSize, fileSize - offset);
+  auto stream =
+      input.read(offset, headerReadSize, dwio::common::LogType::STRIPE_INDEX);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      headerReadSize, stream.get(), headerBuffer, bufferStart, bufferEnd);
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      headerBuffer, headerReadSize);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  const uint64_t headerSize = header.read(&protocol);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED) {
+    return true;
+  }
+  VELOX_CHECK(
+      header.numBytes > 0 &&
+          header.numBytes % SplitBlockBloomFilter::kBytesPerBlock == 0,
+      "Invalid Bloom filter size {}",
+      header.numBytes);
+
+  std::vector<uint32_t> words(header.numBytes / sizeof(uint32_t));
+  stream = input.read(
+      offset + headerSize,
+      header.numBytes,
+      dwio::common::LogType::STRIPE_INDEX);
+  bufferStart = nullptr;
+  bufferEnd = nullptr;
+  dwio::common::readBytes(
+      header.numBytes, stream.get(), words.data(), bufferStart, bufferEnd);
+  SplitBlockBloomFilter bloomFilter(std::move(words));
+  for (auto hash : hashes) {
+    if (bloomFilter.findHash(hash)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::optional<std::pair<uint64_t, uint64_t>> ParquetData::dictionaryPageRegion(
+    uint32_t index,
+    const common::Filter& filter) const {
+  auto& chunk = rowGroups_[index].columns[type_->column()];
+  if (!chunk.__isset.meta_data) {
+    return std::nullopt;
+  }
+  auto& metaData = chunk.meta_data;
+  if (!metaData.__isset.dictionary_page_offset ||
+      metaData.dictionary_page_offset <= 0 ||
+      metaData.dictionary_page_offset >= metaData.data_page_offset ||
+      !isOnlyDictionaryEncoded(metaData)) {
+    return std::nullopt;
+  }
+  if (filter.testNull() && mayHaveNulls(metaData)) {
+    return std::nullopt;
+  }
+  const uint64_t offset = metaData.dictionary_page_offset;
+  return std::make_pair(offset, metaData.data_page_offset - offset);
+}
+
+std::unique_ptr<dwio::common::SeekableInputStream>
+ParquetData::enqueueDictionaryPage(
+    uint32_t index,
+    const common::Filter& filter,
+    dwio::common::BufferedInput& input) const {
+  auto region = dictionaryPageRegion(index, filter);
+  if (!region.has_value()) {
+    return nullptr;
+  }
+  auto id = dwio::common::StreamIdentifier(type_->column());
+  return input.enqueue({region->first, region->second}, &id);
+}
+
+bool ParquetData::dictionaryMatches(
+    uint32_t index,
+    const common::Filter& filter,
+    std::unique_ptr<dwio::common::SeekableInputStream> stream) const {
+  auto& metaData = rowGroups_[index].columns[type_->column()].meta_data;
+  PageReader reader(
+      std::move(stream),
+      pool_,
+      type_,
+      metaData.codec,
+      metaData.data_page_offset - metaData.dictionary_page_offset);
+  auto& dictionary = reader.readDictionaryPage();
+  std::vector<uint8_t> results(dictionary.numValues);
+  if (!reader.filterDictionary(filter, results.data())) {
+    return true;
+  }
+  return std::any_of(results.begin(), results.end(), [](auto result) {
+    return result == dwio::common::FilterResult::kSuccess;
+  });
+}
+
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
   static std::vector<uint64_t> empty;
   VELOX_CHECK_LT(index, streams_.size());
@@ -120,6 +481,12 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
       type_,
       metadata.codec,
       metadata.total_compressed_size);
+  if (index < pageIndexes_.size() && pageIndexes_[index]) {
+    reader_->setPageIndex(
+        std::move(pageIndexes_[index]),
+        columnChunkRegion(index).first,
+        std::move(loadedPages_[index]));
+  }
   return dwio::common::PositionProvider(empty);
 }
 
@@ -21,6 +21,8 @@
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -47,16 +49,54 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const std::vector<thrift::RowGroup>& rowGroups,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      dwio::common::ColumnReaderStatistics& stats)
       : pool_(pool),
+        stats_(stats),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         rowGroups_(rowGroups),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
 
-  /// Prepares to read data for 'index'th row group.
-  void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
+  /// Prepares to read data for 'index'th row group. If 'rowRanges' is given
+  /// and the OffsetIndex of the column chunk is loaded, only the data pages
+  /// with rows in 'rowRanges' are read.
+  void enqueueRowGroup(
+      uint32_t index,
+      dwio::common::BufferedInput& input,
+      const std::vector<RowRange>* FOLLY_NULLABLE rowRanges = nullptr);
+
+  /// True if the page index of the column can be used for seeking to rows and
+  /// skipping pages.
+  bool canUsePageIndex() const {
+    return maxRepeat_ == 0;
+  }
+
+  /// Extends ['begin', 'end') to cover the OffsetIndex and, if
+  /// 'withColumnIndex' is true, the ColumnIndex of the column chunk in
+  /// 'index'th row group. Does nothing if the column chunk has no page index.
+  void pageIndexRegion(
+      uint32_t index,
+      bool withColumnIndex,
+      uint64_t& begin,
+      uint64_t& end) const;
+
+  /// Parses the page index of the column chunk in 'index'th row group from
+  /// 'data', which has the bytes of the file starting at 'dataOffset' and
+  /// covers the region returned by pageIndexRegion().
+  void loadPageIndex(
+      uint32_t index,
+      bool withColumnIndex,
+      const char* FOLLY_NONNULL data,
+      uint64_t dataOffset);
+
+  /// Returns the rows of 'index'th row group that are on pages that may have
+  /// values passing 'filter' according to the page index. Returns std::nullopt
+  /// if the page index is not loaded.
+  std::optional<std::vector<RowRange>> filterDataPages(
+      uint32_t index,
+      common::Filter& filter) const;
 
   /// Positions 'this' at 'index'th row group. loadRowGroup must be called
   /// first. The returned PositionProvider is empty and should not be used.
@@ -178,19 +218,69 @@ class ParquetData : public dwio::common::FormatData {
   // Returns the <offset, length> of the row group.
   std::pair<int64_t, int64_t> getRowGroupRegion(uint32_t index) const;
 
+  /// False if the Bloom filter of the column chunk in 'index'th row group
+  /// shows that no value passes 'filter'. Only equality and IN filters on
+  /// integers and strings are checked. The Bloom filter is read from 'input'.
+  bool rowGroupMatchesBloomFilter(
+      uint32_t index,
+      const common::Filter& filter,
+      dwio::common::BufferedInput& input) const;
+
+  /// Returns the offset and size of the dictionary page of the column chunk in
+  /// 'index'th row group if the chunk has only dictionary encoded data pages,
+  /// so that the dictionary can show that no row passes 'filter'. Returns
+  /// std::nullopt if the dictionary cannot be used for 'filter'.
+  std::optional<std::pair<uint64_t, uint64_t>> dictionaryPageRegion(
+      uint32_t index,
+      const common::Filter& filter) const;
+
+  /// Enqueues the dictionary page of the column chunk in 'index'th row group
+  /// on 'input' if dictionaryPageRegion() is set. Returns nullptr otherwise.
+  std::unique_ptr<dwio::common::SeekableInputStream> enqueueDictionaryPage(
+      uint32_t index,
+      const common::Filter& filter,
+      dwio::common::BufferedInput& input) const;
+
+  /// False if no entry of the dictionary page of 'index'th row group passes
+  /// 'filter'. 'stream' is from enqueueDictionaryPage() and its input must be
+  /// loaded.
+  bool dictionaryMatches(
+      uint32_t index,
+      const common::Filter& filter,
+      std::unique_ptr<dwio::common::SeekableInputStream> stream) const;
+
  private:
   /// True if 'filter' may have hits for the column of 'this' according to the
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  // Returns the offset and size of the column chunk in 'index'th row group.
+  std::pair<uint64_t, uint64_t> columnChunkRegion(uint32_t index) const;
+
+  // Enqueues the dictionary page and the data pages of 'index'th row group
+  // that have rows in 'rowRanges'. Adjacent pages are enqueued together.
+  std::unique_ptr<dwio::common::SeekableInputStream> enqueuePages(
+      uint32_t index,
+      dwio::common::BufferedInput& input,
+      const std::vector<RowRange>& rowRanges);
+
  protected:
   memory::MemoryPool& pool_;
+  dwio::common::ColumnReaderStatistics& stats_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const std::vector<thrift::RowGroup>& rowGroups_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  // Page index of the column chunk in each of 'rowGroups_'. Only loaded if
+  // there are filters that can use it.
+  std::vector<std::unique_ptr<ColumnPageIndex>> pageIndexes_;
+
+  // Flags for the data pages that are in 'streams_' if only some of the
+  // pages are enqueued. Empty if all pages are enqueued.
+  std::vector<std::vector<bool>> loadedPages_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
@@ -16,6 +16,7 @@
 
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include <thrift/protocol/TCompactProtocol.h> //@manual
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/MetricsLog.h"
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
@@ -25,6 +26,56 @@ namespace facebook::velox::parquet {
 
 using dwio::common::ColumnSelector;
 
+namespace {
+int64_t parsedSize(const std::vector<thrift::KeyValue>& keyValues) {
+  int64_t size = keyValues.size() * sizeof(thrift::KeyValue);
+  for (const auto& keyValue : keyValues) {
+    size += keyValue.key.size() + keyValue.value.size();
+  }
+  return size;
+}
+
+int64_t parsedSize(const thrift::ColumnChunk& chunk) {
+  const auto& metadata = chunk.meta_data;
+  const auto& stats = metadata.statistics;
+  int64_t size = chunk.file_path.size() +
+      chunk.encrypted_column_metadata.size() +
+      metadata.encodings.size() * sizeof(thrift::Encoding::type) +
+      metadata.path_in_schema.size() * sizeof(std::string) +
+      parsedSize(metadata.key_value_metadata) + stats.max.size() +
+      stats.min.size() + stats.max_value.size() + stats.min_value.size() +
+      metadata.encoding_stats.size() * sizeof(thrift::PageEncodingStats);
+  for (const auto& name : metadata.path_in_schema) {
+    size += name.size();
+  }
+  return size;
+}
+
+// Returns the approximate memory used by the parsed 'fileMetaData'. The
+// parsed footer is several times its serialized size, mostly in the column
+// chunks of each row group.
+int64_t parsedSize(const thrift::FileMetaData& fileMetaData) {
+  int64_t size = sizeof(thrift::FileMetaData) +
+      fileMetaData.schema.size() * sizeof(thrift::SchemaElement) +
+      parsedSize(fileMetaData.key_value_metadata) +
+      fileMetaData.created_by.size() +
+      fileMetaData.column_orders.size() * sizeof(thrift::ColumnOrder) +
+      fileMetaData.footer_signing_key_metadata.size();
+  for (const auto& element : fileMetaData.schema) {
+    size += element.name.size();
+  }
+  for (const auto& rowGroup : fileMetaData.row_groups) {
+    size += sizeof(thrift::RowGroup) +
+        rowGroup.columns.size() * sizeof(thrift::ColumnChunk) +
+        rowGroup.sorting_columns.size() * sizeof(thrift::SortingColumn);
+    for (const auto& chunk : rowGroup.columns) {
+      size += parsedSize(chunk);
+    }
+  }
+  return size;
+}
+} // namespace
+
 /// Metadata and options for reading Parquet.
 class ReaderBase {
  public:
@@ -110,7 +161,9 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // Shared with other readers of the file if 'options_' has a metadata cache
+  // key.
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -133,7 +186,27 @@ ReaderBase::ReaderBase(
   VELOX_CHECK_GT(fileLength_, 0, "Parquet file is empty");
   VELOX_CHECK_GE(fileLength_, 12, "Parquet file is too small");
 
-  loadFileMetaData();
+  auto* metadataCache = options_.fileMetadataCacheKey().empty()
+      ? nullptr
+      : dwio::common::FileMetadataCache::getInstance();
+  if (metadataCache != nullptr) {
+    fileMetaData_ = metadataCache->get<thrift::FileMetaData>(
+        options_.fileMetadataCacheKey(), dwio::common::FileFormat::PARQUET);
+  }
+  if (fileMetaData_ == nullptr) {
+    loadFileMetaData();
+    if (metadataCache != nullptr) {
+      metadataCache->put(
+          options_.fileMetadataCacheKey(),
+          dwio::common::FileFormat::PARQUET,
+          fileMetaData_,
+          parsedSize(*fileMetaData_));
+    }
+  } else if (
+      fileLength_ <= std::max(filePreloadThreshold_, directorySizeGuess_)) {
+    // The footer is cached but small files are still read in one IO.
+    input_->loadCompleteFile();
+  }
   initializeSchema();
 }
 
@@ -184,8 +257,9 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  fileMetaData_ = std::move(fileMetaData);
 }
 
 void ReaderBase::initializeSchema() {
@@ -668,6 +742,7 @@ void ParquetRowReader::filterRowGroups() {
     metadataFilter->eval(res.metadataFilterResults, res.filterResult);
   }
 
+  auto& structReader = static_cast<StructColumnReader&>(*columnReader_);
   uint64_t rowNumber = 0;
   for (auto i = 0; i < rowGroups_.size(); i++) {
     VELOX_CHECK_GT(rowGroups_[i].columns.size(), 0);
@@ -684,6 +759,10 @@ void ParquetRowReader::filterRowGroups() {
     if (rowGroupInRange) {
       if (i < res.totalCount && bits::isBitSet(res.filterResult.data(), i)) {
         ++skippedRowGroups_;
+      } else if (!structReader.rowGroupMatchesBloomFilters(
+                     i, readerBase_->bufferedInput())) {
+        // Checked after the stats since the Bloom filters need IO.
+        ++skippedRowGroups_;
       } else {
         rowGroupIds_.push_back(i);
         firstRowOfRowGroup_.push_back(rowNumber);
@@ -691,22 +770,74 @@ void ParquetRowReader::filterRowGroups() {
     }
     rowNumber += rowGroups_[i].num_rows;
   }
+
+  // The dictionaries of the remaining row groups are read together so that
+  // the reads are coalesced instead of one blocking read per row group.
+  const auto matches = structReader.rowGroupsMatchDictionaries(
+      rowGroupIds_, readerBase_->bufferedInput());
+  int32_t numKept = 0;
+  for (auto i = 0; i < rowGroupIds_.size(); ++i) {
+    if (!matches[i]) {
+      ++skippedRowGroups_;
+      continue;
+    }
+    rowGroupIds_[numKept] = rowGroupIds_[i];
+    firstRowOfRowGroup_[numKept] = firstRowOfRowGroup_[i];
+    ++numKept;
+  }
+  rowGroupIds_.resize(numKept);
+  firstRowOfRowGroup_.resize(numKept);
 }
 
 int64_t ParquetRowReader::nextRowNumber() {
-  if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-      !advanceToNextRowGroup()) {
-    return kAtEnd;
+  for (;;) {
+    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+        !advanceToNextRowGroup()) {
+      return kAtEnd;
+    }
+    skipPrunedRows();
+    if (currentRowInGroup_ < rowsInCurrentRowGroup_) {
+      break;
+    }
   }
   return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
 }
 
+void ParquetRowReader::skipPrunedRows() {
+  if (!rowRanges_.has_value()) {
+    return;
+  }
+  auto& ranges = rowRanges_.value();
+  const int64_t currentRow = currentRowInGroup_;
+  while (nextRowRange_ < ranges.size() &&
+         ranges[nextRowRange_].end <= currentRow) {
+    ++nextRowRange_;
+  }
+  if (nextRowRange_ == ranges.size()) {
+    // No more rows in this row group can pass the filters.
+    currentRowInGroup_ = rowsInCurrentRowGroup_;
+    return;
+  }
+  const auto begin = ranges[nextRowRange_].begin;
+  if (begin > currentRow) {
+    columnReader_->setReadOffset(
+        columnReader_->readOffset() + begin - currentRow);
+    currentRowInGroup_ = begin;
+  }
+}
+
 int64_t ParquetRowReader::nextReadSize(uint64_t size) {
   VELOX_CHECK_GT(size, 0);
   if (nextRowNumber() == kAtEnd) {
     return kAtEnd;
   }
-  return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+  uint64_t rowsLeft = rowsInCurrentRowGroup_ - currentRowInGroup_;
+  if (rowRanges_.has_value()) {
+    // Reads do not cross the end of a range so that the pruned rows after it
+    // are skipped.
+    rowsLeft = rowRanges_->at(nextRowRange_).end - currentRowInGroup_;
+  }
+  return std::min(size, rowsLeft);
 }
 
 uint64_t ParquetRowReader::next(
@@ -737,6 +868,9 @@ bool ParquetRowReader::advanceToNextRowGroup() {
   currentRowGroupPtr_ = &rowGroups_[rowGroupIds_[nextRowGroupIdsIdx_]];
   rowsInCurrentRowGroup_ = currentRowGroupPtr_->num_rows;
   currentRowInGroup_ = 0;
+  rowRanges_ = static_cast<StructColumnReader&>(*columnReader_)
+                   .takeRowRanges(nextRowGroupIndex);
+  nextRowRange_ = 0;
   nextRowGroupIdsIdx_++;
   columnReader_->seekToRowGroup(nextRowGroupIndex);
   return true;
@@ -745,6 +879,7 @@ bool ParquetRowReader::advanceToNextRowGroup() {
 void ParquetRowReader::updateRuntimeStats(
     dwio::common::RuntimeStatistics& stats) const {
   stats.skippedStrides += skippedRowGroups_;
+  stats.columnReaderStatistics.skippedPages += columnReaderStats_.skippedPages;
 }
 
 void ParquetRowReader::resetFilterCaches() {
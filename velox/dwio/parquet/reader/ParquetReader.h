@@ -20,6 +20,7 @@
 #include "velox/dwio/common/Reader.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/dwio/common/SelectiveColumnReader.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 
@@ -78,6 +79,10 @@ class ParquetRowReader : public dwio::common::RowReader {
   // by filterRowGroups().
   bool advanceToNextRowGroup();
 
+  // Skips the rows of the current row group that the page index shows to have
+  // no rows passing the filters. The pages of these rows may not be loaded.
+  void skipPrunedRows();
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions options_;
@@ -93,6 +98,14 @@ class ParquetRowReader : public dwio::common::RowReader {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
 
+  // Rows of the current row group that may pass the filters according to the
+  // page index. std::nullopt if all rows are read.
+  std::optional<std::vector<RowRange>> rowRanges_;
+
+  // Index of the first range in 'rowRanges_' that ends after
+  // 'currentRowInGroup_'.
+  size_t nextRowRange_{0};
+
   // Number of row groups skipped based on stats.
   int32_t skippedRowGroups_{0};
 
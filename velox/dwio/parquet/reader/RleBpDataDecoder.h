@@ -108,49 +108,13 @@ class RleBpDataDecoder : public facebook::velox::parquet::RleBpDecoder {
         !std::is_same_v<typename Visitor::FilterType, common::AlwaysTrue>;
     constexpr bool hasHook =
         !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
-    auto rows = visitor.rows();
-    auto numRows = visitor.numRows();
-    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
-    if (hasNulls) {
-      raw_vector<int32_t>* innerVector = nullptr;
-      auto outerVector = &visitor.outerNonNullRows();
-      if (Visitor::dense || rowsAsRange.back() == rowsAsRange.size() - 1) {
-        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
-        if (outerVector->empty()) {
-          visitor.setAllNull(hasFilter ? 0 : numRows);
-          return;
-        }
-        bulkScan<hasFilter, hasHook, true>(
-            folly::Range<const int32_t*>(rows, outerVector->size()),
-            outerVector->data(),
-            visitor);
-      } else {
-        innerVector = &visitor.innerNonNullRows();
-        int32_t tailSkip = -1;
-        auto anyNulls = dwio::common::nonNullRowsFromSparse < hasFilter,
-             !hasFilter &&
-            !hasHook >
-                (nulls,
-                 rowsAsRange,
-                 *innerVector,
-                 *outerVector,
-                 (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
-                 tailSkip);
-        if (anyNulls) {
-          visitor.setHasNulls();
-        }
-        if (innerVector->empty()) {
-          skip<false>(tailSkip, 0, nullptr);
-          visitor.setAllNull(hasFilter ? 0 : numRows);
-          return;
-        }
-        bulkScan<hasFilter, hasHook, true>(
-            *innerVector, outerVector->data(), visitor);
-        skip<false>(tailSkip, 0, nullptr);
-      }
-    } else {
-      bulkScan<hasFilter, hasHook, false>(rowsAsRange, nullptr, visitor);
-    }
+    dwio::common::fastPathRows<hasNulls>(
+        *this,
+        nulls,
+        visitor,
+        [&](folly::Range<const int32_t*> rows, const int32_t* scatterRows) {
+          bulkScan<hasFilter, hasHook, hasNulls>(rows, scatterRows, visitor);
+        });
   }
 
   template <bool hasFilter, bool hasHook, bool scatter, typename Visitor>
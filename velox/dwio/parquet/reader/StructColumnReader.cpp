@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
+#include "velox/dwio/common/StreamUtil.h"
 #include "velox/dwio/parquet/reader/RepeatedColumnReader.h"
 
 namespace facebook::velox::parquet {
@@ -99,16 +100,181 @@ void StructColumnReader::read(
 std::shared_ptr<dwio::common::BufferedInput> StructColumnReader::loadRowGroup(
     uint32_t index,
     const std::shared_ptr<dwio::common::BufferedInput>& input) {
+  auto rowRanges = filterDataPages(index, *input);
+  if (rowRanges.has_value()) {
+    rowRanges_[index] = *rowRanges;
+  }
   if (isRowGroupBuffered(index, *input)) {
-    enqueueRowGroup(index, *input);
+    // All pages are in memory, so there is no IO to save.
+    enqueueRowGroup(index, *input, nullptr);
     return input;
   }
   auto newInput = input->clone();
-  enqueueRowGroup(index, *newInput);
+  enqueueRowGroup(
+      index, *newInput, rowRanges.has_value() ? &rowRanges.value() : nullptr);
   newInput->load(dwio::common::LogType::STRIPE);
   return newInput;
 }
 
+std::optional<std::vector<RowRange>> StructColumnReader::takeRowRanges(
+    uint32_t index) {
+  auto it = rowRanges_.find(index);
+  if (it == rowRanges_.end()) {
+    return std::nullopt;
+  }
+  auto rowRanges = std::move(it->second);
+  rowRanges_.erase(it);
+  return rowRanges;
+}
+
+bool StructColumnReader::rowGroupMatchesBloomFilters(
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  for (auto& child : children_) {
+    auto filter = child->scanSpec()->filter();
+    auto& childType = static_cast<const ParquetTypeWithId&>(child->fileType());
+    if (!filter || childType.column() == ParquetTypeWithId::kNonLeaf) {
+      continue;
+    }
+    auto& data = child->formatData().as<ParquetData>();
+    if (!data.rowGroupMatchesBloomFilter(index, *filter, input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<bool> StructColumnReader::rowGroupsMatchDictionaries(
+    const std::vector<uint32_t>& rowGroupIds,
+    const dwio::common::BufferedInput& input) {
+  struct DictionaryPage {
+    // Position in 'rowGroupIds'.
+    int32_t position;
+    const ParquetData* data;
+    const common::Filter* filter;
+    std::unique_ptr<dwio::common::SeekableInputStream> stream;
+  };
+  std::vector<bool> matches(rowGroupIds.size(), true);
+  std::unique_ptr<dwio::common::BufferedInput> dictionaryInput;
+  std::vector<DictionaryPage> pages;
+  uint64_t loadBytes = 0;
+  // Loads the enqueued dictionary pages and evaluates the filters on them.
+  auto evaluate = [&]() {
+    if (pages.empty()) {
+      return;
+    }
+    dictionaryInput->load(dwio::common::LogType::STREAM);
+    for (auto& page : pages) {
+      if (matches[page.position] &&
+          !page.data->dictionaryMatches(
+              rowGroupIds[page.position],
+              *page.filter,
+              std::move(page.stream))) {
+        matches[page.position] = false;
+      }
+    }
+    pages.clear();
+    dictionaryInput.reset();
+    loadBytes = 0;
+  };
+
+  std::vector<std::pair<const ParquetData*, const common::Filter*>> leaves;
+  for (auto& child : children_) {
+    auto filter = child->scanSpec()->filter();
+    auto& childType = static_cast<const ParquetTypeWithId&>(child->fileType());
+    if (filter && childType.column() != ParquetTypeWithId::kNonLeaf) {
+      leaves.emplace_back(&child->formatData().as<ParquetData>(), filter);
+    }
+  }
+  for (auto i = 0; i < rowGroupIds.size(); ++i) {
+    uint64_t rowGroupBytes = 0;
+    for (auto& [data, filter] : leaves) {
+      if (auto region = data->dictionaryPageRegion(rowGroupIds[i], *filter)) {
+        rowGroupBytes += region->second;
+      }
+    }
+    if (rowGroupBytes == 0) {
+      continue;
+    }
+    // The dictionaries of consecutive row groups are read in one coalesced
+    // load of at most kMaxDictionaryLoadBytes. Larger dictionaries are read
+    // one row group at a time.
+    if (loadBytes > 0 && loadBytes + rowGroupBytes > kMaxDictionaryLoadBytes) {
+      evaluate();
+    }
+    if (!dictionaryInput) {
+      dictionaryInput = input.clone();
+    }
+    for (auto& [data, filter] : leaves) {
+      auto stream = data->enqueueDictionaryPage(
+          rowGroupIds[i], *filter, *dictionaryInput);
+      if (stream) {
+        pages.push_back({i, data, filter, std::move(stream)});
+      }
+    }
+    loadBytes += rowGroupBytes;
+  }
+  evaluate();
+  return matches;
+}
+
+std::optional<std::vector<RowRange>> StructColumnReader::filterDataPages(
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  // The top level leaf columns and their filters. The page indexes of nested
+  // columns are not used.
+  std::vector<std::pair<ParquetData*, common::Filter*>> leaves;
+  bool hasFilter = false;
+  for (auto& child : children_) {
+    auto& childType = static_cast<const ParquetTypeWithId&>(child->fileType());
+    auto& data = child->formatData().as<ParquetData>();
+    if (childType.column() == ParquetTypeWithId::kNonLeaf ||
+        !data.canUsePageIndex()) {
+      continue;
+    }
+    auto filter = child->scanSpec()->filter();
+    hasFilter |= filter != nullptr;
+    leaves.emplace_back(&data, filter);
+  }
+  if (!hasFilter) {
+    return std::nullopt;
+  }
+
+  // The page indexes of a row group are usually next to each other, so they
+  // are read in one IO.
+  uint64_t begin = std::numeric_limits<uint64_t>::max();
+  uint64_t end = 0;
+  for (auto& [data, filter] : leaves) {
+    data->pageIndexRegion(index, filter != nullptr, begin, end);
+  }
+  if (begin >= end) {
+    return std::nullopt;
+  }
+  std::vector<char> buffer(end - begin);
+  auto stream =
+      input.read(begin, end - begin, dwio::common::LogType::STRIPE_INDEX);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      buffer.size(), stream.get(), buffer.data(), bufferStart, bufferEnd);
+
+  std::optional<std::vector<RowRange>> rowRanges;
+  for (auto& [data, filter] : leaves) {
+    data->loadPageIndex(index, filter != nullptr, buffer.data(), begin);
+    if (!filter) {
+      continue;
+    }
+    auto ranges = data->filterDataPages(index, *filter);
+    if (!ranges.has_value()) {
+      continue;
+    }
+    rowRanges = rowRanges.has_value()
+        ? intersectRowRanges(rowRanges.value(), ranges.value())
+        : std::move(ranges);
+  }
+  return rowRanges;
+}
+
 bool StructColumnReader::isRowGroupBuffered(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -119,16 +285,18 @@ bool StructColumnReader::isRowGroupBuffered(
 
 void StructColumnReader::enqueueRowGroup(
     uint32_t index,
-    dwio::common::BufferedInput& input) {
+    dwio::common::BufferedInput& input,
+    const std::vector<RowRange>* rowRanges) {
   for (auto& child : children_) {
     if (auto structChild = dynamic_cast<StructColumnReader*>(child)) {
-      structChild->enqueueRowGroup(index, input);
+      structChild->enqueueRowGroup(index, input, nullptr);
     } else if (auto listChild = dynamic_cast<ListColumnReader*>(child)) {
       listChild->enqueueRowGroup(index, input);
     } else if (auto mapChild = dynamic_cast<MapColumnReader*>(child)) {
       mapChild->enqueueRowGroup(index, input);
     } else {
-      child->formatData().as<ParquetData>().enqueueRowGroup(index, input);
+      child->formatData().as<ParquetData>().enqueueRowGroup(
+          index, input, rowRanges);
     }
   }
 }
@@ -36,11 +36,40 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   /// Creates the streams for 'rowGroup'. Checks whether row 'rowGroup'
   /// has been buffered in 'input'. If true, return the input. Or else creates
-  /// the streams in a new input and loads.
+  /// the streams in a new input and loads. If the filters on top level
+  /// columns can be evaluated against the page index, only the pages with
+  /// rows that may pass the filters are loaded. See takeRowRanges().
   std::shared_ptr<dwio::common::BufferedInput> loadRowGroup(
       uint32_t index,
       const std::shared_ptr<dwio::common::BufferedInput>& input);
 
+  /// Returns the rows of row group 'index' that may pass the filters
+  /// according to the page index and forgets them. The other rows must be
+  /// skipped without reading since their pages may not be loaded. Returns
+  /// std::nullopt if all rows must be read. loadRowGroup() must be called
+  /// first.
+  std::optional<std::vector<RowRange>> takeRowRanges(uint32_t index);
+
+  /// False if the Bloom filters of the top level columns of 'index'th row
+  /// group show that no row passes the filters. Reads the Bloom filters from
+  /// 'input'.
+  bool rowGroupMatchesBloomFilters(
+      uint32_t index,
+      dwio::common::BufferedInput& input);
+
+  /// Upper bound for the dictionary pages that rowGroupsMatchDictionaries()
+  /// reads in one coalesced load.
+  static constexpr uint64_t kMaxDictionaryLoadBytes = 8 << 20;
+
+  /// Returns a flag for each of 'rowGroupIds' that is false if the
+  /// dictionaries of the top level columns show that no row of the row group
+  /// passes the filters. The dictionary pages of consecutive row groups are
+  /// read in coalesced loads of up to kMaxDictionaryLoadBytes from a clone of
+  /// 'input'.
+  std::vector<bool> rowGroupsMatchDictionaries(
+      const std::vector<uint32_t>& rowGroupIds,
+      const dwio::common::BufferedInput& input);
+
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
   void advanceFieldReader(
@@ -70,7 +99,17 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
  private:
   dwio::common::SelectiveColumnReader* findBestLeaf();
 
-  void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
+  void enqueueRowGroup(
+      uint32_t index,
+      dwio::common::BufferedInput& input,
+      const std::vector<RowRange>* FOLLY_NULLABLE rowRanges);
+
+  // Loads the page indexes of the top level columns of row group 'index' from
+  // 'input' and evaluates the filters on them. Returns the rows that may pass
+  // the filters or std::nullopt if the page indexes are not usable.
+  std::optional<std::vector<RowRange>> filterDataPages(
+      uint32_t index,
+      dwio::common::BufferedInput& input);
 
   bool isRowGroupBuffered(uint32_t index, dwio::common::BufferedInput& input);
 
@@ -85,6 +124,11 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
   // The level information for extracting nulls for 'this' from the
   // repdefs in a leaf PageReader.
   ::parquet::internal::LevelInfo levelInfo_;
+
+  // Rows that may pass the filters according to the page index for the row
+  // groups loaded by loadRowGroup(). Row groups without usable page indexes
+  // are not in the map.
+  std::unordered_map<uint32_t, std::vector<RowRange>> rowRanges_;
 };
 
 } // namespace facebook::velox::parquet
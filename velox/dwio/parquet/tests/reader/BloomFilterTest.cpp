@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+TEST(BloomFilterTest, hashes) {
+  // XXH64 hashes with seed 0 of the byte sequences 0, 1, ..., n - 1, as used
+  // by other Parquet implementations.
+  const int64_t kExpected[] = {
+      -1205034819632174695L,
+      -1642502924627794072L,
+      5216751715308240086L,
+      -1889335612763511331L,
+      -13835840860730338L,
+      -2521325055659080948L,
+      4867868962443297827L,
+      1498682999415010002L};
+  char bytes[8];
+  for (auto i = 0; i < 8; ++i) {
+    EXPECT_EQ(
+        kExpected[i],
+        SplitBlockBloomFilter::hash(std::string_view(bytes, i)))
+        << i;
+    bytes[i] = i;
+  }
+  int64_t bigint;
+  int32_t integer;
+  memcpy(&bigint, bytes, sizeof(bigint));
+  memcpy(&integer, bytes, sizeof(integer));
+  EXPECT_EQ(
+      SplitBlockBloomFilter::hash(std::string_view(bytes, 8)),
+      SplitBlockBloomFilter::hash(bigint));
+  EXPECT_EQ(
+      SplitBlockBloomFilter::hash(std::string_view(bytes, 4)),
+      SplitBlockBloomFilter::hash(integer));
+}
+
+TEST(BloomFilterTest, insertAndFind) {
+  constexpr int32_t kNumValues = 10'000;
+  // About 10 bits per value.
+  SplitBlockBloomFilter filter(16 * 1024);
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    filter.insertHash(SplitBlockBloomFilter::hash(i * 3));
+  }
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    EXPECT_TRUE(filter.findHash(SplitBlockBloomFilter::hash(i * 3))) << i;
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    numFalsePositives +=
+        filter.findHash(SplitBlockBloomFilter::hash(i * 3 + 1));
+  }
+  // The expected false positive rate is about 1%.
+  EXPECT_LT(numFalsePositives, kNumValues / 20);
+}
+
+TEST(BloomFilterTest, strings) {
+  SplitBlockBloomFilter filter(SplitBlockBloomFilter::kBytesPerBlock);
+  filter.insertHash(SplitBlockBloomFilter::hash(std::string_view("apple")));
+  filter.insertHash(SplitBlockBloomFilter::hash(std::string_view("")));
+  EXPECT_TRUE(
+      filter.findHash(SplitBlockBloomFilter::hash(std::string_view("apple"))));
+  EXPECT_TRUE(
+      filter.findHash(SplitBlockBloomFilter::hash(std::string_view(""))));
+  EXPECT_FALSE(
+      filter.findHash(SplitBlockBloomFilter::hash(std::string_view("pear"))));
+}
+
+TEST(BloomFilterTest, invalidSize) {
+  EXPECT_THROW(SplitBlockBloomFilter(0), VeloxRuntimeError);
+  EXPECT_THROW(SplitBlockBloomFilter(48), VeloxRuntimeError);
+}
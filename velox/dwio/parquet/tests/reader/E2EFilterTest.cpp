@@ -16,9 +16,16 @@
 
 #include "velox/dwio/common/tests/E2EFilterTestBase.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+#include "velox/dwio/parquet/writer/NativeWriter.h"
 #include "velox/dwio/parquet/writer/Writer.h"
 
+#include <atomic>
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
 
 using namespace facebook::velox;
 using namespace facebook::velox::common;
@@ -70,8 +77,12 @@ class E2EFilterTest : public E2EFilterTestBase {
           });
     };
 
-    writer_ = std::make_unique<facebook::velox::parquet::Writer>(
-        std::move(sink), options_);
+    if (useNativeWriter_) {
+      writer_ = std::make_unique<NativeWriter>(std::move(sink), options_);
+    } else {
+      writer_ = std::make_unique<facebook::velox::parquet::Writer>(
+          std::move(sink), options_);
+    }
     for (auto& batch : batches) {
       writer_->write(batch);
     }
@@ -85,8 +96,10 @@ class E2EFilterTest : public E2EFilterTestBase {
     return std::make_unique<ParquetReader>(std::move(input), opts);
   }
 
-  std::unique_ptr<facebook::velox::parquet::Writer> writer_;
+  std::unique_ptr<dwio::common::Writer> writer_;
   facebook::velox::parquet::WriterOptions options_;
+  // Writes with NativeWriter instead of the Arrow based Writer.
+  bool useNativeWriter_ = false;
   uint64_t rowsInRowGroup_ = 10'000;
   int64_t bytesInRowGroup_ = 128 * 1'024 * 1'024;
 };
@@ -128,6 +141,110 @@ TEST_F(E2EFilterTest, integerDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, integerDeltaBinaryPacked) {
+  options_.enableDictionary = false;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_BINARY_PACKED;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint",
+      [&]() {
+        makeAllNulls("long_null");
+        makeIntDistribution<int64_t>(
+            "long_val",
+            10, // min
+            100, // max
+            22, // repeats
+            19, // rareFrequency
+            -9999, // rareMin
+            10000000000, // rareMax
+            true); // keepNulls
+      },
+      true,
+      {"short_val", "int_val", "long_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, integerDeltaBinaryPackedPerColumn) {
+  options_.enableDictionary = false;
+  options_.columnEncodings["long_val"] =
+      facebook::velox::parquet::arrow::Encoding::DELTA_BINARY_PACKED;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "int_val:int,"
+      "long_val:bigint",
+      [&]() {},
+      true,
+      {"int_val", "long_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, pageIndex) {
+  options_.enableDictionary = false;
+  options_.enablePageIndex = true;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint",
+      [&]() {
+        makeAllNulls("long_null");
+        // Runs of equal values that span several pages so that filters on
+        // 'int_val' skip pages.
+        for (auto batch = 0; batch < batchCount_; ++batch) {
+          for (auto run = 0; run < 10; ++run) {
+            makeReapeatingValues<int32_t>(
+                "int_val",
+                batch,
+                run * batchSize_ / 10,
+                (run + 1) * batchSize_ / 10,
+                batch * 10 + run);
+          }
+        }
+      },
+      true,
+      {"short_val", "int_val", "long_val", "long_null"},
+      20);
+
+  // An equality filter on runs of 1000 rows reads only the pages of one run.
+  constexpr vector_size_t kRows = 10'000;
+  rowType_ = ROW({"int_val", "long_val"}, {INTEGER(), BIGINT()});
+  auto ints = BaseVector::create<FlatVector<int32_t>>(
+      INTEGER(), kRows, leafPool_.get());
+  auto longs = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kRows, leafPool_.get());
+  std::vector<uint64_t> hitRows;
+  for (auto row = 0; row < kRows; ++row) {
+    ints->set(row, row / 1'000);
+    longs->set(row, row);
+    if (row / 1'000 == 5) {
+      hitRows.push_back(batchPosition(0, row));
+    }
+  }
+  std::vector<RowVectorPtr> batches = {std::make_shared<RowVector>(
+      leafPool_.get(),
+      rowType_,
+      nullptr,
+      kRows,
+      std::vector<VectorPtr>{ints, longs})};
+  writeToMemory(rowType_, batches, false);
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType_);
+  spec->getOrCreateChild(common::Subfield("int_val"))
+      ->addFilter(common::BigintRange(5, 5, false));
+  uint64_t time = 0;
+  readWithFilter(spec, MutationSpec{}, batches, hitRows, time, false);
+  EXPECT_EQ(0, runtimeStats_.skippedStrides);
+  EXPECT_LT(0, runtimeStats_.columnReaderStatistics.skippedPages);
+}
+
 TEST_F(E2EFilterTest, compression) {
   for (const auto compression :
        {common::CompressionKind_SNAPPY,
@@ -237,6 +354,57 @@ TEST_F(E2EFilterTest, integerDictionary) {
       20);
 }
 
+TEST_F(E2EFilterTest, integerDictionaryLongRuns) {
+  // The dictionary ids of long runs of one value are RLE runs in the
+  // RLE_DICTIONARY data pages. Reads that fall inside a run return constant
+  // vectors, with and without a filter.
+  constexpr vector_size_t kRows = 10'000;
+  constexpr int32_t kReadSize = 1'000;
+  rowsInRowGroup_ = kRows;
+  rowType_ = ROW({"long_val"}, {BIGINT()});
+  auto longs = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kRows, leafPool_.get());
+  for (auto row = 0; row < kRows; ++row) {
+    longs->set(row, row < kRows / 2 ? 7 : 8);
+  }
+  writeToMemory(
+      rowType_,
+      {std::make_shared<RowVector>(
+          leafPool_.get(),
+          rowType_,
+          nullptr,
+          kRows,
+          std::vector<VectorPtr>{longs})},
+      false);
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType_);
+  auto batches = readBatches(spec, kReadSize);
+  ASSERT_EQ(kRows / kReadSize, batches.size());
+  for (auto i = 0; i < batches.size(); ++i) {
+    auto& column = batches[i]->childAt(0);
+    ASSERT_EQ(VectorEncoding::Simple::CONSTANT, column->encoding());
+    EXPECT_EQ(
+        i < batches.size() / 2 ? 7 : 8,
+        column->as<SimpleVector<int64_t>>()->valueAt(0));
+  }
+
+  auto filterSpec = std::make_shared<common::ScanSpec>("<root>");
+  filterSpec->addAllChildFields(*rowType_);
+  filterSpec->getOrCreateChild(common::Subfield("long_val"))
+      ->addFilter(common::BigintRange(8, 8, false));
+  vector_size_t numHits = 0;
+  for (auto& batch : readBatches(filterSpec, kReadSize)) {
+    if (batch->size() == 0) {
+      continue;
+    }
+    auto& column = batch->childAt(0);
+    ASSERT_EQ(VectorEncoding::Simple::CONSTANT, column->encoding());
+    EXPECT_EQ(8, column->as<SimpleVector<int64_t>>()->valueAt(0));
+    numHits += batch->size();
+  }
+  EXPECT_EQ(kRows / 2, numHits);
+}
+
 TEST_F(E2EFilterTest, floatAndDoubleDirect) {
   options_.enableDictionary = false;
   options_.dataPageSize = 4 * 1024;
@@ -258,6 +426,28 @@ TEST_F(E2EFilterTest, floatAndDoubleDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, floatAndDoubleByteStreamSplit) {
+  options_.enableDictionary = false;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::BYTE_STREAM_SPLIT;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "float_val:float,"
+      "double_val:double,"
+      "float_val2:float,"
+      "double_val2:double,"
+      "float_null:float",
+      [&]() {
+        makeAllNulls("float_null");
+        makeQuantizedFloat<float>("float_val2", 200, true);
+        makeQuantizedFloat<double>("double_val2", 522, true);
+      },
+      true,
+      {"float_val", "double_val", "float_val2", "double_val2", "float_null"},
+      20);
+}
+
 TEST_F(E2EFilterTest, floatAndDouble) {
   // float_val and double_val may be direct since the
   // values are random.float_val2 and double_val2 are expected to be
@@ -430,6 +620,42 @@ TEST_F(E2EFilterTest, stringDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, stringDeltaLengthByteArray) {
+  options_.enableDictionary = false;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_LENGTH_BYTE_ARRAY;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringUnique("string_val_2");
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
+TEST_F(E2EFilterTest, stringDeltaByteArray) {
+  options_.enableDictionary = false;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_BYTE_ARRAY;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringDistribution("string_val_2", 170, false, true);
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
 TEST_F(E2EFilterTest, stringDictionary) {
   testWithTypes(
       "string_val:string,"
@@ -445,6 +671,72 @@ TEST_F(E2EFilterTest, stringDictionary) {
       20);
 }
 
+TEST_F(E2EFilterTest, dictionaryRowGroupSkip) {
+  // Each batch is a row group with two distinct values in 'int_val'. The
+  // min/max stats of the row groups overlap but the dictionaries do not.
+  rowsInRowGroup_ = 10'000;
+  batchCount_ = 4;
+  batchSize_ = 10'000;
+
+  testWithTypes(
+      "int_val:int,"
+      "string_val:string",
+      [&]() {
+        for (auto batch = 0; batch < batchCount_; ++batch) {
+          makeReapeatingValues<int32_t>(
+              "int_val", batch, 0, batchSize_ / 2, batch);
+          makeReapeatingValues<int32_t>(
+              "int_val", batch, batchSize_ / 2, batchSize_, 100 - batch);
+        }
+        makeStringDistribution("string_val", 100, true, false);
+      },
+      true,
+      {"int_val", "string_val"},
+      20);
+
+  // The same layout with a filter on one value, so that the dictionaries
+  // skip all other row groups.
+  constexpr int32_t kNumRowGroups = 4;
+  constexpr vector_size_t kRows = 1'000;
+  rowsInRowGroup_ = kRows;
+  rowType_ = ROW({"int_val"}, {INTEGER()});
+  std::vector<RowVectorPtr> batches;
+  for (auto group = 0; group < kNumRowGroups; ++group) {
+    auto ints = BaseVector::create<FlatVector<int32_t>>(
+        INTEGER(), kRows, leafPool_.get());
+    for (auto row = 0; row < kRows; ++row) {
+      ints->set(row, row < kRows / 2 ? group : 100 - group);
+    }
+    batches.push_back(std::make_shared<RowVector>(
+        leafPool_.get(),
+        rowType_,
+        nullptr,
+        kRows,
+        std::vector<VectorPtr>{ints}));
+  }
+  writeToMemory(rowType_, batches, false);
+
+  auto testFilter = [&](const common::Filter& filter,
+                        const std::vector<uint64_t>& hitRows,
+                        int32_t numSkipped) {
+    SCOPED_TRACE(filter.toString());
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    spec->getOrCreateChild(common::Subfield("int_val"))->addFilter(filter);
+    uint64_t time = 0;
+    readWithFilter(spec, MutationSpec{}, batches, hitRows, time, false);
+    EXPECT_EQ(numSkipped, runtimeStats_.skippedStrides);
+  };
+
+  std::vector<uint64_t> hitRows;
+  for (auto row = kRows / 2; row < kRows; ++row) {
+    hitRows.push_back(batchPosition(2, row));
+  }
+  testFilter(common::BigintRange(98, 98, false), hitRows, kNumRowGroups - 1);
+  // Within the min and max of every row group but in no dictionary.
+  testFilter(common::BigintRange(50, 50, false), {}, kNumRowGroups);
+}
+
 TEST_F(E2EFilterTest, dedictionarize) {
   rowsInRowGroup_ = 10'000;
   options_.dictionaryPageSizeLimit = 20'000;
@@ -615,6 +907,380 @@ TEST_F(E2EFilterTest, combineRowGroup) {
   EXPECT_EQ(parquetReader.numberOfRows(), 5);
 }
 
+TEST_F(E2EFilterTest, nativeWriterIntegers) {
+  useNativeWriter_ = true;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "tinyint_val:tinyint,"
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint",
+      [&]() {
+        makeIntDistribution<int64_t>(
+            "long_val",
+            10, // min
+            100, // max
+            22, // repeats
+            19, // rareFrequency
+            -9999, // rareMin
+            10000000000, // rareMax
+            true); // keepNulls
+        makeIntDistribution<int8_t>(
+            "tinyint_val",
+            10, // min
+            100, // max
+            22, // repeats
+            19, // rareFrequency
+            -99, // rareMin
+            3000, // rareMax
+            true); // keepNulls
+        makeAllNulls("long_null");
+      },
+      false,
+      {"tinyint_val", "short_val", "int_val", "long_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, nativeWriterDirect) {
+  useNativeWriter_ = true;
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "boolean_val:boolean,"
+      "int_val:int,"
+      "float_val:float,"
+      "double_val:double,"
+      "string_val:string",
+      [&]() {
+        makeQuantizedFloat<float>("float_val", 200, true);
+        makeStringDistribution("string_val", 100, true, false);
+      },
+      false,
+      {"boolean_val", "int_val", "float_val", "double_val", "string_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, nativeWriterStrings) {
+  useNativeWriter_ = true;
+  rowsInRowGroup_ = 10'000;
+  options_.dictionaryPageSizeLimit = 20'000;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string,"
+      "string_const:string,"
+      "varbinary_val:varbinary",
+      [&]() {
+        makeStringDistribution("string_val", 100, true, false);
+        // Exceeds the dictionary size limit and falls back to plain pages.
+        makeStringDistribution("string_val_2", 1700000, false, true);
+        makeStringDistribution("string_const", 1, true, false);
+      },
+      false,
+      {"string_val", "string_val_2"},
+      20);
+}
+
+TEST_F(E2EFilterTest, nativeWriterDecimalAndDate) {
+  useNativeWriter_ = true;
+
+  testWithTypes(
+      "decimal_val:decimal(8, 2),"
+      "date_val:date",
+      [&]() {
+        makeIntDistribution<int64_t>(
+            "decimal_val",
+            10, // min
+            100, // max
+            22, // repeats
+            19, // rareFrequency
+            -999, // rareMin
+            30000, // rareMax
+            true); // keepNulls
+        makeIntDistribution<int32_t>(
+            "date_val",
+            10, // min
+            100, // max
+            22, // repeats
+            19, // rareFrequency
+            -999, // rareMin
+            30000, // rareMax
+            true); // keepNulls
+      },
+      false,
+      {"decimal_val", "date_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, nativeWriterCompression) {
+  useNativeWriter_ = true;
+  options_.dataPageSize = 4 * 1024;
+  for (const auto compression :
+       {common::CompressionKind_SNAPPY,
+        common::CompressionKind_ZSTD,
+        common::CompressionKind_GZIP}) {
+    options_.compression = compression;
+
+    testWithTypes(
+        "int_val:int,"
+        "long_val:bigint,"
+        "string_val:string",
+        [&]() { makeStringDistribution("string_val", 100, true, false); },
+        false,
+        {"int_val", "long_val", "string_val"},
+        3);
+  }
+}
+
+TEST_F(E2EFilterTest, nativeWriterParallelEncoding) {
+  folly::CPUThreadPoolExecutor executor(4);
+  useNativeWriter_ = true;
+  options_.encodingExecutor = &executor;
+  options_.dataPageSize = 4 * 1024;
+  options_.compression = common::CompressionKind_ZSTD;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "double_val:double,"
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringDistribution("string_val", 100, true, false);
+        makeStringDistribution("string_val_2", 170, false, true);
+      },
+      false,
+      {"int_val", "long_val", "string_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, nativeWriterBloomFilter) {
+  // Row group 'g' has the values that are 'g' modulo kNumRowGroups. The min
+  // and max of all row groups overlap, so that only the Bloom filters show
+  // which row group has a value. There are no dictionaries to filter on.
+  constexpr int32_t kNumRowGroups = 4;
+  constexpr vector_size_t kRows = 1'000;
+  useNativeWriter_ = true;
+  options_.enableDictionary = false;
+  options_.enableBloomFilter = true;
+  rowsInRowGroup_ = kRows;
+  rowType_ = ROW({"long_val", "string_val"}, {BIGINT(), VARCHAR()});
+  std::vector<RowVectorPtr> batches;
+  for (auto group = 0; group < kNumRowGroups; ++group) {
+    auto longs = BaseVector::create<FlatVector<int64_t>>(
+        BIGINT(), kRows, leafPool_.get());
+    auto strings = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), kRows, leafPool_.get());
+    for (auto row = 0; row < kRows; ++row) {
+      const int64_t value = row * kNumRowGroups + group;
+      longs->set(row, value);
+      strings->set(row, StringView(fmt::format("s{}", value)));
+    }
+    batches.push_back(std::make_shared<RowVector>(
+        leafPool_.get(),
+        rowType_,
+        nullptr,
+        kRows,
+        std::vector<VectorPtr>{longs, strings}));
+  }
+  writeToMemory(rowType_, batches, false);
+
+  auto testFilter = [&](const std::string& column,
+                        const common::Filter& filter,
+                        const std::vector<uint64_t>& hitRows,
+                        int32_t numSkipped) {
+    SCOPED_TRACE(filter.toString());
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    spec->getOrCreateChild(common::Subfield(column))->addFilter(filter);
+    uint64_t time = 0;
+    readWithFilter(spec, MutationSpec{}, batches, hitRows, time, false);
+    EXPECT_EQ(numSkipped, runtimeStats_.skippedStrides);
+  };
+
+  // Row 10 of row group 2 has 42 and row 11 has 46.
+  testFilter(
+      "long_val",
+      common::BigintRange(42, 42, false),
+      {batchPosition(2, 10)},
+      kNumRowGroups - 1);
+  testFilter(
+      "long_val",
+      common::BigintValuesUsingHashTable(42, 5'000, {42, 46, 5'000}, false),
+      {batchPosition(2, 10), batchPosition(2, 11)},
+      kNumRowGroups - 1);
+  testFilter(
+      "string_val",
+      common::BytesValues({"s42", "s46"}, false),
+      {batchPosition(2, 10), batchPosition(2, 11)},
+      kNumRowGroups - 1);
+  // Between the min and the max of all row groups but in none of them.
+  testFilter(
+      "string_val",
+      common::BytesRange("s5000", false, false, "s5000", false, false, false),
+      {},
+      kNumRowGroups);
+}
+
+TEST_F(E2EFilterTest, nativeWriterFactory) {
+  rowType_ = ROW({"int_val"}, {INTEGER()});
+  auto batch = std::static_pointer_cast<RowVector>(
+      test::BatchMaker::createBatch(rowType_, 1'000, *leafPool_, nullptr, 0));
+  auto sink = std::make_unique<MemorySink>(
+      10 * 1024 * 1024, FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  dwio::common::WriterOptions options;
+  options.schema = rowType_;
+  options.memoryPool = rootPool_.get();
+  options.parquetNativeWriter = true;
+  auto writer = ParquetWriterFactory().createWriter(std::move(sink), options);
+  ASSERT_NE(nullptr, dynamic_cast<NativeWriter*>(writer.get()));
+  writer->write(batch);
+  writer->close();
+
+  // The footer has a column order for each column, so that readers use the
+  // min and max statistics.
+  namespace thrift = facebook::velox::parquet::thrift;
+  const auto* data = sinkPtr->data();
+  const auto size = sinkPtr->size();
+  uint32_t footerLength;
+  memcpy(&footerLength, data + size - 8, sizeof(footerLength));
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      data + size - 8 - footerLength, footerLength);
+  auto protocol = std::make_unique<
+      apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
+      transport);
+  thrift::FileMetaData fileMetaData;
+  fileMetaData.read(protocol.get());
+  EXPECT_EQ(1'000, fileMetaData.num_rows);
+  ASSERT_EQ(1, fileMetaData.column_orders.size());
+  EXPECT_TRUE(fileMetaData.column_orders[0].__isset.TYPE_ORDER);
+}
+
+TEST_F(E2EFilterTest, nativeWriterFactoryEncodingExecutor) {
+  // Counts the tasks the writer runs on the executor.
+  class CountingExecutor : public folly::Executor {
+   public:
+    void add(folly::Func func) override {
+      ++numTasks;
+      executor_.add(std::move(func));
+    }
+
+    std::atomic<int32_t> numTasks{0};
+
+   private:
+    folly::CPUThreadPoolExecutor executor_{4};
+  };
+
+  CountingExecutor executor;
+  rowType_ = ROW({"int_val", "long_val"}, {INTEGER(), BIGINT()});
+  auto batch = std::static_pointer_cast<RowVector>(
+      test::BatchMaker::createBatch(rowType_, 1'000, *leafPool_, nullptr, 0));
+  auto sink = std::make_unique<MemorySink>(
+      10 * 1024 * 1024, FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  dwio::common::WriterOptions options;
+  options.schema = rowType_;
+  options.memoryPool = rootPool_.get();
+  options.parquetNativeWriter = true;
+  options.encodingExecutor = &executor;
+  auto writer = ParquetWriterFactory().createWriter(std::move(sink), options);
+  writer->write(batch);
+  writer->close();
+  EXPECT_LT(0, executor.numTasks);
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  std::string_view data(sinkPtr->data(), sinkPtr->size());
+  auto input = std::make_unique<BufferedInput>(
+      std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+  auto reader = makeReader(readerOpts, std::move(input));
+  EXPECT_EQ(1'000, reader->numberOfRows());
+}
+
+TEST_F(E2EFilterTest, nativeWriterEncodedVectors) {
+  // Dictionary and constant vectors are written without being flattened.
+  useNativeWriter_ = true;
+  constexpr vector_size_t kSize = 1'000;
+  rowType_ =
+      ROW({"dictionary_val", "constant_val", "null_val", "int_val"},
+          {VARCHAR(), BIGINT(), DOUBLE(), INTEGER()});
+  auto dictionaryBase =
+      std::static_pointer_cast<RowVector>(test::BatchMaker::createBatch(
+          ROW({"s"}, {VARCHAR()}), 100, *leafPool_, nullptr, 1))
+          ->childAt(0);
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 3; ++i) {
+    auto indices = allocateIndices(kSize, leafPool_.get());
+    auto rawIndices = indices->asMutable<vector_size_t>();
+    for (auto row = 0; row < kSize; ++row) {
+      rawIndices[row] = (row * 7 + i) % dictionaryBase->size();
+    }
+    auto ints =
+        std::static_pointer_cast<RowVector>(test::BatchMaker::createBatch(
+            ROW({"i"}, {INTEGER()}), kSize, *leafPool_, nullptr, i));
+    batches.push_back(std::make_shared<RowVector>(
+        leafPool_.get(),
+        rowType_,
+        nullptr,
+        kSize,
+        std::vector<VectorPtr>{
+            BaseVector::wrapInDictionary(
+                nullptr, indices, kSize, dictionaryBase),
+            BaseVector::createConstant(
+                BIGINT(),
+                variant(static_cast<int64_t>(i)),
+                kSize,
+                leafPool_.get()),
+            BaseVector::createNullConstant(DOUBLE(), kSize, leafPool_.get()),
+            ints->childAt(0)}));
+  }
+  writeToMemory(rowType_, batches, false);
+
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType_);
+  uint64_t time = 0;
+  readWithoutFilter(spec, batches, time);
+}
+
+TEST_F(E2EFilterTest, nativeWriterDictionaryMemory) {
+  // The dictionary of the column chunk being written is allocated from the
+  // writer's memory pool.
+  constexpr vector_size_t kSize = 20'000;
+  constexpr int32_t kPrefixSize = 90;
+  rowType_ = ROW({"string_val"}, {VARCHAR()});
+  std::vector<std::string> strings(kSize);
+  auto values = BaseVector::create<FlatVector<StringView>>(
+      VARCHAR(), kSize, leafPool_.get());
+  for (auto i = 0; i < kSize; ++i) {
+    strings[i] = std::string(kPrefixSize, 'x') + std::to_string(i);
+    values->set(i, StringView(strings[i]));
+  }
+  auto batch = std::make_shared<RowVector>(
+      leafPool_.get(),
+      rowType_,
+      nullptr,
+      kSize,
+      std::vector<VectorPtr>{values});
+
+  auto pool = rootPool_->addAggregateChild("nativeWriterDictionaryMemory");
+  options_.dictionaryPageSizeLimit = 8 << 20;
+  auto writer = std::make_unique<NativeWriter>(
+      std::make_unique<MemorySink>(
+          200 * 1024 * 1024, FileSink::Options{.pool = leafPool_.get()}),
+      options_,
+      pool);
+  const auto initialBytes = pool->currentBytes();
+  writer->write(batch);
+  EXPECT_LE(initialBytes + kSize * kPrefixSize, pool->currentBytes());
+  writer->close();
+  writer.reset();
+  EXPECT_EQ(0, pool->currentBytes());
+}
+
 // Define main so that gflags get processed.
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
@@ -107,6 +107,53 @@ TEST_F(ParquetPageReaderTest, corruptedPageHeader) {
   EXPECT_THROW(pageReader->readPageHeader(), VeloxException);
 }
 
+TEST_F(ParquetPageReaderTest, pageRangesInputStream) {
+  // Bytes 0-99 and 200-299 of a column chunk are loaded. Each byte is its
+  // offset modulo 256.
+  std::string chunk(300, 0);
+  for (auto i = 0; i < chunk.size(); ++i) {
+    chunk[i] = i;
+  }
+  std::vector<PageRangesInputStream::Range> ranges;
+  for (auto offset : {0, 200}) {
+    ranges.push_back(
+        {offset,
+         100,
+         std::make_unique<SeekableArrayInputStream>(
+             chunk.data() + offset, 100, 30)});
+  }
+  PageRangesInputStream stream(std::move(ranges), "test");
+  auto expectNext = [&](int32_t offset, int32_t size) {
+    const void* data;
+    int32_t numBytes;
+    ASSERT_TRUE(stream.Next(&data, &numBytes));
+    ASSERT_EQ(size, numBytes);
+    EXPECT_EQ(static_cast<char>(offset), *static_cast<const char*>(data));
+  };
+  auto seek = [&](uint64_t offset) {
+    std::vector<uint64_t> positions{offset};
+    PositionProvider position(positions);
+    stream.seekToPosition(position);
+  };
+
+  expectNext(0, 30);
+  seek(250);
+  expectNext(250, 30);
+  expectNext(280, 20);
+  // Seeks back into the first range and then into the second one.
+  seek(10);
+  expectNext(10, 30);
+  seek(205);
+  expectNext(205, 30);
+  EXPECT_EQ(235, stream.ByteCount());
+
+  // The range in between is not loaded.
+  seek(150);
+  const void* data;
+  int32_t size;
+  EXPECT_THROW(stream.Next(&data, &size), VeloxException);
+}
+
 TEST(CompressionOptionsTest, testCompressionOptions) {
   auto options = PageReader::getParquetDecompressionOptions();
   EXPECT_EQ(
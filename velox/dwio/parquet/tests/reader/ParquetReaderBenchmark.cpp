@@ -39,7 +39,10 @@ const double kFilterErrorMargin = 0.2;
 
 class ParquetReaderBenchmark {
  public:
-  explicit ParquetReaderBenchmark(bool disableDictionary)
+  explicit ParquetReaderBenchmark(
+      bool disableDictionary,
+      facebook::velox::parquet::arrow::Encoding::type encoding =
+          facebook::velox::parquet::arrow::Encoding::PLAIN)
       : disableDictionary_(disableDictionary) {
     rootPool_ =
         memory::defaultMemoryManager().addRootPool("ParquetReaderBenchmark");
@@ -54,6 +57,7 @@ class ParquetReaderBenchmark {
       // The parquet file is in plain encoding format.
       options.enableDictionary = false;
     }
+    options.encoding = encoding;
     options.memoryPool = rootPool_.get();
     writer_ = std::make_unique<facebook::velox::parquet::Writer>(
         std::move(sink), options);
@@ -255,6 +259,22 @@ void run(
       columnName, type, 0, filterRateX100, nullsRateX100, nextSize);
 }
 
+// Compares reading the same data encoded as RLE_DICTIONARY, PLAIN and
+// DELTA_BINARY_PACKED.
+void runWithEncoding(
+    uint32_t,
+    const std::string& columnName,
+    const TypePtr& type,
+    float filterRateX100,
+    uint8_t nullsRateX100,
+    uint32_t nextSize,
+    bool disableDictionary,
+    facebook::velox::parquet::arrow::Encoding::type encoding) {
+  ParquetReaderBenchmark benchmark(disableDictionary, encoding);
+  benchmark.readSingleColumn(
+      columnName, type, 0, filterRateX100, nullsRateX100, nextSize);
+}
+
 #define PARQUET_BENCHMARKS_FILTER_NULLS(_type_, _name_, _filter_, _null_) \
   BENCHMARK_NAMED_PARAM(                                                  \
       run,                                                                \
@@ -363,6 +383,39 @@ void run(
   PARQUET_BENCHMARKS_FILTERS(_type_, _name_, 100) \
   BENCHMARK_DRAW_LINE();
 
+#define PARQUET_BENCHMARKS_ENCODINGS(_type_, _name_, _filter_, _null_) \
+  BENCHMARK_NAMED_PARAM(                                               \
+      runWithEncoding,                                                 \
+      _name_##_Filter_##_filter_##_Nulls_##_null_##_next_20k_dict,     \
+      #_name_,                                                         \
+      _type_,                                                          \
+      _filter_,                                                        \
+      _null_,                                                          \
+      20000,                                                           \
+      false,                                                           \
+      facebook::velox::parquet::arrow::Encoding::PLAIN);               \
+  BENCHMARK_NAMED_PARAM(                                               \
+      runWithEncoding,                                                 \
+      _name_##_Filter_##_filter_##_Nulls_##_null_##_next_20k_plain,    \
+      #_name_,                                                         \
+      _type_,                                                          \
+      _filter_,                                                        \
+      _null_,                                                          \
+      20000,                                                           \
+      true,                                                            \
+      facebook::velox::parquet::arrow::Encoding::PLAIN);               \
+  BENCHMARK_NAMED_PARAM(                                               \
+      runWithEncoding,                                                 \
+      _name_##_Filter_##_filter_##_Nulls_##_null_##_next_20k_delta,    \
+      #_name_,                                                         \
+      _type_,                                                          \
+      _filter_,                                                        \
+      _null_,                                                          \
+      20000,                                                           \
+      true,                                                            \
+      facebook::velox::parquet::arrow::Encoding::DELTA_BINARY_PACKED); \
+  BENCHMARK_DRAW_LINE();
+
 #define PARQUET_BENCHMARKS_NO_FILTER(_type_, _name_) \
   PARQUET_BENCHMARKS_FILTERS(_type_, _name_, 100)    \
   BENCHMARK_DRAW_LINE();
@@ -371,6 +424,12 @@ PARQUET_BENCHMARKS(BIGINT(), BigInt);
 PARQUET_BENCHMARKS(DOUBLE(), Double);
 PARQUET_BENCHMARKS_NO_FILTER(MAP(BIGINT(), BIGINT()), Map);
 PARQUET_BENCHMARKS_NO_FILTER(ARRAY(BIGINT()), List);
+PARQUET_BENCHMARKS_ENCODINGS(BIGINT(), BigInt, 5, 0);
+PARQUET_BENCHMARKS_ENCODINGS(BIGINT(), BigInt, 5, 20);
+PARQUET_BENCHMARKS_ENCODINGS(BIGINT(), BigInt, 100, 0);
+PARQUET_BENCHMARKS_ENCODINGS(BIGINT(), BigInt, 100, 20);
+PARQUET_BENCHMARKS_ENCODINGS(INTEGER(), Integer, 5, 0);
+PARQUET_BENCHMARKS_ENCODINGS(INTEGER(), Integer, 100, 0);
 
 // TODO: Add all data types
 
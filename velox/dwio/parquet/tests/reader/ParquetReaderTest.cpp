@@ -14,10 +14,13 @@
  * limitations under the License.
  */
 
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/dwio/parquet/tests/ParquetReaderTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 
+#include <folly/ScopeGuard.h>
+
 using namespace facebook::velox;
 using namespace facebook::velox::common;
 using namespace facebook::velox::dwio::common;
@@ -633,6 +636,91 @@ TEST_F(ParquetReaderTest, preloadSmallFile) {
   }
 }
 
+TEST_F(ParquetReaderTest, fileMetadataCache) {
+  FileMetadataCache cache(1 << 20);
+  FileMetadataCache::setInstance(&cache);
+  SCOPE_EXIT {
+    FileMetadataCache::setInstance(nullptr);
+  };
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  facebook::velox::dwio::common::ReaderOptions readerOptions{defaultPool.get()};
+  // Only the tail is read when the reader is made.
+  readerOptions.setFilePreloadThreshold(0);
+  readerOptions.setDirectorySizeGuess(1024);
+  readerOptions.setFileMetadataCacheKey(sample);
+
+  auto expected = vectorMaker_->rowVector(
+      {rangeVector<int64_t>(20, 1), rangeVector<double>(20, 1)});
+  for (auto i = 0; i < 2; ++i) {
+    SCOPED_TRACE(fmt::format("Open {}", i));
+    auto file = std::make_shared<LocalReadFile>(sample);
+    ParquetReader reader(
+        std::make_unique<BufferedInput>(file, *defaultPool), readerOptions);
+    // The second reader takes the footer from the cache without IO.
+    if (i == 0) {
+      EXPECT_GT(file->bytesRead(), 0);
+    } else {
+      EXPECT_EQ(0, file->bytesRead());
+    }
+    EXPECT_EQ(i, cache.stats().numHits);
+    EXPECT_EQ(reader.numberOfRows(), 20ULL);
+
+    auto rowReaderOpts = getReaderOpts(sampleSchema());
+    rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+    auto rowReader = reader.createRowReader(rowReaderOpts);
+    assertReadExpected(sampleSchema(), *rowReader, expected, *pool_);
+  }
+
+  // A file under the preload threshold is read in one IO also when the footer
+  // is cached.
+  class CountingMetricsLog : public MetricsLog {
+   public:
+    CountingMetricsLog() : MetricsLog("") {}
+
+    void logRead(
+        uint64_t /*duration*/,
+        const std::string& /*category*/,
+        uint64_t /*fileSize*/,
+        uint64_t /*psSize*/,
+        uint64_t /*footerSize*/,
+        uint64_t /*readOffset*/,
+        uint64_t /*readSize*/,
+        MetricsType /*type*/,
+        uint32_t /*numFileRead*/,
+        uint32_t /*numStripeCache*/) const override {
+      ++numReads;
+    }
+
+    mutable std::atomic<int32_t> numReads{0};
+  };
+  readerOptions.setFilePreloadThreshold(
+      facebook::velox::dwio::common::ReaderOptions::
+          kDefaultFilePreloadThreshold);
+  auto file = std::make_shared<LocalReadFile>(sample);
+  ASSERT_LE(file->size(), readerOptions.getFilePreloadThreshold());
+  auto metricsLog = std::make_shared<CountingMetricsLog>();
+  ParquetReader reader(
+      std::make_unique<BufferedInput>(file, *defaultPool, metricsLog),
+      readerOptions);
+  EXPECT_EQ(2, cache.stats().numHits);
+  EXPECT_EQ(1, metricsLog->numReads);
+  EXPECT_EQ(file->size(), file->bytesRead());
+  auto rowReaderOpts = getReaderOpts(sampleSchema());
+  rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+  auto rowReader = reader.createRowReader(rowReaderOpts);
+  assertReadExpected(sampleSchema(), *rowReader, expected, *pool_);
+  EXPECT_EQ(1, metricsLog->numReads);
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(1, stats.numEntries);
+
+  // The parsed footer is charged more than its serialized size.
+  LocalReadFile file(sample);
+  uint32_t footerLength;
+  file.pread(file.size() - 8, sizeof(footerLength), &footerLength);
+  EXPECT_GT(stats.bytes, footerLength);
+}
+
 TEST_F(ParquetReaderTest, prefetchRowGroups) {
   auto rowType = ROW({"id"}, {BIGINT()});
   const std::string sample(getExampleFilePath("multiple_row_groups.parquet"));
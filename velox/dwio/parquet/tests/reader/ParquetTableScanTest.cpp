@@ -17,9 +17,12 @@
 #include <folly/init/Init.h>
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/dwio/parquet/RegisterParquetReader.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/type/tests/SubfieldFiltersBuilder.h"
@@ -35,14 +38,9 @@ class ParquetTableScanTest : public HiveConnectorTestBase {
  protected:
   using OperatorTestBase::assertQuery;
 
-  void SetUp() {
+  void SetUp() override {
+    HiveConnectorTestBase::SetUp();
     registerParquetReaderFactory();
-
-    auto hiveConnector =
-        connector::getConnectorFactory(
-            connector::hive::HiveConnectorFactory::kHiveConnectorName)
-            ->newConnector(kHiveConnectorId, nullptr);
-    connector::registerConnector(hiveConnector);
   }
 
   void assertSelect(
@@ -442,6 +440,53 @@ TEST_F(ParquetTableScanTest, readAsLowerCase) {
       result.second, {makeRowVector({"a"}, {makeFlatVector<int64_t>({0, 1})})});
 }
 
+TEST_F(ParquetTableScanTest, decompressedPageCache) {
+  const auto compression = common::CompressionKind_SNAPPY;
+  if (!facebook::velox::parquet::Writer::isCodecAvailable(compression)) {
+    GTEST_SKIP() << "Snappy is not available";
+  }
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [&](auto row) { return row % 17; }),
+         makeFlatVector<double>(1'000, [&](auto row) { return row % 13; })}));
+  }
+  // One row group per vector, so that the column chunks of the file are
+  // referenced once per row group.
+  auto filePath = TempFilePath::create();
+  facebook::velox::parquet::WriterOptions options;
+  options.compression = compression;
+  options.memoryPool = rootPool_.get();
+  facebook::velox::parquet::Writer writer(
+      std::make_unique<dwio::common::WriteFileSink>(
+          std::make_unique<LocalWriteFile>(filePath->path, true, false),
+          filePath->path),
+      options);
+  for (const auto& vector : vectors) {
+    writer.write(vector);
+    writer.flush();
+  }
+  writer.close();
+  createDuckDbTable(vectors);
+
+  // The second split of the file reads the pages decompressed by the first.
+  auto plan =
+      PlanBuilder().tableScan(asRowType(vectors[0]->type())).planNode();
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .plan(plan)
+          .splits(std::vector<std::shared_ptr<connector::ConnectorSplit>>{
+              makeSplit(filePath->path), makeSplit(filePath->path)})
+          .connectorConfig(
+              kHiveConnectorId,
+              connector::hive::HiveConfig::kDecompressedPageCacheMinReadPct,
+              "0")
+          .assertResults("SELECT * FROM tmp UNION ALL SELECT * FROM tmp");
+  auto stats = task->taskStats().pipelineStats[0].operatorStats[0].runtimeStats;
+  ASSERT_GT(stats.at("numDecompressedPageHit").sum, 0);
+  ASSERT_GT(stats.at("decompressedPageHitBytes").sum, 0);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   folly::init(&argc, &argv, false);
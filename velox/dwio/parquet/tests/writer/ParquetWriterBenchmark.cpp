@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/dwio/parquet/writer/NativeWriter.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+const vector_size_t kNumRowsPerBatch = 10'000;
+const uint32_t kNumBatches = 50;
+// Distinct values of the dictionary encoded batches.
+const vector_size_t kNumDistinctValues = 1'000;
+
+// Compares the write throughput of the Arrow based Writer and NativeWriter.
+class ParquetWriterBenchmark {
+ public:
+  ParquetWriterBenchmark() {
+    rootPool_ =
+        memory::defaultMemoryManager().addRootPool("ParquetWriterBenchmark");
+    leafPool_ = rootPool_->addLeafChild("ParquetWriterBenchmark");
+  }
+
+  // Makes batches of 'type'. If 'dictionary' is true, each column is a
+  // dictionary vector over kNumDistinctValues values.
+  std::vector<RowVectorPtr> makeBatches(
+      const RowTypePtr& type,
+      bool dictionary) {
+    std::vector<RowVectorPtr> batches;
+    for (auto i = 0; i < kNumBatches; ++i) {
+      if (!dictionary) {
+        batches.push_back(
+            std::static_pointer_cast<RowVector>(test::BatchMaker::createBatch(
+                type, kNumRowsPerBatch, *leafPool_, nullptr, i)));
+        continue;
+      }
+      auto base =
+          std::static_pointer_cast<RowVector>(test::BatchMaker::createBatch(
+              type, kNumDistinctValues, *leafPool_, nullptr, i));
+      auto indices = allocateIndices(kNumRowsPerBatch, leafPool_.get());
+      auto rawIndices = indices->asMutable<vector_size_t>();
+      for (auto row = 0; row < kNumRowsPerBatch; ++row) {
+        rawIndices[row] = folly::Random::rand32(kNumDistinctValues);
+      }
+      std::vector<VectorPtr> children;
+      for (auto& child : base->children()) {
+        children.push_back(BaseVector::wrapInDictionary(
+            nullptr, indices, kNumRowsPerBatch, child));
+      }
+      batches.push_back(std::make_shared<RowVector>(
+          leafPool_.get(),
+          type,
+          nullptr,
+          kNumRowsPerBatch,
+          std::move(children)));
+    }
+    return batches;
+  }
+
+  // Writes 'batches' to memory and returns the size of the file.
+  uint64_t write(const std::vector<RowVectorPtr>& batches, bool native) {
+    auto sink = std::make_unique<dwio::common::MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    WriterOptions options;
+    options.memoryPool = rootPool_.get();
+    std::unique_ptr<dwio::common::Writer> writer;
+    if (native) {
+      writer = std::make_unique<NativeWriter>(std::move(sink), options);
+    } else {
+      writer = std::make_unique<Writer>(std::move(sink), options);
+    }
+    for (auto& batch : batches) {
+      writer->write(batch);
+    }
+    writer->close();
+    return sinkPtr->size();
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<memory::MemoryPool> leafPool_;
+};
+
+void run(uint32_t, const RowTypePtr& type, bool dictionary, bool native) {
+  ParquetWriterBenchmark benchmark;
+  std::vector<RowVectorPtr> batches;
+  BENCHMARK_SUSPEND {
+    batches = benchmark.makeBatches(type, dictionary);
+  }
+  auto size = benchmark.write(batches, native);
+  folly::doNotOptimizeAway(size);
+}
+
+#define PARQUET_WRITER_BENCHMARKS(_type_, _name_)                        \
+  BENCHMARK_NAMED_PARAM(run, _name_##_flat_arrow, _type_, false, false); \
+  BENCHMARK_RELATIVE_NAMED_PARAM(                                        \
+      run, _name_##_flat_native, _type_, false, true);                   \
+  BENCHMARK_NAMED_PARAM(run, _name_##_dict_arrow, _type_, true, false);  \
+  BENCHMARK_RELATIVE_NAMED_PARAM(                                        \
+      run, _name_##_dict_native, _type_, true, true);                    \
+  BENCHMARK_DRAW_LINE();
+
+PARQUET_WRITER_BENCHMARKS(ROW({"c0"}, {BIGINT()}), BigInt);
+PARQUET_WRITER_BENCHMARKS(ROW({"c0"}, {DOUBLE()}), Double);
+PARQUET_WRITER_BENCHMARKS(ROW({"c0"}, {VARCHAR()}), Varchar);
+PARQUET_WRITER_BENCHMARKS(
+    ROW({"c0", "c1", "c2", "c3"}, {INTEGER(), BIGINT(), DOUBLE(), VARCHAR()}),
+    Mixed);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,1099 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/NativeWriter.h"
+
+#include <folly/Random.h>
+#include <folly/ScopeGuard.h>
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+#include <folly/io/IOBuf.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+
+#include <cmath>
+#include <map>
+
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/memory/AllocationPool.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+constexpr std::string_view kMagic = "PAR1";
+
+// Upper bound for the rows of a data page. Dictionary encoded pages of narrow
+// indices would otherwise hold millions of rows before reaching the page size.
+constexpr int32_t kMaxRowsInPage = 20'000;
+
+constexpr int32_t kNoId = -1;
+
+// Containers for the encoding state of a column chunk. They allocate from the
+// writer's memory pool so that buffered pages and dictionaries are accounted.
+template <typename T>
+using PoolVector = std::vector<T, memory::StlAllocator<T>>;
+
+using PoolString =
+    std::basic_string<char, std::char_traits<char>, memory::StlAllocator<char>>;
+
+template <typename K>
+using PoolSet = folly::F14FastSet<
+    K,
+    folly::f14::DefaultHasher<K>,
+    folly::f14::DefaultKeyEqual<K>,
+    memory::StlAllocator<K>>;
+
+template <typename K, typename V>
+using PoolMap = folly::F14FastMap<
+    K,
+    V,
+    folly::f14::DefaultHasher<K>,
+    folly::f14::DefaultKeyEqual<K>,
+    memory::StlAllocator<std::pair<const K, V>>>;
+
+// Bloom filters have about this many bits per distinct value, which gives a
+// false positive rate of about 1%. The size is rounded up to a power of two
+// and capped at kMaxBloomFilterBytes.
+constexpr int32_t kBloomFilterBitsPerValue = 10;
+constexpr int64_t kMaxBloomFilterBytes = 1 << 20;
+
+using ThriftBuffer = apache::thrift::transport::TMemoryBuffer;
+
+// Appends the compact protocol encoding of 'object' to 'out'.
+template <typename T>
+void serializeThrift(const T& object, std::string& out) {
+  auto buffer = std::make_shared<ThriftBuffer>();
+  apache::thrift::protocol::TCompactProtocolT<ThriftBuffer> protocol(buffer);
+  object.write(&protocol);
+  uint8_t* data;
+  uint32_t size;
+  buffer->getBuffer(&data, &size);
+  out.append(reinterpret_cast<const char*>(data), size);
+}
+
+template <typename T, typename Out>
+void appendRaw(T value, Out& out) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename Out>
+void appendVarint(uint32_t value, Out& out) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+// Appends 'values' to 'out' in the RLE/bit-packed hybrid encoding with
+// 'bitWidth' bits per value. Runs of at least 8 equal values are RLE runs, the
+// values in between are bit-packed in groups of 8.
+template <typename Out>
+void encodeRleBp(
+    const PoolVector<uint32_t>& values,
+    int32_t bitWidth,
+    Out& out) {
+  constexpr int32_t kMinRepeat = 8;
+  constexpr int32_t kMaxGroups = 63;
+  const int32_t numValues = values.size();
+  // Returns the number of values equal to values[begin] starting at 'begin',
+  // counting at most 'limit'.
+  auto runLength = [&](int32_t begin, int32_t limit) {
+    auto end = begin + 1;
+    while (end < numValues && end - begin < limit &&
+           values[end] == values[begin]) {
+      ++end;
+    }
+    return end - begin;
+  };
+  int32_t i = 0;
+  while (i < numValues) {
+    auto run = runLength(i, std::numeric_limits<int32_t>::max());
+    if (run >= kMinRepeat) {
+      appendVarint(run << 1, out);
+      const uint32_t value = values[i];
+      out.append(
+          reinterpret_cast<const char*>(&value), bits::nbytes(bitWidth));
+      i += run;
+      continue;
+    }
+    auto end = i;
+    do {
+      end = std::min(end + 8, numValues);
+    } while (end < numValues && end - i < kMaxGroups * 8 &&
+             runLength(end, kMinRepeat) < kMinRepeat);
+    // Only the last group of the page may be partial. It is padded with
+    // zeros.
+    const int32_t numGroups = bits::roundUp(end - i, 8) / 8;
+    appendVarint(numGroups << 1 | 1, out);
+    uint64_t buffer = 0;
+    int32_t numBits = 0;
+    for (auto j = i; j < i + numGroups * 8; ++j) {
+      buffer |= static_cast<uint64_t>(j < end ? values[j] : 0) << numBits;
+      numBits += bitWidth;
+      for (; numBits >= 8; numBits -= 8) {
+        out.push_back(static_cast<char>(buffer));
+        buffer >>= 8;
+      }
+    }
+    i = end;
+  }
+}
+
+thrift::CompressionCodec::type thriftCodec(common::CompressionKind kind) {
+  switch (kind) {
+    case common::CompressionKind_NONE:
+      return thrift::CompressionCodec::UNCOMPRESSED;
+    case common::CompressionKind_SNAPPY:
+      return thrift::CompressionCodec::SNAPPY;
+    case common::CompressionKind_GZIP:
+      return thrift::CompressionCodec::GZIP;
+    case common::CompressionKind_ZSTD:
+      return thrift::CompressionCodec::ZSTD;
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported compression {} in native Parquet writer",
+          common::compressionKindToString(kind));
+  }
+}
+
+dwio::common::StripeProgress getStripeProgress(
+    uint64_t stagingRows,
+    int64_t stagingBytes) {
+  return dwio::common::StripeProgress{
+      .stripeRowCount = stagingRows, .stripeSizeEstimate = stagingBytes};
+}
+
+} // namespace
+
+// Encodes the values of one top level column into the pages of a column
+// chunk. The pages of the current row group are kept in memory until the row
+// group is written.
+class ColumnChunkWriter {
+ public:
+  ColumnChunkWriter(
+      std::string name,
+      TypePtr type,
+      thrift::Type::type physicalType,
+      const WriterOptions& options,
+      memory::MemoryPool& pool)
+      : name_(std::move(name)),
+        type_(std::move(type)),
+        physicalType_(physicalType),
+        options_(options),
+        pool_(pool),
+        codec_(thriftCodec(options.compression)),
+        compressor_(
+            codec_ == thrift::CompressionCodec::UNCOMPRESSED
+                ? nullptr
+                : common::compressionKindToCodec(options.compression)),
+        pages_(std::make_unique<dwio::common::DataBuffer<char>>(pool_)),
+        dictionaryPage_(
+            std::make_unique<dwio::common::DataBuffer<char>>(pool_)),
+        bloomFilterHashes_(memory::StlAllocator<uint64_t>(pool_)) {}
+
+  virtual ~ColumnChunkWriter() = default;
+
+  // Appends rows [begin, end) of 'vector'.
+  virtual void
+  write(const BaseVector& vector, vector_size_t begin, vector_size_t end) = 0;
+
+  thrift::SchemaElement schemaElement() const;
+
+  // Size of the encoded pages of the current column chunk.
+  int64_t bufferedBytes() const {
+    return pages_->size() + dictionaryPage_->size() + pageBytes();
+  }
+
+  // Writes the page being filled and the dictionary page, if any. Called
+  // before finish().
+  virtual void finishPages() = 0;
+
+  // Finishes the column chunk and appends its pages to 'out'. Returns the
+  // metadata for the chunk written at 'offset' in the file.
+  thrift::ColumnChunk finish(
+      int64_t offset,
+      std::vector<dwio::common::DataBuffer<char>>& out);
+
+  // Appends the Bloom filter of the column chunk returned by the last
+  // finish() to 'out'. Returns the number of bytes appended, 0 if there is
+  // no Bloom filter.
+  int64_t finishBloomFilter(std::vector<dwio::common::DataBuffer<char>>& out);
+
+ protected:
+  // Encoded size of the page being filled.
+  virtual int64_t pageBytes() const = 0;
+
+  virtual thrift::Statistics statistics() const = 0;
+
+  // Clears the dictionary and statistics for the next column chunk.
+  virtual void reset() = 0;
+
+  // Writes a data page whose bytes are the concatenation of 'parts'.
+  void writeDataPage(
+      std::initializer_list<std::string_view> parts,
+      int32_t numValues,
+      thrift::Encoding::type encoding);
+
+  void writeDictionaryPage(std::string_view page, int32_t numValues);
+
+  const WriterOptions& options() const {
+    return options_;
+  }
+
+  void addToBloomFilter(uint64_t hash) {
+    bloomFilterHashes_.insert(hash);
+  }
+
+ private:
+  // Appends the header and the compressed 'parts' of a page to 'out'. The
+  // parts are compressed as a chain, so that they are not concatenated first.
+  void writePage(
+      thrift::PageHeader& header,
+      std::initializer_list<std::string_view> parts,
+      dwio::common::DataBuffer<char>& out);
+
+  const std::string name_;
+  const TypePtr type_;
+  const thrift::Type::type physicalType_;
+  const WriterOptions& options_;
+  memory::MemoryPool& pool_;
+  const thrift::CompressionCodec::type codec_;
+  const std::unique_ptr<folly::io::Codec> compressor_;
+
+  std::unique_ptr<dwio::common::DataBuffer<char>> pages_;
+  std::unique_ptr<dwio::common::DataBuffer<char>> dictionaryPage_;
+  // Number of data pages by encoding.
+  std::map<thrift::Encoding::type, int32_t> dataPageEncodings_;
+  int64_t numValues_{0};
+  int64_t uncompressedBytes_{0};
+  std::string header_;
+  // Hashes of the distinct values of the column chunk if Bloom filters are
+  // enabled. The size of the filter depends on their number.
+  PoolSet<uint64_t> bloomFilterHashes_;
+};
+
+thrift::SchemaElement ColumnChunkWriter::schemaElement() const {
+  thrift::SchemaElement element;
+  element.__set_name(name_);
+  element.__set_type(physicalType_);
+  element.__set_repetition_type(thrift::FieldRepetitionType::OPTIONAL);
+  switch (type_->kind()) {
+    case TypeKind::TINYINT:
+      element.__set_converted_type(thrift::ConvertedType::INT_8);
+      break;
+    case TypeKind::SMALLINT:
+      element.__set_converted_type(thrift::ConvertedType::INT_16);
+      break;
+    case TypeKind::INTEGER:
+      if (type_->isDate()) {
+        element.__set_converted_type(thrift::ConvertedType::DATE);
+      }
+      break;
+    case TypeKind::BIGINT:
+      if (type_->isShortDecimal()) {
+        auto [precision, scale] = getDecimalPrecisionScale(*type_);
+        element.__set_converted_type(thrift::ConvertedType::DECIMAL);
+        element.__set_precision(precision);
+        element.__set_scale(scale);
+      }
+      break;
+    case TypeKind::VARCHAR:
+      element.__set_converted_type(thrift::ConvertedType::UTF8);
+      break;
+    default:
+      break;
+  }
+  return element;
+}
+
+void ColumnChunkWriter::writePage(
+    thrift::PageHeader& header,
+    std::initializer_list<std::string_view> parts,
+    dwio::common::DataBuffer<char>& out) {
+  int64_t size = 0;
+  std::unique_ptr<folly::IOBuf> input;
+  for (auto part : parts) {
+    size += part.size();
+    if (compressor_) {
+      auto buffer = folly::IOBuf::wrapBuffer(part.data(), part.size());
+      if (input) {
+        input->prependChain(std::move(buffer));
+      } else {
+        input = std::move(buffer);
+      }
+    }
+  }
+  std::unique_ptr<folly::IOBuf> compressed;
+  if (compressor_) {
+    compressed = compressor_->compress(input.get());
+  }
+  header.__set_uncompressed_page_size(size);
+  header.__set_compressed_page_size(
+      compressed ? compressed->computeChainDataLength() : size);
+  header_.clear();
+  serializeThrift(header, header_);
+  out.extendAppend(out.size(), header_.data(), header_.size());
+  if (compressed) {
+    for (auto range : *compressed) {
+      out.extendAppend(
+          out.size(),
+          reinterpret_cast<const char*>(range.data()),
+          range.size());
+    }
+  } else {
+    for (auto part : parts) {
+      out.extendAppend(out.size(), part.data(), part.size());
+    }
+  }
+  uncompressedBytes_ += header_.size() + size;
+}
+
+void ColumnChunkWriter::writeDataPage(
+    std::initializer_list<std::string_view> parts,
+    int32_t numValues,
+    thrift::Encoding::type encoding) {
+  thrift::DataPageHeader dataPageHeader;
+  dataPageHeader.__set_num_values(numValues);
+  dataPageHeader.__set_encoding(encoding);
+  dataPageHeader.__set_definition_level_encoding(thrift::Encoding::RLE);
+  dataPageHeader.__set_repetition_level_encoding(thrift::Encoding::RLE);
+  thrift::PageHeader header;
+  header.__set_type(thrift::PageType::DATA_PAGE);
+  header.__set_data_page_header(dataPageHeader);
+  writePage(header, parts, *pages_);
+  ++dataPageEncodings_[encoding];
+  numValues_ += numValues;
+}
+
+void ColumnChunkWriter::writeDictionaryPage(
+    std::string_view page,
+    int32_t numValues) {
+  thrift::DictionaryPageHeader dictionaryPageHeader;
+  dictionaryPageHeader.__set_num_values(numValues);
+  dictionaryPageHeader.__set_encoding(thrift::Encoding::PLAIN);
+  thrift::PageHeader header;
+  header.__set_type(thrift::PageType::DICTIONARY_PAGE);
+  header.__set_dictionary_page_header(dictionaryPageHeader);
+  writePage(header, {page}, *dictionaryPage_);
+}
+
+thrift::ColumnChunk ColumnChunkWriter::finish(
+    int64_t offset,
+    std::vector<dwio::common::DataBuffer<char>>& out) {
+  std::vector<thrift::Encoding::type> encodings = {thrift::Encoding::RLE};
+  std::vector<thrift::PageEncodingStats> encodingStats;
+  thrift::ColumnMetaData metaData;
+  const int64_t dictionaryPageSize = dictionaryPage_->size();
+  if (dictionaryPageSize > 0) {
+    thrift::PageEncodingStats stats;
+    stats.__set_page_type(thrift::PageType::DICTIONARY_PAGE);
+    stats.__set_encoding(thrift::Encoding::PLAIN);
+    stats.__set_count(1);
+    encodingStats.push_back(stats);
+    encodings.push_back(thrift::Encoding::PLAIN);
+    metaData.__set_dictionary_page_offset(offset);
+  }
+  for (auto [encoding, count] : dataPageEncodings_) {
+    thrift::PageEncodingStats stats;
+    stats.__set_page_type(thrift::PageType::DATA_PAGE);
+    stats.__set_encoding(encoding);
+    stats.__set_count(count);
+    encodingStats.push_back(stats);
+    if (std::find(encodings.begin(), encodings.end(), encoding) ==
+        encodings.end()) {
+      encodings.push_back(encoding);
+    }
+  }
+  metaData.__set_type(physicalType_);
+  metaData.__set_encodings(encodings);
+  metaData.__set_path_in_schema({name_});
+  metaData.__set_codec(codec_);
+  metaData.__set_num_values(numValues_);
+  metaData.__set_total_uncompressed_size(uncompressedBytes_);
+  metaData.__set_total_compressed_size(dictionaryPageSize + pages_->size());
+  metaData.__set_data_page_offset(offset + dictionaryPageSize);
+  metaData.__set_statistics(statistics());
+  metaData.__set_encoding_stats(encodingStats);
+
+  thrift::ColumnChunk chunk;
+  chunk.__set_file_offset(offset);
+  chunk.__set_meta_data(metaData);
+
+  if (dictionaryPageSize > 0) {
+    out.push_back(std::move(*dictionaryPage_));
+    dictionaryPage_ = std::make_unique<dwio::common::DataBuffer<char>>(pool_);
+  }
+  out.push_back(std::move(*pages_));
+  pages_ = std::make_unique<dwio::common::DataBuffer<char>>(pool_);
+  dataPageEncodings_.clear();
+  numValues_ = 0;
+  uncompressedBytes_ = 0;
+  reset();
+  return chunk;
+}
+
+int64_t ColumnChunkWriter::finishBloomFilter(
+    std::vector<dwio::common::DataBuffer<char>>& out) {
+  if (bloomFilterHashes_.empty()) {
+    return 0;
+  }
+  const auto numBytes = std::min<int64_t>(
+      kMaxBloomFilterBytes,
+      std::max<int64_t>(
+          SplitBlockBloomFilter::kBytesPerBlock,
+          bits::nextPowerOfTwo(
+              bloomFilterHashes_.size() * kBloomFilterBitsPerValue / 8)));
+  SplitBlockBloomFilter filter(numBytes);
+  for (auto hash : bloomFilterHashes_) {
+    filter.insertHash(hash);
+  }
+  bloomFilterHashes_.clear();
+
+  thrift::BloomFilterHeader header;
+  header.__set_numBytes(numBytes);
+  thrift::BloomFilterAlgorithm algorithm;
+  algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+  header.__set_algorithm(algorithm);
+  thrift::BloomFilterHash hash;
+  hash.__set_XXHASH(thrift::XxHash());
+  header.__set_hash(hash);
+  thrift::BloomFilterCompression compression;
+  compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+  header.__set_compression(compression);
+  header_.clear();
+  serializeThrift(header, header_);
+
+  dwio::common::DataBuffer<char> buffer(pool_);
+  buffer.extendAppend(0, header_.data(), header_.size());
+  const auto bytes = filter.bytes();
+  buffer.extendAppend(buffer.size(), bytes.data(), bytes.size());
+  out.push_back(std::move(buffer));
+  return header_.size() + bytes.size();
+}
+
+namespace {
+
+template <typename P>
+struct DictionaryKey {
+  using type = P;
+};
+
+// Floating point values are deduplicated by their bits so that NaNs and
+// signed zeros are kept as they are.
+template <>
+struct DictionaryKey<float> {
+  using type = uint32_t;
+};
+
+template <>
+struct DictionaryKey<double> {
+  using type = uint64_t;
+};
+
+// Writes Velox values of type T as Parquet values of physical type P.
+// Non-boolean values are dictionary encoded until the dictionary exceeds
+// 'dictionaryPageSizeLimit'. The rest of the column chunk is then plain
+// encoded.
+template <typename T, typename P>
+class TypedColumnChunkWriter : public ColumnChunkWriter {
+ public:
+  using Key = typename DictionaryKey<P>::type;
+
+  TypedColumnChunkWriter(
+      std::string name,
+      TypePtr type,
+      thrift::Type::type physicalType,
+      const WriterOptions& options,
+      memory::MemoryPool& pool)
+      : ColumnChunkWriter(
+            std::move(name),
+            std::move(type),
+            physicalType,
+            options,
+            pool),
+        baseIds_(memory::StlAllocator<int32_t>(pool)),
+        useDictionary_(canUseDictionary()),
+        dictionaryIds_(
+            memory::StlAllocator<std::pair<const Key, int32_t>>(pool)),
+        dictionary_(memory::StlAllocator<P>(pool)),
+        dictionaryStrings_(&pool),
+        defineLevels_(memory::StlAllocator<uint32_t>(pool)),
+        indices_(memory::StlAllocator<uint32_t>(pool)),
+        values_(memory::StlAllocator<char>(pool)),
+        page_(memory::StlAllocator<char>(pool)) {}
+
+  void write(const BaseVector& vector, vector_size_t begin, vector_size_t end)
+      override {
+    decoded_.decode(vector);
+    // Ids of the values of a dictionary or constant vector in the Parquet
+    // dictionary, so that each distinct value is looked up once.
+    constantId_ = kNoId;
+    if (useDictionary_ && !decoded_.isIdentityMapping() &&
+        !decoded_.isConstantMapping()) {
+      baseIds_.assign(decoded_.base()->size(), kNoId);
+    }
+    for (auto row = begin; row < end; ++row) {
+      if (decoded_.isNullAt(row)) {
+        defineLevels_.push_back(0);
+        ++numNulls_;
+      } else {
+        if (useDictionary_ && !appendDictionaryIndex(row)) {
+          // The dictionary is full.
+          finishPage();
+          useDictionary_ = false;
+        }
+        if (!useDictionary_) {
+          appendPlain(value(row));
+        }
+        defineLevels_.push_back(1);
+      }
+      if (defineLevels_.size() >= kMaxRowsInPage ||
+          pageBytes() >= options().dataPageSize) {
+        finishPage();
+      }
+    }
+  }
+
+  void finishPages() override {
+    finishPage();
+    if (dictionary_.empty()) {
+      return;
+    }
+    page_.clear();
+    for (auto value : dictionary_) {
+      appendPlain(value, page_);
+    }
+    writeDictionaryPage(page_, dictionary_.size());
+  }
+
+ protected:
+  int64_t pageBytes() const override {
+    const int64_t levelBytes = defineLevels_.size() / 8;
+    if (useDictionary_) {
+      return levelBytes + indices_.size() * dictionaryBitWidth() / 8;
+    }
+    return levelBytes + values_.size();
+  }
+
+  thrift::Statistics statistics() const override {
+    thrift::Statistics stats;
+    stats.__set_null_count(numNulls_);
+    if (hasMinMax_) {
+      std::string min;
+      std::string max;
+      if constexpr (std::is_same_v<P, StringView>) {
+        min = minString_;
+        max = maxString_;
+      } else {
+        appendRaw(min_, min);
+        appendRaw(max_, max);
+      }
+      stats.__set_min_value(min);
+      stats.__set_max_value(max);
+    }
+    return stats;
+  }
+
+  void reset() override {
+    dictionaryIds_.clear();
+    dictionary_.clear();
+    dictionaryStrings_.clear();
+    dictionaryBytes_ = 0;
+    useDictionary_ = canUseDictionary();
+    hasMinMax_ = false;
+    minString_.clear();
+    maxString_.clear();
+    numNulls_ = 0;
+  }
+
+ private:
+  bool canUseDictionary() const {
+    return options().enableDictionary && !std::is_same_v<P, bool>;
+  }
+
+  P value(vector_size_t row) const {
+    return static_cast<P>(decoded_.valueAt<T>(row));
+  }
+
+  int32_t dictionaryBitWidth() const {
+    return dictionary_.size() <= 2
+        ? 1
+        : 64 - __builtin_clzll(dictionary_.size() - 1);
+  }
+
+  static Key toKey(P value) {
+    if constexpr (std::is_floating_point_v<P>) {
+      Key key;
+      memcpy(&key, &value, sizeof(key));
+      return key;
+    } else {
+      return value;
+    }
+  }
+
+  static int32_t plainSize(P value) {
+    if constexpr (std::is_same_v<P, StringView>) {
+      return sizeof(int32_t) + value.size();
+    } else {
+      return sizeof(P);
+    }
+  }
+
+  // Appends the dictionary index of the value at 'row'. Returns false if the
+  // value is not in the dictionary and the dictionary is full.
+  bool appendDictionaryIndex(vector_size_t row) {
+    int32_t* cachedId = nullptr;
+    if (decoded_.isConstantMapping()) {
+      cachedId = &constantId_;
+    } else if (!decoded_.isIdentityMapping()) {
+      cachedId = &baseIds_[decoded_.index(row)];
+    }
+    if (cachedId && *cachedId != kNoId) {
+      indices_.push_back(*cachedId);
+      return true;
+    }
+    auto id = dictionaryId(value(row));
+    if (id == kNoId) {
+      return false;
+    }
+    if (cachedId) {
+      *cachedId = id;
+    }
+    indices_.push_back(id);
+    return true;
+  }
+
+  int32_t dictionaryId(P value) {
+    auto it = dictionaryIds_.find(toKey(value));
+    if (it != dictionaryIds_.end()) {
+      return it->second;
+    }
+    const auto size = plainSize(value);
+    if (dictionaryBytes_ + size > options().dictionaryPageSizeLimit) {
+      return kNoId;
+    }
+    if constexpr (std::is_same_v<P, StringView>) {
+      // The dictionary outlives the input vectors.
+      if (!value.isInline()) {
+        auto* copy = dictionaryStrings_.allocateFixed(value.size());
+        memcpy(copy, value.data(), value.size());
+        value = StringView(copy, value.size());
+      }
+    }
+    const int32_t id = dictionary_.size();
+    dictionary_.push_back(value);
+    dictionaryIds_.emplace(toKey(value), id);
+    dictionaryBytes_ += size;
+    // All values of the dictionary occur in the column chunk.
+    updateStats(value);
+    return id;
+  }
+
+  void appendPlain(P value) {
+    updateStats(value);
+    if constexpr (std::is_same_v<P, bool>) {
+      if (numPlainValues_ % 8 == 0) {
+        values_.push_back(0);
+      }
+      if (value) {
+        values_.back() |= 1 << (numPlainValues_ % 8);
+      }
+    } else {
+      appendPlain(value, values_);
+    }
+    ++numPlainValues_;
+  }
+
+  template <typename Out>
+  static void appendPlain(P value, Out& out) {
+    if constexpr (std::is_same_v<P, StringView>) {
+      appendRaw<int32_t>(value.size(), out);
+      out.append(value.data(), value.size());
+    } else {
+      appendRaw(value, out);
+    }
+  }
+
+  // Adds 'value' to the statistics and the Bloom filter of the column chunk.
+  void updateStats(P value) {
+    if constexpr (!std::is_same_v<P, bool>) {
+      if (options().enableBloomFilter) {
+        addToBloomFilter(bloomFilterHash(value));
+      }
+    }
+    if constexpr (std::is_floating_point_v<P>) {
+      if (std::isnan(value)) {
+        return;
+      }
+    }
+    if (!hasMinMax_) {
+      setMin(value);
+      setMax(value);
+      hasMinMax_ = true;
+      return;
+    }
+    if (value < min_) {
+      setMin(value);
+    } else if (max_ < value) {
+      setMax(value);
+    }
+  }
+
+  static uint64_t bloomFilterHash(P value) {
+    if constexpr (std::is_same_v<P, StringView>) {
+      return SplitBlockBloomFilter::hash(
+          std::string_view(value.data(), value.size()));
+    } else {
+      return SplitBlockBloomFilter::hash(value);
+    }
+  }
+
+  void setMin(P value) {
+    if constexpr (std::is_same_v<P, StringView>) {
+      minString_.assign(value.data(), value.size());
+      min_ = StringView(minString_);
+    } else {
+      min_ = value;
+    }
+  }
+
+  void setMax(P value) {
+    if constexpr (std::is_same_v<P, StringView>) {
+      maxString_.assign(value.data(), value.size());
+      max_ = StringView(maxString_);
+    } else {
+      max_ = value;
+    }
+  }
+
+  // Writes the buffered rows as a data page. Definition levels are RLE
+  // encoded and prefixed with their length.
+  void finishPage() {
+    if (defineLevels_.empty()) {
+      return;
+    }
+    page_.clear();
+    appendRaw<uint32_t>(0, page_);
+    encodeRleBp(defineLevels_, 1, page_);
+    const uint32_t levelsSize = page_.size() - sizeof(uint32_t);
+    memcpy(page_.data(), &levelsSize, sizeof(levelsSize));
+    // A page of only nulls has no values and is written as plain.
+    if (useDictionary_ && !indices_.empty()) {
+      const auto bitWidth = dictionaryBitWidth();
+      page_.push_back(bitWidth);
+      encodeRleBp(indices_, bitWidth, page_);
+      writeDataPage(
+          {page_}, defineLevels_.size(), thrift::Encoding::RLE_DICTIONARY);
+    } else {
+      // The plain values are written after the levels without copying them
+      // into 'page_'.
+      writeDataPage(
+          {page_, values_}, defineLevels_.size(), thrift::Encoding::PLAIN);
+    }
+    defineLevels_.clear();
+    indices_.clear();
+    values_.clear();
+    numPlainValues_ = 0;
+  }
+
+  DecodedVector decoded_;
+  PoolVector<int32_t> baseIds_;
+  int32_t constantId_{kNoId};
+
+  bool useDictionary_;
+  PoolMap<Key, int32_t> dictionaryIds_;
+  PoolVector<P> dictionary_;
+  // Owns the non-inlined strings referenced by 'dictionary_'.
+  memory::AllocationPool dictionaryStrings_;
+  int64_t dictionaryBytes_{0};
+
+  // Rows of the page being filled.
+  PoolVector<uint32_t> defineLevels_;
+  PoolVector<uint32_t> indices_;
+  PoolString values_;
+  int32_t numPlainValues_{0};
+  PoolString page_;
+
+  bool hasMinMax_{false};
+  P min_{};
+  P max_{};
+  std::string minString_;
+  std::string maxString_;
+  int64_t numNulls_{0};
+};
+
+template <typename T, typename P>
+std::unique_ptr<ColumnChunkWriter> makeTypedWriter(
+    const std::string& name,
+    const TypePtr& type,
+    thrift::Type::type physicalType,
+    const WriterOptions& options,
+    memory::MemoryPool& pool) {
+  return std::make_unique<TypedColumnChunkWriter<T, P>>(
+      name, type, physicalType, options, pool);
+}
+
+std::unique_ptr<ColumnChunkWriter> makeColumnWriter(
+    const std::string& name,
+    const TypePtr& type,
+    const WriterOptions& options,
+    memory::MemoryPool& pool) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      return makeTypedWriter<bool, bool>(
+          name, type, thrift::Type::BOOLEAN, options, pool);
+    case TypeKind::TINYINT:
+      return makeTypedWriter<int8_t, int32_t>(
+          name, type, thrift::Type::INT32, options, pool);
+    case TypeKind::SMALLINT:
+      return makeTypedWriter<int16_t, int32_t>(
+          name, type, thrift::Type::INT32, options, pool);
+    case TypeKind::INTEGER:
+      return makeTypedWriter<int32_t, int32_t>(
+          name, type, thrift::Type::INT32, options, pool);
+    case TypeKind::BIGINT:
+      return makeTypedWriter<int64_t, int64_t>(
+          name, type, thrift::Type::INT64, options, pool);
+    case TypeKind::REAL:
+      return makeTypedWriter<float, float>(
+          name, type, thrift::Type::FLOAT, options, pool);
+    case TypeKind::DOUBLE:
+      return makeTypedWriter<double, double>(
+          name, type, thrift::Type::DOUBLE, options, pool);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return makeTypedWriter<StringView, StringView>(
+          name, type, thrift::Type::BYTE_ARRAY, options, pool);
+    default:
+      VELOX_UNSUPPORTED(
+          "Type {} of column {} is not supported by the native Parquet writer",
+          type->toString(),
+          name);
+  }
+}
+
+} // namespace
+
+NativeWriter::NativeWriter(
+    std::unique_ptr<dwio::common::FileSink> sink,
+    const WriterOptions& options,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : options_(options),
+      pool_(std::move(pool)),
+      generalPool_{pool_->addLeafChild(".general")},
+      sink_(std::move(sink)) {
+  if (options.flushPolicyFactory) {
+    flushPolicy_ = options.flushPolicyFactory();
+  } else {
+    flushPolicy_ = std::make_unique<DefaultFlushPolicy>();
+  }
+  // Fails early on codecs that are not supported.
+  thriftCodec(options.compression);
+}
+
+NativeWriter::NativeWriter(
+    std::unique_ptr<dwio::common::FileSink> sink,
+    const WriterOptions& options)
+    : NativeWriter{
+          std::move(sink),
+          options,
+          options.memoryPool->addAggregateChild(fmt::format(
+              "writer_node_{}",
+              folly::to<std::string>(folly::Random::rand64())))} {}
+
+NativeWriter::~NativeWriter() = default;
+
+void NativeWriter::initialize(const RowTypePtr& type) {
+  type_ = type;
+  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
+  fileMetaData_->__set_version(2);
+  fileMetaData_->__set_num_rows(0);
+  fileMetaData_->__set_created_by("parquet-cpp-velox");
+
+  // Columns are ordered by the signed or unsigned order of their type.
+  // Readers ignore the min_value and max_value of columns without an order.
+  std::vector<thrift::ColumnOrder> columnOrders(type->size());
+  for (auto& order : columnOrders) {
+    order.__set_TYPE_ORDER(thrift::TypeDefinedOrder());
+  }
+  fileMetaData_->__set_column_orders(columnOrders);
+
+  std::vector<thrift::SchemaElement> schema(1);
+  schema[0].__set_name("schema");
+  schema[0].__set_repetition_type(thrift::FieldRepetitionType::REQUIRED);
+  schema[0].__set_num_children(type->size());
+  for (uint32_t i = 0; i < type->size(); ++i) {
+    columns_.push_back(makeColumnWriter(
+        type->nameOf(i), type->childAt(i), options_, *generalPool_));
+    schema.push_back(columns_.back()->schemaElement());
+  }
+  fileMetaData_->__set_schema(schema);
+}
+
+void NativeWriter::writeBytes(const char* data, int32_t size) {
+  dwio::common::DataBuffer<char> buffer(*generalPool_);
+  buffer.append(0, data, size);
+  sink_->write(std::move(buffer));
+  fileOffset_ += size;
+}
+
+void NativeWriter::forEachColumn(const std::function<void(size_t)>& func) {
+  auto* executor = options_.encodingExecutor;
+  if (!executor || columns_.size() < 2) {
+    for (size_t i = 0; i < columns_.size(); ++i) {
+      func(i);
+    }
+    return;
+  }
+  std::vector<std::shared_ptr<AsyncSource<bool>>> tasks;
+  tasks.reserve(columns_.size());
+  auto sync = folly::makeGuard([&]() {
+    // The tasks reference 'func' and must all be finished before returning,
+    // also when one of them failed. The first error is already rethrown.
+    for (auto& task : tasks) {
+      try {
+        task->move();
+      } catch (const std::exception&) {
+      }
+    }
+  });
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    tasks.push_back(std::make_shared<AsyncSource<bool>>([&func, i]() {
+      func(i);
+      return std::make_unique<bool>(true);
+    }));
+    executor->add([task = tasks.back()]() { task->prepare(); });
+  }
+  // Tasks not yet started on 'executor' run on this thread.
+  for (auto& task : tasks) {
+    task->move();
+  }
+}
+
+void NativeWriter::write(const VectorPtr& data) {
+  auto* input = data->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(input, "Native Parquet writer expects a RowVector");
+  if (!type_) {
+    initialize(asRowType(data->type()));
+  }
+  if (options_.encodingExecutor) {
+    // Lazy vectors are loaded on this thread before the columns are encoded
+    // in parallel.
+    for (auto& child : input->children()) {
+      child->loadedVector();
+    }
+  }
+
+  int64_t bufferedBytes = 0;
+  for (auto& column : columns_) {
+    bufferedBytes += column->bufferedBytes();
+  }
+  if (flushPolicy_->shouldFlush(getStripeProgress(numRows_, bufferedBytes))) {
+    flush();
+  }
+
+  const auto maxRows = flushPolicy_->rowsInRowGroup();
+  const vector_size_t size = input->size();
+  vector_size_t begin = 0;
+  while (begin < size) {
+    const vector_size_t end =
+        std::min<uint64_t>(size, begin + maxRows - numRows_);
+    forEachColumn([&](size_t i) {
+      columns_[i]->write(*input->childAt(i), begin, end);
+    });
+    numRows_ += end - begin;
+    begin = end;
+    if (numRows_ >= maxRows) {
+      flush();
+    }
+  }
+}
+
+void NativeWriter::flush() {
+  if (numRows_ == 0) {
+    return;
+  }
+  if (fileOffset_ == 0) {
+    writeBytes(kMagic.data(), kMagic.size());
+  }
+  forEachColumn([&](size_t i) { columns_[i]->finishPages(); });
+
+  const auto rowGroupOffset = fileOffset_;
+  std::vector<dwio::common::DataBuffer<char>> buffers;
+  std::vector<thrift::ColumnChunk> chunks;
+  int64_t totalBytes = 0;
+  for (auto& column : columns_) {
+    chunks.push_back(column->finish(fileOffset_, buffers));
+    auto& metaData = chunks.back().meta_data;
+    fileOffset_ += metaData.total_compressed_size;
+    totalBytes += metaData.total_uncompressed_size;
+  }
+  sink_->write(buffers);
+  const auto rowGroupSize = fileOffset_ - rowGroupOffset;
+
+  // The Bloom filters follow the column chunks of the row group.
+  buffers.clear();
+  for (auto i = 0; i < columns_.size(); ++i) {
+    const auto size = columns_[i]->finishBloomFilter(buffers);
+    if (size > 0) {
+      chunks[i].meta_data.__set_bloom_filter_offset(fileOffset_);
+      fileOffset_ += size;
+    }
+  }
+  if (!buffers.empty()) {
+    sink_->write(buffers);
+  }
+
+  thrift::RowGroup rowGroup;
+  rowGroup.__set_columns(chunks);
+  rowGroup.__set_num_rows(numRows_);
+  rowGroup.__set_total_byte_size(totalBytes);
+  rowGroup.__set_file_offset(rowGroupOffset);
+  rowGroup.__set_total_compressed_size(rowGroupSize);
+  rowGroup.__set_ordinal(fileMetaData_->row_groups.size());
+  fileMetaData_->row_groups.push_back(std::move(rowGroup));
+  fileMetaData_->num_rows += numRows_;
+  numRows_ = 0;
+}
+
+void NativeWriter::close() {
+  flush();
+  if (fileMetaData_) {
+    if (fileOffset_ == 0) {
+      writeBytes(kMagic.data(), kMagic.size());
+    }
+    std::string footer;
+    serializeThrift(*fileMetaData_, footer);
+    appendRaw<uint32_t>(footer.size(), footer);
+    footer.append(kMagic);
+    writeBytes(footer.data(), footer.size());
+  }
+  sink_->close();
+  columns_.clear();
+}
+
+void NativeWriter::abort() {
+  sink_.reset();
+  columns_.clear();
+  fileMetaData_.reset();
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/writer/Writer.h"
+
+namespace facebook::velox::parquet {
+
+namespace thrift {
+class FileMetaData;
+} // namespace thrift
+
+class ColumnChunkWriter;
+
+// Writes Velox vectors into a DataSink without going through Arrow. Values are
+// encoded into pages straight from flat, constant and dictionary vectors. The
+// distinct values of a Velox dictionary vector are looked up in the Parquet
+// dictionary once per batch, so that dictionary encoded input is written as
+// dictionary encoded pages without being flattened. Writes top level columns
+// of BOOLEAN, TINYINT, SMALLINT, INTEGER, BIGINT, REAL, DOUBLE, VARCHAR,
+// VARBINARY, DATE and short DECIMAL types. ParquetWriterFactory creates it
+// instead of Writer if dwio::common::WriterOptions::parquetNativeWriter is
+// set.
+class NativeWriter : public dwio::common::Writer {
+ public:
+  // Constructs a writer with output to 'sink'. 'pool' is used for the encoded
+  // column chunks of the row group being written and for their dictionaries
+  // and page buffers. If 'encodingExecutor' is set in 'options', the column
+  // chunks of a row group are encoded and compressed in parallel on it and
+  // assembled in column order.
+  NativeWriter(
+      std::unique_ptr<dwio::common::FileSink> sink,
+      const WriterOptions& options,
+      std::shared_ptr<memory::MemoryPool> pool);
+
+  NativeWriter(
+      std::unique_ptr<dwio::common::FileSink> sink,
+      const WriterOptions& options);
+
+  ~NativeWriter() override;
+
+  // Appends 'data' into the writer. A row group is finished when the flush
+  // policy asks for it and at most every 'rowsInRowGroup' rows.
+  void write(const VectorPtr& data) override;
+
+  // Writes the rows added so far as a row group.
+  void flush() override;
+
+  // Flushes and writes the file footer. 'sink' is closed.
+  void close() override;
+
+  void abort() override;
+
+ private:
+  // Creates the column writers for the columns of 'type' on first write.
+  void initialize(const RowTypePtr& type);
+
+  // Calls 'func' with the index of each column. Runs the calls in parallel
+  // on 'encodingExecutor' if one is set and returns when all are done.
+  void forEachColumn(const std::function<void(size_t)>& func);
+
+  void writeBytes(const char* data, int32_t size);
+
+  const WriterOptions options_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+  // Thread safe leaf pool for the encoded pages. Used from the encoding
+  // executor's threads.
+  std::shared_ptr<memory::MemoryPool> generalPool_;
+  std::unique_ptr<dwio::common::FileSink> sink_;
+  std::unique_ptr<DefaultFlushPolicy> flushPolicy_;
+
+  RowTypePtr type_;
+  std::vector<std::unique_ptr<ColumnChunkWriter>> columns_;
+  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+
+  // Rows in the row group being written.
+  uint64_t numRows_{0};
+  // Bytes written to 'sink_'.
+  int64_t fileOffset_{0};
+};
+
+} // namespace facebook::velox::parquet
@@ -21,6 +21,7 @@
 #include <arrow/table.h>
 
 #include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/dwio/parquet/writer/NativeWriter.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 
@@ -132,7 +133,14 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   }
   properties =
       properties->compression(getArrowParquetCompression(options.compression));
+  properties = properties->encoding(options.encoding);
+  for (const auto& [path, encoding] : options.columnEncodings) {
+    properties = properties->encoding(path, encoding);
+  }
   properties = properties->data_pagesize(options.dataPageSize);
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   return properties->build();
@@ -283,6 +291,7 @@ parquet::WriterOptions getParquetOptions(
     const dwio::common::WriterOptions& options) {
   parquet::WriterOptions parquetOptions;
   parquetOptions.memoryPool = options.memoryPool;
+  parquetOptions.encodingExecutor = options.encodingExecutor;
   if (options.compressionKind.has_value()) {
     parquetOptions.compression = options.compressionKind.value();
   }
@@ -293,6 +302,9 @@ std::unique_ptr<dwio::common::Writer> ParquetWriterFactory::createWriter(
     std::unique_ptr<dwio::common::FileSink> sink,
     const dwio::common::WriterOptions& options) {
   auto parquetOptions = getParquetOptions(options);
+  if (options.parquetNativeWriter) {
+    return std::make_unique<NativeWriter>(std::move(sink), parquetOptions);
+  }
   return std::make_unique<Writer>(std::move(sink), parquetOptions);
 }
 
@@ -16,6 +16,11 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
+#include <string>
+#include <unordered_map>
+
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/FileSink.h"
@@ -23,6 +28,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
+#include "velox/dwio/parquet/writer/arrow/Types.h"
 #include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::parquet {
@@ -90,6 +96,23 @@ struct WriterOptions {
   // folly/FBVector(https://github.com/facebook/folly/blob/main/folly/docs/FBVector.md#memory-handling).
   double bufferGrowRatio = 1.5;
   common::CompressionKind compression = common::CompressionKind_NONE;
+  // Encoding used for data pages when dictionary encoding is disabled or the
+  // dictionary grew too large. Applies to every column that is not in
+  // 'columnEncodings'. Ignored by NativeWriter.
+  arrow::Encoding::type encoding = arrow::Encoding::PLAIN;
+  // Overrides 'encoding' for the columns with the given dot separated paths,
+  // e.g. "a.b" for field 'b' of top level struct 'a'.
+  std::unordered_map<std::string, arrow::Encoding::type> columnEncodings;
+  // Writes the ColumnIndex and OffsetIndex of each column chunk. Readers use
+  // them to skip data pages.
+  bool enablePageIndex = false;
+  // Writes a split block Bloom filter for each column chunk, except for
+  // BOOLEAN columns. Readers use them to skip row groups that have no value
+  // of an equality or IN filter. Ignored by the Arrow based Writer.
+  bool enableBloomFilter = false;
+  // If set, NativeWriter encodes and compresses the column chunks of a row
+  // group in parallel on this executor. Ignored by the Arrow based Writer.
+  folly::Executor* encodingExecutor{nullptr};
   velox::memory::MemoryPool* memoryPool;
   // The default factory allows the writer to construct the default flush
   // policy with the configs in its ctor.
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include <folly/Conv.h>
+#include <strings.h>
+#include <xsimd/xsimd.hpp>
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/type/TimestampConversion.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::text {
+
+namespace {
+
+// Returns the offset of the first byte of 'data' between 'begin' and 'end'
+// that is equal to 'first' or 'second', or 'end' if there is none.
+int32_t findEither(
+    const char* data,
+    int32_t begin,
+    int32_t end,
+    char first,
+    char second) {
+  using Batch = xsimd::batch<int8_t>;
+  const auto firstBatch = Batch::broadcast(first);
+  const auto secondBatch = Batch::broadcast(second);
+  auto i = begin;
+  for (; i + static_cast<int32_t>(Batch::size) <= end; i += Batch::size) {
+    auto bytes =
+        Batch::load_unaligned(reinterpret_cast<const int8_t*>(data + i));
+    uint32_t hits =
+        simd::toBitMask((bytes == firstBatch) | (bytes == secondBatch));
+    if (hits) {
+      return i + __builtin_ctz(hits);
+    }
+  }
+  for (; i < end; ++i) {
+    if (data[i] == first || data[i] == second) {
+      return i;
+    }
+  }
+  return end;
+}
+
+bool isSupportedType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return true;
+    case TypeKind::BIGINT:
+      return !type.isDecimal();
+    default:
+      return false;
+  }
+}
+
+// Parses 'field' into 'value'. Returns false if 'field' is not a valid value,
+// in which case the value is null as in Hive.
+bool parseValue(std::string_view field, const Type& /*type*/, bool& value) {
+  if (field.size() == 4 && strncasecmp(field.data(), "true", 4) == 0) {
+    value = true;
+    return true;
+  }
+  if (field.size() == 5 && strncasecmp(field.data(), "false", 5) == 0) {
+    value = false;
+    return true;
+  }
+  return false;
+}
+
+template <typename T>
+bool parseValue(std::string_view field, const Type& type, T& value) {
+  if constexpr (std::is_same_v<T, Timestamp>) {
+    try {
+      value = util::fromTimestampString(field.data(), field.size());
+    } catch (const VeloxUserError&) {
+      return false;
+    }
+    return true;
+  } else {
+    if constexpr (std::is_same_v<T, int32_t>) {
+      if (type.isDate()) {
+        try {
+          value = util::castFromDateString(field.data(), field.size(), true);
+        } catch (const VeloxUserError&) {
+          return false;
+        }
+        return true;
+      }
+    }
+    auto result = folly::tryTo<T>(folly::StringPiece(field));
+    if (result.hasError()) {
+      return false;
+    }
+    value = result.value();
+    return true;
+  }
+}
+
+} // namespace
+
+TextRowReader::TextRowReader(
+    std::shared_ptr<dwio::common::BufferedInput> input,
+    RowTypePtr rowType,
+    const dwio::common::SerDeOptions& serDeOptions,
+    const dwio::common::RowReaderOptions& options,
+    memory::MemoryPool& pool)
+    : pool_(pool),
+      input_(std::move(input)),
+      rowType_(std::move(rowType)),
+      serDeOptions_(serDeOptions),
+      options_(options),
+      fieldDelim_(serDeOptions_.separators[static_cast<size_t>(
+          dwio::common::SerDeSeparator::FIELD_DELIM)]),
+      lineReader_(
+          input_,
+          options_.getOffset(),
+          options_.getLength(),
+          options_.getSkipRows(),
+          /*padding=*/0,
+          pool_) {
+  isColumnRead_.resize(rowType_->size(), options_.getScanSpec() == nullptr);
+  if (auto& scanSpec = options_.getScanSpec()) {
+    for (auto& childSpec : scanSpec->children()) {
+      if (childSpec->isConstant() ||
+          !(childSpec->projectOut() || childSpec->filter())) {
+        continue;
+      }
+      isColumnRead_[rowType_->getChildIdx(childSpec->fieldName())] = true;
+    }
+  }
+  for (column_index_t i = 0; i < rowType_->size(); ++i) {
+    if (!isColumnRead_[i]) {
+      continue;
+    }
+    auto& type = rowType_->childAt(i);
+    VELOX_CHECK(
+        isSupportedType(*type),
+        "Unsupported type {} of column {} in text file",
+        type->toString(),
+        rowType_->nameOf(i));
+    numFields_ = i + 1;
+  }
+}
+
+int64_t TextRowReader::nextRowNumber() {
+  if (lineReader_.atEnd() && (!linesRead_ || numLines_ == 0)) {
+    return kAtEnd;
+  }
+  return rowNumber_;
+}
+
+int64_t TextRowReader::nextReadSize(uint64_t size) {
+  if (!linesRead_) {
+    numLines_ = lineReader_.next(std::min<uint64_t>(
+        size, std::numeric_limits<vector_size_t>::max()));
+    linesRead_ = true;
+  }
+  return numLines_ == 0 ? kAtEnd : numLines_;
+}
+
+uint64_t TextRowReader::next(
+    uint64_t size,
+    velox::VectorPtr& result,
+    const dwio::common::Mutation* mutation) {
+  if (mutation && mutation->deletedRows) {
+    VELOX_NYI("Deleted rows are not supported for text files");
+  }
+  if (nextReadSize(size) == kAtEnd) {
+    return 0;
+  }
+  const auto numRows = numLines_;
+  linesRead_ = false;
+  splitFields(numRows);
+  std::vector<VectorPtr> children(rowType_->size());
+  for (column_index_t i = 0; i < rowType_->size(); ++i) {
+    if (isColumnRead_[i]) {
+      children[i] = readColumn(i, numRows);
+    } else {
+      children[i] =
+          BaseVector::createNullConstant(rowType_->childAt(i), numRows, &pool_);
+    }
+  }
+  auto rowVector = std::make_shared<RowVector>(
+      &pool_, rowType_, nullptr, numRows, std::move(children));
+  if (auto& scanSpec = options_.getScanSpec()) {
+    result = projectColumns(rowVector, *scanSpec);
+  } else {
+    result = std::move(rowVector);
+  }
+  rowNumber_ += numRows;
+  return numRows;
+}
+
+int32_t TextRowReader::findFieldEnd(int32_t begin, int32_t end) const {
+  const auto* data = lineReader_.data();
+  if (!serDeOptions_.isEscaped) {
+    return findEither(data, begin, end, fieldDelim_, fieldDelim_);
+  }
+  for (;;) {
+    const auto position =
+        findEither(data, begin, end, fieldDelim_, serDeOptions_.escapeChar);
+    if (position == end || data[position] == fieldDelim_) {
+      return position;
+    }
+    // Skip the escaped character.
+    begin = position + 2;
+    if (begin >= end) {
+      return end;
+    }
+  }
+}
+
+void TextRowReader::splitFields(vector_size_t numRows) {
+  fieldBegins_.resize(numRows * numFields_);
+  fieldEnds_.resize(numRows * numFields_);
+  const column_index_t lastColumn = rowType_->size() - 1;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    auto* fieldBegins = fieldBegins_.data() + row * numFields_;
+    auto* fieldEnds = fieldEnds_.data() + row * numFields_;
+    auto begin = lineReader_.lineBegins()[row];
+    const auto end = lineReader_.lineEnds()[row];
+    column_index_t i = 0;
+    for (; i < numFields_ && begin <= end; ++i) {
+      const auto fieldEnd =
+          serDeOptions_.lastColumnTakesRest && i == lastColumn
+          ? end
+          : findFieldEnd(begin, end);
+      fieldBegins[i] = begin;
+      fieldEnds[i] = fieldEnd;
+      begin = fieldEnd + 1;
+    }
+    for (; i < numFields_; ++i) {
+      fieldBegins[i] = -1;
+    }
+  }
+}
+
+std::string_view TextRowReader::stringValue(int32_t begin, int32_t end) {
+  std::string_view field(lineReader_.data() + begin, end - begin);
+  if (!serDeOptions_.isEscaped ||
+      field.find(serDeOptions_.escapeChar) == std::string_view::npos) {
+    return field;
+  }
+  unescaped_.clear();
+  for (size_t i = 0; i < field.size(); ++i) {
+    if (field[i] == serDeOptions_.escapeChar && i + 1 < field.size()) {
+      ++i;
+    }
+    unescaped_.push_back(field[i]);
+  }
+  return unescaped_;
+}
+
+template <TypeKind kKind>
+void TextRowReader::readValues(
+    column_index_t column,
+    vector_size_t numRows,
+    BaseVector& result) {
+  using T = typename TypeTraits<kKind>::NativeType;
+  auto* flat = result.asUnchecked<FlatVector<T>>();
+  const auto& type = *rowType_->childAt(column);
+  const auto& nullString = serDeOptions_.nullString;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    const auto begin = fieldBegins_[row * numFields_ + column];
+    if (begin < 0) {
+      flat->setNull(row, true);
+      continue;
+    }
+    const auto end = fieldEnds_[row * numFields_ + column];
+    std::string_view field(lineReader_.data() + begin, end - begin);
+    if (field == nullString) {
+      flat->setNull(row, true);
+      continue;
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      auto value = stringValue(begin, end);
+      // Copies the value into the string buffers of 'flat' unless it is
+      // inlined.
+      flat->set(row, StringView(value.data(), value.size()));
+    } else {
+      T value;
+      if (field.empty() || !parseValue(field, type, value)) {
+        flat->setNull(row, true);
+      } else {
+        flat->set(row, value);
+      }
+    }
+  }
+}
+
+VectorPtr TextRowReader::readColumn(
+    column_index_t column,
+    vector_size_t numRows) {
+  const auto& type = rowType_->childAt(column);
+  auto result = BaseVector::create(type, numRows, &pool_);
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      readValues<TypeKind::BOOLEAN>(column, numRows, *result);
+      break;
+    case TypeKind::TINYINT:
+      readValues<TypeKind::TINYINT>(column, numRows, *result);
+      break;
+    case TypeKind::SMALLINT:
+      readValues<TypeKind::SMALLINT>(column, numRows, *result);
+      break;
+    case TypeKind::INTEGER:
+      readValues<TypeKind::INTEGER>(column, numRows, *result);
+      break;
+    case TypeKind::BIGINT:
+      readValues<TypeKind::BIGINT>(column, numRows, *result);
+      break;
+    case TypeKind::REAL:
+      readValues<TypeKind::REAL>(column, numRows, *result);
+      break;
+    case TypeKind::DOUBLE:
+      readValues<TypeKind::DOUBLE>(column, numRows, *result);
+      break;
+    case TypeKind::VARCHAR:
+      readValues<TypeKind::VARCHAR>(column, numRows, *result);
+      break;
+    case TypeKind::VARBINARY:
+      readValues<TypeKind::VARBINARY>(column, numRows, *result);
+      break;
+    case TypeKind::TIMESTAMP:
+      readValues<TypeKind::TIMESTAMP>(column, numRows, *result);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  return result;
+}
+
+TextReader::TextReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& options)
+    : pool_(options.getMemoryPool()),
+      input_(std::move(input)),
+      rowType_(options.getFileSchema()),
+      serDeOptions_(options.getSerDeOptions()) {
+  VELOX_CHECK_NOT_NULL(rowType_, "Reading a text file requires its schema");
+  typeWithId_ = dwio::common::TypeWithId::create(rowType_);
+}
+
+std::unique_ptr<dwio::common::RowReader> TextReader::createRowReader(
+    const dwio::common::RowReaderOptions& options) const {
+  return std::make_unique<TextRowReader>(
+      input_, rowType_, serDeOptions_, options, pool_);
+}
+
+} // namespace facebook::velox::text
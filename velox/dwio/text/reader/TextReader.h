@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/LineReader.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::text {
+
+/// Implements the RowReader interface for delimited text files, e.g. Hive
+/// tables stored as TEXTFILE with LazySimpleSerDe. Reads the lines that start
+/// in the byte range of the RowReaderOptions, so that a file can be scanned
+/// in parallel by several splits. A line belongs to the split whose range
+/// contains the newline ending the previous line. Only the columns that the
+/// ScanSpec projects or filters are parsed. The fields of a line are split
+/// only up to the last of these columns.
+class TextRowReader : public dwio::common::RowReader {
+ public:
+  TextRowReader(
+      std::shared_ptr<dwio::common::BufferedInput> input,
+      RowTypePtr rowType,
+      const dwio::common::SerDeOptions& serDeOptions,
+      const dwio::common::RowReaderOptions& options,
+      memory::MemoryPool& pool);
+
+  int64_t nextRowNumber() override;
+
+  int64_t nextReadSize(uint64_t size) override;
+
+  uint64_t next(
+      uint64_t size,
+      velox::VectorPtr& result,
+      const dwio::common::Mutation* = nullptr) override;
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& /*stats*/) const override {}
+
+  void resetFilterCaches() override {}
+
+  std::optional<size_t> estimatedRowSize() const override {
+    return std::nullopt;
+  }
+
+ private:
+  // Finds the bounds of the fields of the lines of the current batch of
+  // 'lineReader_' for the first 'numFields_' columns.
+  void splitFields(vector_size_t numRows);
+
+  // Returns the offset of the first unescaped field delimiter in the line data
+  // between 'begin' and 'end', or 'end' if there is none.
+  int32_t findFieldEnd(int32_t begin, int32_t end) const;
+
+  // Makes a vector of 'numRows' values of 'column' from the fields found by
+  // splitFields().
+  VectorPtr readColumn(column_index_t column, vector_size_t numRows);
+
+  template <TypeKind kKind>
+  void readValues(
+      column_index_t column,
+      vector_size_t numRows,
+      BaseVector& result);
+
+  // Returns the unescaped string value of the field at 'begin' and 'end' of
+  // the line data. Uses 'unescaped_' for the value if it has escapes.
+  std::string_view stringValue(int32_t begin, int32_t end);
+
+  memory::MemoryPool& pool_;
+  const std::shared_ptr<dwio::common::BufferedInput> input_;
+  const RowTypePtr rowType_;
+  const dwio::common::SerDeOptions serDeOptions_;
+  const dwio::common::RowReaderOptions options_;
+  const uint8_t fieldDelim_;
+
+  // True if the column at the index is parsed.
+  std::vector<bool> isColumnRead_;
+  // Number of leading fields found in each line, i.e. one past the last
+  // parsed column.
+  column_index_t numFields_{0};
+
+  dwio::common::LineReader lineReader_;
+
+  // Bounds of the fields of the current batch in the line data, 'numFields_'
+  // entries per line. The begin is -1 for a field missing from its line.
+  std::vector<int32_t> fieldBegins_;
+  std::vector<int32_t> fieldEnds_;
+
+  // Holds a string value with escapes removed.
+  std::string unescaped_;
+
+  // True if the lines of the next batch have been found by nextReadSize().
+  bool linesRead_{false};
+  vector_size_t numLines_{0};
+  // Lines returned so far. Row numbers are relative to the start of the
+  // range.
+  int64_t rowNumber_{0};
+};
+
+/// Implements the reader interface for delimited text files. A text file has
+/// no metadata, so the schema is given by ReaderOptions::getFileSchema() and
+/// the delimiters by ReaderOptions::getSerDeOptions().
+class TextReader : public dwio::common::Reader {
+ public:
+  TextReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options);
+
+  ~TextReader() override = default;
+
+  std::optional<uint64_t> numberOfRows() const override {
+    return std::nullopt;
+  }
+
+  std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
+      uint32_t /*index*/) const override {
+    return nullptr;
+  }
+
+  const velox::RowTypePtr& rowType() const override {
+    return rowType_;
+  }
+
+  const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
+      const override {
+    return typeWithId_;
+  }
+
+  std::unique_ptr<dwio::common::RowReader> createRowReader(
+      const dwio::common::RowReaderOptions& options = {}) const override;
+
+ private:
+  memory::MemoryPool& pool_;
+  const std::shared_ptr<dwio::common::BufferedInput> input_;
+  const RowTypePtr rowType_;
+  std::shared_ptr<const dwio::common::TypeWithId> typeWithId_;
+  const dwio::common::SerDeOptions serDeOptions_;
+};
+
+class TextReaderFactory : public dwio::common::ReaderFactory {
+ public:
+  TextReaderFactory() : ReaderFactory(dwio::common::FileFormat::TEXT) {}
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options) override {
+    return std::make_unique<TextReader>(std::move(input), options);
+  }
+};
+
+} // namespace facebook::velox::text
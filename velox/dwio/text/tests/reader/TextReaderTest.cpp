@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+#include "velox/type/Filter.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::text;
+
+namespace {
+
+class TextReaderTest : public testing::Test, public test::VectorTestBase {
+ protected:
+  std::unique_ptr<dwio::common::Reader> makeReader(
+      const std::string& data,
+      const RowTypePtr& type,
+      const dwio::common::SerDeOptions& serDeOptions =
+          dwio::common::SerDeOptions(',')) {
+    dwio::common::ReaderOptions options(pool());
+    options.setFileSchema(type);
+    options.setSerDeOptions(serDeOptions);
+    auto input = std::make_unique<dwio::common::BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), *pool());
+    return TextReaderFactory().createReader(std::move(input), options);
+  }
+
+  // Reads all rows of 'reader' with 'options' in batches of 'batchSize'.
+  RowVectorPtr read(
+      const dwio::common::Reader& reader,
+      const dwio::common::RowReaderOptions& options = {},
+      uint64_t batchSize = 1'000) {
+    auto rowReader = reader.createRowReader(options);
+    RowVectorPtr result;
+    VectorPtr batch;
+    while (rowReader->next(batchSize, batch) > 0) {
+      if (!result) {
+        result = std::static_pointer_cast<RowVector>(
+            BaseVector::create(batch->type(), 0, pool()));
+      }
+      result->append(batch.get());
+    }
+    EXPECT_EQ(rowReader->nextRowNumber(), dwio::common::RowReader::kAtEnd);
+    return result;
+  }
+};
+
+TEST_F(TextReaderTest, types) {
+  auto type =
+      ROW({"b", "i", "bi", "d", "s", "dt"},
+          {BOOLEAN(), INTEGER(), BIGINT(), DOUBLE(), VARCHAR(), DATE()});
+  auto reader = makeReader(
+      "true,1,10,1.5,apple,2023-01-02\n"
+      "FALSE,-2,\\N,,,bad\n"
+      "x,3\n"
+      "false,4,40,4.25,a longer string value,1970-01-01",
+      type);
+  EXPECT_EQ(reader->numberOfRows(), std::nullopt);
+  EXPECT_EQ(*reader->rowType(), *type);
+  auto expected = makeRowVector(
+      type->names(),
+      {
+          makeNullableFlatVector<bool>({true, false, std::nullopt, false}),
+          makeFlatVector<int32_t>({1, -2, 3, 4}),
+          makeNullableFlatVector<int64_t>(
+              {10, std::nullopt, std::nullopt, 40}),
+          makeNullableFlatVector<double>(
+              {1.5, std::nullopt, std::nullopt, 4.25}),
+          makeNullableFlatVector<std::string>(
+              {"apple", "", std::nullopt, "a longer string value"}),
+          makeNullableFlatVector<int32_t>(
+              {19359, std::nullopt, std::nullopt, 0}, DATE()),
+      });
+  test::assertEqualVectors(expected, read(*reader));
+}
+
+TEST_F(TextReaderTest, projectionAndFilter) {
+  // 'c3' is of a type the reader cannot parse. It is never parsed because it
+  // is not in the ScanSpec.
+  auto type =
+      ROW({"c0", "c1", "c2", "c3"},
+          {BIGINT(), VARCHAR(), DOUBLE(), ARRAY(BIGINT())});
+  std::string data;
+  for (auto i = 0; i < 10; ++i) {
+    data += fmt::format("{},s{},{},[{}]\n", i, i, i * 0.5, i);
+  }
+  auto reader = makeReader(data, type);
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addField("c2", 0);
+  scanSpec->getOrCreateChild(common::Subfield("c0"))
+      ->setFilter(std::make_unique<common::BigintRange>(2, 4, false));
+  dwio::common::RowReaderOptions options;
+  options.setScanSpec(scanSpec);
+  auto expected = makeRowVector({"c2"}, {makeFlatVector<double>({1, 1.5, 2})});
+  test::assertEqualVectors(expected, read(*reader, options, 3));
+
+  scanSpec->addField("c3", 1);
+  VELOX_ASSERT_THROW(
+      reader->createRowReader(options), "Unsupported type ARRAY<BIGINT>");
+}
+
+TEST_F(TextReaderTest, ranges) {
+  constexpr int32_t kNumRows = 1'000;
+  auto type = ROW({"c0", "c1"}, {INTEGER(), VARCHAR()});
+  std::string data;
+  for (auto i = 0; i < kNumRows; ++i) {
+    data += fmt::format("{},{}\n", i, std::string(i % 37, 'x'));
+  }
+  auto reader = makeReader(data, type);
+  for (uint64_t rangeSize : {1, 7, 100, 4'096, 1 << 20}) {
+    SCOPED_TRACE(fmt::format("rangeSize={}", rangeSize));
+    std::vector<int32_t> values;
+    for (uint64_t offset = 0; offset < data.size(); offset += rangeSize) {
+      dwio::common::RowReaderOptions options;
+      options.range(offset, rangeSize);
+      if (auto result = read(*reader, options, 100)) {
+        auto* c0 = result->childAt(0)->asFlatVector<int32_t>();
+        for (auto i = 0; i < result->size(); ++i) {
+          values.push_back(c0->valueAt(i));
+        }
+      }
+    }
+    ASSERT_EQ(values.size(), kNumRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      ASSERT_EQ(values[i], i);
+    }
+  }
+}
+
+TEST_F(TextReaderTest, headerAndEscapes) {
+  auto type = ROW({"s", "i"}, {VARCHAR(), BIGINT()});
+  auto reader = makeReader(
+      "header 1\nheader 2\na\\,b,1\r\nc\\\\,2,extra\n",
+      type,
+      dwio::common::SerDeOptions(',', '\2', '\3', '\\', true));
+  dwio::common::RowReaderOptions options;
+  options.setSkipRows(2);
+  auto expected = makeRowVector(
+      type->names(),
+      {
+          makeFlatVector<std::string>({"a,b", "c\\"}),
+          makeFlatVector<int64_t>({1, 2}),
+      });
+  test::assertEqualVectors(expected, read(*reader, options));
+}
+
+TEST_F(TextReaderTest, lastColumnTakesRest) {
+  auto type = ROW({"s0", "s1"}, {VARCHAR(), VARCHAR()});
+  dwio::common::SerDeOptions serDeOptions('|');
+  serDeOptions.lastColumnTakesRest = true;
+  auto reader = makeReader("a|b|c\nd\n", type, serDeOptions);
+  auto expected = makeRowVector(
+      type->names(),
+      {
+          makeFlatVector<std::string>({"a", "d"}),
+          makeNullableFlatVector<std::string>({"b|c", std::nullopt}),
+      });
+  test::assertEqualVectors(expected, read(*reader));
+}
+
+} // namespace
@@ -221,6 +221,35 @@ TEST_F(TableScanTest, allColumns) {
   EXPECT_LT(0, exec::TableScan::ioWaitNanos());
 }
 
+TEST_F(TableScanTest, localFileMmap) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  std::unordered_map<std::string, std::string> properties{
+      {HiveConfig::kLocalFileMmap, "true"}};
+  resetHiveConnector(std::make_shared<core::MemConfig>(properties));
+  // The file is read through the mapping only without AsyncDataCache.
+  auto makeQueryCtx = [&]() {
+    return std::make_shared<core::QueryCtx>(
+        executor_.get(),
+        QueryConfig({}),
+        std::unordered_map<std::string, std::shared_ptr<Config>>{},
+        nullptr);
+  };
+  AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+      .queryCtx(makeQueryCtx())
+      .splits(makeHiveConnectorSplits({filePath}))
+      .assertResults("SELECT * FROM tmp");
+  AssertQueryBuilder(
+      PlanBuilder().tableScan(rowType_, {"c1 > 0"}, "c0 % 3 = 0").planNode(),
+      duckDbQueryRunner_)
+      .queryCtx(makeQueryCtx())
+      .splits(makeHiveConnectorSplits({filePath}))
+      .assertResults("SELECT * FROM tmp WHERE c1 > 0 AND c0 % 3 = 0");
+}
+
 TEST_F(TableScanTest, connectorStats) {
   auto hiveConnector =
       std::dynamic_pointer_cast<connector::hive::HiveConnector>(
@@ -1224,6 +1253,38 @@ TEST_F(TableScanTest, splitDoubleRead) {
   }
 }
 
+TEST_F(TableScanTest, decompressedPageCache) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [&](auto row) { return row % 17; }),
+         makeFlatVector<StringView>(1'000, [&](auto row) {
+           return StringView::makeInline(fmt::format("s{}", row % 13));
+         })}));
+  }
+  // One stripe per vector, so that the streams of the file are referenced
+  // once per stripe.
+  auto config = std::make_shared<dwrf::Config>();
+  config->set<uint64_t>(dwrf::Config::STRIPE_SIZE, 1);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors, config);
+  createDuckDbTable(vectors);
+
+  // The second split of the file reads the pages decompressed by the first.
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .plan(tableScanNode(asRowType(vectors[0]->type())))
+                  .splits(makeHiveConnectorSplits({filePath, filePath}))
+                  .connectorConfig(
+                      kHiveConnectorId,
+                      HiveConfig::kDecompressedPageCacheMinReadPct,
+                      "0")
+                  .assertResults(
+                      "SELECT * FROM tmp UNION ALL SELECT * FROM tmp");
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_GT(stats.at("numDecompressedPageHit").sum, 0);
+  ASSERT_GT(stats.at("decompressedPageHitBytes").sum, 0);
+}
+
 TEST_F(TableScanTest, multipleSplits) {
   std::vector<int32_t> numPrefetchSplits = {0, 2};
   for (const auto& numPrefetchSplit : numPrefetchSplits) {